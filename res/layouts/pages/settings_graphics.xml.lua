@@ -38,6 +38,7 @@ end
 function on_open()
     create_setting("chunks.load-distance", "Load Distance", 1)
     create_setting("chunks.load-speed", "Load Speed", 1)
+    create_setting("graphics.chunk-lod-distance", "LOD Distance", 1, "", "graphics.chunk-lod-distance.tooltip")
     create_setting("graphics.fog-curve", "Fog Curve", 0.1)
     create_setting("graphics.gamma", "Gamma", 0.05, "", "graphics.gamma.tooltip")
     create_checkbox("graphics.backlight", "Backlight", "graphics.backlight.tooltip")
@@ -51,6 +51,8 @@ local function append(self, b)
     end
     if _type(b) == "number" then
         self.bytes[self.size] = b
+    elseif _type(b) == "string" then
+        FFI.copy(self.bytes + self.size, b, elems)
     else
         for i=1, #b do
             self.bytes[self.size + i - 1] = b[i]
@@ -210,7 +212,12 @@ local function FFIBytearray_as_string(bytes)
     end
 end
 
+local function FFIBytearray_istype(value)
+    return FFI.istype(bytearray_type, value)
+end
+
 return {
     FFIBytearray = setmetatable(FFIBytearray, FFIBytearray),
-    FFIBytearray_as_string = FFIBytearray_as_string
+    FFIBytearray_as_string = FFIBytearray_as_string,
+    FFIBytearray_istype = FFIBytearray_istype
 }
@@ -39,6 +39,17 @@ end
 local Socket = {__index={
     send=function(self, ...) return network.__send(self.id, ...) end,
     recv=function(self, ...) return network.__recv(self.id, ...) end,
+    recv_into=function(self, dst, length)
+        length = length or network.__available(self.id) or 0
+        dst:reserve(dst.size + length)
+        return network.__recv_into(self.id, dst, length)
+    end,
+    send_packet=function(self, ...)
+        return network.__send_packet(self.id, ...)
+    end,
+    recv_packet=function(self, ...)
+        return network.__recv_packet(self.id, ...)
+    end,
     close=function(self) return network.__close(self.id) end,
     available=function(self) return network.__available(self.id) or 0 end,
     is_alive=function(self) return network.__is_alive(self.id) end,
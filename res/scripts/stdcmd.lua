@@ -170,6 +170,47 @@ console.add_command(
     end
 )
 
+console.add_command(
+    "profiler.start",
+    "Start profiler capture",
+    function()
+        profiler.start()
+        return "profiler capture started"
+    end
+)
+
+console.add_command(
+    "profiler.stop name:str='trace'",
+    "Stop profiler capture and save it as Chrome trace (chrome://tracing, Perfetto)",
+    function(args, kwargs)
+        local trace = profiler.stop()
+        if trace == nil then
+            return "profiler capture is not active"
+        end
+        local filename = 'export:'..args[1]..'.json'
+        file.write(filename, trace)
+        return "profiler capture has been saved as "..file.resolve(filename)
+    end
+)
+
+console.add_command(
+    "metrics name:str=''",
+    "Show engine metric value or all metrics in Prometheus format",
+    function(args, kwargs)
+        local name = args[1]
+        if #name == 0 then
+            return metrics.export()
+        end
+        local value = metrics.get(name)
+        if value == nil then
+            return "metric '"..name.."' not found"
+        elseif type(value) == "table" then
+            return json.tostring(value, true)
+        end
+        return tostring(value)
+    end
+)
+
 console.add_command(
     "fragment.save x1:int~pos.x y1:int~pos.y z1:int~pos.z "..
                   "x2:int~pos.x y2:int~pos.y z2:int~pos.z "..
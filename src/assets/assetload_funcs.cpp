@@ -27,6 +27,7 @@
 #include "util/stringutil.hpp"
 #include "Assets.hpp"
 #include "AssetsLoader.hpp"
+#include "atlas_cache.hpp"
 
 static debug::Logger logger("assetload-funcs");
 
@@ -136,6 +137,8 @@ assetload::postfunc assetload::posteffect(
     };
 }
 
+static constexpr uint ATLAS_EXTRUSION = 2;
+
 static bool append_atlas(AtlasBuilder& atlas, const io::path& file) {
     std::string name = file.stem();
     // skip duplicates
@@ -168,13 +171,33 @@ assetload::postfunc assetload::atlas(
         }
         return [](auto){};
     }
-    AtlasBuilder builder;
+    std::set<std::string> names;
+    std::vector<io::path> files;
     for (const auto& file : paths.listdir(directory)) {
         if (!imageio::is_read_supported(file.extension())) continue;
-        if (!append_atlas(builder, file)) continue;
+        // skip duplicates
+        if (!names.insert(file.stem()).second) continue;
+        files.push_back(file);
+    }
+    auto cacheFile = atlas_cache::get_file(name);
+    uint64_t cacheKey = 0;
+    std::unique_ptr<Atlas> cached;
+    if (!cacheFile.empty()) {
+        cacheKey = atlas_cache::calc_key(files, ATLAS_EXTRUSION, 0);
+        cached = atlas_cache::load(cacheFile, cacheKey, false);
+    }
+
+    Atlas* atlas;
+    if (cached) {
+        atlas = cached.release();
+    } else {
+        AtlasBuilder builder;
+        for (const auto& file : files) {
+            append_atlas(builder, file);
+        }
+        atlas = builder.build(ATLAS_EXTRUSION, false).release();
+        atlas_cache::save(cacheFile, *atlas, cacheKey);
     }
-    std::set<std::string> names = builder.getNames();
-    Atlas* atlas = builder.build(2, false).release();
     return [=](auto assets) {
         atlas->prepare();
         assets->store(std::unique_ptr<Atlas>(atlas), name);
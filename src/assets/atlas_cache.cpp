@@ -0,0 +1,166 @@
+#include "atlas_cache.hpp"
+
+#include <cstring>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "coders/byte_utils.hpp"
+#include "debug/Logger.hpp"
+#include "graphics/core/Atlas.hpp"
+#include "graphics/core/ImageData.hpp"
+#include "io/io.hpp"
+
+static debug::Logger logger("atlas-cache");
+
+static inline const char MAGIC[] = "VEATLAS";
+static inline io::path CACHE_FOLDER = "cache:atlases";
+
+static constexpr uint64_t FNV_OFFSET = 0xcbf29ce484222325ULL;
+static constexpr uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+static inline uint64_t fnv1a(uint64_t hash, const ubyte* data, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+template <typename T>
+static inline uint64_t fnv1a(uint64_t hash, T value) {
+    return fnv1a(hash, reinterpret_cast<const ubyte*>(&value), sizeof(T));
+}
+
+uint64_t atlas_cache::calc_key(
+    const std::vector<io::path>& files, uint extrusion, uint maxResolution
+) {
+    uint64_t hash = FNV_OFFSET;
+    hash = fnv1a(hash, FORMAT_VERSION);
+    hash = fnv1a(hash, extrusion);
+    hash = fnv1a(hash, maxResolution);
+    for (const auto& file : files) {
+        auto name = file.string();
+        hash = fnv1a(
+            hash, reinterpret_cast<const ubyte*>(name.data()), name.length()
+        );
+        // raw bytes hashing is cheap compared to decoding
+        auto bytes = io::read_bytes_buffer(file);
+        hash = fnv1a(hash, bytes.size());
+        hash = fnv1a(hash, bytes.data(), bytes.size());
+    }
+    return hash;
+}
+
+std::vector<ubyte> atlas_cache::encode(const Atlas& atlas, uint64_t key) {
+    const auto& image = *atlas.getImage();
+    const auto& regions = atlas.getRegions();
+
+    ByteBuilder builder(image.getDataSize() + regions.size() * 32 + 64);
+    builder.putCStr(MAGIC);
+    builder.putInt32(FORMAT_VERSION);
+    builder.putInt64(key);
+    builder.put(static_cast<ubyte>(image.getFormat()));
+    builder.putInt32(image.getWidth());
+    builder.putInt32(image.getHeight());
+    builder.putInt32(regions.size());
+    for (const auto& [name, region] : regions) {
+        builder.put(name);
+        builder.putFloat32(region.u1);
+        builder.putFloat32(region.v1);
+        builder.putFloat32(region.u2);
+        builder.putFloat32(region.v2);
+    }
+    builder.put(image.getData(), image.getDataSize());
+    return builder.build();
+}
+
+std::unique_ptr<Atlas> atlas_cache::decode(
+    const ubyte* src, size_t size, uint64_t key, bool prepare
+) {
+    ByteReader reader(src, size);
+    try {
+        reader.checkMagic(MAGIC, sizeof(MAGIC));
+    } catch (const std::runtime_error&) {
+        return nullptr;
+    }
+    if (reader.remaining() < 25 || reader.getInt32() != FORMAT_VERSION ||
+        static_cast<uint64_t>(reader.getInt64()) != key) {
+        return nullptr;
+    }
+    auto format = static_cast<ImageFormat>(reader.get());
+    if (format != ImageFormat::rgb888 && format != ImageFormat::rgba8888) {
+        return nullptr;
+    }
+    uint width = reader.getInt32();
+    uint height = reader.getInt32();
+    uint count = reader.getInt32();
+
+    std::unordered_map<std::string, UVRegion> regions;
+    for (uint i = 0; i < count; i++) {
+        std::string name = reader.getString();
+        float u1 = reader.getFloat32();
+        float v1 = reader.getFloat32();
+        float u2 = reader.getFloat32();
+        float v2 = reader.getFloat32();
+        regions[name] = UVRegion(u1, v1, u2, v2);
+    }
+    size_t channels = 3 + (format == ImageFormat::rgba8888);
+    size_t dataSize = static_cast<size_t>(width) * height * channels;
+    if (reader.remaining() != dataSize) {
+        return nullptr;
+    }
+    auto data = std::make_unique<ubyte[]>(dataSize);
+    std::memcpy(data.get(), reader.pointer(), dataSize);
+    auto image = std::make_unique<ImageData>(
+        format, width, height, std::move(data)
+    );
+    return std::make_unique<Atlas>(std::move(image), std::move(regions), prepare);
+}
+
+std::unique_ptr<Atlas> atlas_cache::load(
+    const io::path& file, uint64_t key, bool prepare
+) {
+    if (file.empty() || !io::is_regular_file(file)) {
+        return nullptr;
+    }
+    try {
+        auto bytes = io::read_bytes_buffer(file);
+        auto atlas = decode(bytes.data(), bytes.size(), key, prepare);
+        if (atlas == nullptr) {
+            logger.info() << "outdated atlas cache " << file.string();
+        }
+        return atlas;
+    } catch (const std::runtime_error& err) {
+        logger.error() << "could not read atlas cache " << file.string()
+                       << ": " << err.what();
+        return nullptr;
+    }
+}
+
+bool atlas_cache::save(const io::path& file, const Atlas& atlas, uint64_t key) {
+    if (file.empty()) {
+        return false;
+    }
+    try {
+        io::create_directories(file.parent());
+        auto bytes = encode(atlas, key);
+        return io::write_bytes(file, bytes.data(), bytes.size());
+    } catch (const std::runtime_error& err) {
+        logger.error() << "could not write atlas cache " << file.string()
+                       << ": " << err.what();
+        return false;
+    }
+}
+
+io::path atlas_cache::get_file(const std::string& name) {
+    if (io::get_device(CACHE_FOLDER.entryPoint()) == nullptr) {
+        return io::path();
+    }
+    std::string filename = name;
+    for (char& c : filename) {
+        if (c == '/' || c == ':' || c == '\\') {
+            c = '_';
+        }
+    }
+    return CACHE_FOLDER / (filename + ".atlas");
+}
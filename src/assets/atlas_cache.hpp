@@ -0,0 +1,51 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "typedefs.hpp"
+#include "io/fwd.hpp"
+
+class Atlas;
+
+/// @brief Persistent cache of baked texture atlases.
+/// Stores packed atlas raster and UV regions, so unchanged atlases are loaded
+/// without decoding source images, packing and extrusion.
+namespace atlas_cache {
+    /// @brief Cache format version. Increment on any format or packing
+    /// algorithm change to invalidate existing cache files
+    inline constexpr int FORMAT_VERSION = 1;
+
+    /// @brief Calculate cache key for the atlas build
+    /// @param files source image files in order of appending to the builder
+    /// @param extrusion textures extrusion pixels
+    /// @param maxResolution max atlas resolution
+    uint64_t calc_key(
+        const std::vector<io::path>& files, uint extrusion, uint maxResolution
+    );
+
+    /// @brief Encode atlas to cache file bytes
+    std::vector<ubyte> encode(const Atlas& atlas, uint64_t key);
+
+    /// @brief Decode atlas from cache file bytes
+    /// @param key expected cache key
+    /// @param prepare generate atlas texture (calls .prepare())
+    /// @return nullptr if data is invalid, outdated or key does not match
+    std::unique_ptr<Atlas> decode(
+        const ubyte* src, size_t size, uint64_t key, bool prepare
+    );
+
+    /// @brief Try to load atlas from the cache file
+    /// @return nullptr if cache file not found or outdated
+    std::unique_ptr<Atlas> load(
+        const io::path& file, uint64_t key, bool prepare
+    );
+
+    /// @brief Write atlas to the cache file
+    bool save(const io::path& file, const Atlas& atlas, uint64_t key);
+
+    /// @brief Get cache file path for the atlas name
+    /// @return empty path if cache device is not available
+    io::path get_file(const std::string& name);
+}
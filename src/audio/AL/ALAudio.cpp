@@ -41,10 +41,16 @@ ALStream::ALStream(
     ALAudio* al, std::shared_ptr<PCMStream> source, bool keepSource
 )
     : al(al), source(std::move(source)), keepSource(keepSource) {
+    // a few buffers ahead of the queued ones
+    buffered = std::make_shared<BufferedPCMStream>(
+        this->source, BUFFER_SIZE * (STREAM_BUFFERS + 1)
+    );
+    al->getDecoder().add(buffered);
 }
 
 ALStream::~ALStream() {
     bindSpeaker(0);
+    buffered = nullptr;
     source = nullptr;
 
     while (!unusedBuffers.empty()) {
@@ -62,8 +68,13 @@ std::shared_ptr<PCMStream> ALStream::getSource() const {
 }
 
 bool ALStream::preloadBuffer(uint buffer, bool loop) {
-    size_t read = source->readFully(this->buffer, BUFFER_SIZE, loop);
+    // wait until the whole buffer is decoded unless it's the end
+    if (buffered->available() < BUFFER_SIZE && !buffered->isEnded()) {
+        return false;
+    }
+    size_t read = buffered->readFully(this->buffer, BUFFER_SIZE, loop);
     if (!read) return false;
+    al->getDecoder().notify();
     ALenum format =
         AL::to_al_format(source->getChannels(), source->getBitsPerSample());
     AL_CHECK(alBufferData(
@@ -74,6 +85,7 @@ bool ALStream::preloadBuffer(uint buffer, bool loop) {
 
 std::unique_ptr<Speaker> ALStream::createSpeaker(bool loop, int channel) {
     this->loop = loop;
+    buffered->setLoop(loop);
     uint free_source = al->getFreeSource();
     if (free_source == 0) {
         return nullptr;
@@ -165,9 +177,10 @@ void ALStream::update(double delta) {
     if (p_speaker->isStopped() && !alspeaker->stopped) { //TODO: -V560 false-positive?
         if (preloaded) {
             p_speaker->play();
-        } else {
+        } else if (buffered->isEnded() && buffered->available() == 0) {
             p_speaker->stop();
         }
+        // otherwise waiting for the decoder
     }
 }
 
@@ -189,7 +202,10 @@ duration_t ALStream::getTime() const {
 void ALStream::setTime(duration_t time) {
     if (!source->isSeekable()) return;
     uint sample = time * source->getSampleRate();
-    source->seek(sample);
+    buffered->seek(sample);
+    // decode the first buffer right away to continue without a gap
+    while (buffered->available() < BUFFER_SIZE && buffered->decode());
+    al->getDecoder().notify();
     auto alspeaker =
         dynamic_cast<ALSpeaker*>(audio::get_speaker(this->speaker));
     if (alspeaker) {
@@ -355,6 +371,7 @@ int ALSpeaker::getPriority() const {
 
 ALAudio::ALAudio(ALCdevice* device, ALCcontext* context)
     : device(device), context(context) {
+    decoder = std::make_unique<StreamDecoder>();
     ALCint size;
     alcGetIntegerv(device, ALC_ATTRIBUTES_SIZE, 1, &size);
     std::vector<ALCint> attrs(size);
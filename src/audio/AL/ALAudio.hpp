@@ -8,6 +8,7 @@
 
 #include "typedefs.hpp"
 #include "audio/audio.hpp"
+#include "audio/StreamDecoder.hpp"
 
 #ifdef __APPLE__
 #include <OpenAL/al.h>
@@ -53,6 +54,8 @@ namespace audio {
 
         ALAudio* al;
         std::shared_ptr<PCMStream> source;
+        /// @brief Source decoded ahead by the decoder thread
+        std::shared_ptr<BufferedPCMStream> buffered;
         std::queue<uint> unusedBuffers;
         speakerid_t speaker = 0;
         bool keepSource;
@@ -143,10 +146,16 @@ namespace audio {
         std::vector<uint> freebuffers;
 
         uint maxSources = 256;
+
+        std::unique_ptr<StreamDecoder> decoder;
     public:
         ALAudio(ALCdevice* device, ALCcontext* context);
         ~ALAudio();
 
+        StreamDecoder& getDecoder() {
+            return *decoder;
+        }
+
         uint getFreeSource();
         uint getFreeBuffer();
         void freeSource(uint source);
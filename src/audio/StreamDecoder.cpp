@@ -0,0 +1,154 @@
+#include "StreamDecoder.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+#include "debug/Profiler.hpp"
+
+using namespace audio;
+
+/// @brief Max time between checks of streams for free space
+static constexpr auto IDLE_INTERVAL = std::chrono::milliseconds(20);
+
+BufferedPCMStream::BufferedPCMStream(
+    std::shared_ptr<PCMStream> source, size_t capacity
+)
+    : source(std::move(source)), buffer(capacity) {
+}
+
+bool BufferedPCMStream::decode() {
+    std::lock_guard lock(sourceMutex);
+    if (ended.load(std::memory_order_relaxed) || !source->isOpen()) {
+        return false;
+    }
+    size_t count;
+    char* region = buffer.writeRegion(count);
+    count = std::min(count, DECODE_CHUNK);
+    // keep whole frames
+    size_t frameSize = source->getChannels() * source->getBitsPerSample() / 8;
+    count -= count % std::max<size_t>(frameSize, 1);
+    if (count == 0) {
+        return false;
+    }
+    size_t read = source->read(region, count);
+    if (read == 0 && loop.load(std::memory_order_relaxed) &&
+        source->isSeekable()) {
+        source->seek(0);
+        read = source->read(region, count);
+    }
+    if (read == 0 || read == PCMStream::ERROR) {
+        ended.store(true, std::memory_order_release);
+        return false;
+    }
+    buffer.commit(read);
+    return true;
+}
+
+void BufferedPCMStream::setLoop(bool loop) {
+    if (this->loop.exchange(loop) == loop || !loop) {
+        return;
+    }
+    std::lock_guard lock(sourceMutex);
+    if (ended && source->isOpen() && source->isSeekable()) {
+        source->seek(0);
+        ended = false;
+    }
+}
+
+size_t BufferedPCMStream::readFully(
+    char* buffer, size_t bufferSize, bool loop
+) {
+    setLoop(loop);
+    return read(buffer, bufferSize);
+}
+
+size_t BufferedPCMStream::read(char* buffer, size_t bufferSize) {
+    return this->buffer.read(buffer, bufferSize);
+}
+
+void BufferedPCMStream::close() {
+    std::lock_guard lock(sourceMutex);
+    source->close();
+    ended = true;
+}
+
+void BufferedPCMStream::seek(size_t position) {
+    std::lock_guard lock(sourceMutex);
+    if (!source->isSeekable()) {
+        return;
+    }
+    source->seek(position);
+    // decoder is not writing while the source mutex is locked
+    buffer.clear();
+    ended = !source->isOpen();
+}
+
+StreamDecoder::StreamDecoder() : thread([this]() { run(); }) {
+}
+
+StreamDecoder::~StreamDecoder() {
+    {
+        std::lock_guard lock(mutex);
+        stopRequested = true;
+    }
+    cv.notify_one();
+    thread.join();
+}
+
+void StreamDecoder::run() {
+    debug::Profiler::setThreadName("audio decoder");
+    std::vector<std::shared_ptr<BufferedPCMStream>> active;
+    while (true) {
+        {
+            std::unique_lock lock(mutex);
+            cv.wait_for(lock, IDLE_INTERVAL, [this]() {
+                return wakeup || stopRequested;
+            });
+            if (stopRequested) {
+                break;
+            }
+            wakeup = false;
+            streams.erase(
+                std::remove_if(
+                    streams.begin(),
+                    streams.end(),
+                    [](const auto& stream) { return stream.expired(); }
+                ),
+                streams.end()
+            );
+            for (const auto& weak : streams) {
+                if (auto stream = weak.lock()) {
+                    active.push_back(std::move(stream));
+                }
+            }
+        }
+        // fill streams chunk by chunk so none of them starves
+        bool decoded;
+        do {
+            PROFILE_ZONE("StreamDecoder::decode");
+            decoded = false;
+            for (const auto& stream : active) {
+                decoded |= stream->decode();
+            }
+        } while (decoded);
+        // released streams are destroyed here if it was the last reference
+        active.clear();
+    }
+}
+
+void StreamDecoder::add(const std::shared_ptr<BufferedPCMStream>& stream) {
+    {
+        std::lock_guard lock(mutex);
+        streams.push_back(stream);
+        wakeup = true;
+    }
+    cv.notify_one();
+}
+
+void StreamDecoder::notify() {
+    {
+        std::lock_guard lock(mutex);
+        wakeup = true;
+    }
+    cv.notify_one();
+}
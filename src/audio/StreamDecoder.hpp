@@ -0,0 +1,111 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "audio.hpp"
+#include "util/RingBuffer.hpp"
+
+namespace audio {
+    /// @brief PCMStream decoded ahead of playback by StreamDecoder thread.
+    /// Reading never blocks on decoding and returns only already decoded
+    /// data, so source end must be checked with isEnded
+    class BufferedPCMStream : public PCMStream {
+        std::shared_ptr<PCMStream> source;
+        util::RingBuffer<char> buffer;
+        /// @brief Guards source, held by decoder while decoding a chunk
+        std::mutex sourceMutex;
+        std::atomic<bool> loop = false;
+        /// @brief Decoder reached the source end
+        std::atomic<bool> ended = false;
+    public:
+        /// @brief Max bytes decoded at once
+        static inline constexpr size_t DECODE_CHUNK = 16384;
+
+        /// @param capacity decoded data buffer capacity in bytes
+        BufferedPCMStream(std::shared_ptr<PCMStream> source, size_t capacity);
+
+        /// @brief Decoder: decode next chunk if there is free space
+        /// @return true if data was decoded
+        bool decode();
+
+        /// @brief Number of decoded bytes available for reading
+        size_t available() const {
+            return buffer.size();
+        }
+
+        /// @brief Check if all data is decoded (available data may remain)
+        bool isEnded() const {
+            return ended.load(std::memory_order_acquire);
+        }
+
+        /// @brief Decode from the start when the end is reached.
+        /// Decoding is restarted if the end is already reached
+        void setLoop(bool loop);
+
+        /// @brief Read decoded data without waiting
+        /// @param loop see setLoop
+        size_t readFully(char* buffer, size_t bufferSize, bool loop) override;
+
+        size_t read(char* buffer, size_t bufferSize) override;
+
+        void close() override;
+
+        bool isOpen() const override {
+            return source->isOpen();
+        }
+
+        size_t getTotalSamples() const override {
+            return source->getTotalSamples();
+        }
+
+        duration_t getTotalDuration() const override {
+            return source->getTotalDuration();
+        }
+
+        uint getChannels() const override {
+            return source->getChannels();
+        }
+
+        uint getSampleRate() const override {
+            return source->getSampleRate();
+        }
+
+        uint getBitsPerSample() const override {
+            return source->getBitsPerSample();
+        }
+
+        bool isSeekable() const override {
+            return source->isSeekable();
+        }
+
+        /// @brief Seek source and discard decoded data. Waits for the
+        /// chunk being decoded
+        void seek(size_t position) override;
+    };
+
+    /// @brief Background thread keeping buffered streams filled
+    class StreamDecoder {
+        std::vector<std::weak_ptr<BufferedPCMStream>> streams;
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool wakeup = false;
+        bool stopRequested = false;
+        std::thread thread;
+
+        void run();
+    public:
+        StreamDecoder();
+        ~StreamDecoder();
+
+        /// @brief Decode stream until it's released
+        void add(const std::shared_ptr<BufferedPCMStream>& stream);
+
+        /// @brief Wake up the decoder after reading or seeking streams
+        void notify();
+    };
+}
@@ -9,19 +9,19 @@
 
 using namespace json;
 
-static void to_binary(ByteBuilder& builder, const dv::value& value) {
+static void object_to_binary(ByteBuilder& builder, const dv::value& object);
+
+static void value_to_binary(ByteBuilder& builder, const dv::value& value) {
     switch (value.getType()) {
         case dv::value_type::none:
             throw std::runtime_error("none value is not implemented");
-        case dv::value_type::object: {
-            const auto bytes = json::to_binary(value);
-            builder.put(bytes.data(), bytes.size());
+        case dv::value_type::object:
+            object_to_binary(builder, value);
             break;
-        }
         case dv::value_type::list:
             builder.put(BJSON_TYPE_LIST);
             for (const auto& element : value) {
-                to_binary(builder, element);
+                value_to_binary(builder, element);
             }
             builder.put(BJSON_END);
             break;
@@ -63,27 +63,35 @@ static void to_binary(ByteBuilder& builder, const dv::value& value) {
     }
 }
 
-std::vector<ubyte> json::to_binary(const dv::value& object, bool compress) {
-    if (compress) {
-        auto bytes = to_binary(object, false);
-        return gzip::compress(bytes.data(), bytes.size());
-    }
-    ByteBuilder builder;
+static void object_to_binary(ByteBuilder& builder, const dv::value& object) {
+    size_t start = builder.size();
     // type byte
     builder.put(BJSON_TYPE_DOCUMENT);
-    // document size
+    // document size placeholder
     builder.putInt32(0);
 
     // writing entries
     for (const auto& [key, value] : object.asObject()) {
         builder.putCStr(key.c_str());
-        to_binary(builder, value);
+        value_to_binary(builder, value);
     }
     // terminating byte
     builder.put(BJSON_END);
 
     // updating document size
-    builder.setInt32(1, builder.size());
+    builder.setInt32(start + 1, builder.size() - start);
+}
+
+void json::to_binary(ByteBuilder& builder, const dv::value& object) {
+    object_to_binary(builder, object);
+}
+
+std::vector<ubyte> json::to_binary(const dv::value& object, bool compress) {
+    ByteBuilder builder;
+    object_to_binary(builder, object);
+    if (compress) {
+        return gzip::compress(builder.data(), builder.size());
+    }
     return builder.build();
 }
 
@@ -167,3 +175,150 @@ dv::value json::from_binary(const ubyte* src, size_t size) {
         return value_from_binary(reader);
     }
 }
+
+BinaryReader::BinaryReader(const ubyte* src, size_t size)
+    : reader(src, size) {
+}
+
+ubyte BinaryReader::peekType() {
+    return reader.peek();
+}
+
+void BinaryReader::beginObject() {
+    ubyte typecode = reader.get();
+    if (typecode != BJSON_TYPE_DOCUMENT) {
+        throw std::runtime_error(
+            "document expected, got <"+std::to_string(typecode)+">");
+    }
+    reader.getInt32();
+}
+
+bool BinaryReader::nextKey(std::string_view& key) {
+    if (reader.peek() == BJSON_END) {
+        reader.get();
+        return false;
+    }
+    key = reader.getCString();
+    return true;
+}
+
+void BinaryReader::beginList() {
+    ubyte typecode = reader.get();
+    if (typecode != BJSON_TYPE_LIST) {
+        throw std::runtime_error(
+            "list expected, got <"+std::to_string(typecode)+">");
+    }
+}
+
+bool BinaryReader::nextElement() {
+    if (reader.peek() == BJSON_END) {
+        reader.get();
+        return false;
+    }
+    return true;
+}
+
+integer_t BinaryReader::readInteger() {
+    ubyte typecode = reader.get();
+    switch (typecode) {
+        case BJSON_TYPE_BYTE:
+            return reader.get();
+        case BJSON_TYPE_INT16:
+            return reader.getInt16();
+        case BJSON_TYPE_INT32:
+            return reader.getInt32();
+        case BJSON_TYPE_INT64:
+            return reader.getInt64();
+        case BJSON_TYPE_NUMBER:
+            return static_cast<integer_t>(reader.getFloat64());
+    }
+    throw std::runtime_error(
+        "integer expected, got <"+std::to_string(typecode)+">");
+}
+
+number_t BinaryReader::readNumber() {
+    if (reader.peek() == BJSON_TYPE_NUMBER) {
+        reader.get();
+        return reader.getFloat64();
+    }
+    return static_cast<number_t>(readInteger());
+}
+
+bool BinaryReader::readBoolean() {
+    ubyte typecode = reader.get();
+    if (typecode != BJSON_TYPE_FALSE && typecode != BJSON_TYPE_TRUE) {
+        throw std::runtime_error(
+            "boolean expected, got <"+std::to_string(typecode)+">");
+    }
+    return typecode == BJSON_TYPE_TRUE;
+}
+
+std::string_view BinaryReader::readString() {
+    ubyte typecode = reader.get();
+    if (typecode != BJSON_TYPE_STRING) {
+        throw std::runtime_error(
+            "string expected, got <"+std::to_string(typecode)+">");
+    }
+    uint32_t length = static_cast<uint32_t>(reader.getInt32());
+    if (length > reader.remaining()) {
+        throw std::runtime_error("buffer underflow");
+    }
+    auto chars = reinterpret_cast<const char*>(reader.pointer());
+    reader.skip(length);
+    return std::string_view(chars, length);
+}
+
+dv::value BinaryReader::readValue() {
+    return value_from_binary(reader);
+}
+
+void BinaryReader::skip() {
+    ubyte typecode = reader.get();
+    switch (typecode) {
+        case BJSON_TYPE_DOCUMENT: {
+            // document size includes type byte and size field
+            int32_t size = reader.getInt32();
+            if (size < 5 || size - 5 > reader.remaining()) {
+                throw std::runtime_error(
+                    "invalid document size "+std::to_string(size));
+            }
+            reader.skip(size - 5);
+            break;
+        }
+        case BJSON_TYPE_LIST:
+            while (nextElement()) {
+                skip();
+            }
+            break;
+        case BJSON_TYPE_BYTE:
+            reader.skip(1);
+            break;
+        case BJSON_TYPE_INT16:
+            reader.skip(2);
+            break;
+        case BJSON_TYPE_INT32:
+            reader.skip(4);
+            break;
+        case BJSON_TYPE_INT64:
+        case BJSON_TYPE_NUMBER:
+            reader.skip(8);
+            break;
+        case BJSON_TYPE_STRING:
+        case BJSON_TYPE_BYTES: {
+            uint32_t size = static_cast<uint32_t>(reader.getInt32());
+            if (size > reader.remaining()) {
+                throw std::runtime_error("buffer underflow");
+            }
+            reader.skip(size);
+            break;
+        }
+        case BJSON_TYPE_FALSE:
+        case BJSON_TYPE_TRUE:
+        case BJSON_TYPE_NULL:
+            break;
+        default:
+            throw std::runtime_error(
+                "type support not implemented for <" +
+                std::to_string(typecode) + ">");
+    }
+}
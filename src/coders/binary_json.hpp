@@ -1,9 +1,11 @@
 #pragma once
 
 #include <memory>
+#include <string_view>
 #include <vector>
 
 #include "data/dv.hpp"
+#include "byte_utils.hpp"
 
 #include "typedefs.hpp"
 
@@ -24,6 +26,67 @@ namespace json {
     inline constexpr int BJSON_TYPE_CDOCUMENT = 0x1F;
 
     std::vector<ubyte> to_binary(const dv::value& obj, bool compress = false);
+
+    /// @brief Write document to the builder in a single pass.
+    /// Nested documents sizes are back-patched
+    void to_binary(ByteBuilder& builder, const dv::value& obj);
     
     dv::value from_binary(const ubyte* src, size_t size);
+
+    /// @brief Pull-style BJSON reader. Allows to decode values directly into
+    /// typed targets without building an intermediate dv::value tree.
+    /// Does not support compressed documents.
+    class BinaryReader {
+        ByteReader reader;
+    public:
+        BinaryReader(const ubyte* src, size_t size);
+
+        /// @brief Get next value type code without pointer move
+        ubyte peekType();
+
+        /// @brief Enter document
+        /// @throws std::runtime_error if next value is not a document
+        void beginObject();
+
+        /// @brief Read next document entry key
+        /// @param key string view referencing the source buffer
+        /// @return false if end of the document reached
+        bool nextKey(std::string_view& key);
+
+        /// @brief Enter list
+        /// @throws std::runtime_error if next value is not a list
+        void beginList();
+
+        /// @return false if end of the list reached
+        bool nextElement();
+
+        integer_t readInteger();
+        number_t readNumber();
+        bool readBoolean();
+
+        /// @return string view referencing the source buffer
+        std::string_view readString();
+
+        /// @brief Read any value as dv::value
+        dv::value readValue();
+
+        /// @brief Skip next value
+        void skip();
+
+        /// @brief Read list of numbers into the array
+        /// @return number of elements read
+        template <typename T>
+        size_t readNumbers(T* dst, size_t n) {
+            beginList();
+            size_t i = 0;
+            while (nextElement()) {
+                if (i < n) {
+                    dst[i++] = static_cast<T>(readNumber());
+                } else {
+                    skip();
+                }
+            }
+            return i;
+        }
+    };
 }
@@ -1,3 +1,4 @@
+#define VC_ENABLE_REFLECTION
 #include "compression.hpp"
 
 #include <string>
@@ -6,6 +7,8 @@
 
 #include "rle.hpp"
 #include "gzip.hpp"
+#include "lz4.hpp"
+#include "zstd.hpp"
 #include "util/BufferPool.hpp"
 
 using namespace compression;
@@ -27,13 +30,17 @@ static std::shared_ptr<ubyte[]> get_buffer(size_t minSize) {
     return nullptr;
 }
 
-static auto compress_rle(
+/// @brief Compress using pooled buffer if possible
+/// @param bufferSize max encoded data length
+/// @param encodefunc encoder writing to the buffer and returning data length
+template <typename EncodeFunc>
+static std::unique_ptr<ubyte[]> compress_buffered(
     const ubyte* src,
     size_t srclen,
     size_t& len,
-    size_t(*encodefunc)(const ubyte*, size_t, ubyte*)
+    size_t bufferSize,
+    const EncodeFunc& encodefunc
 ) {
-    size_t bufferSize = srclen * 2;
     auto buffer = get_buffer(bufferSize);
     auto bytes = buffer.get();
     std::unique_ptr<ubyte[]> uptr;
@@ -41,7 +48,7 @@ static auto compress_rle(
         uptr = std::make_unique<ubyte[]>(bufferSize);
         bytes = uptr.get();
     }
-    len = encodefunc(src, srclen, bytes);
+    len = encodefunc(src, srclen, bytes, bufferSize);
     if (uptr) {
         if (len < bufferSize * BUFFER_NOCROP_THRESOLD) {
             auto cropped = std::make_unique<ubyte[]>(len);
@@ -55,10 +62,70 @@ static auto compress_rle(
     return data;
 }
 
+static auto compress_rle(
+    const ubyte* src,
+    size_t srclen,
+    size_t& len,
+    size_t(*encodefunc)(const ubyte*, size_t, ubyte*)
+) {
+    return compress_buffered(
+        src,
+        srclen,
+        len,
+        srclen * 2,
+        [encodefunc](const ubyte* src, size_t srclen, ubyte* dst, size_t) {
+            return encodefunc(src, srclen, dst);
+        }
+    );
+}
+
+template <typename DecodeFunc>
+static std::unique_ptr<ubyte[]> decompress_exact(
+    const ubyte* src, size_t srclen, size_t dstlen, const DecodeFunc& decodefunc
+) {
+    auto decompressed = std::make_unique<ubyte[]>(dstlen);
+    size_t decoded = decodefunc(src, srclen, decompressed.get(), dstlen);
+    if (decoded != dstlen) {
+        throw std::runtime_error(
+            "expected decompressed size " + std::to_string(dstlen) +
+            " got " + std::to_string(decoded));
+    }
+    return decompressed;
+}
+
+Settings compression::parse_settings(std::string_view str) {
+    Settings settings {};
+    size_t sep = str.find(':');
+    auto name = str.substr(0, sep);
+    if (!MethodMeta.getItem(name, settings.method)) {
+        throw std::runtime_error(
+            "unknown compression method '" + std::string(name) + "'"
+        );
+    }
+    if (sep != std::string_view::npos) {
+        settings.level = std::stoi(std::string(str.substr(sep + 1)));
+    }
+    return settings;
+}
+
+std::string compression::to_string(const Settings& settings) {
+    auto name = MethodMeta.getNameString(settings.method);
+    if (settings.level) {
+        return name + ":" + std::to_string(settings.level);
+    }
+    return name;
+}
+
 std::unique_ptr<ubyte[]> compression::compress(
     const ubyte* src, size_t srclen, size_t& len, Method method
 ) {
-    switch (method) {
+    return compress(src, srclen, len, Settings(method));
+}
+
+std::unique_ptr<ubyte[]> compression::compress(
+    const ubyte* src, size_t srclen, size_t& len, const Settings& settings
+) {
+    switch (settings.method) {
         case Method::NONE:
             throw std::invalid_argument("compression method is NONE");
         case Method::EXTRLE8:
@@ -72,6 +139,27 @@ std::unique_ptr<ubyte[]> compression::compress(
             len = buffer.size();
             return data;
         }
+        case Method::LZ4:
+            return compress_buffered(
+                src, srclen, len, lz4::compress_bound(srclen), lz4::compress
+            );
+        case Method::ZSTD: {
+            int level = settings.level ? settings.level : zstd::DEFAULT_LEVEL;
+            const auto* dictionary = settings.dictionary.get();
+            return compress_buffered(
+                src,
+                srclen,
+                len,
+                zstd::compress_bound(srclen),
+                [level, dictionary](
+                    const ubyte* src, size_t srclen, ubyte* dst, size_t capacity
+                ) {
+                    return zstd::compress(
+                        src, srclen, dst, capacity, level, dictionary
+                    );
+                }
+            );
+        }
         default:
             throw std::runtime_error("not implemented");
     }
@@ -80,7 +168,13 @@ std::unique_ptr<ubyte[]> compression::compress(
 std::unique_ptr<ubyte[]> compression::decompress(
     const ubyte* src, size_t srclen, size_t dstlen, Method method
 ) {
-    switch (method) {
+    return decompress(src, srclen, dstlen, Settings(method));
+}
+
+std::unique_ptr<ubyte[]> compression::decompress(
+    const ubyte* src, size_t srclen, size_t dstlen, const Settings& settings
+) {
+    switch (settings.method) {
         case Method::NONE:
             throw std::invalid_argument("compression method is NONE");
         case Method::EXTRLE8: {
@@ -109,6 +203,23 @@ std::unique_ptr<ubyte[]> compression::decompress(
             std::memcpy(decompressed.get(), buffer.data(), buffer.size());
             return decompressed;
         }
+        case Method::LZ4:
+            return decompress_exact(src, srclen, dstlen, lz4::decompress);
+        case Method::ZSTD: {
+            const auto* dictionary = settings.dictionary.get();
+            return decompress_exact(
+                src,
+                srclen,
+                dstlen,
+                [dictionary](
+                    const ubyte* src, size_t srclen, ubyte* dst, size_t capacity
+                ) {
+                    return zstd::decompress(
+                        src, srclen, dst, capacity, dictionary
+                    );
+                }
+            );
+        }
         default:
             throw std::runtime_error("not implemented");
     }
@@ -1,14 +1,53 @@
 #pragma once
 
 #include <memory>
+#include <string>
+#include <string_view>
 
 #include "typedefs.hpp"
+#include "util/EnumMetadata.hpp"
+
+namespace zstd {
+    class Dictionary;
+}
 
 namespace compression {
+    /// @brief Compression method. Values are stored in region files header,
+    /// so must not be changed
     enum class Method {
-        NONE, EXTRLE8, EXTRLE16, GZIP
+        NONE, EXTRLE8, EXTRLE16, GZIP, LZ4, ZSTD
     };
 
+    VC_ENUM_METADATA(Method)
+        {"none", Method::NONE},
+        {"extrle8", Method::EXTRLE8},
+        {"extrle16", Method::EXTRLE16},
+        {"gzip", Method::GZIP},
+        {"lz4", Method::LZ4},
+        {"zstd", Method::ZSTD},
+    VC_ENUM_END
+
+    /// @brief Compression method with its parameters
+    struct Settings {
+        Method method = Method::NONE;
+        /// @brief Compression level (ZSTD only), 0 is the method default
+        int level = 0;
+        /// @brief Trained dictionary (ZSTD only)
+        std::shared_ptr<zstd::Dictionary> dictionary = nullptr;
+
+        Settings() = default;
+        Settings(Method method, int level = 0)
+            : method(method), level(level) {}
+    };
+
+    /// @brief Parse settings from string in format `method[:level]`,
+    /// e.g. "extrle16", "zstd:9"
+    /// @throws std::runtime_error if method is unknown
+    Settings parse_settings(std::string_view str);
+
+    /// @brief Convert settings to string in format `method[:level]`
+    std::string to_string(const Settings& settings);
+
     /// @brief Compress buffer
     /// @param src source buffer
     /// @param srclen length of the source buffer
@@ -20,6 +59,17 @@ namespace compression {
         const ubyte* src, size_t srclen, size_t& len, Method method
     );
 
+    /// @brief Compress buffer
+    /// @param src source buffer
+    /// @param srclen length of the source buffer
+    /// @param len (out argument) length of result buffer
+    /// @param settings compression method and parameters
+    /// @return compressed bytes array
+    /// @throws std::invalid_argument if compression method is NONE
+    std::unique_ptr<ubyte[]> compress(
+        const ubyte* src, size_t srclen, size_t& len, const Settings& settings
+    );
+
     /// @brief Decompress buffer
     /// @param src compressed buffer
     /// @param srclen length of compressed buffer
@@ -27,4 +77,14 @@ namespace compression {
     /// @return decompressed bytes array
     std::unique_ptr<ubyte[]> decompress(
         const ubyte* src, size_t srclen, size_t dstlen, Method method);
+
+    /// @brief Decompress buffer
+    /// @param src compressed buffer
+    /// @param srclen length of compressed buffer
+    /// @param dstlen max expected length of source buffer
+    /// @param settings compression method and dictionary
+    /// @return decompressed bytes array
+    std::unique_ptr<ubyte[]> decompress(
+        const ubyte* src, size_t srclen, size_t dstlen, const Settings& settings
+    );
 }
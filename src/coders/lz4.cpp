@@ -0,0 +1,39 @@
+#include "lz4.hpp"
+
+#include <lz4.h>
+
+#include <stdexcept>
+
+size_t lz4::compress_bound(size_t size) {
+    return LZ4_compressBound(size);
+}
+
+size_t lz4::compress(
+    const ubyte* src, size_t size, ubyte* dst, size_t capacity
+) {
+    int written = LZ4_compress_default(
+        reinterpret_cast<const char*>(src),
+        reinterpret_cast<char*>(dst),
+        size,
+        capacity
+    );
+    if (written <= 0) {
+        throw std::runtime_error("lz4 compression failed");
+    }
+    return written;
+}
+
+size_t lz4::decompress(
+    const ubyte* src, size_t size, ubyte* dst, size_t capacity
+) {
+    int read = LZ4_decompress_safe(
+        reinterpret_cast<const char*>(src),
+        reinterpret_cast<char*>(dst),
+        size,
+        capacity
+    );
+    if (read < 0) {
+        throw std::runtime_error("malformed lz4 block");
+    }
+    return read;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "typedefs.hpp"
+
+namespace lz4 {
+    /// @brief Get max size of LZ4 block compressed from source of given size
+    size_t compress_bound(size_t size);
+
+    /// @brief Compress bytes array to LZ4 block
+    /// @param src source bytes array
+    /// @param size length of source bytes array
+    /// @param dst destination buffer
+    /// @param capacity destination buffer capacity (see compress_bound)
+    /// @return compressed data length
+    size_t compress(const ubyte* src, size_t size, ubyte* dst, size_t capacity);
+
+    /// @brief Decompress LZ4 block
+    /// @param src LZ4 block data
+    /// @param size LZ4 block length
+    /// @param dst destination buffer
+    /// @param capacity destination buffer capacity
+    /// @return decompressed data length
+    /// @throws std::runtime_error if block is malformed
+    size_t decompress(const ubyte* src, size_t size, ubyte* dst, size_t capacity);
+}
@@ -3,6 +3,7 @@
 #include <vorbis/codec.h>
 #include <vorbis/vorbisfile.h>
 
+#include <algorithm>
 #include <string>
 
 #include "io/io.hpp"
@@ -60,25 +61,33 @@ std::unique_ptr<audio::PCM> ogg::load_pcm(
     size_t totalSamples = seekable ? ov_pcm_total(&vf, -1) : 0;
 
     if (!headerOnly) {
-        const int bufferSize = 4096;
+        const size_t minFreeSpace = 4096;
+        const size_t maxReadSize = 65536;
         int section = 0;
-        char buffer[bufferSize];
 
-        bool eof = false;
-        while (!eof) {
-            long ret = ov_read(&vf, buffer, bufferSize, 0, 2, true, &section);
+        // decoded size is known for seekable streams, extra space is used
+        // to detect the end
+        data.resize(totalSamples * channels * 2 + minFreeSpace);
+        size_t size = 0;
+        while (true) {
+            if (data.size() - size < minFreeSpace) {
+                data.resize(data.size() * 2);
+            }
+            int readSize = std::min(data.size() - size, maxReadSize);
+            long ret = ov_read(
+                &vf, data.data() + size, readSize, 0, 2, true, &section
+            );
             if (ret == 0) {
-                eof = true;
+                break;
             } else if (ret < 0) {
                 logger.error()
                     << "ogg::load_pcm: " << vorbis_error_message(ret);
             } else {
-                data.insert(
-                    data.end(), std::begin(buffer), std::begin(buffer) + ret
-                );
+                size += ret;
             }
         }
-        totalSamples = data.size() / channels / 2;
+        data.resize(size);
+        totalSamples = size / channels / 2;
     }
     ov_clear(&vf);
     return std::make_unique<PCM>(
@@ -80,6 +80,9 @@ inline bool is_lua_operator_start(int c) {
 class Tokenizer : BasicParser<wchar_t> {
     const Syntax& syntax;
     std::vector<Token> tokens;
+    /// @brief Tokenize single line without string escapes validation
+    bool lineMode = false;
+    LineState state = LineState::NORMAL;
 public:
     Tokenizer(
         const Syntax& syntax, std::string_view file, std::wstring_view source
@@ -87,6 +90,17 @@ public:
         : BasicParser(file, source), syntax(syntax) {
     }
 
+    Tokenizer(const Syntax& syntax, std::wstring_view line, LineState state)
+        : BasicParser("<line>", line),
+          syntax(syntax),
+          lineMode(true),
+          state(state) {
+    }
+
+    LineState getState() const {
+        return state;
+    }
+
     std::wstring parseLuaName() {
         char c = peek();
         if (!is_identifier_start(c)) {
@@ -136,7 +150,7 @@ public:
                 return std::wstring({first});
         }
         skip(1);
-        char second = peekNoJump();
+        wchar_t second = hasNext() ? peekNoJump() : 0;
         if ((first == '=' && second == '=') || (first == '~' && second == '=') ||
             (first == '<' && second == '=') || (first == '>' && second == '=')) {
             skip(1);
@@ -144,14 +158,79 @@ public:
         }
         if (first == '.' && second == '.') {
             skip(1);
-            if (peekNoJump() == '.') {
+            if (hasNext() && peekNoJump() == '.') {
                 skip(1);
             }
         }
         return std::wstring(source.substr(start, pos - start));
     }
 
+    /// @brief Read multiline comment or string until the end sequence
+    /// or the source end
+    std::wstring_view readMultiline(const std::wstring& end, LineState open) {
+        auto string = readUntil(end, true);
+        if (isNext(end)) {
+            skip(end.length());
+            state = LineState::NORMAL;
+        } else {
+            state = open;
+        }
+        return string;
+    }
+
+    /// @brief Skip quoted string body without escapes validation
+    void skipQuoted(wchar_t quote, LineState open) {
+        state = open;
+        while (hasNext()) {
+            wchar_t c = source[pos++];
+            if (c == '\\') {
+                // escaped line break keeps the string open
+                if (hasNext()) {
+                    pos++;
+                }
+            } else if (c == quote) {
+                state = LineState::NORMAL;
+                return;
+            }
+        }
+    }
+
+    /// @brief Finish a token left open by previous lines
+    void resumeToken() {
+        auto start = currentLocation();
+        switch (state) {
+            case LineState::NORMAL:
+                return;
+            case LineState::COMMENT: {
+                auto string = readMultiline(
+                    syntax.multilineCommentEnd, LineState::COMMENT
+                );
+                emitToken(TokenTag::COMMENT, std::wstring(string), start);
+                break;
+            }
+            case LineState::STRING: {
+                auto string = readMultiline(
+                    syntax.multilineStringEnd, LineState::STRING
+                );
+                emitToken(TokenTag::STRING, std::wstring(string), start);
+                break;
+            }
+            case LineState::SINGLE_QUOTED:
+            case LineState::DOUBLE_QUOTED:
+                skipQuoted(
+                    state == LineState::SINGLE_QUOTED ? '\'' : '"', state
+                );
+                emitToken(
+                    TokenTag::STRING,
+                    std::wstring(source.substr(start.pos, pos - start.pos)),
+                    start
+                );
+                break;
+        }
+    }
+
     std::vector<Token> tokenize() {
+        resumeToken();
         skipWhitespace();
         while (hasNext()) {
             skipWhitespace();
@@ -188,8 +267,9 @@ public:
             const auto& mcommentStart = syntax.multilineCommentStart;
             if (!mcommentStart.empty() && c == mcommentStart[0] &&
                 isNext(syntax.multilineCommentStart)) {
-                auto string = readUntil(syntax.multilineCommentEnd, true);
-                skip(syntax.multilineCommentEnd.length());
+                auto string = readMultiline(
+                    syntax.multilineCommentEnd, LineState::COMMENT
+                );
                 emitToken(
                     TokenTag::COMMENT,
                     std::wstring(string) + syntax.multilineCommentEnd,
@@ -201,8 +281,9 @@ public:
             if (!mstringStart.empty() && c == mstringStart[0] &&
                 isNext(syntax.multilineStringStart)) {
                 skip(mstringStart.length());
-                auto string = readUntil(syntax.multilineStringEnd, true);
-                skip(syntax.multilineStringEnd.length());
+                auto string = readMultiline(
+                    syntax.multilineStringEnd, LineState::STRING
+                );
                 emitToken(TokenTag::STRING, std::wstring(string), start);
                 continue;
             }
@@ -221,6 +302,19 @@ public:
                     continue;
                 case '\'': case '"': {
                     skip(1);
+                    if (lineMode) {
+                        skipQuoted(
+                            c,
+                            c == '"' ? LineState::DOUBLE_QUOTED
+                                     : LineState::SINGLE_QUOTED
+                        );
+                        emitToken(
+                            TokenTag::STRING,
+                            std::wstring(source.substr(start.pos, pos - start.pos)),
+                            start
+                        );
+                        continue;
+                    }
                     auto string = parseString(c, false);
                     emitToken(TokenTag::STRING, std::move(string), start);
                     continue;
@@ -250,3 +344,19 @@ std::vector<Token> devtools::tokenize(
 ) {
     return Tokenizer(syntax, file, source).tokenize();
 }
+
+LineState devtools::tokenize_line(
+    const Syntax& syntax,
+    std::wstring_view line,
+    LineState state,
+    std::vector<Token>& tokens
+) {
+    Tokenizer tokenizer(syntax, line, state);
+    auto lineTokens = tokenizer.tokenize();
+    tokens.insert(
+        tokens.end(),
+        std::make_move_iterator(lineTokens.begin()),
+        std::make_move_iterator(lineTokens.end())
+    );
+    return tokenizer.getState();
+}
@@ -2,6 +2,7 @@
 
 #include <set>
 #include <string>
+#include <cstdint>
 #include <vector>
 
 #include "devtools/syntax.hpp"
@@ -22,7 +23,34 @@ namespace devtools {
         void deserialize(const dv::value& src) override;
     };
 
+    /// @brief Tokenizer state at a line start
+    enum class LineState : uint8_t {
+        NORMAL,
+        /// @brief Inside of a multiline comment
+        COMMENT,
+        /// @brief Inside of a multiline string
+        STRING,
+        /// @brief Inside of a '...' string
+        SINGLE_QUOTED,
+        /// @brief Inside of a "..." string
+        DOUBLE_QUOTED,
+    };
+
     std::vector<Token> tokenize(
         const Syntax& syntax, std::string_view file, std::wstring_view source
     );
+
+    /// @brief Tokenize a single line continuing a token left open by
+    /// previous lines. String escapes are not validated
+    /// @param line line without line break
+    /// @param state state the previous line ended with
+    /// @param tokens [out] tokens with locations relative to the line start.
+    /// Token left open is emitted up to the line end
+    /// @return state at the line end
+    LineState tokenize_line(
+        const Syntax& syntax,
+        std::wstring_view line,
+        LineState state,
+        std::vector<Token>& tokens
+    );
 }
@@ -0,0 +1,142 @@
+#include "zstd.hpp"
+
+#include <zdict.h>
+#include <zstd.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+using namespace zstd;
+
+struct CCtxDeleter {
+    void operator()(ZSTD_CCtx* ctx) const {
+        ZSTD_freeCCtx(ctx);
+    }
+};
+
+struct DCtxDeleter {
+    void operator()(ZSTD_DCtx* ctx) const {
+        ZSTD_freeDCtx(ctx);
+    }
+};
+
+// contexts are reused to avoid of allocations on each call
+static ZSTD_CCtx* get_cctx() {
+    static thread_local std::unique_ptr<ZSTD_CCtx, CCtxDeleter> ctx(
+        ZSTD_createCCtx()
+    );
+    return ctx.get();
+}
+
+static ZSTD_DCtx* get_dctx() {
+    static thread_local std::unique_ptr<ZSTD_DCtx, DCtxDeleter> ctx(
+        ZSTD_createDCtx()
+    );
+    return ctx.get();
+}
+
+static size_t check_error(size_t code, const char* what) {
+    if (ZSTD_isError(code)) {
+        throw std::runtime_error(
+            std::string(what) + ": " + ZSTD_getErrorName(code)
+        );
+    }
+    return code;
+}
+
+Dictionary::Dictionary(std::vector<ubyte> bytes, int level)
+    : bytes(std::move(bytes)), level(level) {
+    id = ZSTD_getDictID_fromDict(this->bytes.data(), this->bytes.size());
+    if (id == 0) {
+        throw std::runtime_error("invalid zstd dictionary");
+    }
+    cdict = ZSTD_createCDict(this->bytes.data(), this->bytes.size(), level);
+    ddict = ZSTD_createDDict(this->bytes.data(), this->bytes.size());
+    if (cdict == nullptr || ddict == nullptr) {
+        ZSTD_freeCDict(cdict);
+        ZSTD_freeDDict(ddict);
+        throw std::runtime_error("could not load zstd dictionary");
+    }
+}
+
+Dictionary::~Dictionary() {
+    ZSTD_freeCDict(cdict);
+    ZSTD_freeDDict(ddict);
+}
+
+size_t zstd::compress_bound(size_t size) {
+    return ZSTD_compressBound(size);
+}
+
+size_t zstd::compress(
+    const ubyte* src,
+    size_t size,
+    ubyte* dst,
+    size_t capacity,
+    int level,
+    const Dictionary* dictionary
+) {
+    if (dictionary) {
+        return check_error(
+            ZSTD_compress_usingCDict(
+                get_cctx(), dst, capacity, src, size, dictionary->getCDict()
+            ),
+            "zstd compression failed"
+        );
+    }
+    return check_error(
+        ZSTD_compressCCtx(get_cctx(), dst, capacity, src, size, level),
+        "zstd compression failed"
+    );
+}
+
+uint zstd::get_dictionary_id(const ubyte* src, size_t size) {
+    return ZSTD_getDictID_fromFrame(src, size);
+}
+
+size_t zstd::decompress(
+    const ubyte* src,
+    size_t size,
+    ubyte* dst,
+    size_t capacity,
+    const Dictionary* dictionary
+) {
+    uint dictId = ZSTD_getDictID_fromFrame(src, size);
+    if (dictId == 0) {
+        return check_error(
+            ZSTD_decompressDCtx(get_dctx(), dst, capacity, src, size),
+            "malformed zstd frame"
+        );
+    }
+    if (dictionary == nullptr || dictionary->getId() != dictId) {
+        throw std::runtime_error(
+            "missing zstd dictionary " + std::to_string(dictId)
+        );
+    }
+    return check_error(
+        ZSTD_decompress_usingDDict(
+            get_dctx(), dst, capacity, src, size, dictionary->getDDict()
+        ),
+        "malformed zstd frame"
+    );
+}
+
+std::vector<ubyte> zstd::train_dictionary(
+    const std::vector<ubyte>& samples,
+    const std::vector<size_t>& sizes,
+    size_t capacity
+) {
+    std::vector<ubyte> dictionary(capacity);
+    size_t size = ZDICT_trainFromBuffer(
+        dictionary.data(), capacity, samples.data(), sizes.data(), sizes.size()
+    );
+    if (ZDICT_isError(size)) {
+        throw std::runtime_error(
+            std::string("zstd dictionary training failed: ") +
+            ZDICT_getErrorName(size)
+        );
+    }
+    dictionary.resize(size);
+    return dictionary;
+}
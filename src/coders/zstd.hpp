@@ -0,0 +1,103 @@
+#pragma once
+
+#include <vector>
+
+#include "typedefs.hpp"
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
+namespace zstd {
+    inline constexpr int DEFAULT_LEVEL = 3;
+
+    /// @brief Trained zstd dictionary. Improves compression ratio of small
+    /// similar payloads (chunk inventories, entities etc.)
+    class Dictionary {
+        std::vector<ubyte> bytes;
+        uint id;
+        int level;
+        ZSTD_CDict_s* cdict;
+        ZSTD_DDict_s* ddict;
+    public:
+        /// @param bytes dictionary content
+        /// @param level compression level the dictionary is prepared for
+        /// @throws std::runtime_error if dictionary is invalid
+        Dictionary(std::vector<ubyte> bytes, int level);
+        Dictionary(const Dictionary&) = delete;
+        ~Dictionary();
+
+        /// @brief Get dictionary ID written to frames compressed with it
+        uint getId() const {
+            return id;
+        }
+
+        int getLevel() const {
+            return level;
+        }
+
+        const std::vector<ubyte>& getBytes() const {
+            return bytes;
+        }
+
+        const ZSTD_CDict_s* getCDict() const {
+            return cdict;
+        }
+
+        const ZSTD_DDict_s* getDDict() const {
+            return ddict;
+        }
+    };
+
+    /// @brief Get max size of zstd frame compressed from source of given size
+    size_t compress_bound(size_t size);
+
+    /// @brief Compress bytes array to zstd frame
+    /// @param src source bytes array
+    /// @param size length of source bytes array
+    /// @param dst destination buffer
+    /// @param capacity destination buffer capacity (see compress_bound)
+    /// @param level compression level (ignored if dictionary is used)
+    /// @param dictionary optional dictionary
+    /// @return compressed data length
+    size_t compress(
+        const ubyte* src,
+        size_t size,
+        ubyte* dst,
+        size_t capacity,
+        int level,
+        const Dictionary* dictionary = nullptr
+    );
+
+    /// @brief Get ID of the dictionary used to compress zstd frame
+    /// @return 0 if frame is compressed without dictionary or is malformed
+    uint get_dictionary_id(const ubyte* src, size_t size);
+
+    /// @brief Decompress zstd frame
+    /// @param src zstd frame data
+    /// @param size zstd frame length
+    /// @param dst destination buffer
+    /// @param capacity destination buffer capacity
+    /// @param dictionary dictionary used for compression, if any
+    /// @return decompressed data length
+    /// @throws std::runtime_error if frame is malformed or requires
+    /// a dictionary that is not provided
+    size_t decompress(
+        const ubyte* src,
+        size_t size,
+        ubyte* dst,
+        size_t capacity,
+        const Dictionary* dictionary = nullptr
+    );
+
+    /// @brief Train dictionary on payload samples
+    /// @param samples samples concatenated
+    /// @param sizes size of each sample
+    /// @param capacity max dictionary size
+    /// @return dictionary content
+    /// @throws std::runtime_error if training failed (e.g. too few samples)
+    std::vector<ubyte> train_dictionary(
+        const std::vector<ubyte>& samples,
+        const std::vector<size_t>& sizes,
+        size_t capacity
+    );
+}
@@ -41,6 +41,9 @@ inline constexpr uint VOXEL_USER_BITS_OFFSET = sizeof(blockstate_t)*8-VOXEL_USER
 /// lookup latency. Default value (1.0) shows x2 slower work.
 inline constexpr float CHUNKS_MAP_MAX_LOAD_FACTOR = 0.1f;
 
+/// @brief Max number of unloaded chunks kept for reuse (~400 KiB each)
+inline constexpr size_t CHUNKS_POOL_CAPACITY = 128;
+
 /// @brief chunk volume (count of voxels per Chunk)
 inline constexpr int CHUNK_VOL = (CHUNK_W * CHUNK_H * CHUNK_D);
 
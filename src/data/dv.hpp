@@ -3,10 +3,15 @@
 #include <stdint.h>
 #include <string>
 #include <memory>
+#include <new>
+#include <tuple>
 #include <iosfwd>
 #include <vector>
 #include <cstring>
+#include <iterator>
+#include <algorithm>
 #include <stdexcept>
+#include <string_view>
 #include <unordered_map>
 
 namespace util {
@@ -55,7 +60,7 @@ namespace dv {
     using const_reference = const value&;
 
     namespace objects {
-        using Object = std::unordered_map<key_t, value>;
+        class Object;
         using List = std::vector<value>;
         using Bytes = util::Buffer<byte_t>;
     }
@@ -462,14 +467,7 @@ namespace dv {
             }
         }
 
-        optionalvalue at(const key_t& k) const {
-            check_type(type, value_type::object);
-            const auto& found = val.object->find(k);
-            if (found == val.object->end()) {
-                return optionalvalue(nullptr);
-            }
-            return optionalvalue(&found->second);
-        }
+        optionalvalue at(const key_t& k) const;
 
         optionalvalue at(size_t index) {
             check_type(type, value_type::list);
@@ -515,6 +513,328 @@ namespace dv {
     inline bool is_numeric(const value& val) {
         return val.isInteger() || val.isNumber();
     }
+
+    namespace objects {
+        /// @brief Flat object storage.
+        ///
+        /// Entries are stored in insertion order: first INLINE_CAPACITY
+        /// entries are placed inside the object itself (so a small object
+        /// created with make_shared costs a single allocation), the rest
+        /// go to fixed-size blocks. Slots of erased entries are reused by
+        /// new ones, so storage is bounded by the max number of entries.
+        /// Entries are never relocated, so references stay valid until the
+        /// entry is erased. Objects with
+        /// more than INLINE_CAPACITY entries are looked up through a sorted
+        /// index, smaller ones are scanned linearly.
+        class Object {
+            static constexpr size_t INLINE_CAPACITY = 4;
+            static constexpr size_t BLOCK_CAPACITY = 32;
+
+            struct Slot {
+                alignas(pair) unsigned char storage[sizeof(pair)];
+                bool alive = false;
+
+                pair& get() noexcept {
+                    return *std::launder(reinterpret_cast<pair*>(storage));
+                }
+                const pair& get() const noexcept {
+                    return *std::launder(
+                        reinterpret_cast<const pair*>(storage)
+                    );
+                }
+            };
+
+            Slot inlineSlots[INLINE_CAPACITY];
+            std::vector<std::unique_ptr<Slot[]>> blocks;
+            /// @brief Sorted by key positions of alive entries.
+            /// Used only if more than INLINE_CAPACITY slots were used
+            std::vector<uint32_t> index;
+            /// @brief Positions of erased slots reused by new entries
+            std::vector<uint32_t> freeSlots;
+            /// @brief Number of used slots including erased ones
+            size_t used = 0;
+            /// @brief Number of alive entries
+            size_t count = 0;
+
+            Slot& slotAt(size_t pos) noexcept {
+                if (pos < INLINE_CAPACITY) {
+                    return inlineSlots[pos];
+                }
+                pos -= INLINE_CAPACITY;
+                return blocks[pos / BLOCK_CAPACITY][pos % BLOCK_CAPACITY];
+            }
+
+            const Slot& slotAt(size_t pos) const noexcept {
+                return const_cast<Object*>(this)->slotAt(pos);
+            }
+
+            bool indexed() const noexcept {
+                return used > INLINE_CAPACITY;
+            }
+
+            std::string_view keyAt(size_t pos) const noexcept {
+                return slotAt(pos).get().first;
+            }
+
+            size_t lowerBound(std::string_view key) const noexcept {
+                size_t lo = 0;
+                size_t hi = index.size();
+                while (lo < hi) {
+                    size_t mid = (lo + hi) / 2;
+                    if (keyAt(index[mid]) < key) {
+                        lo = mid + 1;
+                    } else {
+                        hi = mid;
+                    }
+                }
+                return lo;
+            }
+
+            size_t findPos(std::string_view key) const noexcept {
+                if (!indexed()) {
+                    for (size_t i = 0; i < used; i++) {
+                        const auto& slot = inlineSlots[i];
+                        if (slot.alive && slot.get().first == key) {
+                            return i;
+                        }
+                    }
+                    return used;
+                }
+                size_t i = lowerBound(key);
+                if (i < index.size() && keyAt(index[i]) == key) {
+                    return index[i];
+                }
+                return used;
+            }
+
+            template <typename... Args>
+            size_t append(Args&&... args) {
+                size_t pos;
+                if (!freeSlots.empty()) {
+                    pos = freeSlots.back();
+                    freeSlots.pop_back();
+                } else {
+                    if (used >= INLINE_CAPACITY &&
+                        (used - INLINE_CAPACITY) % BLOCK_CAPACITY == 0) {
+                        blocks.push_back(
+                            std::make_unique<Slot[]>(BLOCK_CAPACITY)
+                        );
+                    }
+                    pos = used++;
+                }
+                auto& slot = slotAt(pos);
+                new (slot.storage) pair(std::forward<Args>(args)...);
+                slot.alive = true;
+                count++;
+
+                if (pos == INLINE_CAPACITY) {
+                    buildIndex();
+                } else if (indexed()) {
+                    size_t i = lowerBound(slot.get().first);
+                    index.insert(
+                        index.begin() + i, static_cast<uint32_t>(pos)
+                    );
+                }
+                return pos;
+            }
+
+            void buildIndex() {
+                index.clear();
+                index.reserve(used);
+                for (size_t i = 0; i < used; i++) {
+                    if (slotAt(i).alive) {
+                        index.push_back(static_cast<uint32_t>(i));
+                    }
+                }
+                std::sort(index.begin(), index.end(), [this](auto a, auto b) {
+                    return keyAt(a) < keyAt(b);
+                });
+            }
+
+            template <class O, class T>
+            class basic_iterator {
+                O* object;
+                size_t pos;
+
+                void skipErased() noexcept {
+                    while (pos < object->used && !object->slotAt(pos).alive) {
+                        pos++;
+                    }
+                }
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = pair;
+                using difference_type = std::ptrdiff_t;
+                using pointer = T*;
+                using reference = T&;
+
+                basic_iterator(O* object, size_t pos) noexcept
+                    : object(object), pos(pos) {
+                    skipErased();
+                }
+
+                reference operator*() const noexcept {
+                    return object->slotAt(pos).get();
+                }
+                pointer operator->() const noexcept {
+                    return &object->slotAt(pos).get();
+                }
+                basic_iterator& operator++() noexcept {
+                    pos++;
+                    skipErased();
+                    return *this;
+                }
+                basic_iterator operator++(int) noexcept {
+                    auto copy = *this;
+                    ++(*this);
+                    return copy;
+                }
+                bool operator==(const basic_iterator& other) const noexcept {
+                    return pos == other.pos;
+                }
+                bool operator!=(const basic_iterator& other) const noexcept {
+                    return pos != other.pos;
+                }
+            };
+        public:
+            using iterator = basic_iterator<Object, pair>;
+            using const_iterator = basic_iterator<const Object, const pair>;
+
+            Object() = default;
+
+            Object(std::initializer_list<pair> pairs) {
+                for (const auto& [key, val] : pairs) {
+                    (*this)[key] = val;
+                }
+            }
+
+            Object(const Object& other) {
+                for (const auto& [key, val] : other) {
+                    append(key, val);
+                }
+            }
+
+            Object(Object&& other) {
+                for (auto& [key, val] : other) {
+                    append(key, std::move(val));
+                }
+                other.clear();
+            }
+
+            ~Object() {
+                clear();
+            }
+
+            Object& operator=(const Object& other) {
+                if (this != &other) {
+                    clear();
+                    for (const auto& [key, val] : other) {
+                        append(key, val);
+                    }
+                }
+                return *this;
+            }
+
+            Object& operator=(Object&& other) {
+                if (this != &other) {
+                    clear();
+                    for (auto& [key, val] : other) {
+                        append(key, std::move(val));
+                    }
+                    other.clear();
+                }
+                return *this;
+            }
+
+            value& operator[](std::string_view key) {
+                size_t pos = findPos(key);
+                if (pos == used) {
+                    pos = append(std::piecewise_construct,
+                                 std::forward_as_tuple(key),
+                                 std::forward_as_tuple());
+                }
+                return slotAt(pos).get().second;
+            }
+
+            iterator find(std::string_view key) noexcept {
+                return iterator(this, findPos(key));
+            }
+
+            const_iterator find(std::string_view key) const noexcept {
+                return const_iterator(this, findPos(key));
+            }
+
+            size_t erase(std::string_view key) {
+                size_t pos = findPos(key);
+                if (pos == used) {
+                    return 0;
+                }
+                if (indexed()) {
+                    index.erase(index.begin() + lowerBound(key));
+                }
+                auto& slot = slotAt(pos);
+                slot.get().~pair();
+                slot.alive = false;
+                count--;
+                if (count == 0) {
+                    clear();
+                } else {
+                    freeSlots.push_back(static_cast<uint32_t>(pos));
+                }
+                return 1;
+            }
+
+            void clear() noexcept {
+                for (size_t i = 0; i < used; i++) {
+                    auto& slot = slotAt(i);
+                    if (slot.alive) {
+                        slot.get().~pair();
+                        slot.alive = false;
+                    }
+                }
+                blocks.clear();
+                index.clear();
+                freeSlots.clear();
+                used = 0;
+                count = 0;
+            }
+
+            size_t size() const noexcept {
+                return count;
+            }
+
+            /// @brief Get number of allocated slots including free ones
+            size_t slotsCount() const noexcept {
+                return used;
+            }
+
+            bool empty() const noexcept {
+                return count == 0;
+            }
+
+            iterator begin() noexcept {
+                return iterator(this, 0);
+            }
+            iterator end() noexcept {
+                return iterator(this, used);
+            }
+            const_iterator begin() const noexcept {
+                return const_iterator(this, 0);
+            }
+            const_iterator end() const noexcept {
+                return const_iterator(this, used);
+            }
+        };
+    }
+
+    inline optionalvalue value::at(const key_t& k) const {
+        check_type(type, value_type::object);
+        const auto& found = val.object->find(k);
+        if (found == val.object->end()) {
+            return optionalvalue(nullptr);
+        }
+        return optionalvalue(&found->second);
+    }
 }
 
 namespace dv {
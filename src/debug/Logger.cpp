@@ -1,42 +1,83 @@
 #include "Logger.hpp"
 
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <ctime>
+#include <exception>
 #include <iomanip>
 #include <iostream>
+#include <thread>
 #include <utility>
 
+#include "util/MPSCQueue.hpp"
+
 using namespace debug;
 
-std::ofstream Logger::file;
-std::mutex Logger::mutex;
-std::string Logger::utcOffset = "";
-unsigned Logger::moduleLen = 20;
+namespace {
+    struct LogRecord {
+        LogLevel level;
+        std::string name;
+        std::string message;
+        std::chrono::system_clock::time_point time;
+    };
 
-LogMessage::~LogMessage() {
-    logger->log(level, ss.str());
+    /// @brief Stops the writer before the other logger state is destroyed
+    struct WriterGuard {
+        ~WriterGuard() {
+            Logger::close();
+        }
+    };
 }
 
-Logger::Logger(std::string name) : name(std::move(name)) {
+/// @brief Max delay before queued messages are written
+static constexpr auto WRITER_INTERVAL = std::chrono::milliseconds(50);
+static constexpr unsigned MODULE_LEN = 20;
+
+static std::string utcOffset = "";
+static std::ofstream file;
+static std::atomic<LogLevel> levels[] {LogLevel::debug, LogLevel::debug};
+
+static util::MPSCQueue<LogRecord> queue;
+static std::atomic<uint64_t> pushed = 0;
+/// @brief Number of written messages, modified under mutex
+static std::atomic<uint64_t> written = 0;
+static std::atomic<size_t> dropped = 0;
+static std::atomic<bool> running = false;
+/// @brief Number of producers pushing to the queue after seeing the writer
+/// running
+static std::atomic<int> activeProducers = 0;
+/// @brief Set by producers when the queue is getting full
+static std::atomic<bool> backlogWakeup = false;
+
+/// @brief Guards sinks while writer is not running and writer state
+static std::mutex mutex;
+static std::condition_variable wakeupCv;
+static std::condition_variable flushedCv;
+static bool wakeup = false;
+static bool stopRequested = false;
+static std::thread writer;
+static std::terminate_handler prevTerminateHandler = nullptr;
+
+static WriterGuard writerGuard;
+
+static bool is_accepted(LogLevel level, LogSink sink) {
+    return level == LogLevel::print ||
+           level >= levels[static_cast<int>(sink)].load(
+                        std::memory_order_relaxed
+                    );
 }
 
-void Logger::log(
-    LogLevel level, const std::string& name, const std::string& message
-) {
-    if (level == LogLevel::print) {
-        std::cout << "[" << name << "]    " << message << std::endl;
-        return;
+static std::string format_record(const LogRecord& record) {
+    if (record.level == LogLevel::print) {
+        return "[" + record.name + "]    " + record.message;
     }
-
     using namespace std::chrono;
 
     std::stringstream ss;
-    switch (level) {
+    switch (record.level) {
         case LogLevel::print:
         case LogLevel::debug:
-#ifdef NDEBUG
-            return;
-#endif
             ss << "[D]";
             break;
         case LogLevel::info:
@@ -49,38 +90,243 @@ void Logger::log(
             ss << "[E]";
             break;
     }
-    time_t tm = std::time(nullptr);
+    time_t tm = system_clock::to_time_t(record.time);
     auto ms =
-        duration_cast<milliseconds>(system_clock::now().time_since_epoch()) %
-        1000;
+        duration_cast<milliseconds>(record.time.time_since_epoch()) % 1000;
     ss << " " << std::put_time(std::localtime(&tm), "%Y/%m/%d %T");
     ss << '.' << std::setfill('0') << std::setw(3) << ms.count();
-    ss << utcOffset << " [" << std::setfill(' ') << std::setw(moduleLen) << name
-       << "] ";
-    ss << message;
-    {
-        std::lock_guard<std::mutex> lock(mutex);
-        auto string = ss.str();
-        if (file.good()) {
-            file << string << '\n';
-            file.flush();
+    ss << utcOffset << " [" << std::setfill(' ') << std::setw(MODULE_LEN)
+       << record.name << "] ";
+    ss << record.message;
+    return ss.str();
+}
+
+/// @brief Write record to sinks without flushing. Must be called by the
+/// writer thread or under mutex when writer is not running
+static void write_record(const LogRecord& record) {
+    bool toFile = record.level != LogLevel::print && file.good() &&
+                  is_accepted(record.level, LogSink::file);
+    bool toConsole = is_accepted(record.level, LogSink::console);
+    if (!toFile && !toConsole) {
+        return;
+    }
+    auto string = format_record(record);
+    if (toFile) {
+        file << string << '\n';
+    }
+    if (toConsole) {
+        std::cout << string << '\n';
+    }
+}
+
+static void flush_sinks() {
+    file.flush();
+    std::cout.flush();
+}
+
+static void report_dropped(size_t& reported) {
+    size_t count = dropped.load(std::memory_order_relaxed);
+    if (count == reported) {
+        return;
+    }
+    write_record(LogRecord {
+        LogLevel::warning,
+        "logger",
+        std::to_string(count - reported) + " messages dropped (queue is full)",
+        std::chrono::system_clock::now()});
+    reported = count;
+}
+
+static void run_writer() {
+    size_t reportedDrops = dropped.load();
+    LogRecord record;
+    while (true) {
+        bool stop;
+        {
+            std::unique_lock lock(mutex);
+            wakeupCv.wait_for(lock, WRITER_INTERVAL, []() {
+                return wakeup || stopRequested || backlogWakeup;
+            });
+            wakeup = false;
+            backlogWakeup = false;
+            stop = stopRequested;
+        }
+        uint64_t count = 0;
+        while (queue.pop(record)) {
+            write_record(record);
+            // free queue space for producers during long batches
+            if (++count % 1024 == 0) {
+                std::lock_guard lock(mutex);
+                written += 1024;
+                count = 0;
+            }
+        }
+        report_dropped(reportedDrops);
+        // one flush per batch
+        if (count) {
+            flush_sinks();
+        }
+        {
+            std::lock_guard lock(mutex);
+            written += count;
+        }
+        flushedCv.notify_all();
+        if (stop) {
+            break;
+        }
+    }
+}
+
+static void on_terminate() {
+    Logger::flush();
+    if (prevTerminateHandler) {
+        prevTerminateHandler();
+    }
+    std::abort();
+}
+
+LogMessage::~LogMessage() {
+    logger->log(level, ss.str());
+}
+
+Logger::Logger(std::string name) : name(std::move(name)) {
+}
+
+void Logger::log(
+    LogLevel level, const std::string& name, std::string message
+) {
+#ifdef NDEBUG
+    if (level == LogLevel::debug) {
+        return;
+    }
+#endif
+    if (!is_accepted(level, LogSink::file) &&
+        !is_accepted(level, LogSink::console)) {
+        return;
+    }
+    LogRecord record {
+        level, name, std::move(message), std::chrono::system_clock::now()};
+
+    activeProducers.fetch_add(1, std::memory_order_acq_rel);
+    if (!running.load(std::memory_order_acquire)) {
+        activeProducers.fetch_sub(1, std::memory_order_release);
+        std::lock_guard lock(mutex);
+        // messages pushed while the writer was stopping go first
+        LogRecord queued;
+        while (queue.pop(queued)) {
+            write_record(queued);
+            written++;
         }
-        std::cout << string << std::endl;
+        write_record(record);
+        flush_sinks();
+        return;
+    }
+    if (level != LogLevel::error &&
+        pushed.load(std::memory_order_relaxed) -
+                written.load(std::memory_order_relaxed) >=
+            QUEUE_CAPACITY) {
+        activeProducers.fetch_sub(1, std::memory_order_release);
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    queue.push(std::move(record));
+    uint64_t queued = pushed.fetch_add(1, std::memory_order_release) + 1 -
+                      written.load(std::memory_order_relaxed);
+    activeProducers.fetch_sub(1, std::memory_order_release);
+
+    if (level == LogLevel::error) {
+        // written synchronously to not be lost if the process crashes
+        flush();
+    } else if (queued >= QUEUE_CAPACITY / 4 && !backlogWakeup.exchange(true)) {
+        // may be missed by the writer, then it wakes up by timeout
+        wakeupCv.notify_one();
     }
 }
 
 void Logger::init(const std::string& filename) {
+    std::lock_guard lock(mutex);
     file.open(filename);
 
     time_t tm = std::time(nullptr);
     std::stringstream ss;
     ss << std::put_time(std::localtime(&tm), "%z");
     utcOffset = ss.str();
+
+    if (!running) {
+        stopRequested = false;
+        running = true;
+        writer = std::thread(run_writer);
+        prevTerminateHandler = std::set_terminate(on_terminate);
+    }
 }
 
 void Logger::flush() {
-    std::lock_guard<std::mutex> lock(mutex);
-    file.flush();
+    std::unique_lock lock(mutex);
+    if (!running || std::this_thread::get_id() == writer.get_id()) {
+        flush_sinks();
+        return;
+    }
+    uint64_t target = pushed.load(std::memory_order_acquire);
+    wakeup = true;
+    wakeupCv.notify_one();
+    flushedCv.wait(lock, [target]() {
+        return written >= target || !running;
+    });
+}
+
+void Logger::close() {
+    {
+        std::lock_guard lock(mutex);
+        if (!running || stopRequested) {
+            return;
+        }
+        stopRequested = true;
+    }
+    wakeupCv.notify_one();
+    writer.join();
+
+    // new messages are written synchronously
+    running.store(false, std::memory_order_release);
+    // wait for producers pushing after the writer has been stopped
+    while (activeProducers.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+    std::lock_guard lock(mutex);
+    // messages pushed while the writer was stopping
+    LogRecord record;
+    while (queue.pop(record)) {
+        write_record(record);
+        written++;
+    }
+    flush_sinks();
+    flushedCv.notify_all();
+}
+
+void Logger::setLevel(LogSink sink, LogLevel level) {
+    levels[static_cast<int>(sink)] = level;
+}
+
+LogLevel Logger::getLevel(LogSink sink) {
+    return levels[static_cast<int>(sink)];
+}
+
+size_t Logger::getDroppedCount() {
+    return dropped.load(std::memory_order_relaxed);
+}
+
+bool Logger::parseLevel(std::string_view name, LogLevel& level) {
+    if (name == "debug") {
+        level = LogLevel::debug;
+    } else if (name == "info") {
+        level = LogLevel::info;
+    } else if (name == "warning") {
+        level = LogLevel::warning;
+    } else if (name == "error") {
+        level = LogLevel::error;
+    } else {
+        return false;
+    }
+    return true;
 }
 
 void Logger::log(LogLevel level, std::string message) {
@@ -3,10 +3,13 @@
 #include <fstream>
 #include <mutex>
 #include <sstream>
+#include <string_view>
 
 namespace debug {
     enum class LogLevel { print, debug, info, warning, error };
 
+    enum class LogSink { file, console };
+
     class Logger;
 
     class LogMessage {
@@ -26,21 +29,46 @@ namespace debug {
         }
     };
 
+    /// @brief Named logger. Messages are pushed to a lock-free queue and
+    /// written by a background thread (after init), so logging does not
+    /// block on I/O. Error messages are never dropped: logging an error
+    /// blocks until it is written and flushed, so it is not lost if the
+    /// process crashes.
     class Logger {
-        static std::mutex mutex;
-        static std::string utcOffset;
-        static std::ofstream file;
-        static unsigned moduleLen;
-
         std::string name;
 
         static void log(
-            LogLevel level, const std::string& name, const std::string& message
+            LogLevel level, const std::string& name, std::string message
         );
     public:
+        /// @brief Max number of queued messages. Non-error messages are
+        /// dropped while the queue is full
+        static constexpr size_t QUEUE_CAPACITY = 65536;
+
+        /// @brief Open log file and start the writer thread
         static void init(const std::string& filename);
+
+        /// @brief Block until all queued messages are written and flushed.
+        /// Also called on std::terminate
         static void flush();
 
+        /// @brief Stop the writer thread writing remaining messages.
+        /// Messages logged after are written synchronously
+        static void close();
+
+        /// @brief Set min level of messages written to the sink.
+        /// Print messages are not filtered
+        static void setLevel(LogSink sink, LogLevel level);
+
+        static LogLevel getLevel(LogSink sink);
+
+        /// @return number of messages dropped because of full queue
+        static size_t getDroppedCount();
+
+        /// @brief Parse level name: debug, info, warning, error
+        /// @return false if name is invalid
+        static bool parseLevel(std::string_view name, LogLevel& level);
+
         Logger(std::string name);
 
         void log(LogLevel level, std::string message);
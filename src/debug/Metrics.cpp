@@ -0,0 +1,404 @@
+#include "Metrics.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "coders/json.hpp"
+#include "debug/Logger.hpp"
+#include "io/io.hpp"
+#include "settings.hpp"
+
+static debug::Logger logger("metrics");
+
+using namespace debug;
+
+Histogram::Histogram(std::vector<double> bounds)
+    : bounds(std::move(bounds)),
+      buckets(std::make_unique<std::atomic<uint64_t>[]>(this->bounds.size() + 1)) {
+    if (!std::is_sorted(this->bounds.begin(), this->bounds.end())) {
+        throw std::runtime_error("histogram bounds must be sorted");
+    }
+    for (size_t i = 0; i <= this->bounds.size(); i++) {
+        buckets[i] = 0;
+    }
+}
+
+void Histogram::observe(double value) {
+    size_t index =
+        std::lower_bound(bounds.begin(), bounds.end(), value) - bounds.begin();
+    buckets[index].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    double current = sum.load(std::memory_order_relaxed);
+    while (!sum.compare_exchange_weak(
+        current, current + value, std::memory_order_relaxed
+    ));
+}
+
+std::vector<uint64_t> Histogram::getCumulativeCounts() const {
+    std::vector<uint64_t> counts(bounds.size() + 1);
+    uint64_t total = 0;
+    for (size_t i = 0; i <= bounds.size(); i++) {
+        total += buckets[i].load(std::memory_order_relaxed);
+        counts[i] = total;
+    }
+    return counts;
+}
+
+MetricsRegistry& MetricsRegistry::global() {
+    static MetricsRegistry registry;
+    return registry;
+}
+
+bool MetricsRegistry::isValidName(const std::string& name) {
+    if (name.empty() || std::isdigit(static_cast<unsigned char>(name[0]))) {
+        return false;
+    }
+    for (char c : name) {
+        if (!std::isalnum(static_cast<unsigned char>(c)) && c != '_' &&
+            c != ':') {
+            return false;
+        }
+    }
+    return true;
+}
+
+MetricsRegistry::Entry& MetricsRegistry::getOrCreate(
+    const std::string& name, const std::string& help, MetricType type
+) {
+    const auto& found = entries.find(name);
+    if (found != entries.end()) {
+        if (found->second.type != type || found->second.callback) {
+            throw std::runtime_error(
+                "metric '" + name + "' is already registered with another type"
+            );
+        }
+        return found->second;
+    }
+    if (!isValidName(name)) {
+        throw std::runtime_error("invalid metric name '" + name + "'");
+    }
+    auto& entry = entries[name];
+    entry.help = help;
+    entry.type = type;
+    return entry;
+}
+
+Counter& MetricsRegistry::counter(
+    const std::string& name, const std::string& help
+) {
+    std::lock_guard lock(mutex);
+    auto& entry = getOrCreate(name, help, MetricType::counter);
+    if (entry.counter == nullptr) {
+        entry.counter = std::make_unique<Counter>();
+    }
+    return *entry.counter;
+}
+
+Gauge& MetricsRegistry::gauge(
+    const std::string& name, const std::string& help
+) {
+    std::lock_guard lock(mutex);
+    auto& entry = getOrCreate(name, help, MetricType::gauge);
+    if (entry.gauge == nullptr) {
+        entry.gauge = std::make_unique<Gauge>();
+    }
+    return *entry.gauge;
+}
+
+Histogram& MetricsRegistry::histogram(
+    const std::string& name,
+    const std::string& help,
+    std::vector<double> bounds
+) {
+    std::lock_guard lock(mutex);
+    auto& entry = getOrCreate(name, help, MetricType::histogram);
+    if (entry.histogram == nullptr) {
+        entry.histogram = std::make_unique<Histogram>(std::move(bounds));
+    }
+    return *entry.histogram;
+}
+
+ObserverHandler MetricsRegistry::addCallback(
+    const std::string& name,
+    const std::string& help,
+    supplier<double> callback,
+    MetricType type
+) {
+    if (type == MetricType::histogram) {
+        throw std::runtime_error("histogram callbacks are not supported");
+    }
+    std::lock_guard lock(mutex);
+    if (!isValidName(name)) {
+        throw std::runtime_error("invalid metric name '" + name + "'");
+    }
+    const auto& found = entries.find(name);
+    if (found != entries.end() && !found->second.callback) {
+        throw std::runtime_error("metric '" + name + "' is already registered");
+    }
+    // callback of the same name is replaced (e.g. new level is created
+    // before the previous one is destroyed)
+    auto& entry = entries[name];
+    entry.help = help;
+    entry.type = type;
+    entry.callback = std::move(callback);
+    entry.callbackId = ++nextCallbackId;
+    return ObserverHandler([this, name, id = entry.callbackId]() {
+        std::lock_guard lock(mutex);
+        const auto& found = entries.find(name);
+        if (found != entries.end() && found->second.callbackId == id) {
+            entries.erase(found);
+        }
+    });
+}
+
+bool MetricsRegistry::has(const std::string& name) {
+    std::lock_guard lock(mutex);
+    return entries.find(name) != entries.end();
+}
+
+static MetricSample create_sample(
+    const std::string& name,
+    const std::string& help,
+    MetricType type,
+    double value
+) {
+    MetricSample sample;
+    sample.name = name;
+    sample.help = help;
+    sample.type = type;
+    sample.value = value;
+    return sample;
+}
+
+std::vector<MetricSample> MetricsRegistry::collect() {
+    std::vector<std::pair<std::string, supplier<double>>> callbacks;
+    std::vector<MetricSample> samples;
+    {
+        std::lock_guard lock(mutex);
+        for (const auto& [name, entry] : entries) {
+            if (entry.callback) {
+                // evaluated out of the lock to allow callbacks use registry
+                samples.push_back(create_sample(name, entry.help, entry.type, 0));
+                callbacks.emplace_back(name, entry.callback);
+            } else if (entry.counter) {
+                samples.push_back(create_sample(
+                    name, entry.help, entry.type, entry.counter->get()
+                ));
+            } else if (entry.gauge) {
+                samples.push_back(create_sample(
+                    name, entry.help, entry.type, entry.gauge->get()
+                ));
+            } else if (entry.histogram) {
+                auto sample = create_sample(
+                    name, entry.help, entry.type, entry.histogram->getSum()
+                );
+                sample.bounds = entry.histogram->getBounds();
+                sample.buckets = entry.histogram->getCumulativeCounts();
+                sample.count = sample.buckets.back();
+                samples.push_back(std::move(sample));
+            }
+        }
+    }
+    for (const auto& [name, callback] : callbacks) {
+        auto found = std::find_if(
+            samples.begin(), samples.end(), [&name = name](const auto& sample) {
+                return sample.name == name;
+            }
+        );
+        found->value = callback();
+    }
+    return samples;
+}
+
+bool MetricsRegistry::collect(const std::string& name, MetricSample& sample) {
+    supplier<double> callback;
+    {
+        std::lock_guard lock(mutex);
+        const auto& found = entries.find(name);
+        if (found == entries.end()) {
+            return false;
+        }
+        const auto& entry = found->second;
+        sample = create_sample(name, entry.help, entry.type, 0);
+        if (entry.callback) {
+            callback = entry.callback;
+        } else if (entry.counter) {
+            sample.value = entry.counter->get();
+        } else if (entry.gauge) {
+            sample.value = entry.gauge->get();
+        } else if (entry.histogram) {
+            sample.value = entry.histogram->getSum();
+            sample.bounds = entry.histogram->getBounds();
+            sample.buckets = entry.histogram->getCumulativeCounts();
+            sample.count = sample.buckets.back();
+        }
+    }
+    if (callback) {
+        sample.value = callback();
+    }
+    return true;
+}
+
+static const char* type_name(MetricType type) {
+    switch (type) {
+        case MetricType::counter: return "counter";
+        case MetricType::gauge: return "gauge";
+        case MetricType::histogram: return "histogram";
+    }
+    return "untyped";
+}
+
+static void write_number(std::ostream& ss, double value) {
+    if (std::isinf(value)) {
+        ss << (value > 0 ? "+Inf" : "-Inf");
+    } else if (std::isnan(value)) {
+        ss << "NaN";
+    } else {
+        ss << value;
+    }
+}
+
+std::string metrics::to_prometheus(const std::vector<MetricSample>& samples) {
+    std::stringstream ss;
+    ss.precision(15);
+    for (const auto& sample : samples) {
+        if (!sample.help.empty()) {
+            ss << "# HELP " << sample.name << " ";
+            for (char c : sample.help) {
+                if (c == '\\') {
+                    ss << "\\\\";
+                } else if (c == '\n') {
+                    ss << "\\n";
+                } else {
+                    ss << c;
+                }
+            }
+            ss << "\n";
+        }
+        ss << "# TYPE " << sample.name << " " << type_name(sample.type) << "\n";
+        if (sample.type != MetricType::histogram) {
+            ss << sample.name << " ";
+            write_number(ss, sample.value);
+            ss << "\n";
+            continue;
+        }
+        for (size_t i = 0; i < sample.buckets.size(); i++) {
+            ss << sample.name << "_bucket{le=\"";
+            if (i < sample.bounds.size()) {
+                write_number(ss, sample.bounds[i]);
+            } else {
+                ss << "+Inf";
+            }
+            ss << "\"} " << sample.buckets[i] << "\n";
+        }
+        ss << sample.name << "_sum ";
+        write_number(ss, sample.value);
+        ss << "\n" << sample.name << "_count " << sample.count << "\n";
+    }
+    return ss.str();
+}
+
+dv::value metrics::to_value(const MetricSample& sample) {
+    if (sample.type != MetricType::histogram) {
+        return sample.value;
+    }
+    auto buckets = dv::list();
+    for (size_t i = 0; i < sample.buckets.size(); i++) {
+        if (i < sample.bounds.size()) {
+            buckets.add(dv::list(
+                {sample.bounds[i], static_cast<dv::integer_t>(sample.buckets[i])}
+            ));
+        } else {
+            buckets.add(dv::list(
+                {std::string("+Inf"), static_cast<dv::integer_t>(sample.buckets[i])}
+            ));
+        }
+    }
+    return dv::object({
+        {"count", static_cast<dv::integer_t>(sample.count)},
+        {"sum", sample.value},
+        {"buckets", buckets},
+    });
+}
+
+std::string metrics::to_json_line(
+    const std::vector<MetricSample>& samples, double timestamp
+) {
+    auto values = dv::object();
+    for (const auto& sample : samples) {
+        values[sample.name] = to_value(sample);
+    }
+    auto root = dv::object({
+        {"timestamp", timestamp},
+        {"metrics", values},
+    });
+    return json::stringify(root, false);
+}
+
+std::string metrics::format(
+    const std::vector<MetricSample>& samples, const std::string& format
+) {
+    if (format == "prometheus") {
+        return to_prometheus(samples);
+    } else if (format == "jsonl") {
+        auto timestamp = std::chrono::duration<double>(
+            std::chrono::system_clock::now().time_since_epoch()
+        ).count();
+        return to_json_line(samples, timestamp);
+    }
+    throw std::runtime_error("unknown metrics format '" + format + "'");
+}
+
+std::vector<double> metrics::duration_bounds() {
+    return {0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0};
+}
+
+MetricsExporter::MetricsExporter(
+    MetricsRegistry& registry, const MetricsSettings& settings
+)
+    : registry(registry), settings(settings) {
+}
+
+void MetricsExporter::update(double time) {
+    if (settings.exportFile.get().empty() ||
+        time - lastExport < settings.exportInterval.get()) {
+        return;
+    }
+    lastExport = time;
+    try {
+        write();
+    } catch (const std::exception& err) {
+        logger.error() << "could not export metrics: " << err.what();
+    }
+}
+
+void MetricsExporter::write() {
+    const auto& format = settings.exportFormat.get();
+    auto text = metrics::format(registry.collect(), format);
+    auto file = io::resolve(settings.exportFile.get());
+
+    if (format == "jsonl") {
+        std::ofstream stream(file, std::ios::binary | std::ios::app);
+        if (!stream) {
+            throw std::runtime_error("could not open " + file.u8string());
+        }
+        stream << text << "\n";
+        return;
+    }
+    // replace file atomically so readers never see partial content
+    auto tmpFile = file;
+    tmpFile += ".tmp";
+    {
+        std::ofstream stream(tmpFile, std::ios::binary);
+        if (!stream) {
+            throw std::runtime_error("could not open " + tmpFile.u8string());
+        }
+        stream << text;
+    }
+    std::filesystem::rename(tmpFile, file);
+}
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "data/dv.hpp"
+#include "delegates.hpp"
+#include "util/observer_handler.hpp"
+
+struct MetricsSettings;
+
+namespace debug {
+    enum class MetricType { counter, gauge, histogram };
+
+    /// @brief Monotonically increasing value
+    class Counter {
+        std::atomic<uint64_t> value = 0;
+    public:
+        void add(uint64_t n = 1) {
+            value.fetch_add(n, std::memory_order_relaxed);
+        }
+
+        uint64_t get() const {
+            return value.load(std::memory_order_relaxed);
+        }
+    };
+
+    /// @brief Arbitrary value that can go up and down
+    class Gauge {
+        std::atomic<double> value = 0.0;
+    public:
+        void set(double value) {
+            this->value.store(value, std::memory_order_relaxed);
+        }
+
+        double get() const {
+            return value.load(std::memory_order_relaxed);
+        }
+    };
+
+    /// @brief Values distribution over fixed buckets
+    class Histogram {
+        /// @brief Ascending buckets upper bounds (+Inf bucket is implicit)
+        std::vector<double> bounds;
+        std::unique_ptr<std::atomic<uint64_t>[]> buckets;
+        std::atomic<uint64_t> count = 0;
+        std::atomic<double> sum = 0.0;
+    public:
+        Histogram(std::vector<double> bounds);
+
+        void observe(double value);
+
+        const std::vector<double>& getBounds() const {
+            return bounds;
+        }
+
+        /// @return cumulative counts for each bound and +Inf
+        std::vector<uint64_t> getCumulativeCounts() const;
+
+        uint64_t getCount() const {
+            return count.load(std::memory_order_relaxed);
+        }
+
+        double getSum() const {
+            return sum.load(std::memory_order_relaxed);
+        }
+    };
+
+    struct MetricSample {
+        std::string name;
+        std::string help;
+        MetricType type;
+        /// @brief Counter or gauge value, histogram sum
+        double value;
+        /// @brief Histogram only
+        std::vector<double> bounds;
+        /// @brief Histogram only: cumulative counts (last is +Inf)
+        std::vector<uint64_t> buckets;
+        /// @brief Histogram only
+        uint64_t count = 0;
+    };
+
+    /// @brief Named engine metrics. Counters, gauges and histograms live as
+    /// long as the registry, callback gauges are evaluated on collection and
+    /// removed with the returned handler.
+    /// @note Collection must be performed from the main thread as callbacks
+    /// read main thread state
+    class MetricsRegistry {
+        struct Entry {
+            std::string help;
+            MetricType type;
+            std::unique_ptr<Counter> counter;
+            std::unique_ptr<Gauge> gauge;
+            std::unique_ptr<Histogram> histogram;
+            supplier<double> callback;
+            uint64_t callbackId = 0;
+        };
+        std::map<std::string, Entry> entries;
+        std::mutex mutex;
+        uint64_t nextCallbackId = 0;
+
+        Entry& getOrCreate(
+            const std::string& name, const std::string& help, MetricType type
+        );
+    public:
+        /// @brief Engine-wide registry
+        static MetricsRegistry& global();
+
+        /// @brief Get or create counter
+        /// @throws std::runtime_error if name is invalid or used by metric
+        /// of another type
+        Counter& counter(const std::string& name, const std::string& help);
+
+        /// @brief Get or create gauge
+        Gauge& gauge(const std::string& name, const std::string& help);
+
+        /// @brief Get or create histogram
+        /// @param bounds buckets upper bounds (used on creation only)
+        Histogram& histogram(
+            const std::string& name,
+            const std::string& help,
+            std::vector<double> bounds
+        );
+
+        /// @brief Register metric calculated by callback on collection.
+        /// Previous callback with the same name is replaced
+        /// @param type counter or gauge
+        [[nodiscard]] ObserverHandler addCallback(
+            const std::string& name,
+            const std::string& help,
+            supplier<double> callback,
+            MetricType type = MetricType::gauge
+        );
+
+        bool has(const std::string& name);
+
+        /// @brief Collect all metrics sorted by name
+        std::vector<MetricSample> collect();
+
+        /// @brief Collect metric by name
+        /// @return false if metric not found
+        bool collect(const std::string& name, MetricSample& sample);
+
+        /// @brief Check metric name (Prometheus rules: [a-zA-Z_:][a-zA-Z0-9_:]*)
+        static bool isValidName(const std::string& name);
+    };
+
+    namespace metrics {
+        /// @brief Format samples in Prometheus text exposition format
+        std::string to_prometheus(const std::vector<MetricSample>& samples);
+
+        /// @brief Format samples as single JSON line
+        /// @param timestamp unix time in seconds
+        std::string to_json_line(
+            const std::vector<MetricSample>& samples, double timestamp
+        );
+
+        /// @brief Convert sample value to dv::value: number for counters and
+        /// gauges, {count, sum, buckets} object for histograms
+        dv::value to_value(const MetricSample& sample);
+
+        /// @brief Format samples by format name
+        /// @param format 'prometheus' or 'jsonl'
+        /// @throws std::runtime_error if format is unknown
+        std::string format(
+            const std::vector<MetricSample>& samples, const std::string& format
+        );
+
+        /// @brief Default duration histogram bounds (seconds)
+        std::vector<double> duration_bounds();
+    }
+
+    /// @brief Periodically writes registry metrics to the file set in
+    /// settings. Prometheus file is replaced atomically (textfile collector),
+    /// JSON lines are appended
+    class MetricsExporter {
+        MetricsRegistry& registry;
+        const MetricsSettings& settings;
+        double lastExport = 0.0;
+    public:
+        MetricsExporter(
+            MetricsRegistry& registry, const MetricsSettings& settings
+        );
+
+        /// @param time current engine time in seconds
+        void update(double time);
+
+        /// @brief Write metrics to the export file now
+        /// @throws std::runtime_error on I/O error or unknown format
+        void write();
+    };
+}
@@ -0,0 +1,201 @@
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+
+#include "util/stringutil.hpp"
+
+using namespace debug;
+
+namespace {
+    struct ThreadBuffer {
+        uint64_t id;
+        /// @brief Guarded by registry mutex
+        std::string name;
+        /// @brief Grows up to capacity, then used as ring
+        std::vector<ProfileEvent> events;
+        /// @brief Number of events written in the current capture
+        size_t written = 0;
+        /// @brief Capture events belong to
+        uint64_t generation = 0;
+        /// @brief Owner thread is writing an event
+        std::atomic<bool> busy = false;
+        /// @brief Owner thread is alive
+        std::atomic<bool> alive = true;
+    };
+
+    struct ThreadBufferHolder {
+        std::shared_ptr<ThreadBuffer> buffer;
+
+        ~ThreadBufferHolder() {
+            if (buffer) {
+                buffer->alive = false;
+            }
+        }
+    };
+}
+
+std::atomic<bool> Profiler::active = false;
+
+static std::mutex registryMutex;
+static std::vector<std::shared_ptr<ThreadBuffer>> registry;
+static uint64_t nextThreadId = 1;
+static std::atomic<uint64_t> generation = 0;
+static int64_t captureStart = 0;
+
+static thread_local ThreadBufferHolder localBuffer;
+
+static ThreadBuffer& get_thread_buffer() {
+    if (localBuffer.buffer == nullptr) {
+        auto buffer = std::make_shared<ThreadBuffer>();
+        std::lock_guard lock(registryMutex);
+        buffer->id = nextThreadId++;
+        buffer->name = "thread #" + std::to_string(buffer->id);
+        registry.push_back(buffer);
+        localBuffer.buffer = std::move(buffer);
+    }
+    return *localBuffer.buffer;
+}
+
+int64_t Profiler::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()
+    ).count();
+}
+
+void Profiler::setThreadName(std::string name) {
+    auto& buffer = get_thread_buffer();
+    std::lock_guard lock(registryMutex);
+    buffer.name = std::move(name);
+}
+
+void Profiler::record(const char* name, int64_t start, int64_t end) {
+    auto& buffer = get_thread_buffer();
+    // pairs with stop(): either stop waits for this write or we see
+    // the capture is not active anymore
+    buffer.busy.store(true);
+    if (!active.load()) {
+        buffer.busy.store(false, std::memory_order_release);
+        return;
+    }
+    uint64_t currentGeneration = generation.load(std::memory_order_acquire);
+    if (buffer.generation != currentGeneration) {
+        buffer.events.clear();
+        buffer.written = 0;
+        buffer.generation = currentGeneration;
+    }
+    // zone started before the capture
+    if (start >= captureStart) {
+        ProfileEvent event {name, start, end - start};
+        if (buffer.events.size() < THREAD_BUFFER_CAPACITY) {
+            buffer.events.push_back(event);
+        } else {
+            buffer.events[buffer.written % THREAD_BUFFER_CAPACITY] = event;
+        }
+        buffer.written++;
+    }
+    buffer.busy.store(false, std::memory_order_release);
+}
+
+void Profiler::start() {
+    std::lock_guard lock(registryMutex);
+    if (active) {
+        return;
+    }
+    // forget exited threads
+    registry.erase(
+        std::remove_if(
+            registry.begin(),
+            registry.end(),
+            [](const auto& buffer) { return !buffer->alive; }
+        ),
+        registry.end()
+    );
+    captureStart = now();
+    generation.fetch_add(1, std::memory_order_release);
+    active.store(true);
+}
+
+ProfileCapture Profiler::stop() {
+    std::lock_guard lock(registryMutex);
+    ProfileCapture capture;
+    if (!active) {
+        return capture;
+    }
+    active.store(false);
+    capture.start = captureStart;
+
+    uint64_t currentGeneration = generation.load();
+    for (const auto& buffer : registry) {
+        while (buffer->busy.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+        if (buffer->generation != currentGeneration || buffer->written == 0) {
+            continue;
+        }
+        ProfileThreadTrace trace {buffer->id, buffer->name, {}, 0};
+        const auto& events = buffer->events;
+        if (buffer->written > events.size()) {
+            size_t oldest = buffer->written % events.size();
+            trace.events.insert(
+                trace.events.end(), events.begin() + oldest, events.end()
+            );
+            trace.events.insert(
+                trace.events.end(), events.begin(), events.begin() + oldest
+            );
+            trace.dropped = buffer->written - events.size();
+        } else {
+            trace.events = events;
+        }
+        capture.threads.push_back(std::move(trace));
+    }
+    return capture;
+}
+
+static void write_micros(std::stringstream& ss, int64_t nanos) {
+    ss << nanos / 1000 << '.';
+    int64_t fraction = nanos % 1000;
+    if (fraction < 100) ss << '0';
+    if (fraction < 10) ss << '0';
+    ss << fraction;
+}
+
+std::string Profiler::toChromeTrace(const ProfileCapture& capture) {
+    // zone names are static strings, so escape each only once
+    std::unordered_map<const char*, std::string> names;
+    std::stringstream ss;
+    ss << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (const auto& thread : capture.threads) {
+        if (!first) {
+            ss << ',';
+        }
+        first = false;
+        ss << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+           << thread.id << ",\"args\":{\"name\":"
+           << util::escape(thread.name, false) << ",\"dropped\":"
+           << thread.dropped << "}}";
+        for (const auto& event : thread.events) {
+            auto found = names.find(event.name);
+            if (found == names.end()) {
+                found = names.emplace(
+                    event.name, util::escape(event.name, false)
+                ).first;
+            }
+            ss << ",{\"name\":" << found->second
+               << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread.id
+               << ",\"ts\":";
+            write_micros(ss, event.start - capture.start);
+            ss << ",\"dur\":";
+            write_micros(ss, event.duration);
+            ss << '}';
+        }
+    }
+    ss << "]}";
+    return ss.str();
+}
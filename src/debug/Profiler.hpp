@@ -0,0 +1,95 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace debug {
+    /// @brief Completed profiler zone
+    struct ProfileEvent {
+        /// @brief Zone name (static string)
+        const char* name;
+        /// @brief Start time in nanoseconds
+        int64_t start;
+        /// @brief Duration in nanoseconds
+        int64_t duration;
+    };
+
+    /// @brief Zones recorded by a thread during capture
+    struct ProfileThreadTrace {
+        uint64_t id;
+        std::string name;
+        /// @brief Events in order of completion
+        std::vector<ProfileEvent> events;
+        /// @brief Number of oldest events overwritten in the thread buffer
+        size_t dropped;
+    };
+
+    struct ProfileCapture {
+        /// @brief Capture start time in nanoseconds
+        int64_t start = 0;
+        std::vector<ProfileThreadTrace> threads;
+    };
+
+    /// @brief Scoped zones profiler with runtime-toggled captures.
+    /// Each thread writes completed zones into own ring buffer without
+    /// locking, so zones are almost free while no capture is active.
+    class Profiler {
+        static std::atomic<bool> active;
+    public:
+        /// @brief Max events stored per thread during capture
+        static constexpr size_t THREAD_BUFFER_CAPACITY = 65536;
+
+        /// @brief Start new capture (previous events are discarded)
+        static void start();
+
+        /// @brief Stop capture and collect recorded events
+        static ProfileCapture stop();
+
+        static bool isActive() {
+            return active.load(std::memory_order_relaxed);
+        }
+
+        /// @brief Set current thread name shown in traces
+        static void setThreadName(std::string name);
+
+        /// @brief Record a completed zone from the current thread
+        static void record(const char* name, int64_t start, int64_t end);
+
+        /// @return monotonic time in nanoseconds
+        static int64_t now();
+
+        /// @brief Convert capture to Chrome Trace Event Format JSON
+        /// (chrome://tracing, Perfetto UI)
+        static std::string toChromeTrace(const ProfileCapture& capture);
+    };
+
+    /// @brief Records zone from construction to destruction if a capture
+    /// is active at construction
+    class ProfileZone {
+        const char* name;
+        int64_t start;
+    public:
+        ProfileZone(const char* name)
+            : name(name), start(Profiler::isActive() ? Profiler::now() : -1) {
+        }
+
+        ~ProfileZone() {
+            if (start >= 0) {
+                Profiler::record(name, start, Profiler::now());
+            }
+        }
+    };
+}
+
+#define PROFILE_ZONE_CONCAT_(a, b) a##b
+#define PROFILE_ZONE_CONCAT(a, b) PROFILE_ZONE_CONCAT_(a, b)
+
+#ifdef VC_DISABLE_PROFILER
+#define PROFILE_ZONE(name)
+#else
+/// @brief Profile scope until its end. Name must be a string literal
+#define PROFILE_ZONE(name) \
+    debug::ProfileZone PROFILE_ZONE_CONCAT(profileZone_, __LINE__)(name)
+#endif
@@ -1,52 +1,61 @@
 #include "SyntaxProcessor.hpp"
 
+#include <algorithm>
+
 #include "coders/commons.hpp"
 #include "coders/syntax_parser.hpp"
 #include "graphics/core/Font.hpp"
+#include "util/stringutil.hpp"
 
 using namespace devtools;
 
+static std::vector<FontStyle> create_palette() {
+    return {
+        {false, false, false, false, glm::vec4(0.8f, 0.8f, 0.8f, 1)}, // default
+        {true, false, false, false, glm::vec4(0.9, 0.6f, 0.4f, 1)},   // keyword
+        {false, false, false, false, glm::vec4(0.4, 0.8f, 0.5f, 1)},  // string
+        {false, false, false, false, glm::vec4(0.3, 0.3f, 0.3f, 1)},  // comment
+        {true, false, false, false, glm::vec4(1.0f, 0.2f, 0.1f, 1)},  // unexpected
+    };
+}
+
+static int get_style(TokenTag tag) {
+    switch (tag) {
+        case TokenTag::KEYWORD: return SyntaxStyles::KEYWORD;
+        case TokenTag::STRING:
+        case TokenTag::INTEGER:
+        case TokenTag::NUMBER: return SyntaxStyles::LITERAL;
+        case TokenTag::COMMENT: return SyntaxStyles::COMMENT;
+        case TokenTag::UNEXPECTED: return SyntaxStyles::ERROR;
+        default: return SyntaxStyles::DEFAULT;
+    }
+}
+
+static int get_style(LineState state) {
+    switch (state) {
+        case LineState::COMMENT: return SyntaxStyles::COMMENT;
+        case LineState::STRING:
+        case LineState::SINGLE_QUOTED:
+        case LineState::DOUBLE_QUOTED: return SyntaxStyles::LITERAL;
+        default: return SyntaxStyles::DEFAULT;
+    }
+}
+
 static std::unique_ptr<FontStylesScheme> build_styles(
     const std::vector<devtools::Token>& tokens
 ) {
-    using devtools::TokenTag;
-    FontStylesScheme styles {
-        {
-            {false, false, false, false, glm::vec4(0.8f, 0.8f, 0.8f, 1)}, // default
-            {true, false, false, false, glm::vec4(0.9, 0.6f, 0.4f, 1)},   // keyword
-            {false, false, false, false, glm::vec4(0.4, 0.8f, 0.5f, 1)},  // string
-            {false, false, false, false, glm::vec4(0.3, 0.3f, 0.3f, 1)},  // comment
-            {true, false, false, false, glm::vec4(1.0f, 0.2f, 0.1f, 1)},  // unexpected
-        }, 
-        {}
-    };
+    FontStylesScheme styles {create_palette(), {}};
     size_t offset = 0;
     for (int i = 0; i < tokens.size(); i++) {
         const auto& token = tokens.at(i);
-        if (token.tag != TokenTag::KEYWORD &&
-            token.tag != TokenTag::STRING &&
-            token.tag != TokenTag::INTEGER &&
-            token.tag != TokenTag::NUMBER &&
-            token.tag != TokenTag::COMMENT &&
-            token.tag != TokenTag::UNEXPECTED) {
+        int styleIndex = get_style(token.tag);
+        if (styleIndex == SyntaxStyles::DEFAULT) {
             continue;
         }
         if (token.start.pos > offset) {
             styles.map.insert(styles.map.end(), token.start.pos - offset, 0);
         }
         offset = token.end.pos;
-        int styleIndex;
-        switch (token.tag) {
-            case TokenTag::KEYWORD: styleIndex = SyntaxStyles::KEYWORD; break;
-            case TokenTag::STRING:
-            case TokenTag::INTEGER:
-            case TokenTag::NUMBER: styleIndex = SyntaxStyles::LITERAL; break;
-            case TokenTag::COMMENT: styleIndex = SyntaxStyles::COMMENT; break;
-            case TokenTag::UNEXPECTED: styleIndex = SyntaxStyles::ERROR; break;
-            default:
-                styleIndex = 0;
-                break;
-        }
         styles.map.insert(
             styles.map.end(), token.end.pos - token.start.pos, styleIndex
         );
@@ -55,6 +64,117 @@ static std::unique_ptr<FontStylesScheme> build_styles(
     return std::make_unique<FontStylesScheme>(std::move(styles));
 }
 
+SyntaxHighlighter::SyntaxHighlighter(const Syntax& syntax)
+    : syntax(syntax),
+      lineStarts({0}),
+      lineStates({LineState::NORMAL}),
+      styles(std::make_shared<FontStylesScheme>(
+          FontStylesScheme {create_palette(), {0}}
+      )) {
+}
+
+SyntaxHighlighter::~SyntaxHighlighter() = default;
+
+bool SyntaxHighlighter::update(std::wstring_view newText) {
+    auto edit = util::find_edit(text, newText);
+    if (edit.empty()) {
+        tokenizedLines = 0;
+        return false;
+    }
+    size_t prefix = edit.start;
+    size_t removedEnd = edit.start + edit.removed;
+    size_t insertedEnd = edit.start + edit.inserted;
+
+    size_t line = std::upper_bound(
+        lineStarts.begin(), lineStarts.end(), prefix
+    ) - lineStarts.begin() - 1;
+
+    // remove lines started in the removed range and shift next ones
+    auto first = lineStarts.begin() + line + 1;
+    auto last = std::upper_bound(first, lineStarts.end(), removedEnd);
+    lineStates.erase(
+        lineStates.begin() + (first - lineStarts.begin()),
+        lineStates.begin() + (last - lineStarts.begin())
+    );
+    for (auto it = lineStarts.erase(first, last); it != lineStarts.end(); ++it) {
+        *it = *it - removedEnd + insertedEnd;
+    }
+    // add lines started in the inserted range
+    std::vector<size_t> insertedStarts;
+    for (size_t i = prefix; i < insertedEnd; i++) {
+        if (newText[i] == '\n') {
+            insertedStarts.push_back(i + 1);
+        }
+    }
+    lineStarts.insert(
+        lineStarts.begin() + line + 1,
+        insertedStarts.begin(),
+        insertedStarts.end()
+    );
+    lineStates.insert(
+        lineStates.begin() + line + 1,
+        insertedStarts.size(),
+        LineState::NORMAL
+    );
+
+    auto& map = styles->map;
+    map.erase(map.begin() + prefix, map.begin() + removedEnd);
+    map.insert(map.begin() + prefix, insertedEnd - prefix, 0);
+    text.replace(
+        prefix,
+        removedEnd - prefix,
+        newText.substr(prefix, insertedEnd - prefix)
+    );
+
+    // re-tokenize until a line starts in the same state as before
+    size_t lastEdited = line + insertedStarts.size();
+    LineState state = lineStates[line];
+    tokenizedLines = 0;
+    for (size_t i = line; i < lineStarts.size(); i++) {
+        state = tokenizeLine(i, state);
+        tokenizedLines++;
+        if (i + 1 == lineStarts.size() ||
+            (i >= lastEdited && lineStates[i + 1] == state)) {
+            break;
+        }
+        lineStates[i + 1] = state;
+    }
+    return true;
+}
+
+LineState SyntaxHighlighter::tokenizeLine(size_t line, LineState state) {
+    size_t start = lineStarts[line];
+    size_t end = line + 1 < lineStarts.size() ? lineStarts[line + 1] - 1
+                                              : text.length();
+    auto& map = styles->map;
+    std::fill(map.begin() + start, map.begin() + end, SyntaxStyles::DEFAULT);
+
+    tokens.clear();
+    try {
+        state = tokenize_line(
+            syntax,
+            std::wstring_view(text).substr(start, end - start),
+            state,
+            tokens
+        );
+    } catch (const parsing_error& err) {
+        tokens.clear();
+        state = LineState::NORMAL;
+    }
+    for (const auto& token : tokens) {
+        std::fill(
+            map.begin() + start + token.start.pos,
+            map.begin() + start + token.end.pos,
+            get_style(token.tag)
+        );
+    }
+    // line break belongs to a token left open
+    if (end < text.length()) {
+        map[end] = get_style(state);
+    }
+    return state;
+}
+
 void SyntaxProcessor::addSyntax(
     std::unique_ptr<Syntax> syntax
 ) {
@@ -81,3 +201,13 @@ std::unique_ptr<FontStylesScheme> SyntaxProcessor::highlight(
         return nullptr;
     }
 }
+
+std::unique_ptr<SyntaxHighlighter> SyntaxProcessor::createHighlighter(
+    const std::string& ext
+) const {
+    const auto& found = langsExtensions.find(ext);
+    if (found == langsExtensions.end()) {
+        return nullptr;
+    }
+    return std::make_unique<SyntaxHighlighter>(*found->second);
+}
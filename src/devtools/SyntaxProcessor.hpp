@@ -2,6 +2,7 @@
 
 #include <set>
 #include <string>
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include <unordered_map>
@@ -10,17 +11,63 @@ struct FontStylesScheme;
 
 namespace devtools {
     struct Syntax;
+    struct Token;
+    enum class LineState : uint8_t;
 
     enum SyntaxStyles {
         DEFAULT, KEYWORD, LITERAL, COMMENT, ERROR
     };
 
+    /// @brief Incremental highlighter of a single text. Keeps tokenizer
+    /// state at every line start, so an edit re-tokenizes lines from the
+    /// edited one until the line start state converges, patching styles
+    /// map in place
+    class SyntaxHighlighter {
+    public:
+        SyntaxHighlighter(const Syntax& syntax);
+        ~SyntaxHighlighter();
+
+        /// @brief Update styles to the new version of the text.
+        /// Edited range is found by comparing with the previous version
+        /// @return true if text has been changed
+        bool update(std::wstring_view text);
+
+        /// @brief Get styles scheme updated in place
+        const std::shared_ptr<FontStylesScheme>& getStyles() const {
+            return styles;
+        }
+
+        /// @brief Get number of lines tokenized by the last update
+        size_t getTokenizedLines() const {
+            return tokenizedLines;
+        }
+    private:
+        const Syntax& syntax;
+        std::wstring text;
+        /// @brief Start offset of every line
+        std::vector<size_t> lineStarts;
+        /// @brief Tokenizer state at every line start
+        std::vector<LineState> lineStates;
+        std::shared_ptr<FontStylesScheme> styles;
+        /// @brief Reused tokens buffer
+        std::vector<Token> tokens;
+        size_t tokenizedLines = 0;
+
+        /// @return tokenizer state at the line end
+        LineState tokenizeLine(size_t line, LineState state);
+    };
+
     class SyntaxProcessor {
     public:
         std::unique_ptr<FontStylesScheme> highlight(
             const std::string& ext, std::wstring_view source
         ) const;
 
+        /// @return nullptr if no syntax registered for the extension
+        std::unique_ptr<SyntaxHighlighter> createHighlighter(
+            const std::string& ext
+        ) const;
+
         void addSyntax(std::unique_ptr<Syntax> syntax);
     private:
         std::vector<std::unique_ptr<Syntax>> langs;
@@ -5,6 +5,8 @@
 #endif
 
 #include "debug/Logger.hpp"
+#include "debug/Metrics.hpp"
+#include "debug/Profiler.hpp"
 #include "assets/AssetsLoader.hpp"
 #include "audio/audio.hpp"
 #include "coders/GLSLExtension.hpp"
@@ -75,6 +77,7 @@ Engine& Engine::getInstance() {
 void Engine::initialize(CoreParameters coreParameters) {
     params = std::move(coreParameters);
     settingsHandler = std::make_unique<SettingsHandler>(settings);
+    debug::Profiler::setThreadName("main");
 
     logger.info() << "engine version: " << ENGINE_VERSION_STRING;
     if (params.headless) {
@@ -92,11 +95,16 @@ void Engine::initialize(CoreParameters coreParameters) {
     editor = std::make_unique<devtools::Editor>(*this);
     cmd = std::make_unique<cmd::CommandsInterpreter>();
     network = network::Network::create(settings.network);
+    registerMetrics();
 
     if (!params.scriptFile.empty()) {
         paths.setScriptFolder(params.scriptFile.parent_path());
     }
     loadSettings();
+    observeLogLevel(settings.debug.logFileLevel, debug::LogSink::file);
+    observeLogLevel(
+        settings.debug.logConsoleLevel, debug::LogSink::console
+    );
 
     controller = std::make_unique<EngineController>(*this);
     if (!params.headless) {
@@ -188,6 +196,17 @@ void Engine::loadSettings() {
     }
 }
 
+void Engine::observeLogLevel(StringSetting& setting, debug::LogSink sink) {
+    keepAlive(setting.observe([sink](const std::string& name) {
+        debug::LogLevel level;
+        if (debug::Logger::parseLevel(name, level)) {
+            debug::Logger::setLevel(sink, level);
+        } else {
+            logger.warning() << "invalid log level '" << name << "'";
+        }
+    }, true));
+}
+
 void Engine::loadControls() {
     io::path controls_file = EnginePaths::CONTROLS_FILE;
     if (io::is_regular_file(controls_file)) {
@@ -228,10 +247,42 @@ void Engine::run() {
     }
 }
 
+void Engine::registerMetrics() {
+    auto& registry = debug::MetricsRegistry::global();
+    keepAlive(registry.addCallback(
+        "network_download_bytes_total",
+        "Total bytes received by all connections",
+        [this]() {
+            return static_cast<double>(network->getTotalDownload());
+        },
+        debug::MetricType::counter
+    ));
+    keepAlive(registry.addCallback(
+        "network_upload_bytes_total",
+        "Total bytes sent by all connections",
+        [this]() {
+            return static_cast<double>(network->getTotalUpload());
+        },
+        debug::MetricType::counter
+    ));
+    keepAlive(registry.addCallback(
+        "log_messages_dropped_total",
+        "Log messages dropped because of full logger queue",
+        []() {
+            return static_cast<double>(debug::Logger::getDroppedCount());
+        },
+        debug::MetricType::counter
+    ));
+    metricsExporter = std::make_unique<debug::MetricsExporter>(
+        registry, settings.metrics
+    );
+}
+
 void Engine::postUpdate() {
     network->update();
     postRunnables.run();
     scripting::process_post_runnables();
+    metricsExporter->update(time.getTime());
 }
 
 void Engine::updateFrontend() {
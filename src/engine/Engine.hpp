@@ -12,6 +12,7 @@
 
 #include <memory>
 #include <string>
+#include <glm/glm.hpp>
 
 class Window;
 class Assets;
@@ -38,6 +39,11 @@ namespace devtools {
     class Editor;
 }
 
+namespace debug {
+    class MetricsExporter;
+    enum class LogSink;
+}
+
 class initialize_error : public std::runtime_error {
 public:
     initialize_error(const std::string& message) : std::runtime_error(message) {}
@@ -50,6 +56,12 @@ struct CoreParameters {
     std::filesystem::path userFolder = ".";
     std::filesystem::path scriptFile;
     std::filesystem::path projectFolder;
+    /// @brief Name of the world to pre-generate in headless mode
+    std::string pregenWorld;
+    /// @brief Pre-generation area min chunk position
+    glm::ivec2 pregenMin {-32, -32};
+    /// @brief Pre-generation area max chunk position (exclusive)
+    glm::ivec2 pregenMax {32, 32};
 };
 
 using OnWorldOpen = std::function<void(std::unique_ptr<Level>, int64_t)>;
@@ -71,6 +83,7 @@ class Engine : public util::ObjectsKeeper {
     std::unique_ptr<Input> input;
     std::unique_ptr<gui::GUI> gui;
     std::unique_ptr<devtools::Editor> editor;
+    std::unique_ptr<debug::MetricsExporter> metricsExporter;
     PostRunnables postRunnables;
     Time time;
     OnWorldOpen levelConsumer;
@@ -82,6 +95,8 @@ class Engine : public util::ObjectsKeeper {
     void updateHotkeys();
     void loadAssets();
     void loadProject();
+    void registerMetrics();
+    void observeLogLevel(StringSetting& setting, debug::LogSink sink);
 public:
     Engine();
     ~Engine();
@@ -3,11 +3,15 @@
 #include "Engine.hpp"
 #include "logic/scripting/scripting.hpp"
 #include "logic/LevelController.hpp"
+#include "logic/EngineController.hpp"
+#include "logic/WorldPregen.hpp"
 #include "interfaces/Process.hpp"
 #include "debug/Logger.hpp"
+#include "debug/Metrics.hpp"
 #include "world/Level.hpp"
 #include "world/World.hpp"
 #include "util/platform.hpp"
+#include "util/timeutil.hpp"
 
 #include <chrono>
 
@@ -26,6 +30,10 @@ void ServerMainloop::run() {
     const auto& coreParams = engine.getCoreParameters();
     auto& time = engine.getTime();
 
+    if (!coreParams.pregenWorld.empty()) {
+        runPregen();
+        return;
+    }
     if (coreParams.scriptFile.empty()) {
         logger.info() << "nothing to do";
         return;
@@ -39,6 +47,12 @@ void ServerMainloop::run() {
         "script:" + coreParams.scriptFile.filename().u8string()
     );
 
+    auto& tickTime = debug::MetricsRegistry::global().histogram(
+        "server_tick_seconds",
+        "Server tick duration excluding sleep",
+        debug::metrics::duration_bounds()
+    );
+
     double targetDelta = 1.0 / static_cast<double>(TPS);
     double delta = targetDelta;
     auto begin = system_clock::now();
@@ -58,12 +72,16 @@ void ServerMainloop::run() {
                 duration_cast<microseconds>(now - startupTime).count() / 1e6);
             delta = time.getDelta();
         }
+        auto tickStart = steady_clock::now();
         process->update();
         if (controller) {
             controller->getLevel()->getWorld()->updateTimers(delta);
             controller->update(glm::min(delta, 0.2), false);
         }
         engine.postUpdate();
+        tickTime.observe(
+            duration<double>(steady_clock::now() - tickStart).count()
+        );
 
         if (!coreParams.testMode) {
             auto end = system_clock::now();
@@ -78,6 +96,41 @@ void ServerMainloop::run() {
     logger.info() << "script finished";
 }
 
+void ServerMainloop::runPregen() {
+    const auto& coreParams = engine.getCoreParameters();
+    engine.setLevelConsumer([this](auto level, auto) {
+        setLevel(std::move(level));
+    });
+    try {
+        engine.getController()->openWorld(coreParams.pregenWorld, true);
+    } catch (const std::runtime_error& err) {
+        logger.error() << "could not open world: " << err.what();
+        return;
+    }
+    if (controller == nullptr) {
+        logger.error() << "could not open world " << coreParams.pregenWorld;
+        return;
+    }
+    const auto& min = coreParams.pregenMin;
+    const auto& max = coreParams.pregenMax;
+    logger.info() << "pre-generating world " << coreParams.pregenWorld
+                  << " area " << min.x << ", " << min.y << " - " << max.x
+                  << ", " << max.y;
+
+    timeutil::Timer timer;
+    WorldPregen pregen(*controller->getLevel(), min, max);
+    while (pregen.update()) {
+        if (engine.isQuitSignal()) {
+            logger.info() << "pre-generation has been interrupted";
+            break;
+        }
+    }
+    logger.info() << "pre-generation finished " << pregen.getFinishedCount()
+                  << "/" << pregen.getRegionsCount() << " regions in "
+                  << timer.stop() / 1000000 << " s";
+    setLevel(nullptr);
+}
+
 void ServerMainloop::setLevel(std::unique_ptr<Level> level) {
     if (level == nullptr) {
         controller->onWorldQuit();
@@ -113,6 +113,11 @@ std::shared_ptr<UINode> create_debug_panel(
         bool culling = settings.graphics.frustumCulling.get();
         return L"frustum-culling: "+std::wstring(culling ? L"on" : L"off");
     }));
+    panel->add(create_label(gui, [&engine]() {
+        auto& settings = engine.getSettings();
+        bool culling = settings.graphics.occlusionCulling.get();
+        return L"occlusion-culling: "+std::wstring(culling ? L"on" : L"off");
+    }));
     panel->add(create_label(gui, [=]() {
         return L"particles: " +
                std::to_wstring(ParticlesRenderer::visibleParticles) +
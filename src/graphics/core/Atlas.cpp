@@ -12,7 +12,7 @@ Atlas::Atlas(
     bool prepare
 ) : texture(nullptr),
     image(std::move(image)),
-    regions(regions) 
+    regions(std::move(regions)) 
 {        
     if (prepare) {
         this->prepare();
@@ -41,6 +41,10 @@ std::optional<UVRegion> Atlas::getIf(const std::string& name) const {
     return found->second;
 }
 
+const std::unordered_map<std::string, UVRegion>& Atlas::getRegions() const {
+    return regions;
+}
+
 Texture* Atlas::getTexture() const {
     return texture.get();
 }
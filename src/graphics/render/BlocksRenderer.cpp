@@ -32,6 +32,27 @@ BlocksRenderer::BlocksRenderer(
         CHUNK_H,
         CHUNK_D + voxelBufferPadding*2);
     blockDefsCache = content.getIndices()->blocks.getDefs();
+
+    size_t blocksCount = content.getIndices()->blocks.count();
+    opaqueBlocks.resize(blocksCount);
+    for (size_t i = 0; i < blocksCount; i++) {
+        const auto& def = *blockDefsCache[i];
+        opaqueBlocks[i] = def.rt.solid && def.drawGroup == 0 &&
+                          !def.translucent && !def.lightPassing &&
+                          def.culling == CullingMode::DEFAULT;
+    }
+    // far chunks are built from full cubes only
+    lodBlocks.resize(blocksCount);
+    for (size_t i = 0; i < blocksCount; i++) {
+        const auto& def = *blockDefsCache[i];
+        if (i == 0 || def.model.type != BlockModelType::BLOCK) {
+            lodBlocks[i] = LodVolume::TYPE_NONE;
+        } else if (def.translucent) {
+            lodBlocks[i] = LodVolume::TYPE_TRANSLUCENT;
+        } else {
+            lodBlocks[i] = LodVolume::TYPE_OPAQUE;
+        }
+    }
 }
 
 BlocksRenderer::~BlocksRenderer() {
@@ -632,8 +653,117 @@ SortingMeshData BlocksRenderer::renderTranslucent(
     return sortingMesh;
 }
 
-void BlocksRenderer::build(const Chunk* chunk, const Chunks* chunks) {
+/// @brief Face axes and texture index in LodVolume faces order
+static const struct {
+    glm::vec3 x, y, z;
+    int texture;
+} LOD_FACES[6] {
+    {{0, 0, -1}, {0, 1, 0}, {1, 0, 0}, 1},
+    {{0, 0, 1}, {0, 1, 0}, {-1, 0, 0}, 0},
+    {{1, 0, 0}, {0, 0, -1}, {0, 1, 0}, 3},
+    {{1, 0, 0}, {0, 0, 1}, {0, -1, 0}, 2},
+    {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}, 5},
+    {{-1, 0, 0}, {0, 1, 0}, {0, 0, -1}, 4},
+};
+
+void BlocksRenderer::lodCells(ubyte type) {
+    const auto& volume = *lodVolume;
+    int lod = volume.getLod();
+    // blocks are drawn around their centers
+    float centerOffset = lod * 0.5f - 0.5f;
+    for (int y = 0; y < volume.getHeight(); y++) {
+        for (int z = 0; z < volume.getDepth(); z++) {
+            for (int x = 0; x < volume.getWidth(); x++) {
+                const auto& cell = volume.get(x, y, z);
+                if (cell.type != type || cell.openFaces == 0) {
+                    continue;
+                }
+                const auto& def = *blockDefsCache[cell.id];
+                glm::vec3 coord =
+                    glm::vec3(x, y, z) * static_cast<float>(lod) +
+                    centerOffset;
+                for (int faceIndex = 0; faceIndex < 6; faceIndex++) {
+                    if (!(cell.openFaces & (1 << faceIndex))) {
+                        continue;
+                    }
+                    // brightest block behind the face
+                    glm::ivec3 min, max;
+                    volume.getFaceSlice(x, y, z, faceIndex, min, max);
+                    glm::vec4 light(0.0f, 0.0f, 0.0f, 1.0f);
+                    if (min.y < CHUNK_H) {
+                        light = glm::vec4(0.0f);
+                        for (int ly = min.y; ly < max.y; ly++) {
+                            for (int lz = min.z; lz < max.z; lz++) {
+                                for (int lx = min.x; lx < max.x; lx++) {
+                                    light = glm::max(
+                                        light, pickLight(lx, ly, lz)
+                                    );
+                                }
+                            }
+                        }
+                    }
+                    const auto& lodFace = LOD_FACES[faceIndex];
+                    face(
+                        coord,
+                        lodFace.x * static_cast<float>(lod),
+                        lodFace.y * static_cast<float>(lod),
+                        lodFace.z * static_cast<float>(lod),
+                        cache.getRegion(cell.id, lodFace.texture),
+                        light,
+                        !def.shadeless
+                    );
+                }
+                if (overflow) {
+                    return;
+                }
+            }
+        }
+    }
+}
+
+void BlocksRenderer::renderLod() {
+    if (lodVolume == nullptr || lodVolume->getLod() != lod) {
+        lodVolume = std::make_unique<LodVolume>(lod);
+    }
+    lodVolume->build(
+        *voxelsBuffer, chunk->x * CHUNK_W, chunk->z * CHUNK_D, lodBlocks
+    );
+
+    overflow = false;
+    vertexCount = 0;
+    vertexOffset = indexCount = 0;
+
+    // far translucent faces are not sorted so they form a single entry
+    lodCells(LodVolume::TYPE_TRANSLUCENT);
+    sortingMesh = SortingMeshData {{}};
+    if (indexCount) {
+        SortingMeshEntry entry {
+            glm::vec3(
+                chunk->x * CHUNK_W + CHUNK_W * 0.5f,
+                CHUNK_H * 0.5f,
+                chunk->z * CHUNK_D + CHUNK_D * 0.5f
+            ),
+            util::Buffer<ChunkVertex>(indexCount), 0};
+        for (int j = 0; j < indexCount; j++) {
+            ChunkVertex& vertex = entry.vertexData[j];
+            vertex = vertexBuffer[indexBuffer[j]];
+            vertex.position.x += chunk->x * CHUNK_W + 0.5f;
+            vertex.position.y += 0.5f;
+            vertex.position.z += chunk->z * CHUNK_D + 0.5f;
+        }
+        sortingMesh.entries.push_back(std::move(entry));
+    }
+
+    overflow = false;
+    vertexCount = 0;
+    vertexOffset = indexCount = 0;
+
+    lodCells(LodVolume::TYPE_OPAQUE);
+}
+
+void BlocksRenderer::build(const Chunk* chunk, const Chunks* chunks, int lod) {
     this->chunk = chunk;
+    this->lod = lod;
     voxelsBuffer->setPosition(
         chunk->x * CHUNK_W - voxelBufferPadding, 0,
         chunk->z * CHUNK_D - voxelBufferPadding);
@@ -646,6 +776,13 @@ void BlocksRenderer::build(const Chunk* chunk, const Chunks* chunks) {
         return;
     }
     const voxel* voxels = chunk->voxels;
+    visibility.build(voxels, opaqueBlocks);
+
+    if (lod > 1) {
+        cancelled = false;
+        renderLod();
+        return;
+    }
 
     int totalBegin = chunk->bottom * (CHUNK_W * CHUNK_D);
     int totalEnd = chunk->top * (CHUNK_W * CHUNK_D);
@@ -686,16 +823,20 @@ ChunkMeshData BlocksRenderer::createMesh() {
                 ChunkVertex::ATTRIBUTES, sizeof(ChunkVertex::ATTRIBUTES) / sizeof(VertexAttribute)
             )
         ),
-        std::move(sortingMesh)
+        std::move(sortingMesh),
+        visibility,
+        lod
     };
 }
 
-ChunkMesh BlocksRenderer::render(const Chunk *chunk, const Chunks *chunks) {
-    build(chunk, chunks);
+ChunkMesh BlocksRenderer::render(
+    const Chunk* chunk, const Chunks* chunks, int lod
+) {
+    build(chunk, chunks, lod);
 
     return ChunkMesh{std::make_unique<Mesh<ChunkVertex>>(
         vertexBuffer.get(), vertexCount, indexBuffer.get(), indexCount
-    ), std::move(sortingMesh)};
+    ), std::move(sortingMesh), nullptr, visibility, lod};
 }
 
 VoxelsVolume* BlocksRenderer::getVoxelsBuffer() const {
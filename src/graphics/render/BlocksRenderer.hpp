@@ -10,6 +10,7 @@
 #include "voxels/VoxelsVolume.hpp"
 #include "maths/util.hpp"
 #include "commons.hpp"
+#include "LodVolume.hpp"
 #include "settings.hpp"
 
 template<typename VertexStructure> class Mesh;
@@ -43,6 +44,13 @@ class BlocksRenderer {
     util::PseudoRandom randomizer;
 
     SortingMeshData sortingMesh;
+    ChunkVisibility visibility;
+    /// @brief Opaque flag of each block id used for visibility graph
+    std::vector<ubyte> opaqueBlocks;
+    /// @brief LodVolume block type of each block id
+    std::vector<ubyte> lodBlocks;
+    std::unique_ptr<LodVolume> lodVolume;
+    int lod = 1;
 
     void vertex(const glm::vec3& coord, float u, float v, const glm::vec4& light);
     void index(uint32_t a, uint32_t b, uint32_t c, uint32_t d, uint32_t e, uint32_t f);
@@ -142,6 +150,9 @@ class BlocksRenderer {
     
     void render(const voxel* voxels, int beginEnds[256][2]);
     SortingMeshData renderTranslucent(const voxel* voxels, int beginEnds[256][2]);
+
+    void renderLod();
+    void lodCells(ubyte type);
 public:
     BlocksRenderer(
         size_t capacity,
@@ -151,8 +162,10 @@ public:
     );
     virtual ~BlocksRenderer();
 
-    void build(const Chunk* chunk, const Chunks* chunks);
-    ChunkMesh render(const Chunk* chunk, const Chunks* chunks);
+    /// @param lod level of detail: 1 is full resolution, otherwise blocks
+    /// are downsampled to cells of lod^3 blocks (2, 4, 8, 16)
+    void build(const Chunk* chunk, const Chunks* chunks, int lod = 1);
+    ChunkMesh render(const Chunk* chunk, const Chunks* chunks, int lod = 1);
     ChunkMeshData createMesh();
     VoxelsVolume* getVoxelsBuffer() const;
 
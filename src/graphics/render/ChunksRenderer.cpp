@@ -1,6 +1,8 @@
 #include "ChunksRenderer.hpp"
 #include "BlocksRenderer.hpp"
 #include "debug/Logger.hpp"
+#include "debug/Metrics.hpp"
+#include "debug/Profiler.hpp"
 #include "assets/Assets.hpp"
 #include "graphics/core/Mesh.hpp"
 #include "graphics/core/Shader.hpp"
@@ -18,7 +20,7 @@ static debug::Logger logger("chunks-render");
 
 size_t ChunksRenderer::visibleChunks = 0;
 
-class RendererWorker : public util::Worker<std::shared_ptr<Chunk>, RendererResult> {
+class RendererWorker : public util::Worker<RendererJob, RendererResult> {
     const Chunks& chunks;
     BlocksRenderer renderer;
 public:
@@ -39,8 +41,10 @@ public:
           ) {
     }
 
-    RendererResult operator()(const std::shared_ptr<Chunk>& chunk) override {
-        renderer.build(chunk.get(), &chunks);
+    RendererResult operator()(const RendererJob& job) override {
+        PROFILE_ZONE("chunk mesh");
+        const auto& chunk = job.chunk;
+        renderer.build(chunk.get(), &chunks, job.lod);
         if (renderer.isCancelled()) {
             return RendererResult {
                 glm::ivec2(chunk->x, chunk->z), true, ChunkMeshData {}};
@@ -75,13 +79,25 @@ ChunksRenderer::ChunksRenderer(
                   auto meshData = std::move(result.meshData);
                   meshes[result.key] = ChunkMesh {
                       std::make_unique<Mesh<ChunkVertex>>(meshData.mesh),
-                      std::move(meshData.sortingMesh)};
+                      std::move(meshData.sortingMesh),
+                      nullptr,
+                      meshData.visibility,
+                      meshData.lod};
               }
               inwork.erase(result.key);
           },
           settings.graphics.chunkMaxRenderers.get()
       ) {
     threadPool.setStopOnFail(false);
+    queueMetric = debug::MetricsRegistry::global().addCallback(
+        "chunks_render_queue",
+        "Number of chunks waiting for or being meshed",
+        [this]() {
+            return static_cast<double>(
+                threadPool.getWorkTotal() - threadPool.getWorkDone()
+            );
+        }
+    );
     renderer = std::make_unique<BlocksRenderer>(
         settings.graphics.chunkMaxVertices.get(), 
         level->content, cache, settings
@@ -93,13 +109,17 @@ ChunksRenderer::~ChunksRenderer() {
 }
 
 const Mesh<ChunkVertex>* ChunksRenderer::render(
-    const std::shared_ptr<Chunk>& chunk, bool important
+    const std::shared_ptr<Chunk>& chunk, bool important, int lod
 ) {
     chunk->flags.modified = false;
     if (important) {
-        auto mesh = renderer->render(chunk.get(), &chunks);
+        auto mesh = renderer->render(chunk.get(), &chunks, lod);
         meshes[glm::ivec2(chunk->x, chunk->z)] = ChunkMesh {
-            std::move(mesh.mesh), std::move(mesh.sortingMeshData)
+            std::move(mesh.mesh),
+            std::move(mesh.sortingMeshData),
+            nullptr,
+            mesh.visibility,
+            mesh.lod
         };
         return meshes[glm::ivec2(chunk->x, chunk->z)].mesh.get();
     }
@@ -108,7 +128,7 @@ const Mesh<ChunkVertex>* ChunksRenderer::render(
         return nullptr;
     }
     inwork[key] = true;
-    threadPool.enqueueJob(chunk);
+    threadPool.enqueueJob(RendererJob {chunk, lod});
     return nullptr;
 }
 
@@ -126,18 +146,42 @@ void ChunksRenderer::clear() {
 }
 
 const Mesh<ChunkVertex>* ChunksRenderer::getOrRender(
-    const std::shared_ptr<Chunk>& chunk, bool important
+    const std::shared_ptr<Chunk>& chunk, bool important, int lod
 ) {
     auto found = meshes.find(glm::ivec2(chunk->x, chunk->z));
     if (found == meshes.end()) {
-        return render(chunk, important);
+        return render(chunk, important, lod);
     }
-    if (chunk->flags.modified && chunk->flags.lighted) {
-        render(chunk, important);
+    if ((chunk->flags.modified && chunk->flags.lighted) ||
+        found->second.lod != lod) {
+        // current mesh is drawn until the new one is ready
+        render(chunk, important, lod);
     }
     return found->second.mesh.get();
 }
 
+int ChunksRenderer::getLod(float distance, int current) const {
+    int lodDistance = settings.graphics.chunkLodDistance.get();
+    if (lodDistance == 0) {
+        return 1;
+    }
+    int lod = 1;
+    while (lod < MAX_LOD && distance >= lodDistance * lod) {
+        lod *= 2;
+    }
+    if (current == lod || current < 1 || current > MAX_LOD) {
+        return lod;
+    }
+    // range of the current level extended by the margin
+    float min = current == 1 ? 0.0f : lodDistance * current * 0.5f;
+    float max = lodDistance * current;
+    if (distance >= min - LOD_HYSTERESIS &&
+        (current == MAX_LOD || distance < max + LOD_HYSTERESIS)) {
+        return current;
+    }
+    return lod;
+}
+
 void ChunksRenderer::update() {
     threadPool.update();
 }
@@ -149,14 +193,15 @@ const Mesh<ChunkVertex>* ChunksRenderer::retrieveChunk(
     if (chunk == nullptr) {
         return nullptr;
     }
+    const auto& found = meshes.find({chunk->x, chunk->z});
     if (!chunk->flags.lighted) {
-        const auto& found = meshes.find({chunk->x, chunk->z});
         if (found == meshes.end()) {
             return nullptr;
         } else {
             return found->second.mesh.get();
         }
     }
+    int currentLod = found == meshes.end() ? 0 : found->second.lod;
     float distance = glm::distance(
         camera.position,
         glm::vec3(
@@ -165,7 +210,11 @@ const Mesh<ChunkVertex>* ChunksRenderer::retrieveChunk(
             (chunk->z + 0.5f) * CHUNK_D
         )
     );
-    auto mesh = getOrRender(chunk, distance < CHUNK_W * 1.5f);
+    auto mesh = getOrRender(
+        chunk,
+        distance < CHUNK_W * 1.5f,
+        getLod(distance / CHUNK_W, currentLod)
+    );
     if (mesh == nullptr) {
         return nullptr;
     }
@@ -212,6 +261,7 @@ void ChunksRenderer::drawChunks(
     util::insertion_sort(indices.begin(), indices.end());
 
     bool culling = settings.graphics.frustumCulling.get();
+    updateReachable(camera, culling);
 
     visibleChunks = 0;
     shader.uniform1i("u_alphaClip", true);
@@ -221,7 +271,7 @@ void ChunksRenderer::drawChunks(
         auto& chunk = chunks.getChunks()[indices[i].index];
         auto mesh = retrieveChunk(indices[i].index, camera, shader, culling);
 
-        if (mesh) {
+        if (mesh && isReachable(indices[i].index)) {
             glm::vec3 coord(
                 chunk->x * CHUNK_W + 0.5f, 0.5f, chunk->z * CHUNK_D + 0.5f
             );
@@ -233,6 +283,37 @@ void ChunksRenderer::drawChunks(
     }
 }
 
+void ChunksRenderer::updateReachable(const Camera& camera, bool culling) {
+    if (!settings.graphics.occlusionCulling.get()) {
+        reachable.clear();
+        return;
+    }
+    PROFILE_ZONE("visibility graph");
+    const auto& chunksList = chunks.getChunks();
+    chunksVisibility.resize(chunksList.size());
+    for (size_t i = 0; i < chunksList.size(); i++) {
+        const auto& chunk = chunksList[i];
+        // not loaded chunks and chunks without mesh are not blocking view
+        chunksVisibility[i] = nullptr;
+        if (chunk == nullptr) {
+            continue;
+        }
+        const auto& found = meshes.find(glm::ivec2(chunk->x, chunk->z));
+        if (found != meshes.end()) {
+            chunksVisibility[i] = &found->second.visibility;
+        }
+    }
+    visibilityGraph.findVisible(
+        chunksVisibility,
+        chunks.getWidth(),
+        chunks.getHeight(),
+        {chunks.getOffsetX(), chunks.getOffsetY()},
+        camera.position,
+        culling ? &frustum : nullptr,
+        reachable
+    );
+}
+
 static inline void write_sorting_mesh_entries(
     ChunkVertex* buffer, const std::vector<SortingMeshEntry>& chunkEntries
 ) {
@@ -264,7 +345,8 @@ void ChunksRenderer::drawSortedMeshes(const Camera& camera, Shader& shader) {
     
     for (const auto& index : indices) {
         const auto& chunk = chunks[index.index];
-        if (chunk == nullptr || !chunk->flags.lighted) {
+        if (chunk == nullptr || !chunk->flags.lighted ||
+            !isReachable(index.index)) {
             continue;
         }
         const auto& found = meshes.find(glm::ivec2(chunk->x, chunk->z));
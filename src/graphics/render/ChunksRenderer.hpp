@@ -9,6 +9,7 @@
 #include <glm/gtx/hash.hpp>
 
 #include "util/ThreadPool.hpp"
+#include "util/observer_handler.hpp"
 #include "commons.hpp"
 
 template<typename VertexStructure> class Mesh;
@@ -32,6 +33,11 @@ struct ChunksSortEntry {
     }
 };
 
+struct RendererJob {
+    std::shared_ptr<Chunk> chunk;
+    int lod;
+};
+
 struct RendererResult {
     glm::ivec2 key;
     bool cancelled;
@@ -48,7 +54,25 @@ class ChunksRenderer {
     std::unordered_map<glm::ivec2, ChunkMesh> meshes;
     std::unordered_map<glm::ivec2, bool> inwork;
     std::vector<ChunksSortEntry> indices;
-    util::ThreadPool<std::shared_ptr<Chunk>, RendererResult> threadPool;
+    util::ThreadPool<RendererJob, RendererResult> threadPool;
+    ObserverHandler queueMetric;
+
+    VisibilityGraph visibilityGraph;
+    std::vector<const ChunkVisibility*> chunksVisibility;
+    /// @brief Chunks reachable from the camera, empty if occlusion culling
+    /// is disabled
+    std::vector<ubyte> reachable;
+
+    void updateReachable(const Camera& camera, bool culling);
+    bool isReachable(size_t index) const {
+        return reachable.empty() || reachable[index];
+    }
+    /// @brief Get chunk mesh level of detail
+    /// @param distance horizontal distance to the chunk in chunks
+    /// @param current level of detail of the existing mesh (0 if none),
+    /// kept while the distance is near its range
+    int getLod(float distance, int current) const;
+
     const Mesh<ChunkVertex>* retrieveChunk(
         size_t index, const Camera& camera, Shader& shader, bool culling
     );
@@ -63,14 +87,22 @@ public:
     );
     virtual ~ChunksRenderer();
 
+    /// @brief Max level of detail (cell size in blocks)
+    static inline constexpr int MAX_LOD = 4;
+    /// @brief Distance margin (in chunks) of a level of detail range
+    /// preventing meshes rebuilding back and forth near the boundary
+    static inline constexpr float LOD_HYSTERESIS = 0.5f;
+
     const Mesh<ChunkVertex>* render(
-        const std::shared_ptr<Chunk>& chunk, bool important
+        const std::shared_ptr<Chunk>& chunk, bool important, int lod = 1
     );
     void unload(const Chunk* chunk);
     void clear();
 
+    /// @brief Get chunk mesh, request rebuilding if it's modified or has
+    /// other level of detail
     const Mesh<ChunkVertex>* getOrRender(
-        const std::shared_ptr<Chunk>& chunk, bool important
+        const std::shared_ptr<Chunk>& chunk, bool important, int lod = 1
     );
     void drawChunks(const Camera& camera, Shader& shader);
 
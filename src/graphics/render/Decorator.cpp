@@ -73,7 +73,7 @@ void Decorator::addParticles(const Block& def, const glm::ivec3& pos) {
             assets, def.particles->texture, ""
         );
         blockEmitters[pos] = renderer.particles->add(std::make_unique<Emitter>(
-            level,
+            &level,
             glm::vec3{pos.x + 0.5, pos.y + 0.5, pos.z + 0.5},
             *def.particles,
             treg.texture,
@@ -122,7 +122,7 @@ void Decorator::updateRandom(
             assets, "particles:rain_splash_0", ""
         );
         renderer.particles->add(std::make_unique<Emitter>(
-            level,
+            &level,
             glm::vec3 {
                 pos.x + random.randFloat(),
                 pos.y + 1.1,
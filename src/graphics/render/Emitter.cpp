@@ -1,5 +1,6 @@
 #include "Emitter.hpp"
 
+#include <cfloat>
 #include <glm/gtc/random.hpp>
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/norm.hpp>
@@ -10,7 +11,7 @@
 #include "world/Level.hpp"
 
 Emitter::Emitter(
-    const Level& level,
+    const Level* level,
     std::variant<glm::vec3, entityid_t> origin,
     ParticlesPreset preset,
     const Texture* texture,
@@ -19,19 +20,66 @@ Emitter::Emitter(
 )
     : level(level),
       origin(std::move(origin)),
-      prototype({this, 0, {}, preset.velocity, preset.lifetime, region, 0, 0}),
+      prototype({0, {}, preset.velocity, preset.lifetime, region, 0, 0}),
       texture(texture),
       count(count),
       preset(std::move(preset)) {
     random.setSeed(reinterpret_cast<ptrdiff_t>(this));
-    this->prototype.emitter = this;
     timer = preset.spawnInterval * random.randFloat();
 }
 
+void ParticlesBuffer::push(const Particle& particle) {
+    posX.push_back(particle.position.x);
+    posY.push_back(particle.position.y);
+    posZ.push_back(particle.position.z);
+    velX.push_back(particle.velocity.x);
+    velY.push_back(particle.velocity.y);
+    velZ.push_back(particle.velocity.z);
+    lifetime.push_back(particle.lifetime);
+    angle.push_back(particle.angle);
+    angularVelocity.push_back(particle.angularVelocity);
+    random.push_back(particle.random);
+    region.push_back(particle.region);
+    light.emplace_back(1.0f, 1.0f, 1.0f, 0.0f);
+}
+
+template <typename T>
+static inline void swap_remove(std::vector<T>& vec, size_t index) {
+    vec[index] = vec.back();
+    vec.pop_back();
+}
+
+void ParticlesBuffer::swapRemove(size_t index) {
+    swap_remove(posX, index);
+    swap_remove(posY, index);
+    swap_remove(posZ, index);
+    swap_remove(velX, index);
+    swap_remove(velY, index);
+    swap_remove(velZ, index);
+    swap_remove(lifetime, index);
+    swap_remove(angle, index);
+    swap_remove(angularVelocity, index);
+    swap_remove(random, index);
+    swap_remove(region, index);
+    swap_remove(light, index);
+}
+
 const Texture* Emitter::getTexture() const {
     return texture;
 }
 
+const UVRegion& Emitter::getRegion() const {
+    return prototype.region;
+}
+
+const std::vector<UVRegion>& Emitter::getFrames() const {
+    return frames;
+}
+
+void Emitter::setFrames(std::vector<UVRegion> frames) {
+    this->frames = std::move(frames);
+}
+
 static inline glm::vec3 generate_coord(ParticleSpawnShape shape) {
     switch (shape) {
         case ParticleSpawnShape::BALL:
@@ -45,11 +93,7 @@ static inline glm::vec3 generate_coord(ParticleSpawnShape shape) {
     }
 }
 
-void Emitter::update(
-    float delta,
-    const glm::vec3& cameraPosition,
-    std::vector<Particle>& particles
-) {
+void Emitter::update(float delta, const glm::vec3& cameraPosition) {
     const float spawnInterval = preset.spawnInterval;
     if (count == 0 || (count == -1 && spawnInterval < FLT_EPSILON)) {
         return;
@@ -58,7 +102,11 @@ void Emitter::update(
     if (auto staticPos = std::get_if<glm::vec3>(&origin)) {
         position = *staticPos;
     } else if (auto entityId = std::get_if<entityid_t>(&origin)) {
-        if (auto entity = level.entities->get(*entityId)) {
+        if (level == nullptr) {
+            stop();
+            return;
+        }
+        if (auto entity = level->entities->get(*entityId)) {
             position = entity->getTransform().pos;
         } else {
             stop();
@@ -86,7 +134,6 @@ void Emitter::update(
     while (count && timer > spawnInterval) {
         // spawn particle
         Particle particle = prototype;
-        particle.emitter = this;
         particle.random = random.rand32();
         if (glm::abs(preset.angleSpread) >= 0.005f) {
             particle.angle =
@@ -112,12 +159,11 @@ void Emitter::update(
                 random.randFloat()
             );
         }
-        particles.push_back(std::move(particle));
+        particles.push(particle);
         timer -= spawnInterval;
         if (count > 0) {
             count--;
         }
-        refCount++;
     }
 }
 
@@ -130,7 +176,7 @@ bool Emitter::isDead() const {
 }
 
 bool Emitter::isReferred() const {
-    return refCount > 0;
+    return !particles.empty();
 }
 
 const EmitterOrigin& Emitter::getOrigin() const {
@@ -14,9 +14,6 @@ class Level;
 class Emitter;
 
 struct Particle {
-    /// @brief Pointer used to access common behaviour.
-    /// Emitter must be utilized after all related particles despawn.
-    Emitter* emitter;
     /// @brief Some random integer for visuals configuration.
     int random;
     /// @brief Global position
@@ -33,12 +30,48 @@ struct Particle {
     float angularVelocity;
 };
 
+/// @brief Structure-of-arrays storage of particles spawned by an emitter.
+/// Integration loops over plain float arrays are vectorized by compiler.
+struct ParticlesBuffer {
+    std::vector<float> posX;
+    std::vector<float> posY;
+    std::vector<float> posZ;
+    std::vector<float> velX;
+    std::vector<float> velY;
+    std::vector<float> velZ;
+    std::vector<float> lifetime;
+    std::vector<float> angle;
+    std::vector<float> angularVelocity;
+    std::vector<int> random;
+    std::vector<UVRegion> region;
+    /// @brief Sampled light (output of the simulation)
+    std::vector<glm::vec4> light;
+
+    size_t size() const {
+        return posX.size();
+    }
+
+    bool empty() const {
+        return posX.empty();
+    }
+
+    glm::vec3 position(size_t index) const {
+        return {posX[index], posY[index], posZ[index]};
+    }
+
+    void push(const Particle& particle);
+
+    /// @brief Remove particle moving the last one to its place
+    void swapRemove(size_t index);
+};
+
 class Texture;
 
 using EmitterOrigin = std::variant<glm::vec3, entityid_t>;
 
 class Emitter {
-    const Level& level;
+    /// @brief Level used to resolve entity origin (may be null)
+    const Level* level;
     /// @brief Static position or entity
     EmitterOrigin origin;
     /// @brief Particle prototype
@@ -53,14 +86,18 @@ class Emitter {
     float timer = 0.0f;
 
     util::PseudoRandom random;
+    /// @brief Animation frames UV regions resolved from preset.frames
+    std::vector<UVRegion> frames;
 public:
-    /// @brief Number of references (alive particles)
-    int refCount = 0;
+    /// @brief Alive particles spawned by the emitter
+    ParticlesBuffer particles;
     /// @brief Particle settings
     ParticlesPreset preset;
 
+    /// @param level level used to resolve entity origin, may be null
+    /// if the origin is static
     Emitter(
-        const Level& level,
+        const Level* level,
         std::variant<glm::vec3, entityid_t> origin,
         ParticlesPreset preset,
         const Texture* texture,
@@ -73,15 +110,19 @@ public:
     /// @return Emitter particles texture
     const Texture* getTexture() const;
 
+    /// @return Base particles UV region
+    const UVRegion& getRegion() const;
+
+    /// @return Animation frames UV regions
+    const std::vector<UVRegion>& getFrames() const;
+
+    /// @brief Set animation frames UV regions (one per preset.frames entry)
+    void setFrames(std::vector<UVRegion> frames);
+
     /// @brief Update emitter and spawn particles
     /// @param delta delta time
     /// @param cameraPosition current camera global position
-    /// @param particles destination particles vector
-    void update(
-        float delta,
-        const glm::vec3& cameraPosition,
-        std::vector<Particle>& particles
-    );
+    void update(float delta, const glm::vec3& cameraPosition);
 
     /// @brief Set remaining particles count to 0
     void stop();
@@ -0,0 +1,162 @@
+#include "LodVolume.hpp"
+
+#include "voxels/VoxelsVolume.hpp"
+
+static constexpr int FACES = 6;
+
+static const glm::ivec3 FACE_DIRECTIONS[FACES] {
+    {1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}};
+
+/// @brief Check if the face of a cell of the type is visible through
+/// a block of the type
+static inline bool is_open_through(ubyte type, ubyte neighbour) {
+    if (type == LodVolume::TYPE_OPAQUE) {
+        return neighbour != LodVolume::TYPE_OPAQUE;
+    }
+    return neighbour == LodVolume::TYPE_NONE;
+}
+
+LodVolume::LodVolume(int lod)
+    : lod(lod),
+      width(CHUNK_W / lod),
+      height(CHUNK_H / lod),
+      depth(CHUNK_D / lod),
+      cells(width * height * depth) {
+}
+
+void LodVolume::getFaceSlice(
+    int x, int y, int z, int face, glm::ivec3& min, glm::ivec3& max
+) const {
+    const auto& dir = FACE_DIRECTIONS[face];
+    min = glm::ivec3(x, y, z) * lod;
+    max = min + lod;
+    for (int axis = 0; axis < 3; axis++) {
+        if (dir[axis] > 0) {
+            min[axis] = max[axis];
+            max[axis]++;
+        } else if (dir[axis] < 0) {
+            max[axis] = min[axis];
+            min[axis]--;
+        }
+    }
+}
+
+bool LodVolume::isSliceOpen(
+    const VoxelsVolume& volume,
+    const std::vector<ubyte>& types,
+    int x,
+    int y,
+    int z,
+    int face,
+    ubyte type
+) const {
+    glm::ivec3 min, max;
+    getFaceSlice(x, y, z, face, min, max);
+    for (int by = min.y; by < max.y; by++) {
+        for (int bz = min.z; bz < max.z; bz++) {
+            for (int bx = min.x; bx < max.x; bx++) {
+                blockid_t id =
+                    volume.pickBlockId(originX + bx, by, originZ + bz);
+                // not loaded blocks are considered closed
+                if (id == BLOCK_VOID) {
+                    continue;
+                }
+                if (is_open_through(type, types[id])) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+void LodVolume::build(
+    const VoxelsVolume& volume,
+    int originX,
+    int originZ,
+    const std::vector<ubyte>& types
+) {
+    this->originX = originX;
+    this->originZ = originZ;
+
+    for (int y = 0; y < height; y++) {
+        for (int z = 0; z < depth; z++) {
+            for (int x = 0; x < width; x++) {
+                Cell cell {};
+                // topmost blocks are most likely to be seen from far
+                for (int ly = lod - 1; ly >= 0 && cell.type != TYPE_OPAQUE;
+                     ly--) {
+                    for (int lz = 0; lz < lod; lz++) {
+                        for (int lx = 0; lx < lod; lx++) {
+                            blockid_t id = volume.pickBlockId(
+                                originX + x * lod + lx,
+                                y * lod + ly,
+                                originZ + z * lod + lz
+                            );
+                            if (id == BLOCK_VOID) {
+                                continue;
+                            }
+                            ubyte type = types[id];
+                            if (type == TYPE_OPAQUE &&
+                                cell.type != TYPE_OPAQUE) {
+                                cell.id = id;
+                                cell.type = TYPE_OPAQUE;
+                            } else if (type == TYPE_TRANSLUCENT &&
+                                       cell.type == TYPE_NONE) {
+                                cell.id = id;
+                                cell.type = TYPE_TRANSLUCENT;
+                            }
+                        }
+                    }
+                }
+                cells[(y * depth + z) * width + x] = cell;
+            }
+        }
+    }
+
+    for (int y = 0; y < height; y++) {
+        for (int z = 0; z < depth; z++) {
+            for (int x = 0; x < width; x++) {
+                auto& cell = cells[(y * depth + z) * width + x];
+                if (cell.type == TYPE_NONE) {
+                    continue;
+                }
+                for (int face = 0; face < FACES; face++) {
+                    glm::ivec3 pos =
+                        glm::ivec3(x, y, z) + FACE_DIRECTIONS[face];
+                    bool open;
+                    if (pos.y < 0) {
+                        open = false;
+                    } else if (pos.y >= height) {
+                        open = true;
+                    } else if (pos.x < 0 || pos.z < 0 || pos.x >= width ||
+                               pos.z >= depth) {
+                        open = isSliceOpen(
+                            volume, types, x, y, z, face, cell.type
+                        );
+                    } else {
+                        open = is_open_through(
+                            cell.type, get(pos.x, pos.y, pos.z).type
+                        );
+                    }
+                    if (open) {
+                        cell.openFaces |= 1 << face;
+                    }
+                }
+            }
+        }
+    }
+}
+
+size_t LodVolume::countFaces(ubyte type) const {
+    size_t count = 0;
+    for (const auto& cell : cells) {
+        if (cell.type != type) {
+            continue;
+        }
+        for (int face = 0; face < FACES; face++) {
+            count += (cell.openFaces >> face) & 1;
+        }
+    }
+    return count;
+}
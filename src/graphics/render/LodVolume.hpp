@@ -0,0 +1,95 @@
+#pragma once
+
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "constants.hpp"
+#include "typedefs.hpp"
+
+class VoxelsVolume;
+
+/// @brief Chunk voxels downsampled to cells of lod^3 blocks used to build
+/// simplified meshes of far chunks.
+/// Faces order: +X, -X, +Y, -Y, +Z, -Z
+class LodVolume {
+public:
+    /// @brief Block is not represented in downsampled volume
+    static inline constexpr ubyte TYPE_NONE = 0;
+    static inline constexpr ubyte TYPE_OPAQUE = 1;
+    static inline constexpr ubyte TYPE_TRANSLUCENT = 2;
+
+    struct Cell {
+        /// @brief Representative block (topmost opaque or translucent)
+        blockid_t id = 0;
+        ubyte type = TYPE_NONE;
+        /// @brief Mask of faces not covered by neighbours
+        ubyte openFaces = 0;
+    };
+private:
+    int lod;
+    int width;
+    int height;
+    int depth;
+    int originX = 0;
+    int originZ = 0;
+    std::vector<Cell> cells;
+
+    /// @brief Check if voxels layer behind the cell face has blocks
+    /// not covering the cell
+    bool isSliceOpen(
+        const VoxelsVolume& volume,
+        const std::vector<ubyte>& types,
+        int x,
+        int y,
+        int z,
+        int face,
+        ubyte type
+    ) const;
+public:
+    /// @param lod cell size in blocks (chunk dimensions must be divisible)
+    explicit LodVolume(int lod);
+
+    /// @brief Downsample chunk voxels and find open cells faces.
+    /// Faces on chunk borders are checked against the real neighbour voxels
+    /// so meshes of any level of detail leave no cracks between chunks
+    /// @param volume chunk voxels with at least one block padding
+    /// @param originX chunk first block x
+    /// @param originZ chunk first block z
+    /// @param types LodVolume block type of each block id
+    void build(
+        const VoxelsVolume& volume,
+        int originX,
+        int originZ,
+        const std::vector<ubyte>& types
+    );
+
+    const Cell& get(int x, int y, int z) const {
+        return cells[(y * depth + z) * width + x];
+    }
+
+    int getLod() const {
+        return lod;
+    }
+
+    int getWidth() const {
+        return width;
+    }
+
+    int getHeight() const {
+        return height;
+    }
+
+    int getDepth() const {
+        return depth;
+    }
+
+    /// @brief Get blocks layer behind the cell face
+    /// @param min first block of the layer (chunk local coordinates)
+    /// @param max layer end (exclusive)
+    void getFaceSlice(
+        int x, int y, int z, int face, glm::ivec3& min, glm::ivec3& max
+    ) const;
+
+    /// @brief Count open faces of cells of the type
+    size_t countFaces(ubyte type) const;
+};
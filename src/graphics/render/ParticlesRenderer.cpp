@@ -1,6 +1,6 @@
 #include "ParticlesRenderer.hpp"
 
-#include <set>
+#include <algorithm>
 
 #include "assets/Assets.hpp"
 #include "assets/assets_util.hpp"
@@ -10,6 +10,7 @@
 #include "world/Level.hpp"
 #include "voxels/Chunks.hpp"
 #include "MainBatch.hpp"
+#include "ParticlesSimulation.hpp"
 #include "settings.hpp"
 
 size_t ParticlesRenderer::visibleParticles = 0;
@@ -21,106 +22,45 @@ ParticlesRenderer::ParticlesRenderer(
     const Chunks& chunks,
     const GraphicsSettings* settings
 )
-    : chunks(chunks),
-      assets(assets),
+    : assets(assets),
       settings(settings),
+      simulation(std::make_unique<ParticlesSimulation>(chunks)),
       batch(std::make_unique<MainBatch>(4096)) {
 }
 
 ParticlesRenderer::~ParticlesRenderer() = default;
 
-static inline void update_particle(
-    Particle& particle, float delta, const Chunks& chunks
-) {
-    const auto& preset = particle.emitter->preset;
-    auto& pos = particle.position;
-    auto& vel = particle.velocity;
-    auto& angle = particle.angle;
-
-    vel += delta * preset.acceleration;
-    if (preset.collision && chunks.isObstacleAt(pos + vel * delta)) {
-        vel *= 0.0f;
-    }
-    pos += vel * delta;
-    angle += particle.angularVelocity * delta;
-    particle.lifetime -= delta;
-}
-
-void ParticlesRenderer::renderParticles(const Camera& camera, float delta) {
+void ParticlesRenderer::renderParticles(const Camera& camera) {
     const auto& right = camera.right;
     const auto& up = camera.up;
 
-    bool backlight = settings->backlight.get();
-
-    std::vector<const Texture*> unusedTextures;
-
-    for (auto& [texture, vec] : particles) {
-        if (vec.empty()) {
-            unusedTextures.push_back(texture);
-            continue;
+    std::vector<const Emitter*> sorted;
+    sorted.reserve(simulation->getEmitters().size());
+    for (const auto& [_, emitter] : simulation->getEmitters()) {
+        if (emitter->isReferred()) {
+            sorted.push_back(emitter.get());
         }
-        batch->setTexture(texture);
-
-        visibleParticles += vec.size();
-
-        auto iter = vec.begin();
-        while (iter != vec.end()) {
-            auto& particle = *iter;
-            auto& emitter = *particle.emitter;
-            auto& preset = emitter.preset;
-
-            if (!preset.frames.empty()) {
-                float time = preset.lifetime - particle.lifetime;
-                int framesCount = preset.frames.size();
-                int frameid = time / preset.lifetime * framesCount;
-                int frameid2 = glm::min(
-                    (time + delta) / preset.lifetime * framesCount,
-                    framesCount - 1.0f
-                );
-                if (frameid2 != frameid) {
-                    auto tregion = util::get_texture_region(
-                        assets, preset.frames.at(frameid2), ""
-                    );
-                    if (tregion.texture == texture) {
-                        particle.region = tregion.region;
-                    }
-                }
-            }
-            update_particle(particle, delta, chunks);
+    }
+    // group by texture to avoid batch flushes
+    std::sort(sorted.begin(), sorted.end(), [](auto a, auto b) {
+        return a->getTexture() < b->getTexture();
+    });
 
-            float scale = 1.0f + ((particle.random ^ 2628172) % 1000) *
-                0.001f * preset.sizeSpread;
+    for (const auto emitter : sorted) {
+        const auto& preset = emitter->preset;
+        const auto& particles = emitter->particles;
+        batch->setTexture(emitter->getTexture());
 
-            glm::vec4 light(1, 1, 1, 0);
-            if (preset.lighting) {
-                light = MainBatch::sampleLight(
-                    particle.position,
-                    chunks,
-                    backlight
-                );
-                auto size = glm::max(glm::vec3(0.5f), preset.size * scale);
-                for (int x = -1; x <= 1; x++) {
-                    for (int y = -1; y <= 1; y++) {
-                        for (int z = -1; z <= 1; z++) {
-                            light = glm::max(
-                                light,
-                                MainBatch::sampleLight(
-                                    particle.position -
-                                        size * glm::vec3(x, y, z),
-                                    chunks,
-                                    backlight
-                                )
-                            );
-                        }
-                    }
-                }
-                light *= 0.9f + (particle.random % 100) * 0.001f;
-            }
+        visibleParticles += particles.size();
 
+        glm::vec3 globalUp = preset.globalUpVector ? glm::vec3(0, 1, 0) : up;
+        for (size_t i = 0; i < particles.size(); i++) {
+            float scale = 1.0f + ((particles.random[i] ^ 2628172) % 1000) *
+                0.001f * preset.sizeSpread;
 
             glm::vec3 localRight = right;
-            glm::vec3 localUp = preset.globalUpVector ? glm::vec3(0, 1, 0) : up;
-            float angle = particle.angle;
+            glm::vec3 localUp = globalUp;
+            float angle = particles.angle[i];
             if (glm::abs(angle) >= 0.005f) {
                 glm::vec3 rotatedRight(glm::cos(angle), -glm::sin(angle), 0.0f);
                 glm::vec3 rotatedUp(glm::sin(angle), glm::cos(angle), 0.0f);
@@ -131,62 +71,47 @@ void ParticlesRenderer::renderParticles(const Camera& camera, float delta) {
                         camera.front * rotatedUp.z;
             }
             batch->quad(
-                particle.position,
+                particles.position(i),
                 localRight,
                 localUp,
                 preset.size * scale,
-                light,
+                preset.lighting ? particles.light[i] : glm::vec4(1, 1, 1, 0),
                 glm::vec3(1.0f),
-                particle.region
+                particles.region[i]
             );
-            if (particle.lifetime <= 0.0f) {
-                iter = vec.erase(iter);
-                emitter.refCount--;
-            } else {
-                iter++;
-            }
         }
     }
     batch->flush();
-    for (const auto& texture : unusedTextures) {
-        particles.erase(texture);
-    }
 }
 
 void ParticlesRenderer::render(const Camera& camera, float delta) {
     batch->begin();
-    
-    aliveEmitters = emitters.size();
-    visibleParticles = 0;
 
-    renderParticles(camera, delta);
+    simulation->update(delta, camera.position, settings->backlight.get());
 
-    auto iter = emitters.begin();
-    while (iter != emitters.end()) {
-        auto& emitter = *iter->second;
-        if (emitter.isDead() && !emitter.isReferred()) {
-            // destruct Emitter only when there is no particles spawned by it
-            iter = emitters.erase(iter);
-            continue;
-        }
-        auto texture = emitter.getTexture();
-        std::vector<Particle>* vec;
-        vec = &particles[texture];
-        emitter.update(delta, camera.position, *vec);
-        iter++;
-    }
+    aliveEmitters = simulation->getEmitters().size();
+    visibleParticles = 0;
+
+    renderParticles(camera);
 }
 
 Emitter* ParticlesRenderer::getEmitter(u64id_t id) const {
-    const auto& found = emitters.find(id);
-    if (found == emitters.end()) {
-        return nullptr;
-    }
-    return found->second.get();
+    return simulation->getEmitter(id);
 }
 
 u64id_t ParticlesRenderer::add(std::unique_ptr<Emitter> emitter) {
-    u64id_t uid = nextEmitter++;
-    emitters[uid] = std::move(emitter);
-    return uid;
+    const auto& names = emitter->preset.frames;
+    if (!names.empty()) {
+        std::vector<UVRegion> frames;
+        frames.reserve(names.size());
+        for (const auto& name : names) {
+            auto tregion = util::get_texture_region(assets, name, "");
+            frames.push_back(
+                tregion.texture == emitter->getTexture() ? tregion.region
+                                                         : emitter->getRegion()
+            );
+        }
+        emitter->setFrames(std::move(frames));
+    }
+    return simulation->add(std::move(emitter));
 }
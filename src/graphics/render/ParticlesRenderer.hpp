@@ -1,8 +1,6 @@
 #pragma once
 
-#include <vector>
 #include <memory>
-#include <unordered_map>
 
 #include "Emitter.hpp"
 #include "typedefs.hpp"
@@ -15,17 +13,16 @@ class MainBatch;
 class Level;
 struct GraphicsSettings;
 
+class ParticlesSimulation;
+
+/// @brief Renders particles simulated by ParticlesSimulation
 class ParticlesRenderer {
-    const Chunks& chunks;
     const Assets& assets;
     const GraphicsSettings* settings;
-    std::unordered_map<const Texture*, std::vector<Particle>> particles;
+    std::unique_ptr<ParticlesSimulation> simulation;
     std::unique_ptr<MainBatch> batch;
 
-    std::unordered_map<u64id_t, std::unique_ptr<Emitter>> emitters;
-    u64id_t nextEmitter = 1;
-
-    void renderParticles(const Camera& camera, float delta);
+    void renderParticles(const Camera& camera);
 public:
     ParticlesRenderer(
         const Assets& assets,
@@ -37,6 +34,7 @@ public:
 
     void render(const Camera& camera, float delta);
 
+    /// @brief Add emitter resolving its animation frames
     u64id_t add(std::unique_ptr<Emitter> emitter);
 
     /// @brief Get emitter by UID
@@ -0,0 +1,211 @@
+#include "ParticlesSimulation.hpp"
+
+#include "lighting/Lightmap.hpp"
+#include "voxels/Chunks.hpp"
+#include "constants.hpp"
+
+/// @brief Frame-local direct-mapped cache of voxel lights.
+/// Particles of an emitter are sampled in a small area, so most of 27
+/// samples per particle hit already fetched cells.
+class LightCache {
+    static constexpr int SIZE = 4096;
+
+    struct Entry {
+        glm::ivec3 pos;
+        uint32_t stamp;
+        light_t light;
+    };
+    const Chunks& chunks;
+    std::vector<Entry> entries;
+    uint32_t stamp = 1;
+public:
+    LightCache(const Chunks& chunks) : chunks(chunks), entries(SIZE) {
+    }
+
+    /// @brief Invalidate all cached values
+    void reset() {
+        if (++stamp == 0) {
+            std::fill(entries.begin(), entries.end(), Entry {});
+            stamp = 1;
+        }
+    }
+
+    light_t get(int x, int y, int z) {
+        uint32_t hash = (static_cast<uint32_t>(x) * 73856093u) ^
+                        (static_cast<uint32_t>(y) * 19349663u) ^
+                        (static_cast<uint32_t>(z) * 83492791u);
+        auto& entry = entries[hash % SIZE];
+        if (entry.stamp != stamp || entry.pos != glm::ivec3(x, y, z)) {
+            entry.pos = {x, y, z};
+            entry.stamp = stamp;
+            entry.light = chunks.getLight(x, y, z);
+        }
+        return entry.light;
+    }
+
+    light_t sample(const glm::vec3& pos) {
+        return get(
+            std::floor(pos.x),
+            std::floor(std::min(CHUNK_H - 1.0f, pos.y)),
+            std::floor(pos.z)
+        );
+    }
+};
+
+ParticlesSimulation::ParticlesSimulation(const Chunks& chunks)
+    : chunks(chunks), lightCache(std::make_unique<LightCache>(chunks)) {
+}
+
+ParticlesSimulation::~ParticlesSimulation() = default;
+
+static inline glm::vec4 sample_light(
+    LightCache& cache,
+    const glm::vec3& position,
+    const glm::vec3& size,
+    bool backlight
+) {
+    int channels[4] {};
+    for (int x = -1; x <= 1; x++) {
+        for (int y = -1; y <= 1; y++) {
+            for (int z = -1; z <= 1; z++) {
+                light_t light =
+                    cache.sample(position - size * glm::vec3(x, y, z));
+                for (int c = 0; c < 4; c++) {
+                    channels[c] = std::max(
+                        channels[c], static_cast<int>(Lightmap::extract(light, c))
+                    );
+                }
+            }
+        }
+    }
+    int minIntensity = backlight ? 1 : 0;
+    return glm::vec4(
+        std::max(channels[0], minIntensity),
+        std::max(channels[1], minIntensity),
+        std::max(channels[2], minIntensity),
+        std::max(channels[3], minIntensity)
+    ) / 15.0f;
+}
+
+void ParticlesSimulation::updateParticles(
+    Emitter& emitter, float delta, bool backlight
+) {
+    auto& particles = emitter.particles;
+    const auto& preset = emitter.preset;
+    size_t count = particles.size();
+    if (count == 0) {
+        return;
+    }
+
+    const auto& frames = emitter.getFrames();
+    if (!frames.empty()) {
+        int framesCount = frames.size();
+        for (size_t i = 0; i < count; i++) {
+            float time = preset.lifetime - particles.lifetime[i];
+            int frameid = time / preset.lifetime * framesCount;
+            int frameid2 = glm::min(
+                (time + delta) / preset.lifetime * framesCount,
+                framesCount - 1.0f
+            );
+            if (frameid2 != frameid) {
+                particles.region[i] = frames.at(frameid2);
+            }
+        }
+    }
+
+    float* velX = particles.velX.data();
+    float* velY = particles.velY.data();
+    float* velZ = particles.velZ.data();
+    const glm::vec3 acceleration = preset.acceleration * delta;
+    for (size_t i = 0; i < count; i++) {
+        velX[i] += acceleration.x;
+        velY[i] += acceleration.y;
+        velZ[i] += acceleration.z;
+    }
+    if (preset.collision) {
+        for (size_t i = 0; i < count; i++) {
+            glm::vec3 vel(velX[i], velY[i], velZ[i]);
+            if (chunks.isObstacleAt(particles.position(i) + vel * delta)) {
+                velX[i] = velY[i] = velZ[i] = 0.0f;
+            }
+        }
+    }
+    float* posX = particles.posX.data();
+    float* posY = particles.posY.data();
+    float* posZ = particles.posZ.data();
+    float* angle = particles.angle.data();
+    float* lifetime = particles.lifetime.data();
+    const float* angularVelocity = particles.angularVelocity.data();
+    for (size_t i = 0; i < count; i++) {
+        posX[i] += velX[i] * delta;
+        posY[i] += velY[i] * delta;
+        posZ[i] += velZ[i] * delta;
+        angle[i] += angularVelocity[i] * delta;
+        lifetime[i] -= delta;
+    }
+
+    if (preset.lighting) {
+        for (size_t i = 0; i < count; i++) {
+            int random = particles.random[i];
+            float scale = 1.0f + ((random ^ 2628172) % 1000) * 0.001f *
+                                     preset.sizeSpread;
+            auto size = glm::max(glm::vec3(0.5f), preset.size * scale);
+            particles.light[i] =
+                sample_light(*lightCache, particles.position(i), size, backlight) *
+                (0.9f + (random % 100) * 0.001f);
+        }
+    }
+}
+
+/// @brief Swap-remove particles expired on the previous update
+static void remove_expired(ParticlesBuffer& particles) {
+    for (size_t i = 0; i < particles.size();) {
+        if (particles.lifetime[i] <= 0.0f) {
+            particles.swapRemove(i);
+        } else {
+            i++;
+        }
+    }
+}
+
+void ParticlesSimulation::update(
+    float delta, const glm::vec3& cameraPosition, bool backlight
+) {
+    lightCache->reset();
+
+    auto iter = emitters.begin();
+    while (iter != emitters.end()) {
+        auto& emitter = *iter->second;
+        remove_expired(emitter.particles);
+        if (emitter.isDead() && !emitter.isReferred()) {
+            // destruct Emitter only when there is no particles spawned by it
+            iter = emitters.erase(iter);
+            continue;
+        }
+        emitter.update(delta, cameraPosition);
+        updateParticles(emitter, delta, backlight);
+        iter++;
+    }
+}
+
+u64id_t ParticlesSimulation::add(std::unique_ptr<Emitter> emitter) {
+    u64id_t uid = nextEmitter++;
+    emitters[uid] = std::move(emitter);
+    return uid;
+}
+
+Emitter* ParticlesSimulation::getEmitter(u64id_t id) const {
+    const auto& found = emitters.find(id);
+    if (found == emitters.end()) {
+        return nullptr;
+    }
+    return found->second.get();
+}
+
+size_t ParticlesSimulation::countParticles() const {
+    size_t count = 0;
+    for (const auto& [_, emitter] : emitters) {
+        count += emitter->particles.size();
+    }
+    return count;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <glm/glm.hpp>
+
+#include "Emitter.hpp"
+#include "typedefs.hpp"
+
+class Chunks;
+class LightCache;
+
+/// @brief Particles simulation independent of the rendering.
+/// Owns emitters and their particles, integrates movement, resolves
+/// animation frames and samples lighting for the renderer to consume.
+class ParticlesSimulation {
+    const Chunks& chunks;
+    std::unordered_map<u64id_t, std::unique_ptr<Emitter>> emitters;
+    u64id_t nextEmitter = 1;
+    std::unique_ptr<LightCache> lightCache;
+
+    void updateParticles(Emitter& emitter, float delta, bool backlight);
+public:
+    ParticlesSimulation(const Chunks& chunks);
+    ~ParticlesSimulation();
+
+    /// @brief Remove expired particles and emitters, spawn new particles
+    /// and integrate alive ones
+    /// @param delta delta time
+    /// @param cameraPosition current camera global position
+    /// @param backlight apply minimal light intensity
+    void update(float delta, const glm::vec3& cameraPosition, bool backlight);
+
+    u64id_t add(std::unique_ptr<Emitter> emitter);
+
+    /// @brief Get emitter by UID
+    /// @return Emitter or nullptr
+    Emitter* getEmitter(u64id_t id) const;
+
+    const std::unordered_map<u64id_t, std::unique_ptr<Emitter>>& getEmitters(
+    ) const {
+        return emitters;
+    }
+
+    /// @return Total number of alive particles
+    size_t countParticles() const;
+};
@@ -0,0 +1,176 @@
+#include "VisibilityGraph.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "maths/FrustumCulling.hpp"
+#include "maths/voxmaths.hpp"
+#include "voxels/voxel.hpp"
+
+static constexpr int FACES = 6;
+
+static const glm::ivec3 FACE_DIRECTIONS[FACES] {
+    {1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}};
+
+static inline int opposite(int face) {
+    return face ^ 1;
+}
+
+/// @brief Mask of section faces the cell is adjacent to
+static inline int border_faces(int x, int y, int z) {
+    constexpr int SECTION_H = ChunkVisibility::SECTION_H;
+    return (x == CHUNK_W - 1) | (x == 0) << 1 | (y == SECTION_H - 1) << 2 |
+           (y == 0) << 3 | (z == CHUNK_D - 1) << 4 | (z == 0) << 5;
+}
+
+/// @brief Connections of each pair of faces in the mask
+static inline uint64_t connect_faces(int faces) {
+    uint64_t connections = 0;
+    for (int face = 0; face < FACES; face++) {
+        if (faces & (1 << face)) {
+            connections |= static_cast<uint64_t>(faces) << (face * FACES);
+        }
+    }
+    return connections;
+}
+
+void ChunkVisibility::build(
+    const voxel* voxels, const std::vector<ubyte>& opaque
+) {
+    constexpr int SECTION_VOL = CHUNK_W * SECTION_H * CHUNK_D;
+
+    std::array<bool, SECTION_VOL> visited;
+    std::array<uint16_t, SECTION_VOL> stack;
+
+    for (int section = 0; section < SECTIONS; section++) {
+        const voxel* sectionVoxels = voxels + section * SECTION_VOL;
+        for (int i = 0; i < SECTION_VOL; i++) {
+            visited[i] = opaque[sectionVoxels[i].id];
+        }
+        uint64_t connections = 0;
+        for (int start = 0; start < SECTION_VOL; start++) {
+            if (visited[start]) {
+                continue;
+            }
+            // flood fill the open area collecting faces it touches
+            int faces = 0;
+            int stackSize = 0;
+            stack[stackSize++] = start;
+            visited[start] = true;
+            while (stackSize) {
+                int index = stack[--stackSize];
+                int x = index % CHUNK_W;
+                int z = index / CHUNK_W % CHUNK_D;
+                int y = index / (CHUNK_W * CHUNK_D);
+                faces |= border_faces(x, y, z);
+
+                for (const auto& dir : FACE_DIRECTIONS) {
+                    int nx = x + dir.x;
+                    int ny = y + dir.y;
+                    int nz = z + dir.z;
+                    if (nx < 0 || ny < 0 || nz < 0 || nx >= CHUNK_W ||
+                        ny >= SECTION_H || nz >= CHUNK_D) {
+                        continue;
+                    }
+                    int neighbour = vox_index(nx, ny, nz);
+                    if (!visited[neighbour]) {
+                        visited[neighbour] = true;
+                        stack[stackSize++] = neighbour;
+                    }
+                }
+            }
+            connections |= connect_faces(faces);
+        }
+        sections[section] = connections;
+    }
+}
+
+void VisibilityGraph::findVisible(
+    const std::vector<const ChunkVisibility*>& chunks,
+    int width,
+    int depth,
+    glm::ivec2 offset,
+    const glm::vec3& cameraPos,
+    const Frustum* frustum,
+    std::vector<ubyte>& visible
+) {
+    constexpr int SECTION_H = ChunkVisibility::SECTION_H;
+    constexpr int SECTIONS = ChunkVisibility::SECTIONS;
+
+    visible.assign(width * depth, false);
+
+    glm::ivec3 start(
+        floordiv<CHUNK_W>(static_cast<int>(std::floor(cameraPos.x))) -
+            offset.x,
+        floordiv<SECTION_H>(static_cast<int>(std::floor(cameraPos.y))),
+        floordiv<CHUNK_D>(static_cast<int>(std::floor(cameraPos.z))) - offset.y
+    );
+    if (start.x < 0 || start.z < 0 || start.x >= width || start.z >= depth ||
+        start.y < 0 || start.y >= SECTIONS) {
+        // camera is outside of the area
+        visible.assign(width * depth, true);
+        return;
+    }
+    auto is_inside = [=](const glm::ivec3& pos) {
+        return pos.x >= 0 && pos.y >= 0 && pos.z >= 0 && pos.x < width &&
+               pos.y < SECTIONS && pos.z < depth;
+    };
+    auto section_index = [=](const glm::ivec3& pos) {
+        return (pos.y * depth + pos.z) * width + pos.x;
+    };
+    auto is_in_frustum = [=](const glm::ivec3& pos) {
+        if (frustum == nullptr) {
+            return true;
+        }
+        glm::vec3 min(
+            (pos.x + offset.x) * CHUNK_W,
+            pos.y * SECTION_H,
+            (pos.z + offset.y) * CHUNK_D
+        );
+        return frustum->isBoxVisible(
+            min, min + glm::vec3(CHUNK_W, SECTION_H, CHUNK_D)
+        );
+    };
+
+    visited.assign(width * depth * SECTIONS, false);
+    queue.clear();
+
+    visited[section_index(start)] = true;
+    visible[start.z * width + start.x] = true;
+    for (int face = 0; face < FACES; face++) {
+        glm::ivec3 pos = start + FACE_DIRECTIONS[face];
+        if (is_inside(pos) && is_in_frustum(pos)) {
+            visited[section_index(pos)] = true;
+            queue.push_back(Node {pos, opposite(face), 1 << face});
+        }
+    }
+    for (size_t i = 0; i < queue.size(); i++) {
+        Node node = queue[i];
+        int chunkIndex = node.pos.z * width + node.pos.x;
+        visible[chunkIndex] = true;
+
+        const auto chunk = chunks[chunkIndex];
+        for (int face = 0; face < FACES; face++) {
+            // never go back towards the camera
+            if (face == node.entry ||
+                (node.directions & (1 << opposite(face)))) {
+                continue;
+            }
+            if (chunk && !chunk->isConnected(node.pos.y, node.entry, face)) {
+                continue;
+            }
+            glm::ivec3 pos = node.pos + FACE_DIRECTIONS[face];
+            if (!is_inside(pos)) {
+                continue;
+            }
+            auto& visitedFlag = visited[section_index(pos)];
+            if (visitedFlag || !is_in_frustum(pos)) {
+                continue;
+            }
+            visitedFlag = true;
+            queue.push_back(
+                Node {pos, opposite(face), node.directions | (1 << face)}
+            );
+        }
+    }
+}
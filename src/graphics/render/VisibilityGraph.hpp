@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "constants.hpp"
+#include "typedefs.hpp"
+
+struct voxel;
+class Frustum;
+
+/// @brief Which faces of each chunk vertical section are connected
+/// through non-opaque voxels. Faces order: +X, -X, +Y, -Y, +Z, -Z
+class ChunkVisibility {
+public:
+    static inline constexpr int SECTION_H = 16;
+    static inline constexpr int SECTIONS = CHUNK_H / SECTION_H;
+
+    /// @brief Faces connections bitmask (bit a * 6 + b) of each section.
+    /// All faces are connected by default
+    std::array<uint64_t, SECTIONS> sections;
+
+    ChunkVisibility() {
+        sections.fill(~0ULL);
+    }
+
+    bool isConnected(int section, int faceA, int faceB) const {
+        return (sections[section] >> (faceA * 6 + faceB)) & 1;
+    }
+
+    /// @brief Calculate sections connectivity by flood fill
+    /// @param voxels chunk voxels
+    /// @param opaque opaque flag of each block id
+    void build(const voxel* voxels, const std::vector<ubyte>& opaque);
+};
+
+/// @brief Chunk sections visibility graph traversal selecting chunks that
+/// may be seen from the camera section
+class VisibilityGraph {
+    struct Node {
+        glm::ivec3 pos;
+        /// @brief Face the section is entered through
+        int entry;
+        /// @brief Mask of traversal directions used to reach the section
+        int directions;
+    };
+    std::vector<ubyte> visited;
+    std::vector<Node> queue;
+public:
+    /// @brief Find chunks reachable from the camera section by breadth-first
+    /// search never going back towards the camera
+    /// @param chunks visibility of area chunks (index is x + z * width),
+    /// nullptr means the chunk is fully open
+    /// @param width area width in chunks
+    /// @param depth area depth in chunks
+    /// @param offset area position in chunks
+    /// @param cameraPos camera world position
+    /// @param frustum sections outside it are not traversed (nullable)
+    /// @param visible reachable flag of each area chunk
+    void findVisible(
+        const std::vector<const ChunkVisibility*>& chunks,
+        int width,
+        int depth,
+        glm::ivec2 offset,
+        const glm::vec3& cameraPos,
+        const Frustum* frustum,
+        std::vector<ubyte>& visible
+    );
+};
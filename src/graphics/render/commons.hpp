@@ -8,6 +8,7 @@
 
 #include "graphics/core/MeshData.hpp"
 #include "util/Buffer.hpp"
+#include "VisibilityGraph.hpp"
 
 /// @brief Chunk mesh vertex format
 struct ChunkVertex {
@@ -42,10 +43,15 @@ struct SortingMeshData {
 struct ChunkMeshData {
     MeshData<ChunkVertex> mesh;
     SortingMeshData sortingMesh;
+    ChunkVisibility visibility;
+    /// @brief Mesh level of detail (cell size in blocks)
+    int lod = 1;
 };
 
 struct ChunkMesh {
     std::unique_ptr<Mesh<ChunkVertex> > mesh;
     SortingMeshData sortingMeshData;
     std::unique_ptr<Mesh<ChunkVertex> > sortedMesh = nullptr;
+    ChunkVisibility visibility;
+    int lod = 1;
 };
@@ -1,5 +1,6 @@
 #include "Label.hpp"
 
+#include <algorithm>
 #include <utility>
 
 #include "assets/Assets.hpp"
@@ -28,61 +29,111 @@ size_t LabelCache::getTextLineOffset(size_t line) const {
 }
 
 uint LabelCache::getLineByTextIndex(size_t index) const {
-    for (size_t i = 0; i < lines.size(); i++) {
-        if (lines[i].offset > index) {
-            return i-1;
+    auto found = std::upper_bound(
+        lines.begin(),
+        lines.end(),
+        index,
+        [](size_t index, const LineScheme& line) {
+            return index < line.offset;
         }
+    );
+    return found - lines.begin() - 1;
+}
+
+void LabelCache::scanLines(
+    std::wstring_view text, size_t from, size_t to, std::vector<LineScheme>& dst
+) const {
+    size_t len = from == 0 ? 0 : 1;
+    for (size_t i = from; i < to; i++, len++) {
+        if (text[i] == L'\n') {
+            dst.push_back(LineScheme {i+1, false});
+            len = 0;
+        } else if (i > 0 && i+1 < text.length() && wrap && text[i+1] != L'\n') {
+            size_t width = font->calcWidth(text, i-len-1, i-(i-len)+2);
+            if (width >= wrapWidth) {
+                // starting a fake line
+                dst.push_back(LineScheme {i+1, true});
+                len = 0;
+            }
+        }
+    }
+}
+
+int LabelCache::calcLineWidth(std::wstring_view text, size_t line) const {
+    size_t offset = lines[line].offset;
+    if (line + 1 < lines.size()) {
+        return font->calcWidth(
+            text.substr(offset, lines[line + 1].offset - offset)
+        );
     }
-    return lines.size()-1;
+    return font->calcWidth(text.substr(offset));
 }
 
 void LabelCache::update(std::wstring_view text, bool multiline, bool wrap) {
     resetFlag = false;
     lines.clear();
     lines.push_back(LineScheme {0, false});
+    widths.clear();
 
     if (font == nullptr) {
         wrap = false;
     }
+    this->multiline = multiline;
+    this->wrap = wrap;
     
     if (multiline) {
-        size_t len = 0;
-        for (size_t i = 0; i < text.length(); i++, len++) {
-            if (text[i] == L'\n') {
-                lines.push_back(LineScheme {i+1, false});
-                len = 0;
-            } else if (i > 0 && i+1 < text.length() && wrap && text[i+1] != L'\n') {
-                size_t width = font->calcWidth(text, i-len-1, i-(i-len)+2);
-                if (width >= wrapWidth) {
-                    // starting a fake line
-                    lines.push_back(LineScheme {i+1, true});
-                    len = 0;
-                }
-            }
-        }
+        scanLines(text, 0, text.length(), lines);
         if (font != nullptr) {
-            int maxWidth = 0;
-            for (int i = 0; i < lines.size() - 1; i++) {
-                const auto& next = lines[i + 1];
-                const auto& cur = lines[i];
-                maxWidth = std::max(
-                    font->calcWidth(
-                        text.substr(cur.offset, next.offset - cur.offset)
-                    ),
-                    maxWidth
-                );
+            widths.resize(lines.size());
+            for (size_t i = 0; i < lines.size(); i++) {
+                widths[i] = calcLineWidth(text, i);
             }
-            maxWidth = std::max(
-                font->calcWidth(
-                    text.substr(lines[lines.size() - 1].offset)
-                ),
-                maxWidth
-            );
-            multilineWidth = maxWidth;
+            multilineWidth = *std::max_element(widths.begin(), widths.end());
         }
     }
 }
 
+void LabelCache::update(
+    std::wstring_view text, size_t start, size_t removed, size_t inserted
+) {
+    if (resetFlag || !multiline) {
+        return;
+    }
+    size_t removedEnd = start + removed;
+    // first edited non-fake line
+    size_t first = getLineByTextIndex(start);
+    while (first > 0 && lines[first].fake) {
+        first--;
+    }
+    // next non-fake line after the edit
+    size_t next = getLineByTextIndex(removedEnd) + 1;
+    while (next < lines.size() && lines[next].fake) {
+        next++;
+    }
+    for (size_t i = next; i < lines.size(); i++) {
+        lines[i].offset = lines[i].offset - removed + inserted;
+    }
+    size_t to = next < lines.size() ? lines[next].offset : text.length();
+
+    std::vector<LineScheme> edited {lines[first]};
+    scanLines(text, lines[first].offset, to, edited);
+    if (next < lines.size()) {
+        // line break before the next line is already there
+        edited.pop_back();
+    }
+    lines.erase(lines.begin() + first, lines.begin() + next);
+    lines.insert(lines.begin() + first, edited.begin(), edited.end());
+
+    if (font != nullptr) {
+        widths.erase(widths.begin() + first, widths.begin() + next);
+        widths.insert(widths.begin() + first, edited.size(), 0);
+        for (size_t i = first; i < first + edited.size(); i++) {
+            widths[i] = calcLineWidth(text, i);
+        }
+        multilineWidth = *std::max_element(widths.begin(), widths.end());
+    }
+}
+
 Label::Label(GUI& gui, const std::string& text, std::string fontName)
   : UINode(gui, glm::vec2(text.length() * 8, 16)),
     text(util::str2wstr_utf8(text)), 
@@ -129,11 +180,18 @@ void Label::setText(std::wstring text) {
         text = std::move(processedText);
         setStyles(std::move(styles));
     }
-    if (text == this->text && !cache.resetFlag) {
-        return;
+    if (cache.resetFlag) {
+        this->text = std::move(text);
+        cache.update(this->text, multiline, textWrap);
+    } else {
+        // update only edited lines
+        auto edit = util::find_edit(this->text, text);
+        if (edit.empty()) {
+            return;
+        }
+        this->text = std::move(text);
+        cache.update(this->text, edit.start, edit.removed, edit.inserted);
     }
-    this->text = std::move(text);
-    cache.update(this->text, multiline, textWrap);
 
     if (cache.font && autoresize) {
         setSize(calcSize());
@@ -308,6 +366,6 @@ const std::string& Label::getMarkup() const {
     return markup;
 }
 
-void Label::setStyles(std::unique_ptr<FontStylesScheme> styles) {
+void Label::setStyles(std::shared_ptr<FontStylesScheme> styles) {
     this->styles = std::move(styles);
 }
@@ -15,16 +15,43 @@ namespace gui {
     struct LabelCache {
         Font* font = nullptr;
         std::vector<LineScheme> lines;
+        /// @brief Width of each line (multiline mode only)
+        std::vector<int> widths;
         /// @brief Reset cache flag
         bool resetFlag = true;
         size_t wrapWidth = -1;
         int multilineWidth = 0;
+        bool multiline = false;
+        bool wrap = false;
     
         void prepare(Font* font, size_t wrapWidth);
         void update(std::wstring_view text, bool multiline, bool wrap);
 
+        /// @brief Update lines after an edit, re-scanning only the edited
+        /// lines. Does nothing if the cache needs reset
+        /// @param text text after the edit
+        /// @param start edit start index
+        /// @param removed number of removed characters
+        /// @param inserted number of inserted characters
+        void update(
+            std::wstring_view text,
+            size_t start,
+            size_t removed,
+            size_t inserted
+        );
+
         size_t getTextLineOffset(size_t line) const;
         uint getLineByTextIndex(size_t index) const;
+    private:
+        /// @brief Scan text part starting at a non-fake line start
+        void scanLines(
+            std::wstring_view text,
+            size_t from,
+            size_t to,
+            std::vector<LineScheme>& dst
+        ) const;
+
+        int calcLineWidth(std::wstring_view text, size_t line) const;
     };
 
     class Label : public UINode {
@@ -61,7 +88,7 @@ namespace gui {
         /// @brief Text markup language
         std::string markup;
 
-        std::unique_ptr<FontStylesScheme> styles;
+        std::shared_ptr<FontStylesScheme> styles;
     public:
         Label(GUI& gui, const std::string& text, std::string fontName="normal");
         Label(GUI& gui, const std::wstring& text, std::string fontName="normal");
@@ -124,6 +151,7 @@ namespace gui {
         virtual void setMarkup(std::string_view lang);
         virtual const std::string& getMarkup() const;
 
-        virtual void setStyles(std::unique_ptr<FontStylesScheme> styles);
+        /// @brief Set text styles. Scheme may be shared and updated in place
+        virtual void setStyles(std::shared_ptr<FontStylesScheme> styles);
     };
 }
@@ -369,14 +369,34 @@ void TextBox::drawBackground(const DrawContext& pctx, const Assets&) {
 
     batch->rect(pos.x, pos.y, size.x, size.y);
     if (!isFocused() && supplier) {
-        input = supplier();
+        setInput(supplier());
     }
     refreshLabel();
 }
 
+void TextBox::replaceInput(
+    size_t start, size_t length, std::wstring_view text
+) {
+    input.replace(start, length, text);
+    rawTextCache.update(input, start, length, text.length());
+    wrappedTextCache.update(input, start, length, text.length());
+}
+
+void TextBox::setInput(std::wstring text) {
+    auto edit = util::find_edit(input, text);
+    if (edit.empty()) {
+        return;
+    }
+    input = std::move(text);
+    rawTextCache.update(input, edit.start, edit.removed, edit.inserted);
+    wrappedTextCache.update(input, edit.start, edit.removed, edit.inserted);
+}
+
 void TextBox::refreshLabel() {
     rawTextCache.prepare(font, static_cast<size_t>(getSize().x));
-    rawTextCache.update(input, multiline, false);
+    if (rawTextCache.resetFlag || rawTextCache.multiline != multiline) {
+        rawTextCache.update(input, multiline, false);
+    }
 
     label->setColor(textColor * glm::vec4(input.empty() ? 0.5f : 1.0f));
 
@@ -450,13 +470,7 @@ void TextBox::paste(const std::wstring& text, bool history) {
         std::remove(inputText.begin(), inputText.end(), '\r'), inputText.end()
     );
     historian->onPaste(caret, inputText);
-    if (caret >= input.length()) {
-        input += inputText;
-    } else {
-        auto left = input.substr(0, caret);
-        auto right = input.substr(caret);
-        input = left + inputText + right;
-    }
+    replaceInput(std::min(caret, input.length()), 0, inputText);
     refreshLabel();
     setCaret(caret + inputText.length());
     if (validate()) {
@@ -468,13 +482,10 @@ void TextBox::paste(const std::wstring& text, bool history) {
 /// @param start start of the part
 /// @param length length of part that will be removed
 void TextBox::erase(size_t start, size_t length) {
-    size_t end = start + length;
     if (caret > start) {
         setCaret(caret - length);
     }
-    auto left = input.substr(0, start);
-    auto right = input.substr(end);
-    input = left + right;
+    replaceInput(start, length, L"");
 }
 
 /// @brief Remove all selected text and reset selection
@@ -811,12 +822,18 @@ void TextBox::stepDefaultUp(bool shiftPressed, bool breakSelection) {
 }
 
 void TextBox::refreshSyntax() {
-    if (!syntax.empty()) {
+    if (syntax.empty()) {
+        return;
+    }
+    if (highlighter == nullptr) {
         const auto& processor = gui.getEditor().getSyntaxProcessor();
-        if (auto styles = processor.highlight(syntax, input)) {
-            label->setStyles(std::move(styles));
+        highlighter = processor.createHighlighter(syntax);
+        if (highlighter == nullptr) {
+            return;
         }
     }
+    highlighter->update(input);
+    label->setStyles(highlighter->getStyles());
 }
 
 void TextBox::onInput() {
@@ -835,7 +852,7 @@ void TextBox::performEditingKeyboardEvents(Keycode key) {
                 caret = input.length();
             }
             historian->onErase(caret - 1, input.substr(caret - 1, 1));
-            input = input.substr(0, caret - 1) + input.substr(caret);
+            replaceInput(caret - 1, 1, L"");
             setCaret(caret - 1);
             if (validate()) {
                 onInput();
@@ -844,7 +861,7 @@ void TextBox::performEditingKeyboardEvents(Keycode key) {
     } else if (key == Keycode::DELETE) {
         if (!eraseSelected() && caret < input.length()) {
             historian->onErase(caret, input.substr(caret, 1));
-            input = input.substr(0, caret) + input.substr(caret + 1);
+            replaceInput(caret, 1, L"");
             if (validate()) {
                 onInput();
             }
@@ -1029,8 +1046,9 @@ const std::wstring& TextBox::getText() const {
 }
 
 void TextBox::setText(const std::wstring& value) {
-    this->input = value;
-    input.erase(std::remove(input.begin(), input.end(), '\r'), input.end());
+    auto text = value;
+    text.erase(std::remove(text.begin(), text.end(), '\r'), text.end());
+    setInput(std::move(text));
     historian->reset();
     history->clear();
     editedHistorySize = 0;
@@ -1070,12 +1088,16 @@ void TextBox::setCaret(size_t position) {
     }
     int width = label->getSize().x;
 
-    rawTextCache.prepare(font, width);
-    rawTextCache.update(input, multiline, label->isTextWrapping());
+    bool wrap = label->isTextWrapping();
+    wrappedTextCache.prepare(font, width);
+    if (wrappedTextCache.resetFlag || wrappedTextCache.multiline != multiline ||
+        wrappedTextCache.wrap != wrap) {
+        wrappedTextCache.update(input, multiline, wrap);
+    }
 
     caretLastMove = gui.getWindow().time();
 
-    uint line = rawTextCache.getLineByTextIndex(caret);
+    uint line = wrappedTextCache.getLineByTextIndex(caret);
     int offset = label->getLineYOffset(line) + getContentOffset().y;
     uint lineHeight = font->getLineHeight() * label->getLineInterval();
     if (scrollStep == 0) {
@@ -1087,7 +1109,7 @@ void TextBox::setCaret(size_t position) {
         offset -= getSize().y;
         scrolled(-glm::ceil(offset / static_cast<double>(scrollStep) + 0.5f));
     }
-    int lcaret = caret - rawTextCache.getTextLineOffset(line);
+    int lcaret = caret - wrappedTextCache.getTextLineOffset(line);
     int realoffset =
         font->calcWidth(labelText, lcaret) - static_cast<int>(textOffset) + 2;
 
@@ -1126,6 +1148,7 @@ bool TextBox::isShowLineNumbers() const {
 
 void TextBox::setSyntax(std::string_view lang) {
     syntax = lang;
+    highlighter.reset();
     if (syntax.empty()) {
         label->setStyles(nullptr);
     } else {
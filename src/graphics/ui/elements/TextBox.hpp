@@ -6,11 +6,18 @@
 class Font;
 class ActionsHistory;
 
+namespace devtools {
+    class SyntaxHighlighter;
+}
+
 namespace gui {
     class TextBoxHistorian;
     class TextBox : public Container {
         const Input& inputEvents;
+        /// @brief Input lines without wrapping
         LabelCache rawTextCache;
+        /// @brief Input lines wrapped as in the label
+        LabelCache wrappedTextCache;
         std::shared_ptr<ActionsHistory> history;
         std::unique_ptr<TextBoxHistorian> historian;
         int editedHistorySize = 0;
@@ -65,6 +72,7 @@ namespace gui {
         bool showLineNumbers = false;
         std::string markup;
         std::string syntax;
+        std::unique_ptr<devtools::SyntaxHighlighter> highlighter;
 
         void stepLeft(bool shiftPressed, bool breakSelection);
         void stepRight(bool shiftPressed, bool breakSelection);
@@ -91,6 +99,12 @@ namespace gui {
 
         void refreshLabel();
 
+        /// @brief Replace part of the input updating lines caches
+        void replaceInput(size_t start, size_t length, std::wstring_view text);
+
+        /// @brief Set input updating only the changed lines in caches
+        void setInput(std::wstring text);
+
         void onInput();
 
         void refreshSyntax();
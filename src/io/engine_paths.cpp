@@ -55,6 +55,7 @@ void EnginePaths::prepare() {
     io::create_subdevice("core", "res", "");
     io::create_subdevice("export", "user", "export");
     io::create_subdevice("config", "user", "config");
+    io::create_subdevice("cache", "user", "cache");
 }
 
 const std::filesystem::path& EnginePaths::getUserFilesFolder() const {
@@ -255,6 +255,12 @@ bool io::remove(const io::path& file) {
     return device.remove(file.pathPart());
 }
 
+bool io::rename(const io::path& src, const io::path& dst) {
+    std::error_code ec;
+    std::filesystem::rename(io::resolve(src), io::resolve(dst), ec);
+    return !ec;
+}
+
 uint64_t io::remove_all(const io::path& file) {
     auto& device = io::require_device(file.entryPoint());
     return device.removeAll(file.pathPart());
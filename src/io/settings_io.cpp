@@ -70,18 +70,43 @@ SettingsHandler::SettingsHandler(EngineSettings& settings) {
     builder.add("dense-render", &settings.graphics.denseRender);
     builder.add("gamma", &settings.graphics.gamma);
     builder.add("frustum-culling", &settings.graphics.frustumCulling);
+    builder.add("occlusion-culling", &settings.graphics.occlusionCulling);
     builder.add("skybox-resolution", &settings.graphics.skyboxResolution);
     builder.add("chunk-max-vertices", &settings.graphics.chunkMaxVertices);
     builder.add("chunk-max-vertices-dense", &settings.graphics.chunkMaxVerticesDense);
     builder.add("chunk-max-renderers", &settings.graphics.chunkMaxRenderers);
+    builder.add("chunk-lod-distance", &settings.graphics.chunkLodDistance);
 
     builder.section("ui");
     builder.add("language", &settings.ui.language);
     builder.add("world-preview-size", &settings.ui.worldPreviewSize);
 
+    builder.section("storage");
+    builder.add("voxels-compression", &settings.storage.voxelsCompression);
+    builder.add("lights-compression", &settings.storage.lightsCompression);
+    builder.add(
+        "inventories-compression", &settings.storage.inventoriesCompression
+    );
+    builder.add("entities-compression", &settings.storage.entitiesCompression);
+    builder.add(
+        "blocks-data-compression", &settings.storage.blocksDataCompression
+    );
+
+    builder.section("network");
+    builder.add("io-threads", &settings.network.ioThreads);
+    builder.add("write-queue-size", &settings.network.writeQueueSize);
+    builder.add("read-buffer-size", &settings.network.readBufferSize);
+
+    builder.section("metrics");
+    builder.add("export-file", &settings.metrics.exportFile);
+    builder.add("export-interval", &settings.metrics.exportInterval);
+    builder.add("export-format", &settings.metrics.exportFormat);
+
     builder.section("debug");
     builder.add("generator-test-mode", &settings.debug.generatorTestMode);
     builder.add("do-write-lights", &settings.debug.doWriteLights);
+    builder.add("log-file-level", &settings.debug.logFileLevel);
+    builder.add("log-console-level", &settings.debug.logConsoleLevel);
 }
 
 dv::value SettingsHandler::getValue(const std::string& name) const {
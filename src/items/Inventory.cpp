@@ -1,5 +1,6 @@
 #include "Inventory.hpp"
 
+#include "coders/binary_json.hpp"
 #include "content/ContentReport.hpp"
 
 Inventory::Inventory(int64_t id, size_t size) : id(id), slots(size) {
@@ -81,6 +82,49 @@ void Inventory::deserialize(const dv::value& src) {
     }
 }
 
+static ItemStack read_item_stack(json::BinaryReader& reader) {
+    itemid_t id = 0;
+    itemcount_t count = 0;
+    dv::value fields = nullptr;
+
+    std::string_view key;
+    reader.beginObject();
+    while (reader.nextKey(key)) {
+        if (key == "id") {
+            id = reader.readInteger();
+        } else if (key == "count") {
+            count = reader.readInteger();
+        } else if (key == "fields") {
+            fields = reader.readValue();
+        } else {
+            reader.skip();
+        }
+    }
+    return ItemStack(id, count, std::move(fields));
+}
+
+void Inventory::deserialize(json::BinaryReader& reader) {
+    id = 1;
+    std::string_view key;
+    reader.beginObject();
+    while (reader.nextKey(key)) {
+        if (key == "id") {
+            id = reader.readInteger();
+        } else if (key == "slots") {
+            size_t index = 0;
+            reader.beginList();
+            while (reader.nextElement()) {
+                if (index == slots.size()) {
+                    slots.emplace_back();
+                }
+                slots[index++].set(read_item_stack(reader));
+            }
+        } else {
+            reader.skip();
+        }
+    }
+}
+
 dv::value Inventory::serialize() const {
     auto map = dv::object();
     map["id"] = id;
@@ -104,12 +148,17 @@ dv::value Inventory::serialize() const {
     return map;
 }
 
-void Inventory::convert(const ContentReport* report) {
+bool Inventory::convert(const ContentReport* report) {
+    bool modified = false;
     for (auto& slot : slots) {
         itemid_t id = slot.getItemId();
         itemid_t replacement = report->items.getId(id);
-        slot.set(ItemStack(replacement, slot.getCount()));
+        if (replacement != id) {
+            slot.set(ItemStack(replacement, slot.getCount()));
+            modified = true;
+        }
     }
+    return modified;
 }
 
 void Inventory::convert(dv::value& data, const ContentReport* report) {
@@ -10,6 +10,10 @@
 class ContentReport;
 class ContentIndices;
 
+namespace json {
+    class BinaryReader;
+}
+
 class Inventory : public Serializable {
     int64_t id;
     std::vector<ItemStack> slots;
@@ -37,9 +41,13 @@ public:
 
     void deserialize(const dv::value& src) override;
 
+    /// @brief Decode inventory directly from BJSON document
+    void deserialize(json::BinaryReader& reader);
+
     dv::value serialize() const override;
 
-    void convert(const ContentReport* report);
+    /// @return true if any item id is changed
+    bool convert(const ContentReport* report);
     static void convert(dv::value& data, const ContentReport* report);
 
     size_t size() const {
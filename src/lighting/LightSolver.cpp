@@ -56,6 +56,9 @@ void LightSolver::solve(){
             1, 0, 0,
            -1, 0, 0
     };
+    // add entries pushed while removing may be darkened later by the
+    // removal of another source, so they are checked before spreading
+    bool checkStale = !remqueue.empty();
 
     while (!remqueue.empty()){
         const lightentry entry = remqueue.front();
@@ -98,6 +101,10 @@ void LightSolver::solve(){
         const lightentry entry = addqueue.front();
         addqueue.pop();
 
+        if (checkStale &&
+            chunks.getLight(entry.x, entry.y, entry.z, channel) != entry.light) {
+            continue;
+        }
         for (int i = 0; i < 6; i++) {
             int imul3 = i*3;
             int x = entry.x+coords[imul3];
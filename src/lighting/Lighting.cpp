@@ -2,6 +2,7 @@
 #include "LightSolver.hpp"
 #include "Lightmap.hpp"
 #include "content/Content.hpp"
+#include "debug/Profiler.hpp"
 #include "voxels/Chunks.hpp"
 #include "voxels/Chunk.hpp"
 #include "voxels/voxel.hpp"
@@ -95,6 +96,7 @@ void Lighting::buildSkyLight(int cx, int cz){
 
 
 void Lighting::onChunkLoaded(int cx, int cz, bool expand) {
+    PROFILE_ZONE("Lighting::onChunkLoaded");
     auto& solverR = *this->solverR;
     auto& solverG = *this->solverG;
     auto& solverB = *this->solverB;
@@ -213,3 +215,75 @@ void Lighting::onBlockSet(int x, int y, int z, blockid_t id){
         }
     }
 }
+
+void Lighting::onBlocksSet(const std::vector<glm::ivec3>& positions) {
+    const auto& blocks = content.getIndices()->blocks;
+    LightSolver* solvers[] {
+        solverR.get(), solverG.get(), solverB.get(), solverS.get()
+    };
+
+    for (const auto& pos : positions) {
+        voxel* vox = chunks.get(pos.x, pos.y, pos.z);
+        if (vox == nullptr) {
+            continue;
+        }
+        solverR->remove(pos.x, pos.y, pos.z);
+        solverG->remove(pos.x, pos.y, pos.z);
+        solverB->remove(pos.x, pos.y, pos.z);
+        if (blocks.require(vox->id).skyLightPassing) {
+            continue;
+        }
+        solverS->remove(pos.x, pos.y, pos.z);
+        for (int y = pos.y - 1; y >= 0; y--) {
+            solverS->remove(pos.x, y, pos.z);
+            voxel* below = chunks.get(pos.x, y - 1, pos.z);
+            if (below == nullptr || below->id != 0) {
+                break;
+            }
+        }
+    }
+    for (auto solver : solvers) {
+        solver->solve();
+    }
+
+    for (const auto& pos : positions) {
+        voxel* vox = chunks.get(pos.x, pos.y, pos.z);
+        if (vox == nullptr) {
+            continue;
+        }
+        int x = pos.x;
+        int y = pos.y;
+        int z = pos.z;
+        const auto& block = blocks.require(vox->id);
+        if (block.lightPassing) {
+            for (auto solver : solvers) {
+                solver->add(x, y + 1, z);
+                solver->add(x, y - 1, z);
+                solver->add(x + 1, y, z);
+                solver->add(x - 1, y, z);
+                solver->add(x, y, z + 1);
+                solver->add(x, y, z - 1);
+            }
+        }
+        // columns already lit from a changed voxel above are skipped
+        if (block.skyLightPassing && chunks.getLight(x, y, z, 3) != 0xF &&
+            (y + 1 == CHUNK_H || chunks.getLight(x, y + 1, z, 3) == 0xF)) {
+            for (int i = y; i >= 0; i--) {
+                voxel* column = chunks.get(x, i, z);
+                if (column == nullptr ||
+                    !blocks.require(column->id).skyLightPassing) {
+                    break;
+                }
+                solverS->add(x, i, z, 0xF);
+            }
+        }
+        if (block.rt.emissive) {
+            solverR->add(x, y, z, block.emission[0]);
+            solverG->add(x, y, z, block.emission[1]);
+            solverB->add(x, y, z, block.emission[2]);
+        }
+    }
+    for (auto solver : solvers) {
+        solver->solve();
+    }
+}
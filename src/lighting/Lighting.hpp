@@ -2,6 +2,9 @@
 
 #include "typedefs.hpp"
 
+#include <vector>
+#include <glm/glm.hpp>
+
 class Content;
 class ContentIndices;
 class Chunk;
@@ -24,5 +27,10 @@ public:
     void onChunkLoaded(int cx, int cz, bool expand);
     void onBlockSet(int x, int y, int z, blockid_t id);
 
+    /// @brief Update lights after bulk blocks change. Unlike per-block
+    /// onBlockSet, every solver runs only twice for the whole set
+    /// @param positions positions of the changed voxels
+    void onBlocksSet(const std::vector<glm::ivec3>& positions);
+
     static void prebuildSkyLight(Chunk& chunk, const ContentIndices& indices);
 };
@@ -1,8 +1,10 @@
 #include "BlocksController.hpp"
 
 #include <set>
+#include <algorithm>
 
 #include "content/Content.hpp"
+#include "debug/Profiler.hpp"
 #include "items/Inventories.hpp"
 #include "items/Inventory.hpp"
 #include "lighting/Lighting.hpp"
@@ -60,6 +62,37 @@ void BlocksController::updateSides(int x, int y, int z, int w, int h, int d) {
     }
 }
 
+void BlocksController::onBlocksSet(
+    const std::vector<glm::ivec3>& changed, bool updateNeighbours
+) {
+    if (lighting) {
+        lighting->onBlocksSet(changed);
+    }
+    if (!updateNeighbours) {
+        return;
+    }
+    const glm::ivec3 offsets[] {
+        {-1, 0, 0}, {1, 0, 0}, {0, -1, 0}, {0, 1, 0}, {0, 0, -1}, {0, 0, 1}
+    };
+    std::vector<glm::ivec3> targets;
+    targets.reserve(changed.size() * 6);
+    for (const auto& pos : changed) {
+        for (const auto& offset : offsets) {
+            targets.push_back(pos + offset);
+        }
+    }
+    auto less = [](const glm::ivec3& a, const glm::ivec3& b) {
+        if (a.y != b.y) return a.y < b.y;
+        if (a.z != b.z) return a.z < b.z;
+        return a.x < b.x;
+    };
+    std::sort(targets.begin(), targets.end(), less);
+    targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+    for (const auto& pos : targets) {
+        updateBlock(pos.x, pos.y, pos.z);
+    }
+}
+
 void BlocksController::breakBlock(
     Player* player, const Block& def, int x, int y, int z
 ) {
@@ -120,6 +153,7 @@ void BlocksController::updateBlock(int x, int y, int z) {
 }
 
 void BlocksController::update(float delta, uint padding) {
+    PROFILE_ZONE("BlocksController::update");
     if (randTickClock.update(delta)) {
         randomTick(randTickClock.getPart(), randTickClock.getParts(), padding);
     }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <functional>
+#include <vector>
 #include <glm/glm.hpp>
 
 #include "maths/fastmaths.hpp"
@@ -40,6 +41,14 @@ public:
     void updateSides(int x, int y, int z, int w, int h, int d);
     void updateBlock(int x, int y, int z);
 
+    /// @brief Finish bulk blocks change (see blocks_agent::fill, paste,
+    /// set_many): solve lights once and update every neighbour block once
+    /// @param changed positions of the changed voxels
+    /// @param updateNeighbours update blocks around the changed voxels
+    void onBlocksSet(
+        const std::vector<glm::ivec3>& changed, bool updateNeighbours
+    );
+
     void breakBlock(Player* player, const Block& def, int x, int y, int z);
     void placeBlock(
         Player* player, const Block& def, blockstate state, int x, int y, int z
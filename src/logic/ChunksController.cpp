@@ -4,6 +4,8 @@
 #include <memory>
 
 #include "content/Content.hpp"
+#include "debug/Metrics.hpp"
+#include "debug/Profiler.hpp"
 #include "world/files/WorldFiles.hpp"
 #include "graphics/core/Mesh.hpp"
 #include "lighting/Lighting.hpp"
@@ -34,6 +36,7 @@ ChunksController::~ChunksController() = default;
 void ChunksController::update(
     int64_t maxDuration, int loadDistance, uint padding, Player& player
 ) const {
+    PROFILE_ZONE("ChunksController::update");
     const auto& position = player.getPosition();
     int centerX = floordiv<CHUNK_W>(glm::floor(position.x));
     int centerY = floordiv<CHUNK_D>(glm::floor(position.z));
@@ -106,6 +109,7 @@ bool ChunksController::loadVisible(const Player& player, uint padding) const {
 bool ChunksController::buildLights(
     const Player& player, const std::shared_ptr<Chunk>& chunk
 ) const {
+    PROFILE_ZONE("chunk light");
     int surrounding = 0;
     for (int oz = -1; oz <= 1; oz++) {
         for (int ox = -1; ox <= 1; ox++) {
@@ -128,6 +132,7 @@ bool ChunksController::buildLights(
 }
 
 void ChunksController::createChunk(const Player& player, int x, int z) const {
+    PROFILE_ZONE("chunk load");
     if (!player.isLoadingChunks()) {
         if (auto chunk = level.chunks->fetch(x, z)) {
             player.chunks->putChunk(chunk);
@@ -139,7 +144,11 @@ void ChunksController::createChunk(const Player& player, int x, int z) const {
     auto& chunkFlags = chunk->flags;
 
     if (!chunkFlags.loaded) {
+        static auto& generated = debug::MetricsRegistry::global().counter(
+            "chunks_generated_total", "Number of generated chunks"
+        );
         generator->generate(chunk->voxels, x, z);
+        generated.add();
         chunkFlags.unsaved = true;
     }
     chunk->updateHeights();
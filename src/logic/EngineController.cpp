@@ -12,6 +12,7 @@
 #include "content/ContentControl.hpp"
 #include "content/PacksManager.hpp"
 #include "world/files/WorldConverter.hpp"
+#include "world/files/WorldRecompressor.hpp"
 #include "world/files/WorldFiles.hpp"
 #include "frontend/locale.hpp"
 #include "frontend/menu.hpp"
@@ -124,6 +125,32 @@ static void start(Engine& engine, std::shared_ptr<Task> task, const std::wstring
     }
 }
 
+void EngineController::recompressWorld(
+    const std::string& name, bool trainDictionary
+) {
+    io::path folder = engine.getPaths().getWorldFolderByName(name);
+    if (!io::is_directory(folder)) {
+        throw std::runtime_error("world '" + name + "' does not exist");
+    }
+    auto worldFiles = std::make_shared<WorldFiles>(
+        folder, engine.getSettings()
+    );
+    auto recompressor = std::make_shared<WorldRecompressor>(
+        std::move(worldFiles), trainDictionary
+    );
+    recompressor->setOnComplete([this]() {
+        if (engine.isHeadless()) {
+            return;
+        }
+        engine.postRunnable([this]() {
+            auto menu = engine.getGUI().getMenu();
+            menu->reset();
+            menu->setPage("main");
+        });
+    });
+    start(engine, std::move(recompressor), L"Recompressing world...");
+}
+
 static void check_world(const EnginePaths& paths, const io::path& folder) {
     auto worldFile = folder / "world.json";
     if (!io::exists(worldFile)) {
@@ -221,11 +248,12 @@ static void confirm(
 
 void EngineController::openWorld(const std::string& name, bool confirmConvert) {
     const auto& paths = engine.getPaths();
-    auto& debugSettings = engine.getSettings().debug;
     auto folder = paths.getWorldsFolder() / name;
 
     auto content = load_world_content(engine, folder);
-    auto worldFiles = std::make_shared<WorldFiles>(folder, debugSettings);
+    auto worldFiles = std::make_shared<WorldFiles>(
+        folder, engine.getSettings()
+    );
     auto report = World::checkIndices(worldFiles, content);
     
     if (report == nullptr) {
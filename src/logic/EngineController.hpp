@@ -26,6 +26,11 @@ public:
     /// @param name world name
     void deleteWorld(const std::string& name);
 
+    /// @brief Rewrite world region files using compression from settings
+    /// @param name world name
+    /// @param trainDictionary train zstd dictionaries for zstd layers
+    void recompressWorld(const std::string& name, bool trainDictionary);
+
     void reconfigPacks(
         LevelController* controller,
         const std::vector<std::string>& packsToAdd,
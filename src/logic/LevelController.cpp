@@ -1,13 +1,17 @@
 #include "LevelController.hpp"
 
 #include <algorithm>
+#include <chrono>
 
 #include "debug/Logger.hpp"
+#include "debug/Metrics.hpp"
+#include "debug/Profiler.hpp"
 #include "engine/Engine.hpp"
 #include "world/files/WorldFiles.hpp"
 #include "maths/voxmaths.hpp"
 #include "objects/Entities.hpp"
 #include "objects/Players.hpp"
+#include "voxels/GlobalChunks.hpp"
 #include "objects/Player.hpp"
 #include "physics/Hitbox.hpp"
 #include "voxels/Chunks.hpp"
@@ -26,8 +30,14 @@ LevelController::LevelController(
     : settings(engine->getSettings()),
       level(std::move(levelPtr)),
       chunks(std::make_unique<ChunksController>(*level)),
-      playerTickClock(20, 3) {
-    
+      playerTickClock(20, 3),
+      updateTime(debug::MetricsRegistry::global().histogram(
+          "level_update_seconds",
+          "Level update duration",
+          debug::metrics::duration_bounds()
+      )) {
+    registerMetrics();
+
     level->events->listen(LevelEventType::CHUNK_PRESENT, [](auto, Chunk* chunk) {
         scripting::on_chunk_present(*chunk, chunk->flags.loaded);
     });
@@ -68,7 +78,40 @@ LevelController::LevelController(
     } while (confirmed < level->players->size());
 }
 
+void LevelController::registerMetrics() {
+    auto& registry = debug::MetricsRegistry::global();
+    metrics.push_back(registry.addCallback(
+        "level_chunks", "Number of loaded chunks", [this]() {
+            return static_cast<double>(level->chunks->size());
+        }
+    ));
+    metrics.push_back(registry.addCallback(
+        "level_entities", "Number of entities", [this]() {
+            return static_cast<double>(level->entities->size());
+        }
+    ));
+    metrics.push_back(registry.addCallback(
+        "level_players", "Number of players", [this]() {
+            return static_cast<double>(level->players->size());
+        }
+    ));
+    metrics.push_back(registry.addCallback(
+        "world_regions", "Number of in-memory regions", [this]() {
+            auto& regions = level->getWorld()->wfile->getRegions();
+            return static_cast<double>(regions.countRegions());
+        }
+    ));
+    metrics.push_back(registry.addCallback(
+        "world_region_files_open", "Number of open region files", [this]() {
+            auto& regions = level->getWorld()->wfile->getRegions();
+            return static_cast<double>(regions.countOpenRegFiles());
+        }
+    ));
+}
+
 void LevelController::update(float delta, bool pause) {
+    PROFILE_ZONE("LevelController::update");
+    auto start = std::chrono::steady_clock::now();
     for (const auto& [_, player] : *level->players) {
         if (player->isSuspended()) {
             continue;
@@ -116,6 +159,9 @@ void LevelController::update(float delta, bool pause) {
         }
     }
     level->entities->clean();
+    updateTime.observe(std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start
+    ).count());
 }
 
 void LevelController::saveWorld() {
@@ -1,16 +1,22 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "BlocksController.hpp"
 #include "ChunksController.hpp"
 #include "util/Clock.hpp"
+#include "util/observer_handler.hpp"
 
 class Engine;
 class Level;
 class Player;
 struct EngineSettings;
 
+namespace debug {
+    class Histogram;
+}
+
 /// @brief LevelController manages other controllers
 class LevelController {
     EngineSettings& settings;
@@ -20,6 +26,11 @@ class LevelController {
     std::unique_ptr<ChunksController> chunks;
 
     util::Clock playerTickClock;
+
+    debug::Histogram& updateTime;
+    std::vector<ObserverHandler> metrics;
+
+    void registerMetrics();
 public:
     LevelController(Engine* engine, std::unique_ptr<Level> level, Player* clientPlayer);
 
@@ -0,0 +1,82 @@
+#include "PregenProgress.hpp"
+
+#include "debug/Logger.hpp"
+#include "maths/voxmaths.hpp"
+#include "world/files/WorldRegions.hpp"
+
+static debug::Logger logger("pregen");
+
+PregenProgress::PregenProgress(
+    glm::ivec2 areaMin, glm::ivec2 areaMax, io::path checkpointFile
+)
+    : areaMin(glm::min(areaMin, areaMax)),
+      areaMax(glm::max(areaMin, areaMax)),
+      checkpointFile(std::move(checkpointFile)) {
+    int minRegionX = floordiv(this->areaMin.x, REGION_SIZE);
+    int minRegionZ = floordiv(this->areaMin.y, REGION_SIZE);
+    int maxRegionX = floordiv(this->areaMax.x - 1, REGION_SIZE);
+    int maxRegionZ = floordiv(this->areaMax.y - 1, REGION_SIZE);
+    for (int z = minRegionZ; z <= maxRegionZ; z++) {
+        for (int x = minRegionX; x <= maxRegionX; x++) {
+            regions.emplace_back(x, z);
+        }
+    }
+}
+
+void PregenProgress::load() {
+    if (!io::is_regular_file(checkpointFile)) {
+        return;
+    }
+    auto root = io::read_json(checkpointFile);
+    const auto& area = root["area"];
+    if (area.size() != 4 || area[0].asInteger() != areaMin.x ||
+        area[1].asInteger() != areaMin.y || area[2].asInteger() != areaMax.x ||
+        area[3].asInteger() != areaMax.y) {
+        logger.info() << "checkpoint area differs, starting over";
+        return;
+    }
+    for (const auto& region : root["regions"]) {
+        finished.emplace(region[0].asInteger(), region[1].asInteger());
+    }
+    logger.info() << "resuming with " << finished.size() << " of "
+                  << regions.size() << " regions finished";
+}
+
+void PregenProgress::save() const {
+    auto root = dv::object();
+    root["area"] = dv::list({areaMin.x, areaMin.y, areaMax.x, areaMax.y});
+    auto& list = root.list("regions");
+    for (const auto& region : regions) {
+        if (finished.find(region) != finished.end()) {
+            list.add(dv::list({region.x, region.y}));
+        }
+    }
+    // interrupted writing must not corrupt the previous checkpoint
+    io::path tmpFile = checkpointFile.string() + ".tmp";
+    io::write_json(tmpFile, root);
+    io::rename(tmpFile, checkpointFile);
+}
+
+std::optional<glm::ivec2> PregenProgress::next() {
+    while (nextRegion < regions.size() &&
+           finished.find(regions[nextRegion]) != finished.end()) {
+        nextRegion++;
+    }
+    if (nextRegion == regions.size()) {
+        return std::nullopt;
+    }
+    return regions[nextRegion++];
+}
+
+void PregenProgress::finish(const glm::ivec2& region) {
+    finished.insert(region);
+    save();
+}
+
+void PregenProgress::getRegionArea(
+    const glm::ivec2& region, glm::ivec2& min, glm::ivec2& max
+) const {
+    const int size = REGION_SIZE;
+    min = glm::max(region * size, areaMin);
+    max = glm::min((region + 1) * size, areaMax);
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <optional>
+#include <unordered_set>
+#include <vector>
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/glm.hpp>
+#include <glm/gtx/hash.hpp>
+
+#include "io/io.hpp"
+
+/// @brief Pre-generation area split into regions. Finished regions are
+/// stored in a checkpoint file, so the process may be resumed
+class PregenProgress {
+    /// @brief Area min chunk position
+    glm::ivec2 areaMin;
+    /// @brief Area max chunk position (exclusive)
+    glm::ivec2 areaMax;
+    /// @brief Area regions in processing order
+    std::vector<glm::ivec2> regions;
+    std::unordered_set<glm::ivec2> finished;
+    size_t nextRegion = 0;
+    io::path checkpointFile;
+
+    void save() const;
+public:
+    /// @param areaMin area min chunk position
+    /// @param areaMax area max chunk position (exclusive)
+    /// @param checkpointFile checkpoint file path
+    PregenProgress(
+        glm::ivec2 areaMin, glm::ivec2 areaMax, io::path checkpointFile
+    );
+
+    /// @brief Load finished regions from the checkpoint file.
+    /// Checkpoint of a different area is ignored
+    void load();
+
+    /// @return next unfinished region
+    std::optional<glm::ivec2> next();
+
+    /// @brief Mark region finished and save the checkpoint
+    void finish(const glm::ivec2& region);
+
+    /// @brief Get region chunks clipped to the area
+    /// @param region region position
+    /// @param min min chunk position
+    /// @param max max chunk position (exclusive)
+    void getRegionArea(
+        const glm::ivec2& region, glm::ivec2& min, glm::ivec2& max
+    ) const;
+
+    const std::vector<glm::ivec2>& getRegions() const {
+        return regions;
+    }
+
+    size_t getFinishedCount() const {
+        return finished.size();
+    }
+};
@@ -0,0 +1,163 @@
+#include "WorldPregen.hpp"
+
+#include <algorithm>
+
+#include "content/Content.hpp"
+#include "debug/Logger.hpp"
+#include "debug/Profiler.hpp"
+#include "lighting/Lighting.hpp"
+#include "util/parallel_for.hpp"
+#include "util/timeutil.hpp"
+#include "voxels/Chunk.hpp"
+#include "voxels/Chunks.hpp"
+#include "voxels/ChunksPool.hpp"
+#include "world/files/WorldFiles.hpp"
+#include "world/generator/WorldGenerator.hpp"
+#include "world/Level.hpp"
+#include "world/World.hpp"
+
+static debug::Logger logger("pregen");
+
+/// @brief Min number of chunks per saving thread
+static constexpr size_t CHUNKS_PER_THREAD = 16;
+
+WorldPregen::WorldPregen(Level& level, glm::ivec2 areaMin, glm::ivec2 areaMax)
+    : level(level),
+      generator(std::make_unique<WorldGenerator>(
+          level.content.generators.require(level.getWorld()->getGenerator()),
+          level.content,
+          level.getWorld()->getSeed()
+      )),
+      chunksPool(std::make_shared<ChunksPool>(
+          (REGION_SIZE + 2) * (REGION_SIZE + 2)
+      )),
+      progress(
+          areaMin,
+          areaMax,
+          level.getWorld()->wfile->getFolder() / CHECKPOINT_FILE
+      ) {
+    progress.load();
+}
+
+WorldPregen::~WorldPregen() = default;
+
+std::shared_ptr<Chunk> WorldPregen::createChunk(int x, int z) {
+    bool recycled;
+    auto chunk = chunksPool->acquire(x, z, recycled);
+    auto& worldRegions = level.getWorld()->wfile->getRegions();
+    if (auto data = worldRegions.getVoxels(x, z)) {
+        chunk->decode(data.get());
+        if (auto lights = worldRegions.getLights(x, z)) {
+            chunk->lightmap.set(lights.get());
+            chunk->flags.loadedLights = true;
+        } else if (recycled) {
+            chunk->lightmap.clear();
+        }
+    } else {
+        if (recycled) {
+            chunk->lightmap.clear();
+        }
+        generator->generate(chunk->voxels, x, z);
+        chunk->flags.unsaved = true;
+    }
+    chunk->flags.loaded = true;
+    chunk->flags.ready = true;
+    return chunk;
+}
+
+size_t WorldPregen::processRegion(const glm::ivec2& region) {
+    PROFILE_ZONE("pregen region");
+    glm::ivec2 min;
+    glm::ivec2 max;
+    progress.getRegionArea(region, min, max);
+    int minX = min.x;
+    int minZ = min.y;
+    int maxX = max.x;
+    int maxZ = max.y;
+
+    // padding chunks are required to calculate lights but not saved
+    int width = maxX - minX + 2;
+    int depth = maxZ - minZ + 2;
+    const auto& indices = *level.content.getIndices();
+    Chunks chunks(width, depth, 0, 0, nullptr, indices);
+    chunks.setCenter(
+        (minX - 1 + width / 2) * CHUNK_W, (minZ - 1 + depth / 2) * CHUNK_D
+    );
+
+    generator->update(
+        (minX + maxX) / 2, (minZ + maxZ) / 2, std::max(width, depth) / 2 + 1
+    );
+
+    // generator scripts share a single Lua state
+    std::vector<std::shared_ptr<Chunk>> created;
+    created.reserve(width * depth);
+    for (int z = minZ - 1; z <= maxZ; z++) {
+        for (int x = minX - 1; x <= maxX; x++) {
+            created.push_back(createChunk(x, z));
+        }
+    }
+    util::parallel_for(
+        created.size(),
+        CHUNKS_PER_THREAD,
+        [&created, &indices](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                auto& chunk = *created[i];
+                chunk.updateHeights();
+                if (!chunk.flags.loadedLights) {
+                    Lighting::prebuildSkyLight(chunk, indices);
+                }
+            }
+        }
+    );
+    for (const auto& chunk : created) {
+        chunks.putChunk(chunk);
+    }
+
+    std::vector<Chunk*> inner;
+    inner.reserve((width - 2) * (depth - 2));
+    Lighting lighting(level.content, chunks);
+    for (int z = minZ; z < maxZ; z++) {
+        for (int x = minX; x < maxX; x++) {
+            auto chunk = chunks.getChunk(x, z);
+            bool lightsCache = chunk->flags.loadedLights;
+            if (!lightsCache) {
+                lighting.buildSkyLight(x, z);
+            }
+            lighting.onChunkLoaded(x, z, !lightsCache);
+            chunk->flags.lighted = true;
+            inner.push_back(chunk);
+        }
+    }
+
+    auto& worldRegions = level.getWorld()->wfile->getRegions();
+    util::parallel_for(
+        inner.size(),
+        CHUNKS_PER_THREAD,
+        [&inner, &worldRegions](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                worldRegions.put(inner[i], {});
+            }
+        }
+    );
+    worldRegions.flush();
+    return inner.size();
+}
+
+bool WorldPregen::update() {
+    auto region = progress.next();
+    if (!region) {
+        return false;
+    }
+    timeutil::Timer timer;
+    size_t count = processRegion(*region);
+    int64_t mcs = std::max<int64_t>(timer.stop(), 1);
+
+    progress.finish(*region);
+
+    logger.info() << "region " << region->x << "_" << region->y << " ("
+                  << progress.getFinishedCount() << "/"
+                  << progress.getRegions().size() << "): "
+                  << count << " chunks, "
+                  << static_cast<int64_t>(count * 1e6 / mcs) << " chunks/s";
+    return true;
+}
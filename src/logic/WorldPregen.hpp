@@ -0,0 +1,47 @@
+#pragma once
+
+#include <memory>
+
+#include "PregenProgress.hpp"
+
+class Level;
+class Chunk;
+class ChunksPool;
+class WorldGenerator;
+
+/// @brief Headless world pre-generation. Generates, lights and saves
+/// the area chunks region by region writing regions directly
+class WorldPregen {
+    Level& level;
+    std::unique_ptr<WorldGenerator> generator;
+    /// @brief Region chunks are reused for the next region
+    std::shared_ptr<ChunksPool> chunksPool;
+    PregenProgress progress;
+
+    /// @brief Load saved chunk or generate a new one
+    std::shared_ptr<Chunk> createChunk(int x, int z);
+
+    /// @return number of chunks saved
+    size_t processRegion(const glm::ivec2& region);
+public:
+    /// @brief Checkpoint file name inside of the world folder
+    static inline const std::string CHECKPOINT_FILE = "pregen.json";
+
+    /// @param level target level
+    /// @param areaMin area min chunk position
+    /// @param areaMax area max chunk position (exclusive)
+    WorldPregen(Level& level, glm::ivec2 areaMin, glm::ivec2 areaMax);
+    ~WorldPregen();
+
+    /// @brief Generate, light and save the next unfinished region
+    /// @return false if all regions are finished
+    bool update();
+
+    size_t getRegionsCount() const {
+        return progress.getRegions().size();
+    }
+
+    size_t getFinishedCount() const {
+        return progress.getFinishedCount();
+    }
+};
@@ -122,6 +122,86 @@ static int l_set(lua::State* L) {
     return 0;
 }
 
+static int commit_bulk_edit(
+    lua::State* L, const std::vector<glm::ivec3>& changed, bool noupdate
+) {
+    if (controller->getChunksController() != nullptr) {
+        blocks->onBlocksSet(changed, !noupdate);
+    }
+    return lua::pushinteger(L, changed.size());
+}
+
+static int l_fill(lua::State* L) {
+    auto a = lua::tovec3(L, 1);
+    auto b = lua::tovec3(L, 2);
+    auto id = lua::tointeger(L, 3);
+    auto state = lua::tointeger(L, 4);
+    bool noupdate = lua::toboolean(L, 5);
+    if (static_cast<size_t>(id) >= indices->blocks.count()) {
+        return 0;
+    }
+    std::vector<glm::ivec3> changed;
+    blocks_agent::fill(
+        *level->chunks, a, b, id, int2blockstate(state), -1, &changed
+    );
+    return commit_bulk_edit(L, changed, noupdate);
+}
+
+static int l_replace(lua::State* L) {
+    auto a = lua::tovec3(L, 1);
+    auto b = lua::tovec3(L, 2);
+    auto target = lua::tointeger(L, 3);
+    auto id = lua::tointeger(L, 4);
+    auto state = lua::tointeger(L, 5);
+    bool noupdate = lua::toboolean(L, 6);
+    if (static_cast<size_t>(id) >= indices->blocks.count() ||
+        static_cast<size_t>(target) >= indices->blocks.count()) {
+        return 0;
+    }
+    std::vector<glm::ivec3> changed;
+    blocks_agent::fill(
+        *level->chunks, a, b, id, int2blockstate(state), target, &changed
+    );
+    return commit_bulk_edit(L, changed, noupdate);
+}
+
+static int l_set_many(lua::State* L) {
+    if (!lua::istable(L, 1)) {
+        throw std::runtime_error("table expected");
+    }
+    bool noupdate = lua::toboolean(L, 2);
+    size_t length = lua::objlen(L, 1);
+    if (length % 5 != 0) {
+        throw std::runtime_error(
+            "edits buffer length must be multiple of 5 (x, y, z, id, states)"
+        );
+    }
+    size_t blocksCount = indices->blocks.count();
+    std::vector<blocks_agent::voxel_edit> edits;
+    edits.reserve(length / 5);
+    lua::pushvalue(L, 1);
+    for (size_t i = 0; i < length; i += 5) {
+        lua::Integer values[5];
+        for (int j = 0; j < 5; j++) {
+            lua::rawgeti(L, i + j + 1);
+            values[j] = lua::tointeger(L, -1);
+            lua::pop(L);
+        }
+        if (static_cast<size_t>(values[3]) >= blocksCount) {
+            continue;
+        }
+        edits.push_back(blocks_agent::voxel_edit {
+            glm::ivec3(values[0], values[1], values[2]),
+            static_cast<blockid_t>(values[3]),
+            int2blockstate(values[4])});
+    }
+    lua::pop(L);
+
+    std::vector<glm::ivec3> changed;
+    blocks_agent::set_many(*level->chunks, edits, &changed);
+    return commit_bulk_edit(L, changed, noupdate);
+}
+
 static int l_get(lua::State* L) {
     auto x = lua::tointeger(L, 1);
     auto y = lua::tointeger(L, 2);
@@ -619,6 +699,7 @@ static int l_set_field(lua::State* L) {
     }
     chunk->flags.unsaved = true;
     chunk->flags.blocksData = true;
+    chunk->updateVersion();
     return set_field(L, dst, *field, index, dataStruct, value);
 }
 
@@ -643,6 +724,9 @@ const luaL_Reg blocklib[] = {
     {"is_replaceable_at", lua::wrap<l_is_replaceable_at>},
     {"set", lua::wrap<l_set>},
     {"get", lua::wrap<l_get>},
+    {"fill", lua::wrap<l_fill>},
+    {"replace", lua::wrap<l_replace>},
+    {"set_many", lua::wrap<l_set_many>},
     {"get_X", lua::wrap<l_get_x>},
     {"get_Y", lua::wrap<l_get_y>},
     {"get_Z", lua::wrap<l_get_z>},
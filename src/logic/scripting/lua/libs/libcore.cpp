@@ -123,6 +123,19 @@ static int l_delete_world(lua::State* L) {
     return 0;
 }
 
+/// @brief Recompress world region files using current storage settings
+/// @param name Name world
+/// @param trainDictionary Train zstd dictionaries (bool)
+static int l_recompress_world(lua::State* L) {
+    auto name = lua::require_string(L, 1);
+    bool trainDictionary = lua::toboolean(L, 2);
+    if (level != nullptr) {
+        throw std::runtime_error("world must be closed before");
+    }
+    engine->getController()->recompressWorld(name, trainDictionary);
+    return 0;
+}
+
 /// @brief Reconfigure packs
 /// @param addPacks An array of packs to add
 /// @param remPacks An array of packs to remove
@@ -314,6 +327,7 @@ const luaL_Reg corelib[] = {
     {"save_world", lua::wrap<l_save_world>},
     {"close_world", lua::wrap<l_close_world>},
     {"delete_world", lua::wrap<l_delete_world>},
+    {"recompress_world", lua::wrap<l_recompress_world>},
     {"reconfig_packs", lua::wrap<l_reconfig_packs>},
     {"get_setting", lua::wrap<l_get_setting>},
     {"set_setting", lua::wrap<l_set_setting>},
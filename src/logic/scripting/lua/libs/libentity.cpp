@@ -7,6 +7,7 @@
 #include "objects/Player.hpp"
 #include "objects/rigging.hpp"
 #include "physics/Hitbox.hpp"
+#include "physics/RaycastBatch.hpp"
 #include "voxels/Chunks.hpp"
 #include "voxels/Block.hpp"
 #include "voxels/blocks_agent.hpp"
@@ -132,28 +133,33 @@ static int l_get_all_in_radius(lua::State* L) {
     return 1;
 }
 
+static std::set<blockid_t> read_blocks_filter(lua::State* L, int idx) {
+    std::set<blockid_t> filteredBlocks {};
+    if (lua::gettop(L) < idx || lua::isnil(L, idx)) {
+        return filteredBlocks;
+    }
+    if (!lua::istable(L, idx)) {
+        throw std::runtime_error("table expected for filter");
+    }
+    int addLen = lua::objlen(L, idx);
+    for (int i = 0; i < addLen; i++) {
+        lua::rawgeti(L, i + 1, idx);
+        auto blockName = std::string(lua::tostring(L, -1));
+        const Block* block = content->blocks.find(blockName);
+        if (block != nullptr) {
+            filteredBlocks.insert(block->rt.id);
+        }
+        lua::pop(L);
+    }
+    return filteredBlocks;
+}
+
 static int l_raycast(lua::State* L) {
     auto start = lua::tovec<3>(L, 1);
     auto dir = lua::tovec<3>(L, 2);
     auto maxDistance = lua::tonumber(L, 3);
     auto ignoreEntityId = lua::tointeger(L, 4);
-    std::set<blockid_t> filteredBlocks {};
-    if (lua::gettop(L) >= 6) {
-        if (lua::istable(L, 6)) {
-            int addLen = lua::objlen(L, 6);
-            for (int i = 0; i < addLen; i++) {
-                lua::rawgeti(L, i + 1, 6);
-                auto blockName = std::string(lua::tostring(L, -1));
-                const Block* block = content->blocks.find(blockName);
-                if (block != nullptr) {
-                    filteredBlocks.insert(block->rt.id);
-                }
-                lua::pop(L);
-            }
-        } else {
-            throw std::runtime_error("table expected for filter");
-        }
-    }
+    auto filteredBlocks = read_blocks_filter(L, 6);
 
     glm::vec3 end;
     glm::ivec3 normal;
@@ -225,6 +231,66 @@ static int l_raycast(lua::State* L) {
     return 0;
 }
 
+/// @brief Numbers per ray in raycast_batch input: start, dir, max distance
+static constexpr int BATCH_RAY_STRIDE = 7;
+/// @brief Numbers per ray in raycast_batch output: block, entity, length,
+/// normal, iendpoint
+static constexpr int BATCH_HIT_STRIDE = 9;
+
+static int l_raycast_batch(lua::State* L) {
+    if (!lua::istable(L, 1)) {
+        throw std::runtime_error("table expected for rays");
+    }
+    int len = lua::objlen(L, 1);
+    if (len % BATCH_RAY_STRIDE) {
+        throw std::runtime_error(
+            "rays array length must be a multiple of " +
+            std::to_string(BATCH_RAY_STRIDE)
+        );
+    }
+    std::vector<RaycastBatch::Query> queries(len / BATCH_RAY_STRIDE);
+    float values[BATCH_RAY_STRIDE];
+    for (size_t i = 0; i < queries.size(); i++) {
+        for (int j = 0; j < BATCH_RAY_STRIDE; j++) {
+            lua::rawgeti(L, i * BATCH_RAY_STRIDE + j + 1, 1);
+            values[j] = lua::tonumber(L, -1);
+            lua::pop(L);
+        }
+        queries[i] = RaycastBatch::Query {
+            glm::vec3(values[0], values[1], values[2]),
+            glm::vec3(values[3], values[4], values[5]),
+            values[6]};
+    }
+    auto ignoreEntityId = lua::tointeger(L, 2);
+    auto filteredBlocks = read_blocks_filter(L, 3);
+    bool withEntities = lua::gettop(L) < 4 || lua::toboolean(L, 4);
+
+    auto batch = withEntities ? level->entities->createRaycastBatch()
+                              : RaycastBatch();
+    auto hits =
+        batch.perform(*level->chunks, queries, filteredBlocks, ignoreEntityId);
+
+    lua::createtable(L, hits.size() * BATCH_HIT_STRIDE, 0);
+    int index = 1;
+    for (const auto& hit : hits) {
+        lua::pushinteger(L, hit.block == BLOCK_VOID ? -1 : hit.block);
+        lua::rawseti(L, index++);
+        lua::pushinteger(L, hit.entity);
+        lua::rawseti(L, index++);
+        lua::pushnumber(L, hit.distance);
+        lua::rawseti(L, index++);
+        for (int i = 0; i < 3; i++) {
+            lua::pushinteger(L, hit.normal[i]);
+            lua::rawseti(L, index++);
+        }
+        for (int i = 0; i < 3; i++) {
+            lua::pushinteger(L, hit.iend[i]);
+            lua::rawseti(L, index++);
+        }
+    }
+    return 1;
+}
+
 static int l_reload_component(lua::State* L) {
     std::string name = lua::require_string(L, 1);
     size_t pos = name.find(':');
@@ -252,6 +318,7 @@ const luaL_Reg entitylib[] = {
     {"get_all_in_box", lua::wrap<l_get_all_in_box>},
     {"get_all_in_radius", lua::wrap<l_get_all_in_radius>},
     {"raycast", lua::wrap<l_raycast>},
+    {"raycast_batch", lua::wrap<l_raycast_batch>},
     {"reload_component", lua::wrap<l_reload_component>},
     {NULL, NULL}
 };
@@ -0,0 +1,71 @@
+#include "api_lua.hpp"
+
+#include "debug/Metrics.hpp"
+
+using namespace debug;
+
+static int l_get(lua::State* L) {
+    MetricSample sample;
+    if (!MetricsRegistry::global().collect(lua::require_string(L, 1), sample)) {
+        return 0;
+    }
+    return lua::pushvalue(L, metrics::to_value(sample));
+}
+
+static int l_list(lua::State* L) {
+    auto samples = MetricsRegistry::global().collect();
+    lua::createtable(L, samples.size(), 0);
+    for (size_t i = 0; i < samples.size(); i++) {
+        lua::pushstring(L, samples[i].name);
+        lua::rawseti(L, i + 1);
+    }
+    return 1;
+}
+
+static int l_export(lua::State* L) {
+    std::string format = "prometheus";
+    if (!lua::isnoneornil(L, 1)) {
+        format = lua::require_string(L, 1);
+    }
+    return lua::pushstring(
+        L, metrics::format(MetricsRegistry::global().collect(), format)
+    );
+}
+
+static std::string get_help(lua::State* L, int idx) {
+    return lua::isstring(L, idx) ? lua::tostring(L, idx) : "";
+}
+
+static int l_add(lua::State* L) {
+    auto& counter = MetricsRegistry::global().counter(
+        lua::require_string(L, 1), get_help(L, 3)
+    );
+    counter.add(lua::isnoneornil(L, 2) ? 1 : lua::touinteger(L, 2));
+    return 0;
+}
+
+static int l_set(lua::State* L) {
+    auto& gauge = MetricsRegistry::global().gauge(
+        lua::require_string(L, 1), get_help(L, 3)
+    );
+    gauge.set(lua::tonumber(L, 2));
+    return 0;
+}
+
+static int l_observe(lua::State* L) {
+    auto& histogram = MetricsRegistry::global().histogram(
+        lua::require_string(L, 1), get_help(L, 3), metrics::duration_bounds()
+    );
+    histogram.observe(lua::tonumber(L, 2));
+    return 0;
+}
+
+const luaL_Reg metricslib[] = {
+    {"get", lua::wrap<l_get>},
+    {"list", lua::wrap<l_list>},
+    {"export", lua::wrap<l_export>},
+    {"add", lua::wrap<l_add>},
+    {"set", lua::wrap<l_set>},
+    {"observe", lua::wrap<l_observe>},
+    {NULL, NULL}
+};
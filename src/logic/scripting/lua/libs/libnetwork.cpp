@@ -119,33 +119,87 @@ static int l_closeserver(lua::State* L, network::Network& network) {
     return 0;
 }
 
-static int l_send(lua::State* L, network::Network& network) {
-    u64id_t id = lua::tointeger(L, 1);
-    auto connection = network.getConnection(id);
-    if (connection == nullptr ||
-        connection->getState() == network::ConnectionState::CLOSED) {
-        return 0;
-    }
-    if (lua::istable(L, 2)) {
-        lua::pushvalue(L, 2);
-        size_t size = lua::objlen(L, 2);
-        util::Buffer<char> buffer(size);
+/// @brief Length-prefixed packets header: big-endian uint32 payload size
+static constexpr size_t PACKET_HEADER_SIZE = 4;
+
+/// @brief Get bytes of a table, string or Bytearray argument
+/// @param buffer storage used for table conversion
+/// @return bytes view valid until the function return
+static std::string_view get_bytes(
+    lua::State* L, int idx, util::Buffer<char>& buffer
+) {
+    if (lua::istable(L, idx)) {
+        lua::pushvalue(L, idx);
+        size_t size = lua::objlen(L, idx);
+        buffer = util::Buffer<char>(size);
         for (size_t i = 0; i < size; i++) {
             lua::rawgeti(L, i + 1);
             buffer[i] = lua::tointeger(L, -1);
             lua::pop(L);
         }
         lua::pop(L);
-        connection->send(buffer.data(), size);
-    } else if (lua::isstring(L, 2)) {
-        auto string = lua::tolstring(L, 2);
-        connection->send(string.data(), string.length());
+        return std::string_view(buffer.data(), size);
+    } else if (lua::isstring(L, idx)) {
+        return lua::tolstring(L, idx);
     } else {
-        auto string = lua::bytearray_as_string(L, 2);
-        connection->send(string.data(), string.length());
-        lua::pop(L);
+        // string is kept on the stack
+        return lua::bytearray_as_string(L, idx);
     }
-    return 0;
+}
+
+static int push_bytes(
+    lua::State* L, const char* bytes, size_t size, bool usetable
+) {
+    if (usetable) {
+        lua::createtable(L, size, 0);
+        for (size_t i = 0; i < size; i++) {
+            lua::pushinteger(L, bytes[i] & 0xFF);
+            lua::rawseti(L, i+1);
+        }
+        return 1;
+    } else {
+        return lua::create_bytearray(L, bytes, size);
+    }
+}
+
+static int l_send(lua::State* L, network::Network& network) {
+    u64id_t id = lua::tointeger(L, 1);
+    auto connection = network.getConnection(id);
+    if (connection == nullptr ||
+        connection->getState() == network::ConnectionState::CLOSED) {
+        return 0;
+    }
+    util::Buffer<char> buffer;
+    auto bytes = get_bytes(L, 2, buffer);
+    return lua::pushinteger(L, connection->send(bytes.data(), bytes.size()));
+}
+
+static int l_send_packet(lua::State* L, network::Network& network) {
+    u64id_t id = lua::tointeger(L, 1);
+    auto connection = network.getConnection(id);
+    if (connection == nullptr ||
+        connection->getState() == network::ConnectionState::CLOSED) {
+        return lua::pushboolean(L, false);
+    }
+    util::Buffer<char> buffer;
+    auto bytes = get_bytes(L, 2, buffer);
+    if (bytes.size() > std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error("packet is too large");
+    }
+    // a packet is never sent partially to keep the stream consistent
+    if (connection->getWriteSpace() < PACKET_HEADER_SIZE + bytes.size()) {
+        return lua::pushboolean(L, false);
+    }
+    uint32_t size = bytes.size();
+    char header[PACKET_HEADER_SIZE] {
+        static_cast<char>(size >> 24),
+        static_cast<char>(size >> 16),
+        static_cast<char>(size >> 8),
+        static_cast<char>(size),
+    };
+    connection->send(header, PACKET_HEADER_SIZE);
+    connection->send(bytes.data(), bytes.size());
+    return lua::pushboolean(L, true);
 }
 
 static int l_recv(lua::State* L, network::Network& network) {
@@ -162,16 +216,69 @@ static int l_recv(lua::State* L, network::Network& network) {
     if (size == -1) {
         return 0;
     }
-    if (lua::toboolean(L, 3)) {
-        lua::createtable(L, size, 0);
-        for (size_t i = 0; i < size; i++) {
-            lua::pushinteger(L, buffer[i] & 0xFF);
-            lua::rawseti(L, i+1);
-        }
-        return 1;
-    } else {
-        return lua::create_bytearray(L, buffer.data(), size);
+    return push_bytes(L, buffer.data(), size, lua::toboolean(L, 3));
+}
+
+/// @brief Append received bytes to the Bytearray. Reads no more than
+/// the Bytearray capacity left (reserved by Socket.recv_into)
+static int l_recv_into(lua::State* L, network::Network& network) {
+    u64id_t id = lua::tointeger(L, 1);
+    auto dst = lua::tobytearray(L, 2);
+    if (dst == nullptr) {
+        throw std::runtime_error("Bytearray expected");
+    }
+    if (dst->size < 0 || dst->size > dst->capacity) {
+        throw std::runtime_error("invalid Bytearray size");
+    }
+    int length = lua::tointeger(L, 3);
+    auto connection = network.getConnection(id);
+    if (connection == nullptr) {
+        return 0;
+    }
+    length = glm::min(length, connection->available());
+    length = glm::min(length, dst->capacity - dst->size);
+    if (length <= 0) {
+        return lua::pushinteger(L, 0);
+    }
+    int size = connection->recv(
+        reinterpret_cast<char*>(dst->bytes + dst->size), length
+    );
+    if (size == -1) {
+        return 0;
+    }
+    dst->size += size;
+    return lua::pushinteger(L, size);
+}
+
+static int l_recv_packet(lua::State* L, network::Network& network) {
+    u64id_t id = lua::tointeger(L, 1);
+    auto connection = network.getConnection(id);
+    if (connection == nullptr) {
+        return 0;
+    }
+    unsigned char header[PACKET_HEADER_SIZE];
+    if (connection->peek(reinterpret_cast<char*>(header), PACKET_HEADER_SIZE) <
+        PACKET_HEADER_SIZE) {
+        return 0;
+    }
+    size_t size = (static_cast<uint32_t>(header[0]) << 24) |
+                  (static_cast<uint32_t>(header[1]) << 16) |
+                  (static_cast<uint32_t>(header[2]) << 8) |
+                  static_cast<uint32_t>(header[3]);
+    if (PACKET_HEADER_SIZE + size > network.getReadBufferSize()) {
+        // would never be received completely
+        throw std::runtime_error(
+            "packet size " + std::to_string(size) +
+            " exceeds the connection read buffer size"
+        );
+    }
+    if (connection->available() < PACKET_HEADER_SIZE + size) {
+        return 0;
     }
+    util::Buffer<char> buffer(size);
+    connection->recv(reinterpret_cast<char*>(header), PACKET_HEADER_SIZE);
+    connection->recv(buffer.data(), size);
+    return push_bytes(L, buffer.data(), size, lua::toboolean(L, 2));
 }
 
 static int l_available(lua::State* L, network::Network& network) {
@@ -279,7 +386,10 @@ const luaL_Reg networklib[] = {
     {"__connect", wrap<l_connect>},
     {"__close", wrap<l_close>},
     {"__send", wrap<l_send>},
+    {"__send_packet", wrap<l_send_packet>},
     {"__recv", wrap<l_recv>},
+    {"__recv_into", wrap<l_recv_into>},
+    {"__recv_packet", wrap<l_recv_packet>},
     {"__available", wrap<l_available>},
     {"__is_alive", wrap<l_is_alive>},
     {"__is_connected", wrap<l_is_connected>},
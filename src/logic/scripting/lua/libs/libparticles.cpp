@@ -25,7 +25,7 @@ static int l_emit(lua::State* L) {
     auto& assets = *engine->getAssets();
     auto region = util::get_texture_region(assets, particlesPreset.texture, "");
     auto emitter = std::make_unique<Emitter>(
-        *level,
+        level,
         std::move(origin),
         std::move(particlesPreset),
         region.texture,
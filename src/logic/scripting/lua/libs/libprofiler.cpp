@@ -0,0 +1,27 @@
+#include "api_lua.hpp"
+
+#include "debug/Profiler.hpp"
+
+static int l_start(lua::State*) {
+    debug::Profiler::start();
+    return 0;
+}
+
+static int l_stop(lua::State* L) {
+    if (!debug::Profiler::isActive()) {
+        return 0;
+    }
+    auto capture = debug::Profiler::stop();
+    return lua::pushstring(L, debug::Profiler::toChromeTrace(capture));
+}
+
+static int l_is_active(lua::State* L) {
+    return lua::pushboolean(L, debug::Profiler::isActive());
+}
+
+const luaL_Reg profilerlib[] = {
+    {"start", lua::wrap<l_start>},
+    {"stop", lua::wrap<l_stop>},
+    {"is_active", lua::wrap<l_is_active>},
+    {NULL, NULL}
+};
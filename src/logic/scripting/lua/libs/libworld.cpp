@@ -16,6 +16,7 @@
 #include "voxels/Chunk.hpp"
 #include "voxels/Chunks.hpp"
 #include "voxels/GlobalChunks.hpp"
+#include "voxels/EncodedChunksCache.hpp"
 #include "voxels/compressed_chunks.hpp"
 #include "world/Level.hpp"
 #include "world/World.hpp"
@@ -128,23 +129,28 @@ static int l_get_generator(lua::State* L) {
 static int l_get_chunk_data(lua::State* L) {
     int x = static_cast<int>(lua::tointeger(L, 1));
     int z = static_cast<int>(lua::tointeger(L, 2));
+    uint64_t knownVersion = 0;
+    if (!lua::isnoneornil(L, 3)) {
+        knownVersion = lua::tointeger(L, 3);
+    }
     const auto& chunk = level->chunks->getChunk(x, z);
 
-    std::vector<ubyte> chunkData;
+    auto& cache = *level->encodedChunks;
+    EncodedChunksCache::Payload payload;
+    uint64_t version;
     if (chunk == nullptr) {
         auto& regions = level->getWorld()->wfile->getRegions();
-        auto voxelData = regions.getVoxels(x, z);
-        if (voxelData == nullptr) {
+        payload = cache.get(x, z, regions, version, knownVersion);
+        if (payload == nullptr) {
             return 0;
         }
-        static util::Buffer<ubyte> rleBuffer(CHUNK_DATA_LEN * 2);
-        auto metadata = regions.getBlocksData(x, z);
-        chunkData =
-            compressed_chunks::encode(voxelData.get(), metadata, rleBuffer);
     } else {
-        chunkData = compressed_chunks::encode(*chunk);
+        payload = cache.get(*chunk, knownVersion);
+        version = chunk->version;
     }
-    return lua::create_bytearray(L, std::move(chunkData));
+    lua::create_bytearray(L, payload->data(), payload->size());
+    lua::pushinteger(L, version);
+    return 2;
 }
 
 static void integrate_chunk_client(Chunk& chunk) {
@@ -212,6 +218,7 @@ static int l_save_chunk_data(lua::State* L) {
         ),
         level->getWorld()->wfile->getRegions()
     );
+    level->encodedChunks->invalidate(x, z);
     return 0;
 }
 
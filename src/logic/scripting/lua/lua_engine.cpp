@@ -70,8 +70,10 @@ static void create_libs(State* L, StateType stateType) {
         openlib(L, "gui", guilib);
         openlib(L, "input", inputlib);
         openlib(L, "inventory", inventorylib);
+        openlib(L, "metrics", metricslib);
         openlib(L, "network", networklib);
         openlib(L, "player", playerlib);
+        openlib(L, "profiler", profilerlib);
         openlib(L, "time", timelib);
         openlib(L, "world", worldlib);
 
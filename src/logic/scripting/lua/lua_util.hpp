@@ -758,6 +758,32 @@ namespace lua {
         return create_bytearray(L, bytes.data(), bytes.size());
     }
 
+    /// @brief Bytearray cdata layout (see core:internal/bytearray)
+    struct bytearray_t {
+        ubyte* bytes;
+        int size;
+        int capacity;
+    };
+
+    /// @return Bytearray storage or nullptr if the value is not a Bytearray
+    inline bytearray_t* tobytearray(lua::State* L, int idx) {
+        if (idx < 0) {
+            idx = lua::gettop(L) + idx + 1;
+        }
+        lua::requireglobal(L, "Bytearray_istype");
+        lua::pushvalue(L, idx);
+        lua::call(L, 1, 1);
+        bool istype = lua::toboolean(L, -1);
+        lua::pop(L);
+        if (!istype) {
+            return nullptr;
+        }
+        // cdata pointer is the struct address
+        return static_cast<bytearray_t*>(
+            const_cast<void*>(lua::topointer(L, idx))
+        );
+    }
+
     inline std::string_view bytearray_as_string(lua::State* L, int idx) {
         lua::requireglobal(L, "Bytearray_as_string");
         lua::pushvalue(L, idx);
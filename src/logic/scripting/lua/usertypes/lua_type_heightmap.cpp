@@ -6,7 +6,7 @@
 #include <filesystem>
 
 #include "util/functional_util.hpp"
-#define FNL_IMPL
+#include "util/parallel_for.hpp"
 #include "maths/FastNoiseLite.h"
 #include "coders/imageio.hpp"
 #include "io/util.hpp"
@@ -17,6 +17,11 @@
 
 using namespace lua;
 
+/// @brief Min noise samples (pixels * octaves) processed by a thread
+inline constexpr size_t NOISE_MIN_SAMPLES_PER_THREAD = 32'768;
+/// @brief Min elements processed by a thread in element-wise operations
+inline constexpr size_t ELEMENTWISE_MIN_PER_THREAD = 262'144;
+
 LuaHeightmap::LuaHeightmap(const std::shared_ptr<Heightmap>& map)
  : map(map), noise(std::make_unique<fnl_state>(fnlCreateState())) {
 }
@@ -86,78 +91,77 @@ static int l_noise(lua::State* L) {
     if (auto heightmap = touserdata<LuaHeightmap>(L, 1)) {
         uint w = heightmap->getWidth();
         uint h = heightmap->getHeight();
-        auto heights = heightmap->getValues();
+        if (w == 0 || h == 0) {
+            return 0;
+        }
+        auto map = heightmap->getHeightmap().get();
         auto noise = heightmap->getNoise();
 
-        auto offset = tovec<2>(L, 2);
-
-        float s = tonumber(L, 3);
-        int octaves = 1;
-        float multiplier = 1.0f;
+        NoiseParams params {};
+        params.offset = tovec<2>(L, 2);
+        params.scale = tonumber(L, 3);
+        params.octaves = 1;
+        params.multiplier = 1.0f;
         if (gettop(L) > 3) {
-            octaves = tointeger(L, 4);
+            params.octaves = tointeger(L, 4);
         }
         if (gettop(L) > 4) {
-            multiplier = tonumber(L, 5);
+            params.multiplier = tonumber(L, 5);
         }
-        const LuaHeightmap* shiftMapX = nullptr;
-        const LuaHeightmap* shiftMapY = nullptr;
         if (gettop(L) > 5) {
-            shiftMapX = touserdata<LuaHeightmap>(L, 6);
+            if (auto shiftMap = touserdata<LuaHeightmap>(L, 6)) {
+                params.shiftMapX = shiftMap->getValues();
+            }
         }
         if (gettop(L) > 6) {
-            shiftMapY = touserdata<LuaHeightmap>(L, 7);
+            if (auto shiftMap = touserdata<LuaHeightmap>(L, 7)) {
+                params.shiftMapY = shiftMap->getValues();
+            }
         }
         noise->noise_type = noise_type;
-        for (uint y = 0; y < h; y++) {
-            for (uint x = 0; x < w; x++) {
-                uint i = y * w + x;
-                for (uint c = 0; c < octaves; c++) {
-                    float m = s * (1 << c);
-                    float value = heights[i];
-                    float u = (x + offset.x) * m;
-                    float v = (y + offset.y) * m;
-                    if (shiftMapX) {
-                        u += shiftMapX->getValues()[i];
-                    }
-                    if (shiftMapY) {
-                        v += shiftMapY->getValues()[i];
-                    }
 
-                    value += fnlGetNoise2D(noise, u, v) /
-                            static_cast<float>(1 << c) * multiplier;
-                    heights[i] = value;
-                }
+        size_t rowSamples =
+            static_cast<size_t>(w) * std::max(params.octaves, 1);
+        util::parallel_for(
+            h,
+            NOISE_MIN_SAMPLES_PER_THREAD / rowSamples + 1,
+            [=](size_t y1, size_t y2) {
+                map->addNoise(noise, params, y1, y2);
             }
-        }
+        );
     }
     return 0;
 }
 
+/// @brief Apply element-wise function to the range of heightmap values
+/// @param func callback func(begin, end)
+template <typename Func>
+static void apply_elementwise(size_t size, const Func& func) {
+    util::parallel_for(size, ELEMENTWISE_MIN_PER_THREAD, func);
+}
+
 template<template<class> class Op>
 static int l_binop_func(lua::State* L) {
     Op<float> op;
     if (auto heightmap = touserdata<LuaHeightmap>(L, 1)) {
-        uint w = heightmap->getWidth();
-        uint h = heightmap->getHeight();
-        auto heights = heightmap->getValues();
+        size_t size = heightmap->getWidth() * heightmap->getHeight();
+        float* heights = heightmap->getValues();
 
         if (isnumber(L, 2)) {
             float scalar = tonumber(L, 2);
-            for (uint y = 0; y < h; y++) {
-                for (uint x = 0; x < w; x++) {
-                    uint i = y * w + x;
+            apply_elementwise(size, [=](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++) {
                     heights[i] = op(heights[i], scalar);
                 }
-            }
+            });
         } else {
             auto map = touserdata<LuaHeightmap>(L, 2);
-            for (uint y = 0; y < h; y++) {
-                for (uint x = 0; x < w; x++) {
-                    uint i = y * w + x;
-                    heights[i] = op(heights[i], map->getValues()[i]);
+            const float* values = map->getValues();
+            apply_elementwise(size, [=](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++) {
+                    heights[i] = op(heights[i], values[i]);
                 }
-            }
+            });
         }
     }
     return 0;
@@ -165,40 +169,47 @@ static int l_binop_func(lua::State* L) {
 
 static int l_mixin(lua::State* L) {
     if (auto heightmap = touserdata<LuaHeightmap>(L, 1)) {
-        uint w = heightmap->getWidth();
-        uint h = heightmap->getHeight();
-        auto heights = heightmap->getValues();
+        size_t size = heightmap->getWidth() * heightmap->getHeight();
+        float* heights = heightmap->getValues();
 
         if (isnumber(L, 2)) {
             float scalar = tonumber(L, 2);
             if (isnumber(L, 3)) {
                 float t = tonumber(L, 3);
-                for (uint i = 0; i < w * h; i++) {
-                    heights[i] = heights[i] * (1.0f - t) + scalar * t;
-                }
+                apply_elementwise(size, [=](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; i++) {
+                        heights[i] = heights[i] * (1.0f - t) + scalar * t;
+                    }
+                });
             } else {
                 auto tmap = touserdata<LuaHeightmap>(L, 3);
-                auto tmapvalues = tmap->getValues();
-                for (uint i = 0; i < w * h; i++) {
-                    float t = tmapvalues[i];
-                    heights[i] = heights[i] * (1.0f - t) + scalar * t;
-                }
+                const float* tvalues = tmap->getValues();
+                apply_elementwise(size, [=](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; i++) {
+                        float t = tvalues[i];
+                        heights[i] = heights[i] * (1.0f - t) + scalar * t;
+                    }
+                });
             }
         } else {
             auto map = touserdata<LuaHeightmap>(L, 2);
-            auto mapvalues = map->getValues();
+            const float* values = map->getValues();
             if (isnumber(L, 3)) {
                 float t = tonumber(L, 3);
-                for (uint i = 0; i < w * h; i++) {
-                    heights[i] = heights[i] * (1.0f - t) + mapvalues[i] * t;
-                }
+                apply_elementwise(size, [=](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; i++) {
+                        heights[i] = heights[i] * (1.0f - t) + values[i] * t;
+                    }
+                });
             } else {
                 auto tmap = touserdata<LuaHeightmap>(L, 3);
-                auto tmapvalues = tmap->getValues();
-                for (uint i = 0; i < w * h; i++) {
-                    float t = tmapvalues[i];
-                    heights[i] = heights[i] * (1.0f - t) + mapvalues[i] * t;
-                }
+                const float* tvalues = tmap->getValues();
+                apply_elementwise(size, [=](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; i++) {
+                        float t = tvalues[i];
+                        heights[i] = heights[i] * (1.0f - t) + values[i] * t;
+                    }
+                });
             }
         }
     }
@@ -209,15 +220,13 @@ template<template<class> class Op>
 static int l_unaryop_func(lua::State* L) {
     Op<float> op;
     if (auto heightmap = touserdata<LuaHeightmap>(L, 1)) {
-        uint w = heightmap->getWidth();
-        uint h = heightmap->getHeight();
-        auto heights = heightmap->getValues();
-        for (uint y = 0; y < h; y++) {
-            for (uint x = 0; x < w; x++) {
-                uint i = y * w + x;
+        size_t size = heightmap->getWidth() * heightmap->getHeight();
+        float* heights = heightmap->getValues();
+        apply_elementwise(size, [=](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
                 heights[i] = op(heights[i]);
             }
-        }
+        });
     }
     return 0;
 }
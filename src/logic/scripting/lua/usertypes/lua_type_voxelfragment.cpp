@@ -2,6 +2,7 @@
 
 #include "../lua_util.hpp"
 
+#include "logic/BlocksController.hpp"
 #include "world/generator/VoxelFragment.hpp"
 #include "util/stringutil.hpp"
 #include "world/Level.hpp"
@@ -25,9 +26,14 @@ static int l_place(lua::State* L) {
     if (auto fragment = touserdata<LuaVoxelFragment>(L, 1)) {
         auto offset = tovec3(L, 2);
         int rotation = tointeger(L, 3) & 0b11;
-        fragment->getFragment()->place(
-            *scripting::level->chunks, offset, rotation 
+        std::vector<glm::ivec3> changed;
+        auto count = fragment->getFragment()->place(
+            *scripting::level->chunks, offset, rotation, &changed
         );
+        if (scripting::blocks) {
+            scripting::blocks->onBlocksSet(changed, false);
+        }
+        return pushinteger(L, count);
     }
     return 0;
 }
@@ -8,6 +8,7 @@
 #include "content/ContentPack.hpp"
 #include "content/ContentControl.hpp"
 #include "debug/Logger.hpp"
+#include "debug/Profiler.hpp"
 #include "engine/Engine.hpp"
 #include "io/engine_paths.hpp"
 #include "io/io.hpp"
@@ -228,6 +229,7 @@ std::unique_ptr<Process> scripting::start_coroutine(
 }
 
 void scripting::process_post_runnables() {
+    PROFILE_ZONE("scripting post runnables");
     auto L = lua::get_main_state();
     if (lua::getglobal(L, "__process_post_runnables")) {
         lua::call_nothrow(L, 0, 0);
@@ -298,6 +300,7 @@ void scripting::on_world_load(LevelController* controller) {
 }
 
 void scripting::on_world_tick() {
+    PROFILE_ZONE("scripting world tick");
     auto L = lua::get_main_state();
     for (auto& pack : content_control->getAllContentPacks()) {
         lua::emit_event(L, pack.id + ":.worldtick");
@@ -345,6 +348,7 @@ void scripting::cleanup() {
 }
 
 void scripting::on_blocks_tick(const Block& block, int tps) {
+    PROFILE_ZONE("scripting blocks tick");
     std::string name = block.name + ".blockstick";
     lua::emit_event(lua::get_main_state(), name, [tps](auto L) {
         return lua::pushinteger(L, tps);
@@ -775,6 +779,7 @@ void scripting::on_entity_used(const Entity& entity, Player* player) {
 }
 
 void scripting::on_entities_update(int tps, int parts, int part) {
+    PROFILE_ZONE("scripting entities update");
     auto L = lua::get_main_state();
     lua::get_from(L, STDCOMP, "update", true);
     lua::pushinteger(L, tps);
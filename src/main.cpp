@@ -43,5 +43,6 @@ int main(int argc, char** argv) {
     }
 #endif
     Engine::terminate();
+    debug::Logger::close();
     return EXIT_SUCCESS;
 }
@@ -5,6 +5,13 @@
 #include <stdexcept>
 #include <glm/glm.hpp>
 
+#include "util/parallel_for.hpp"
+#define FNL_IMPL
+#include "FastNoiseLite.h"
+
+/// @brief Min pixels resampled by a thread
+inline constexpr size_t RESIZE_MIN_PIXELS_PER_THREAD = 65'536;
+
 static inline float sample_at(
     const float* buffer,
     uint width,
@@ -90,17 +97,35 @@ void Heightmap::resize(
     if (width == dstwidth && height == dstheight) {
         return;
     }
+    if (dstwidth == 0 || dstheight == 0 || width == 0 || height == 0) {
+        width = dstwidth;
+        height = dstheight;
+        buffer.assign(dstwidth * dstheight, 0.0f);
+        return;
+    }
     std::vector<float> dst;
     dst.resize(dstwidth*dstheight);
 
-    uint index = 0;
-    for (uint y = 0; y < dstheight; y++) {
-        for (uint x = 0; x < dstwidth; x++, index++) {
-            float sx = static_cast<float>(x) / dstwidth * width;
-            float sy = static_cast<float>(y) / dstheight * height;
-            dst[index] = sample_at(buffer.data(), width, height, sx, sy, interp);
+    const float* src = buffer.data();
+    float* dstdata = dst.data();
+    uint srcwidth = width;
+    uint srcheight = height;
+    util::parallel_for(
+        dstheight,
+        RESIZE_MIN_PIXELS_PER_THREAD / dstwidth + 1,
+        [=](size_t y1, size_t y2) {
+            for (uint y = y1; y < y2; y++) {
+                uint index = y * dstwidth;
+                float sy = static_cast<float>(y) / dstheight * srcheight;
+                for (uint x = 0; x < dstwidth; x++, index++) {
+                    float sx = static_cast<float>(x) / dstwidth * srcwidth;
+                    dstdata[index] = sample_at(
+                        src, srcwidth, srcheight, sx, sy, interp
+                    );
+                }
+            }
         }
-    }
+    );
 
     width = dstwidth;
     height = dstheight;
@@ -138,3 +163,39 @@ void Heightmap::clamp() {
         buffer[i] = std::min(1.0f, std::max(0.0f, buffer[i]));
     }
 }
+
+void Heightmap::addNoise(
+    fnl_state* noise, const NoiseParams& params, uint y1, uint y2
+) {
+    std::vector<float> us(width);
+    std::vector<float> vs(width);
+    const auto& offset = params.offset;
+    for (uint y = y1; y < y2; y++) {
+        uint row = y * width;
+        float* dst = buffer.data() + row;
+        for (uint c = 0; c < params.octaves; c++) {
+            float m = params.scale * (1 << c);
+            float divider = static_cast<float>(1 << c);
+            for (uint x = 0; x < width; x++) {
+                us[x] = (x + offset.x) * m;
+                vs[x] = (y + offset.y) * m;
+            }
+            if (params.shiftMapX) {
+                const float* shift = params.shiftMapX + row;
+                for (uint x = 0; x < width; x++) {
+                    us[x] += shift[x];
+                }
+            }
+            if (params.shiftMapY) {
+                const float* shift = params.shiftMapY + row;
+                for (uint x = 0; x < width; x++) {
+                    vs[x] += shift[x];
+                }
+            }
+            for (uint x = 0; x < width; x++) {
+                dst[x] += fnlGetNoise2D(noise, us[x], vs[x]) / divider *
+                          params.multiplier;
+            }
+        }
+    }
+}
@@ -3,6 +3,7 @@
 #include <vector>
 #include <string>
 #include <optional>
+#include <glm/glm.hpp>
 
 #include "typedefs.hpp"
 #include "maths/Heightmap.hpp"
@@ -20,6 +21,20 @@ VC_ENUM_METADATA(InterpolationType)
     {"cubic", InterpolationType::CUBIC},
 VC_ENUM_END
 
+struct fnl_state;
+
+/// @brief Parameters of noise octaves added to heightmap
+struct NoiseParams {
+    glm::vec2 offset;
+    float scale;
+    int octaves;
+    float multiplier;
+    /// @brief Optional map of X coordinate shifts (same size as heightmap)
+    const float* shiftMapX;
+    /// @brief Optional map of Y coordinate shifts (same size as heightmap)
+    const float* shiftMapY;
+};
+
 class Heightmap {
     uint width, height;
     std::vector<float> buffer;
@@ -40,6 +55,14 @@ public:
 
     void clamp();
 
+    /// @brief Add noise octaves to rows [y1, y2).
+    /// Coordinates are prepared for whole row, then accumulated in the same
+    /// order as per-pixel evaluation, so results are bit-identical.
+    /// Different rows may be processed in parallel
+    void addNoise(
+        fnl_state* noise, const NoiseParams& params, uint y1, uint y2
+    );
+
     uint getWidth() const {
         return width;
     }
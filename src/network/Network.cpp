@@ -8,6 +8,7 @@
 #include <limits>
 #include <queue>
 #include <thread>
+#include <atomic>
 
 #ifdef _WIN32
 /// included in curl.h
@@ -25,7 +26,13 @@
 using SOCKET = int;
 #endif // _WIN32
 
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#endif
+
 #include "debug/Logger.hpp"
+#include "util/RingBuffer.hpp"
 #include "util/stringutil.hpp"
 
 using namespace network;
@@ -291,15 +298,34 @@ static std::string to_string(const sockaddr_in& addr, bool port=true) {
     return "";
 }
 
+static sockaddr_in resolve_address(const std::string& address, int port) {
+    addrinfo hints {};
+
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+
+    addrinfo* addrinfo = nullptr;
+    if (int res = getaddrinfo(
+        address.c_str(), nullptr, &hints, &addrinfo
+    )) {
+        throw std::runtime_error(gai_strerror(res));
+    }
+
+    sockaddr_in serverAddress;
+    std::memcpy(&serverAddress, addrinfo->ai_addr, sizeof(sockaddr_in));
+    serverAddress.sin_port = htons(port);
+    freeaddrinfo(addrinfo);
+    return serverAddress;
+}
+
 class SocketConnection : public Connection {
     SOCKET descriptor;
     sockaddr_in addr;
     size_t totalUpload = 0;
-    size_t totalDownload = 0;
+    std::atomic<size_t> totalDownload = 0;
     ConnectionState state = ConnectionState::INITIAL;
     std::unique_ptr<std::thread> thread = nullptr;
-    std::vector<char> readBatch;
-    util::Buffer<char> buffer;
+    util::RingBuffer<char> readBuffer;
     std::mutex mutex;
 
     void connectSocket() {
@@ -317,8 +343,10 @@ class SocketConnection : public Connection {
         state = ConnectionState::CONNECTED;
     }
 public:
-    SocketConnection(SOCKET descriptor, sockaddr_in addr)
-        : descriptor(descriptor), addr(std::move(addr)), buffer(16'384) {}
+    SocketConnection(SOCKET descriptor, sockaddr_in addr, size_t readBufferSize)
+        : descriptor(descriptor),
+          addr(std::move(addr)),
+          readBuffer(readBufferSize) {}
 
     ~SocketConnection() {
         if (state != ConnectionState::CLOSED) {
@@ -331,7 +359,14 @@ public:
 
     void startListen() {
         while (state == ConnectionState::CONNECTED) {
-            int size = recvsocket(descriptor, buffer.data(), buffer.size());
+            size_t free;
+            char* region = readBuffer.writeRegion(free);
+            if (free == 0) {
+                // wait until the data is consumed
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                continue;
+            }
+            int size = recvsocket(descriptor, region, free);
             if (size == 0) {
                 logger.info() << "closed connection with " << to_string(addr);
                 closesocket(descriptor);
@@ -346,13 +381,8 @@ public:
                 logger.error() << error.what();
                 break;
             }
-            {
-                std::lock_guard lock(mutex);
-                for (size_t i = 0; i < size; i++) {
-                    readBatch.emplace_back(buffer[i]);
-                }
-                totalDownload += size;
-            }
+            readBuffer.commit(size);
+            totalDownload += size;
             logger.debug() << "read " << size << " bytes from " << to_string(addr);
         }
     }
@@ -373,15 +403,14 @@ public:
     }
 
     int recv(char* buffer, size_t length) override {
-        std::lock_guard lock(mutex);
-
-        if (state != ConnectionState::CONNECTED && readBatch.empty()) {
+        if (state != ConnectionState::CONNECTED && readBuffer.empty()) {
             return -1;
         }
-        int size = std::min(readBatch.size(), length);
-        std::memcpy(buffer, readBatch.data(), size);
-        readBatch.erase(readBatch.begin(), readBatch.begin() + size);
-        return size;
+        return readBuffer.read(buffer, length);
+    }
+
+    int peek(char* buffer, size_t length, size_t offset) override {
+        return readBuffer.peek(buffer, length, offset);
     }
 
     int send(const char* buffer, size_t length) override {
@@ -402,14 +431,17 @@ public:
     }
 
     int available() override {
-        std::lock_guard lock(mutex);
-        return readBatch.size();
+        return readBuffer.size();
+    }
+
+    size_t getWriteSpace() override {
+        return std::numeric_limits<int>::max();
     }
 
     void close(bool discardAll=false) override {
         {
             std::lock_guard lock(mutex);
-            readBatch.clear();
+            readBuffer.clear();
 
             if (state != ConnectionState::CLOSED) {
                 shutdown(descriptor, 2);
@@ -429,9 +461,7 @@ public:
     }
 
     size_t pullDownload() override {
-        size_t size = totalDownload;
-        totalDownload = 0;
-        return size;
+        return totalDownload.exchange(0);
     }
 
     int getPort() const override {
@@ -443,30 +473,20 @@ public:
     }
 
     static std::shared_ptr<SocketConnection> connect(
-        const std::string& address, int port, runnable callback
+        const std::string& address,
+        int port,
+        size_t readBufferSize,
+        runnable callback
     ) {
-        addrinfo hints {};
-
-        hints.ai_family = AF_INET;
-        hints.ai_socktype = SOCK_STREAM;
-
-        addrinfo* addrinfo = nullptr;
-        if (int res = getaddrinfo(
-            address.c_str(), nullptr, &hints, &addrinfo
-        )) {
-            throw std::runtime_error(gai_strerror(res));
-        }
-
-        sockaddr_in serverAddress;
-        std::memcpy(&serverAddress, addrinfo->ai_addr, sizeof(sockaddr_in));
-        serverAddress.sin_port = htons(port);
-        freeaddrinfo(addrinfo);
+        auto serverAddress = resolve_address(address, port);
 
         SOCKET descriptor = socket(AF_INET, SOCK_STREAM, 0);
         if (descriptor == -1) {
             throw std::runtime_error("Could not create socket");
         }
-        auto socket = std::make_shared<SocketConnection>(descriptor, std::move(serverAddress));
+        auto socket = std::make_shared<SocketConnection>(
+            descriptor, std::move(serverAddress), readBufferSize
+        );
         socket->connect(std::move(callback));
         return socket;
     }
@@ -484,9 +504,15 @@ class SocketTcpSServer : public TcpServer {
     bool open = true;
     std::unique_ptr<std::thread> thread = nullptr;
     int port;
+    size_t readBufferSize;
 public:
-    SocketTcpSServer(Network* network, SOCKET descriptor, int port)
-    : network(network), descriptor(descriptor), port(port) {}
+    SocketTcpSServer(
+        Network* network, SOCKET descriptor, int port, size_t readBufferSize
+    )
+        : network(network),
+          descriptor(descriptor),
+          port(port),
+          readBufferSize(readBufferSize) {}
 
     ~SocketTcpSServer() {
         closeSocket();
@@ -510,7 +536,7 @@ public:
                 }
                 logger.info() << "client connected: " << to_string(address);
                 auto socket = std::make_shared<SocketConnection>(
-                    clientDescriptor, address
+                    clientDescriptor, address, readBufferSize
                 );
                 socket->startClient();
                 u64id_t id = network->addConnection(socket);
@@ -558,7 +584,10 @@ public:
     }
 
     static std::shared_ptr<SocketTcpSServer> openServer(
-        Network* network, int port, consumer<u64id_t> handler
+        Network* network,
+        int port,
+        size_t readBufferSize,
+        consumer<u64id_t> handler
     ) {
         SOCKET descriptor = socket(
             AF_INET, SOCK_STREAM, 0
@@ -584,18 +613,749 @@ public:
             throw std::runtime_error("could not bind port "+std::to_string(port));
         }
         logger.info() << "opened server at port " << port;
-        auto server =
-            std::make_shared<SocketTcpSServer>(network, descriptor, port);
+        auto server = std::make_shared<SocketTcpSServer>(
+            network, descriptor, port, readBufferSize
+        );
+        server->startListen(std::move(handler));
+        return server;
+    }
+};
+
+#ifdef __linux__
+
+/// @brief Readiness-based sockets I/O: each worker thread waits on its own
+/// epoll instance, sockets are distributed between workers round-robin.
+/// Handlers are referenced weakly, so destroyed sockets are never called.
+/// Events carry registration generation along with the descriptor, so an
+/// event of a closed socket is not delivered to a new socket that reused
+/// the descriptor
+class network::SocketsReactor {
+public:
+    class Handler {
+    public:
+        virtual ~Handler() = default;
+
+        /// @brief Called from the reactor thread on socket readiness
+        /// @param events epoll events mask
+        virtual void onEvents(uint32_t events) = 0;
+    };
+
+    SocketsReactor(int threadsCount) {
+        for (int i = 0; i < threadsCount; i++) {
+            auto worker = std::make_unique<Worker>();
+            worker->epoll = epoll_create1(EPOLL_CLOEXEC);
+            worker->wakeup = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (worker->epoll == -1 || worker->wakeup == -1) {
+                auto error = handle_socket_error("could not create epoll");
+                closeWorker(*worker);
+                throw error;
+            }
+            epoll_event event {};
+            event.events = EPOLLIN;
+            event.data.u64 = make_key(worker->wakeup, 0);
+            epoll_ctl(worker->epoll, EPOLL_CTL_ADD, worker->wakeup, &event);
+            workers.push_back(std::move(worker));
+        }
+        for (auto& worker : workers) {
+            worker->thread = std::thread([this, worker=worker.get()]() {
+                run(*worker);
+            });
+        }
+        logger.info() << "started sockets reactor with " << threadsCount
+                      << " thread(s)";
+    }
+
+    ~SocketsReactor() {
+        stop();
+        for (auto& worker : workers) {
+            closeWorker(*worker);
+        }
+    }
+
+    void add(SOCKET descriptor, std::weak_ptr<Handler> handler, uint32_t events) {
+        std::lock_guard lock(mutex);
+        size_t index = nextWorker++ % workers.size();
+        // zero generation is reserved for wakeup descriptors
+        if (++nextGeneration == 0) {
+            nextGeneration = 1;
+        }
+        epoll_event event {};
+        event.events = events;
+        event.data.u64 = make_key(descriptor, nextGeneration);
+        if (epoll_ctl(workers[index]->epoll, EPOLL_CTL_ADD, descriptor, &event)) {
+            throw handle_socket_error("epoll_ctl(ADD) error");
+        }
+        handlers[descriptor] = {std::move(handler), index, nextGeneration};
+    }
+
+    void modify(SOCKET descriptor, uint32_t events) {
+        std::lock_guard lock(mutex);
+        const auto& found = handlers.find(descriptor);
+        if (found == handlers.end()) {
+            return;
+        }
+        epoll_event event {};
+        event.events = events;
+        event.data.u64 = make_key(descriptor, found->second.generation);
+        epoll_ctl(
+            workers[found->second.worker]->epoll,
+            EPOLL_CTL_MOD,
+            descriptor,
+            &event
+        );
+    }
+
+    void remove(SOCKET descriptor) {
+        std::lock_guard lock(mutex);
+        const auto& found = handlers.find(descriptor);
+        if (found == handlers.end()) {
+            return;
+        }
+        epoll_ctl(
+            workers[found->second.worker]->epoll,
+            EPOLL_CTL_DEL,
+            descriptor,
+            nullptr
+        );
+        handlers.erase(found);
+    }
+
+    /// @brief Stop and join all reactor threads
+    void stop() {
+        if (!running.exchange(false)) {
+            return;
+        }
+        for (auto& worker : workers) {
+            uint64_t value = 1;
+            if (write(worker->wakeup, &value, sizeof(value)) == -1) {
+                logger.error() << "could not wake up sockets reactor thread";
+            }
+        }
+        for (auto& worker : workers) {
+            if (worker->thread.joinable()) {
+                worker->thread.join();
+            }
+        }
+    }
+private:
+    static constexpr int MAX_EVENTS = 64;
+
+    struct Worker {
+        int epoll = -1;
+        int wakeup = -1;
+        std::thread thread;
+    };
+
+    struct Entry {
+        std::weak_ptr<Handler> handler;
+        size_t worker;
+        uint32_t generation;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::unordered_map<SOCKET, Entry> handlers;
+    std::mutex mutex;
+    size_t nextWorker = 0;
+    uint32_t nextGeneration = 0;
+    std::atomic<bool> running = true;
+
+    static uint64_t make_key(int descriptor, uint32_t generation) {
+        return (static_cast<uint64_t>(generation) << 32) |
+               static_cast<uint32_t>(descriptor);
+    }
+
+    static void closeWorker(Worker& worker) {
+        if (worker.wakeup != -1) {
+            ::close(worker.wakeup);
+        }
+        if (worker.epoll != -1) {
+            ::close(worker.epoll);
+        }
+    }
+
+    void run(Worker& worker) {
+        epoll_event events[MAX_EVENTS];
+        while (running) {
+            int count = epoll_wait(worker.epoll, events, MAX_EVENTS, -1);
+            if (count < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                logger.error() << handle_socket_error("epoll_wait error").what();
+                break;
+            }
+            for (int i = 0; i < count && running; i++) {
+                uint64_t key = events[i].data.u64;
+                int descriptor = static_cast<uint32_t>(key);
+                uint32_t generation = key >> 32;
+                if (generation == 0) {
+                    uint64_t value;
+                    while (read(worker.wakeup, &value, sizeof(value)) > 0);
+                    continue;
+                }
+                std::shared_ptr<Handler> handler;
+                {
+                    std::lock_guard lock(mutex);
+                    const auto& found = handlers.find(descriptor);
+                    if (found != handlers.end() &&
+                        found->second.generation == generation) {
+                        handler = found->second.handler.lock();
+                    }
+                }
+                if (handler == nullptr) {
+                    continue;
+                }
+                try {
+                    handler->onEvents(events[i].events);
+                } catch (const std::exception& err) {
+                    logger.error() << err.what();
+                }
+            }
+        }
+    }
+};
+
+/// @brief Non-blocking socket connection served by the SocketsReactor.
+/// Outgoing data is queued up to the write queue capacity and flushed
+/// when the socket is writable, so send never blocks the caller
+class AsyncSocketConnection
+    : public Connection,
+      public SocketsReactor::Handler,
+      public std::enable_shared_from_this<AsyncSocketConnection> {
+    SocketsReactor& reactor;
+    SOCKET descriptor;
+    sockaddr_in addr;
+    size_t writeQueueSize;
+    std::atomic<size_t> totalUpload = 0;
+    std::atomic<size_t> totalDownload = 0;
+    std::atomic<ConnectionState> state = ConnectionState::INITIAL;
+    /// @brief Written by the reactor thread, read without locking
+    util::RingBuffer<char> readBuffer;
+    /// @brief Pending data starts at writeOffset. Sent prefix is removed
+    /// only when it exceeds the pending part, so each byte is moved at
+    /// most once on average
+    std::vector<char> writeQueue;
+    size_t writeOffset = 0;
+    /// @brief Reading is paused while the read buffer is full
+    std::atomic<bool> readPaused = false;
+    /// @brief Socket is removed from the reactor while reading is paused
+    /// after hang up, to not be woken up by EPOLLHUP again and again
+    bool detached = false;
+    uint32_t watchedEvents = 0;
+    runnable connectCallback;
+    std::mutex mutex;
+
+    uint32_t getInterest() const {
+        uint32_t events = 0;
+        if (!readPaused) {
+            events |= EPOLLIN;
+        }
+        // wait for writability only while there is something to write
+        if (state == ConnectionState::CONNECTING ||
+            writeOffset < writeQueue.size()) {
+            events |= EPOLLOUT;
+        }
+        return events;
+    }
+
+    void updateInterest() {
+        uint32_t events = getInterest();
+        if (events != watchedEvents) {
+            watchedEvents = events;
+            if (!detached) {
+                reactor.modify(descriptor, events);
+            }
+        }
+    }
+
+    void registerSocket() {
+        watchedEvents = getInterest();
+        reactor.add(descriptor, weak_from_this(), watchedEvents);
+    }
+
+    /// @brief Called by consumer when read buffer space is freed
+    void resumeRead() {
+        std::lock_guard lock(mutex);
+        if (!readPaused || state == ConnectionState::CLOSED) {
+            return;
+        }
+        readPaused = false;
+        if (detached) {
+            detached = false;
+            registerSocket();
+        } else {
+            updateInterest();
+        }
+    }
+
+    void onConsumed() {
+        // pairs with the fence in readAvailable: either the reader sees
+        // freed space or we see the pause flag
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (readPaused) {
+            resumeRead();
+        }
+    }
+
+    void closeSocket() {
+        if (state == ConnectionState::CLOSED) {
+            return;
+        }
+        reactor.remove(descriptor);
+        shutdown(descriptor, 2);
+        closesocket(descriptor);
+        state = ConnectionState::CLOSED;
+        writeQueue.clear();
+        writeOffset = 0;
+    }
+
+    void closeWithError(const std::string& message) {
+        auto error = handle_socket_error(message);
+        closeSocket();
+        logger.error() << error.what();
+    }
+
+    void flush() {
+        while (writeOffset < writeQueue.size()) {
+            int len = sendsocket(
+                descriptor,
+                writeQueue.data() + writeOffset,
+                writeQueue.size() - writeOffset,
+                MSG_NOSIGNAL
+            );
+            if (len < 0) {
+                if (errno == EINTR) {
+                    continue;
+                } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    break;
+                }
+                closeWithError("send(...) error");
+                return;
+            }
+            writeOffset += len;
+            totalUpload += len;
+        }
+        if (writeOffset == writeQueue.size()) {
+            writeQueue.clear();
+            writeOffset = 0;
+        }
+        updateInterest();
+    }
+
+    void readAvailable() {
+        while (state == ConnectionState::CONNECTED) {
+            size_t free;
+            char* region = readBuffer.writeRegion(free);
+            if (free == 0) {
+                readPaused = true;
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (readBuffer.space() == 0) {
+                    updateInterest();
+                    return;
+                }
+                readPaused = false;
+                continue;
+            }
+            int size = recvsocket(descriptor, region, free);
+            if (size == 0) {
+                logger.info() << "closed connection with " << to_string(addr);
+                closeSocket();
+                return;
+            } else if (size < 0) {
+                if (errno == EINTR) {
+                    continue;
+                } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    return;
+                }
+                logger.warning() << "an error ocurred while receiving from "
+                                 << to_string(addr);
+                closeWithError("recv(...) error");
+                return;
+            }
+            readBuffer.commit(size);
+            totalDownload += size;
+            logger.debug() << "read " << size << " bytes from "
+                           << to_string(addr);
+        }
+    }
+
+    /// @return true if connection is established
+    bool finishConnect() {
+        int error = 0;
+        socklen_t len = sizeof(error);
+        if (getsockopt(descriptor, SOL_SOCKET, SO_ERROR, &error, &len)) {
+            error = errno;
+        }
+        if (error) {
+            logger.error() << "connect to " << to_string(addr)
+                           << " failed [errno=" << error
+                           << "]: " << strerror(error);
+            closeSocket();
+            return false;
+        }
+        logger.info() << "connected to " << to_string(addr);
+        state = ConnectionState::CONNECTED;
+        flush();
+        return true;
+    }
+public:
+    AsyncSocketConnection(
+        SocketsReactor& reactor,
+        SOCKET descriptor,
+        sockaddr_in addr,
+        size_t writeQueueSize,
+        size_t readBufferSize
+    )
+        : reactor(reactor),
+          descriptor(descriptor),
+          addr(std::move(addr)),
+          writeQueueSize(writeQueueSize),
+          readBuffer(readBufferSize) {}
+
+    ~AsyncSocketConnection() {
+        closeSocket();
+    }
+
+    void onEvents(uint32_t events) override {
+        runnable callback;
+        {
+            std::lock_guard lock(mutex);
+            if (state == ConnectionState::CLOSED) {
+                return;
+            }
+            if (state == ConnectionState::CONNECTING) {
+                if ((events & (EPOLLOUT | EPOLLERR | EPOLLHUP)) &&
+                    finishConnect()) {
+                    callback = std::move(connectCallback);
+                }
+            } else {
+                if (events & (EPOLLIN | EPOLLERR | EPOLLHUP)) {
+                    readAvailable();
+                }
+                if (readPaused && !detached &&
+                    state == ConnectionState::CONNECTED &&
+                    (events & (EPOLLERR | EPOLLHUP))) {
+                    detached = true;
+                    reactor.remove(descriptor);
+                }
+                if ((events & EPOLLOUT) && state == ConnectionState::CONNECTED) {
+                    flush();
+                }
+            }
+        }
+        if (callback) {
+            callback();
+        }
+    }
+
+    void startClient() {
+        std::lock_guard lock(mutex);
+        state = ConnectionState::CONNECTED;
+        registerSocket();
+    }
+
+    void connect(runnable callback) override {
+        std::lock_guard lock(mutex);
+        connectCallback = std::move(callback);
+        state = ConnectionState::CONNECTING;
+        logger.info() << "connecting to " << to_string(addr);
+        int res = connectsocket(
+            descriptor, (const sockaddr*)&addr, sizeof(sockaddr_in)
+        );
+        if (res < 0 && errno != EINPROGRESS) {
+            auto error = handle_socket_error("Connect failed");
+            closesocket(descriptor);
+            state = ConnectionState::CLOSED;
+            logger.error() << error.what();
+            return;
+        }
+        // completion (even immediate) is reported by the reactor thread,
+        // so the callback is always called from the same context
+        registerSocket();
+    }
+
+    int recv(char* buffer, size_t length) override {
+        if (state != ConnectionState::CONNECTED && readBuffer.empty()) {
+            return -1;
+        }
+        int size = readBuffer.read(buffer, length);
+        onConsumed();
+        return size;
+    }
+
+    int peek(char* buffer, size_t length, size_t offset) override {
+        return readBuffer.peek(buffer, length, offset);
+    }
+
+    int send(const char* buffer, size_t length) override {
+        std::lock_guard lock(mutex);
+        if (state == ConnectionState::CLOSED) {
+            return 0;
+        }
+        size_t pending = writeQueue.size() - writeOffset;
+        if (writeOffset > pending) {
+            writeQueue.erase(
+                writeQueue.begin(), writeQueue.begin() + writeOffset
+            );
+            writeOffset = 0;
+        }
+        size_t space = writeQueueSize - std::min(pending, writeQueueSize);
+        size_t accepted = std::min(length, space);
+        if (accepted < length) {
+            logger.warning() << "write queue of " << to_string(addr)
+                             << " is full, " << (length - accepted)
+                             << " bytes rejected";
+        }
+        writeQueue.insert(writeQueue.end(), buffer, buffer + accepted);
+        if (state == ConnectionState::CONNECTED) {
+            flush();
+        }
+        return accepted;
+    }
+
+    int available() override {
+        return readBuffer.size();
+    }
+
+    size_t getWriteSpace() override {
+        std::lock_guard lock(mutex);
+        if (state == ConnectionState::CLOSED) {
+            return 0;
+        }
+        return writeQueueSize -
+               std::min(writeQueue.size() - writeOffset, writeQueueSize);
+    }
+
+    void close(bool discardAll=false) override {
+        std::lock_guard lock(mutex);
+        readBuffer.clear();
+        if (!discardAll && state == ConnectionState::CONNECTED) {
+            flush();
+        }
+        closeSocket();
+    }
+
+    size_t pullUpload() override {
+        return totalUpload.exchange(0);
+    }
+
+    size_t pullDownload() override {
+        return totalDownload.exchange(0);
+    }
+
+    int getPort() const override {
+        return htons(addr.sin_port);
+    }
+
+    std::string getAddress() const override {
+        return to_string(addr, false);
+    }
+
+    ConnectionState getState() const override {
+        return state;
+    }
+
+    static std::shared_ptr<AsyncSocketConnection> connect(
+        SocketsReactor& reactor,
+        size_t writeQueueSize,
+        size_t readBufferSize,
+        const std::string& address,
+        int port,
+        runnable callback
+    ) {
+        auto serverAddress = resolve_address(address, port);
+
+        SOCKET descriptor = socket(
+            AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0
+        );
+        if (descriptor == -1) {
+            throw std::runtime_error("Could not create socket");
+        }
+        auto socket = std::make_shared<AsyncSocketConnection>(
+            reactor,
+            descriptor,
+            std::move(serverAddress),
+            writeQueueSize,
+            readBufferSize
+        );
+        socket->connect(std::move(callback));
+        return socket;
+    }
+};
+
+class AsyncTcpServer
+    : public TcpServer,
+      public SocketsReactor::Handler,
+      public std::enable_shared_from_this<AsyncTcpServer> {
+    Network* network;
+    SocketsReactor& reactor;
+    size_t writeQueueSize;
+    size_t readBufferSize;
+    SOCKET descriptor;
+    std::vector<u64id_t> clients;
+    std::mutex clientsMutex;
+    std::atomic<bool> open = true;
+    consumer<u64id_t> handler;
+    int port;
+
+    void acceptClient(SOCKET clientDescriptor, const sockaddr_in& address) {
+        logger.info() << "client connected: " << to_string(address);
+        auto socket = std::make_shared<AsyncSocketConnection>(
+            reactor, clientDescriptor, address, writeQueueSize, readBufferSize
+        );
+        socket->startClient();
+        u64id_t id = network->addConnection(socket);
+        {
+            std::lock_guard lock(clientsMutex);
+            if (!open) {
+                socket->close(true);
+                return;
+            }
+            clients.push_back(id);
+        }
+        handler(id);
+    }
+public:
+    AsyncTcpServer(
+        Network* network,
+        SocketsReactor& reactor,
+        size_t writeQueueSize,
+        size_t readBufferSize,
+        SOCKET descriptor,
+        int port
+    )
+        : network(network),
+          reactor(reactor),
+          writeQueueSize(writeQueueSize),
+          readBufferSize(readBufferSize),
+          descriptor(descriptor),
+          port(port) {}
+
+    ~AsyncTcpServer() {
+        closeSocket();
+    }
+
+    void startListen(consumer<u64id_t> handler) override {
+        this->handler = std::move(handler);
+        logger.info() << "listening for connections";
+        if (listen(descriptor, SOMAXCONN) < 0) {
+            auto error = handle_socket_error("listen failed");
+            closeSocket();
+            throw error;
+        }
+        reactor.add(descriptor, weak_from_this(), EPOLLIN);
+    }
+
+    void onEvents(uint32_t events) override {
+        while (open) {
+            sockaddr_in address;
+            socklen_t addrlen = sizeof(sockaddr_in);
+            SOCKET clientDescriptor = accept4(
+                descriptor,
+                (sockaddr*)&address,
+                &addrlen,
+                SOCK_NONBLOCK | SOCK_CLOEXEC
+            );
+            if (clientDescriptor == -1) {
+                if (errno == EINTR || errno == ECONNABORTED) {
+                    continue;
+                } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    break;
+                }
+                logger.error() << handle_socket_error("accept failed").what();
+                closeSocket();
+                break;
+            }
+            acceptClient(clientDescriptor, address);
+        }
+    }
+
+    void closeSocket() {
+        if (!open.exchange(false)) {
+            return;
+        }
+        logger.info() << "closing server";
+        reactor.remove(descriptor);
+        {
+            std::lock_guard lock(clientsMutex);
+            for (u64id_t clientid : clients) {
+                if (auto client = network->getConnection(clientid)) {
+                    client->close();
+                }
+            }
+            clients.clear();
+        }
+        shutdown(descriptor, 2);
+        closesocket(descriptor);
+    }
+
+    void close() override {
+        closeSocket();
+    }
+
+    bool isOpen() override {
+        return open;
+    }
+
+    int getPort() const override {
+        return port;
+    }
+
+    static std::shared_ptr<AsyncTcpServer> openServer(
+        Network* network,
+        SocketsReactor& reactor,
+        size_t writeQueueSize,
+        size_t readBufferSize,
+        int port,
+        consumer<u64id_t> handler
+    ) {
+        SOCKET descriptor = socket(
+            AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0
+        );
+        if (descriptor == -1) {
+            throw std::runtime_error("Could not create server socket");
+        }
+        int opt = 1;
+        if (setsockopt(descriptor, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt))) {
+            closesocket(descriptor);
+            throw std::runtime_error("setsockopt");
+        }
+        sockaddr_in address {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = INADDR_ANY;
+        address.sin_port = htons(port);
+        if (bind(descriptor, (sockaddr*)&address, sizeof(address)) < 0) {
+            closesocket(descriptor);
+            throw std::runtime_error("could not bind port "+std::to_string(port));
+        }
+        logger.info() << "opened server at port " << port;
+        auto server = std::make_shared<AsyncTcpServer>(
+            network, reactor, writeQueueSize, readBufferSize, descriptor, port
+        );
         server->startListen(std::move(handler));
         return server;
     }
 };
 
-Network::Network(std::unique_ptr<Requests> requests)
-: requests(std::move(requests)) {
+#endif // __linux__
+
+Network::Network(
+    std::unique_ptr<Requests> requests, const NetworkSettings& settings
+)
+    : requests(std::move(requests)),
+      ioThreads(settings.ioThreads.get()),
+      writeQueueSize(settings.writeQueueSize.get()),
+      readBufferSize(settings.readBufferSize.get()) {
 }
 
-Network::~Network() = default;
+Network::~Network() {
+#ifdef __linux__
+    // no sockets events must be handled while connections are destroyed
+    if (reactor) {
+        reactor->stop();
+    }
+#endif
+}
 
 void Network::get(
     const std::string& url,
@@ -638,16 +1398,35 @@ u64id_t Network::connect(const std::string& address, int port, consumer<u64id_t>
     std::lock_guard lock(connectionsMutex);
     
     u64id_t id = nextConnection++;
-    auto socket = SocketConnection::connect(address, port, [id, callback]() {
-        callback(id);
-    });
+    runnable onConnect = [id, callback]() { callback(id); };
+#ifdef __linux__
+    auto socket = AsyncSocketConnection::connect(
+        *getReactor(),
+        writeQueueSize,
+        readBufferSize,
+        address,
+        port,
+        std::move(onConnect)
+    );
+#else
+    auto socket = SocketConnection::connect(
+        address, port, readBufferSize, std::move(onConnect)
+    );
+#endif
     connections[id] = std::move(socket);
     return id;
 }
 
 u64id_t Network::openServer(int port, consumer<u64id_t> handler) {
     u64id_t id = nextServer++;
-    auto server = SocketTcpSServer::openServer(this, port, handler);
+#ifdef __linux__
+    auto server = AsyncTcpServer::openServer(
+        this, *getReactor(), writeQueueSize, readBufferSize, port, handler
+    );
+#else
+    auto server =
+        SocketTcpSServer::openServer(this, port, readBufferSize, handler);
+#endif
     servers[id] = std::move(server);
     return id;
 }
@@ -660,6 +1439,21 @@ u64id_t Network::addConnection(const std::shared_ptr<Connection>& socket) {
     return id;
 }
 
+SocketsReactor* Network::getReactor() {
+#ifdef __linux__
+    if (reactor == nullptr) {
+        reactor = std::make_shared<SocketsReactor>(ioThreads);
+    }
+    return reactor.get();
+#else
+    return nullptr;
+#endif
+}
+
+size_t Network::getReadBufferSize() const {
+    return readBufferSize;
+}
+
 size_t Network::getTotalUpload() const {
     return requests->getTotalUpload() + totalUpload;
 }
@@ -699,5 +1493,5 @@ void Network::update() {
 
 std::unique_ptr<Network> Network::create(const NetworkSettings& settings) {
     auto requests = CurlRequests::create();
-    return std::make_unique<Network>(std::move(requests));
+    return std::make_unique<Network>(std::move(requests), settings);
 }
@@ -48,9 +48,18 @@ namespace network {
 
         virtual void connect(runnable callback) = 0;
         virtual int recv(char* buffer, size_t length) = 0;
+        /// @brief Copy received data without removing it from the buffer
+        /// @param offset number of bytes to skip
+        /// @return number of copied bytes
+        virtual int peek(char* buffer, size_t length, size_t offset=0) = 0;
+        /// @brief Send or enqueue data for sending
+        /// @return number of accepted bytes, may be less than length
+        /// if the connection write queue is full
         virtual int send(const char* buffer, size_t length) = 0;
         virtual void close(bool discardAll=false) = 0;
         virtual int available() = 0;
+        /// @return max number of bytes send will currently accept
+        virtual size_t getWriteSpace() = 0;
 
         virtual size_t pullUpload() = 0;
         virtual size_t pullDownload() = 0;
@@ -70,9 +79,18 @@ namespace network {
         virtual int getPort() const = 0;
     };
 
+    class SocketsReactor;
+
     class Network {
         std::unique_ptr<Requests> requests;
 
+        /// @brief Event-driven sockets I/O (Linux only), created on demand.
+        /// Declared before connections to be destroyed after them
+        std::shared_ptr<SocketsReactor> reactor;
+        int ioThreads;
+        size_t writeQueueSize;
+        size_t readBufferSize;
+
         std::unordered_map<u64id_t, std::shared_ptr<Connection>> connections;
         std::mutex connectionsMutex {};
         u64id_t nextConnection = 1;
@@ -83,7 +101,9 @@ namespace network {
         size_t totalDownload = 0;
         size_t totalUpload = 0;
     public:
-        Network(std::unique_ptr<Requests> requests);
+        Network(
+            std::unique_ptr<Requests> requests, const NetworkSettings& settings
+        );
         ~Network();
 
         void get(
@@ -110,6 +130,12 @@ namespace network {
 
         u64id_t addConnection(const std::shared_ptr<Connection>& connection);
 
+        /// @return Sockets reactor or nullptr if not supported
+        SocketsReactor* getReactor();
+
+        /// @return Min capacity of connections read buffers
+        size_t getReadBufferSize() const;
+
         size_t getTotalUpload() const;
         size_t getTotalDownload() const;
 
@@ -8,6 +8,7 @@
 #include "content/Content.hpp"
 #include "data/dv_util.hpp"
 #include "debug/Logger.hpp"
+#include "debug/Profiler.hpp"
 #include "engine/Engine.hpp"
 #include "graphics/core/DrawContext.hpp"
 #include "graphics/core/LineBatch.hpp"
@@ -20,10 +21,15 @@
 #include "rigging.hpp"
 #include "physics/Hitbox.hpp"
 #include "physics/PhysicsSolver.hpp"
+#include "physics/RaycastBatch.hpp"
+#include "util/parallel_for.hpp"
 #include "world/Level.hpp"
 
 static debug::Logger logger("entities");
 
+/// @brief Min number of skeletons per pose calculation thread
+static constexpr size_t SKELETONS_PER_THREAD = 64;
+
 static inline std::string COMP_TRANSFORM = "transform";
 static inline std::string COMP_RIGIDBODY = "rigidbody";
 static inline std::string COMP_SKELETON = "skeleton";
@@ -70,6 +76,7 @@ void Entity::setRig(const rigging::SkeletonConfig* rigConfig) {
     skeleton.calculated.matrices.resize(
         rigConfig->getBones().size(), glm::mat4(1.0f)
     );
+    skeleton.dirty = true;
 }
 
 Entities::Entities(Level& level)
@@ -231,6 +238,7 @@ void Entities::loadEntity(const dv::value& map, Entity entity) {
     map.at("skeleton").get(skeletonName);
     if (skeletonName != skeleton.config->getName()) {
         skeleton.config = level.content.getSkeleton(skeletonName);
+        skeleton.dirty = true;
     }
     if (auto found = map.at(COMP_SKELETON)) {
         auto& skeletonmap = *found;
@@ -247,6 +255,7 @@ void Entities::loadEntity(const dv::value& map, Entity entity) {
                  i++) {
                 dv::get_mat(posearr[i], skeleton.pose.matrices[i]);
             }
+            skeleton.dirty = true;
         }
     }
 }
@@ -282,6 +291,17 @@ std::optional<Entities::RaycastResult> Entities::rayCast(
     }
 }
 
+RaycastBatch Entities::createRaycastBatch() {
+    std::vector<RaycastBatch::Target> targets;
+    auto view = registry.view<EntityId, Transform, Rigidbody>();
+    for (auto [entity, eid, transform, body] : view.each()) {
+        if (body.enabled) {
+            targets.push_back({eid.uid, body.hitbox.getAABB()});
+        }
+    }
+    return RaycastBatch(std::move(targets));
+}
+
 void Entities::loadEntities(dv::value root) {
     clean();
     auto& list = root["data"];
@@ -458,6 +478,7 @@ void Entities::preparePhysics(float delta) {
 }
 
 void Entities::updatePhysics(float delta) {
+    PROFILE_ZONE("physics");
     preparePhysics(delta);
 
     auto view = registry.view<EntityId, Transform, Rigidbody>();
@@ -488,6 +509,7 @@ void Entities::updatePhysics(float delta) {
 }
 
 void Entities::update(float delta) {
+    PROFILE_ZONE("Entities::update");
     if (updateTickClock.update(delta)) {
         scripting::on_entities_update(
             updateTickClock.getTickRate(),
@@ -570,6 +592,7 @@ void Entities::render(
     float delta,
     bool pause
 ) {
+    std::vector<std::pair<const Transform*, rigging::Skeleton*>> visible;
     auto view = registry.view<Transform, rigging::Skeleton>();
     for (auto [entity, transform, skeleton] : view.each()) {
         if (transform.dirty) {
@@ -581,9 +604,23 @@ void Entities::render(
         const auto& pos = transform.pos;
         const auto& size = transform.size;
         if (!frustum || frustum->isBoxVisible(pos - size, pos + size)) {
-            const auto* rigConfig = skeleton.config;
-            rigConfig->render(assets, batch, skeleton, transform.combined, pos);
+            visible.emplace_back(&transform, &skeleton);
+        }
+    }
+    util::parallel_for(
+        visible.size(),
+        SKELETONS_PER_THREAD,
+        [&visible](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                const auto& [transform, skeleton] = visible[i];
+                skeleton->config->update(
+                    *skeleton, transform->combined, transform->pos
+                );
+            }
         }
+    );
+    for (const auto& [_, skeleton] : visible) {
+        skeleton->config->render(assets, batch, *skeleton);
     }
 }
 
@@ -105,6 +105,7 @@ class ModelBatch;
 class Frustum;
 class Entities;
 class DrawContext;
+class RaycastBatch;
 
 namespace rigging {
     struct Skeleton;
@@ -244,6 +245,10 @@ public:
         entityid_t ignore = -1
     );
 
+    /// @brief Create raycast batch with hitboxes of all entities having
+    /// enabled rigidbody
+    RaycastBatch createRaycastBatch();
+
     void loadEntities(dv::value map);
     void loadEntity(const dv::value& map);
     void loadEntity(const dv::value& map, Entity entity);
@@ -7,7 +7,7 @@
 #include "graphics/render/ModelBatch.hpp"
 
 #include <glm/ext/matrix_transform.hpp>
-#include <glm/gtx/matrix_decompose.hpp>
+#include <stdexcept>
 
 using namespace rigging;
 
@@ -53,69 +53,65 @@ Skeleton::Skeleton(const SkeletonConfig* config)
     }
 }
 
-static void get_all_nodes(std::vector<Bone*>& nodes, Bone* node) {
-    nodes[node->getIndex()] = node;
+static void get_all_nodes(
+    std::vector<Bone*>& nodes, std::vector<int>& parents, Bone* node, int parent
+) {
+    size_t index = node->getIndex();
+    if (index >= nodes.size() || static_cast<int>(index) <= parent) {
+        throw std::runtime_error("invalid bone index");
+    }
+    nodes[index] = node;
+    parents[index] = parent;
     for (auto& subnode : node->getSubnodes()) {
-        get_all_nodes(nodes, subnode.get());
+        get_all_nodes(nodes, parents, subnode.get(), index);
     }
 }
 
 SkeletonConfig::SkeletonConfig(
     const std::string& name, std::unique_ptr<Bone> root, size_t nodesCount
 )
-    : name(name), root(std::move(root)), nodes(nodesCount) {
-    get_all_nodes(nodes, this->root.get());
-}
-
-size_t SkeletonConfig::update(
-    size_t index, Skeleton& skeleton, Bone* node, const glm::mat4& matrix
-) const {
-    auto boneMatrix = skeleton.pose.matrices[index];
-    auto boneOffset = node->getOffset();
-    glm::mat4 baseMatrix(1.0f);
-    if (glm::length2(boneOffset) > 0.0f) {
-        baseMatrix = glm::translate(glm::mat4(1.0f), boneOffset);
-    }
-    skeleton.calculated.matrices[index] = matrix * baseMatrix * boneMatrix;
-    size_t count = 1;
-    for (auto& subnode : node->getSubnodes()) {
-        count += update(
-            index + count,
-            skeleton,
-            subnode.get(),
-            skeleton.calculated.matrices[index]
-        );
+    : name(name),
+      root(std::move(root)),
+      nodes(nodesCount),
+      parents(nodesCount, -1),
+      offsets(nodesCount) {
+    get_all_nodes(nodes, parents, this->root.get(), -1);
+    for (size_t i = 0; i < nodesCount; i++) {
+        offsets[i] = nodes[i]->getOffset();
     }
-    return count;
 }
 
-void SkeletonConfig::update(
+bool SkeletonConfig::update(
     Skeleton& skeleton, const glm::mat4& matrix, const glm::vec3& position
 ) const {
+    glm::mat4 rootMatrix = matrix;
     if (skeleton.interpolation.isEnabled()) {
-        const auto& interpolation = skeleton.interpolation;
-        glm::vec3 scale, translation, skew;
-        glm::quat rotation;
-        glm::vec4 perspective;
-        glm::decompose(matrix, scale, rotation, translation, skew, perspective);
-
-        auto delta = interpolation.getCurrent() - position;
-        auto interpolatedMatrix = glm::translate(matrix, delta);
-        update(0, skeleton, root.get(), interpolatedMatrix);
-    } else {
-        update(0, skeleton, root.get(), matrix);
+        auto delta = skeleton.interpolation.getCurrent() - position;
+        rootMatrix = glm::translate(matrix, delta);
     }
+    if (!skeleton.dirty && skeleton.calculatedMatrix == rootMatrix) {
+        return false;
+    }
+    const auto& pose = skeleton.pose.matrices;
+    auto& calculated = skeleton.calculated.matrices;
+    for (size_t i = 0; i < nodes.size(); i++) {
+        int parent = parents[i];
+        const auto& parentMatrix = parent == -1 ? rootMatrix : calculated[parent];
+        const auto& offset = offsets[i];
+        if (glm::length2(offset) > 0.0f) {
+            calculated[i] = glm::translate(parentMatrix, offset) * pose[i];
+        } else {
+            calculated[i] = parentMatrix * pose[i];
+        }
+    }
+    skeleton.calculatedMatrix = rootMatrix;
+    skeleton.dirty = false;
+    return true;
 }
 
 void SkeletonConfig::render(
-    const Assets& assets,
-    ModelBatch& batch,
-    Skeleton& skeleton,
-    const glm::mat4& matrix,
-    const glm::vec3& position
+    const Assets& assets, ModelBatch& batch, Skeleton& skeleton
 ) const {
-    update(skeleton, matrix, position);
-
     if (!skeleton.visible) {
         return;
     }
@@ -85,6 +85,11 @@ namespace rigging {
         std::vector<ModelReference> modelOverrides;
         bool visible;
         glm::vec3 tint {1.0f, 1.0f, 1.0f};
+        /// @brief Must be set after pose matrices modification to
+        /// recalculate the pose on the next update
+        bool dirty = true;
+        /// @brief Skeleton matrix used for the last calculated pose
+        glm::mat4 calculatedMatrix {1.0f};
 
         util::VecInterpolation<3, float> interpolation {false};
 
@@ -104,9 +109,12 @@ namespace rigging {
         /// 3 --- sub2
         std::vector<Bone*> nodes;
 
-        size_t update(
-            size_t index, Skeleton& skeleton, Bone* node, const glm::mat4& matrix
-        ) const;
+        /// @brief Flattened hierarchy: parent index for each bone (-1 for
+        /// root). Parents always precede children, so the pose is
+        /// calculated in a single forward pass.
+        std::vector<int> parents;
+        /// @brief Bone offsets relative to parent
+        std::vector<glm::vec3> offsets;
     public:
         SkeletonConfig(
             const std::string& name,
@@ -114,18 +122,23 @@ namespace rigging {
             size_t nodesCount
         );
 
-        void update(
+        /// @brief Calculate bones matrices. Skipped if neither pose nor
+        /// skeleton matrix has changed since the last calculation.
+        /// Touches only the skeleton, so different skeletons may be
+        /// updated in parallel.
+        /// @param skeleton target skeleton
+        /// @param matrix skeleton transform matrix
+        /// @param position actual (not interpolated) skeleton position
+        /// @return true if the pose has been recalculated
+        bool update(
             Skeleton& skeleton,
             const glm::mat4& matrix,
             const glm::vec3& position
         ) const;
 
+        /// @brief Draw skeleton using calculated pose (see update)
         void render(
-            const Assets& assets,
-            ModelBatch& batch,
-            Skeleton& skeleton,
-            const glm::mat4& matrix,
-            const glm::vec3& position
+            const Assets& assets, ModelBatch& batch, Skeleton& skeleton
         ) const;
 
         Skeleton instance() const {
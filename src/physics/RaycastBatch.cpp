@@ -0,0 +1,129 @@
+#include "RaycastBatch.hpp"
+
+#include <limits>
+
+#include "maths/rays.hpp"
+
+RaycastBatch::RaycastBatch(std::vector<Target> targets)
+    : targets(std::move(targets)) {
+    minCell = glm::ivec2(std::numeric_limits<int>::max());
+    maxCell = glm::ivec2(std::numeric_limits<int>::min());
+    for (size_t i = 0; i < this->targets.size(); i++) {
+        const auto& aabb = this->targets[i].aabb;
+        glm::vec3 min = aabb.min();
+        glm::vec3 max = aabb.max();
+        int minX = floordiv<CELL_SIZE>(static_cast<int>(std::floor(min.x)));
+        int minZ = floordiv<CELL_SIZE>(static_cast<int>(std::floor(min.z)));
+        int maxX = floordiv<CELL_SIZE>(static_cast<int>(std::floor(max.x)));
+        int maxZ = floordiv<CELL_SIZE>(static_cast<int>(std::floor(max.z)));
+        for (int z = minZ; z <= maxZ; z++) {
+            for (int x = minX; x <= maxX; x++) {
+                cells[glm::ivec2(x, z)].push_back(i);
+            }
+        }
+        minCell = glm::min(minCell, glm::ivec2(minX, minZ));
+        maxCell = glm::max(maxCell, glm::ivec2(maxX, maxZ));
+    }
+}
+
+/// @brief Check if the DDA moving along the axis will not reach
+/// [min, max] cells range anymore
+static inline bool is_passed(int i, int step, bool moves, int min, int max) {
+    if (!moves) {
+        return i < min || i > max;
+    }
+    return step > 0 ? i > max : i < min;
+}
+
+void RaycastBatch::testCell(
+    Ray& ray,
+    const Query& query,
+    const glm::ivec2& cell,
+    entityid_t ignore,
+    Hit& hit
+) const {
+    const auto& found = cells.find(cell);
+    if (found == cells.end()) {
+        return;
+    }
+    for (size_t index : found->second) {
+        const auto& target = targets[index];
+        if (target.uid == ignore) {
+            continue;
+        }
+        glm::ivec3 normal;
+        scalar_t distance;
+        if (ray.intersectAABB(
+                glm::vec3(), target.aabb, hit.distance, normal, distance
+            ) > RayRelation::None &&
+            distance < hit.distance) {
+            hit.entity = target.uid;
+            hit.normal = normal;
+            hit.distance = static_cast<float>(distance);
+        }
+    }
+}
+
+bool RaycastBatch::raycastEntities(
+    const Query& query, entityid_t ignore, Hit& hit
+) const {
+    if (targets.empty()) {
+        return false;
+    }
+    Ray ray(query.start, query.dir);
+    entityid_t prevEntity = hit.entity;
+
+    // 2D DDA over the grid cells in world units
+    float px = query.start.x / CELL_SIZE;
+    float pz = query.start.z / CELL_SIZE;
+    float dx = query.dir.x;
+    float dz = query.dir.z;
+
+    int ix = std::floor(px);
+    int iz = std::floor(pz);
+
+    int stepx = (dx > 0.0f) ? 1 : -1;
+    int stepz = (dz > 0.0f) ? 1 : -1;
+
+    constexpr float infinity = std::numeric_limits<float>::infinity();
+    constexpr float epsilon = 1e-6f;
+    float txDelta = (std::fabs(dx) < epsilon) ? infinity : std::fabs(CELL_SIZE / dx);
+    float tzDelta = (std::fabs(dz) < epsilon) ? infinity : std::fabs(CELL_SIZE / dz);
+
+    float xdist = (stepx > 0) ? (ix + 1 - px) : (px - ix);
+    float zdist = (stepz > 0) ? (iz + 1 - pz) : (pz - iz);
+
+    float txMax = (txDelta < infinity) ? txDelta * xdist : infinity;
+    float tzMax = (tzDelta < infinity) ? tzDelta * zdist : infinity;
+
+    bool movesX = txDelta < infinity;
+    bool movesZ = tzDelta < infinity;
+
+    float t = 0.0f;
+    // also limits rays with infinite max distance
+    float maxDistance =
+        std::min(hit.distance, std::numeric_limits<float>::max());
+    // hit.distance decreases on hit, so farther cells are skipped
+    while (t <= maxDistance && t <= hit.distance) {
+        // the rest of cells contain no targets
+        if (is_passed(ix, stepx, movesX, minCell.x, maxCell.x) ||
+            is_passed(iz, stepz, movesZ, minCell.y, maxCell.y)) {
+            break;
+        }
+        testCell(ray, query, glm::ivec2(ix, iz), ignore, hit);
+        // vertical ray stays in the same cell
+        if (!movesX && !movesZ) {
+            break;
+        }
+        if (txMax < tzMax) {
+            ix += stepx;
+            t = txMax;
+            txMax += txDelta;
+        } else {
+            iz += stepz;
+            t = tzMax;
+            tzMax += tzDelta;
+        }
+    }
+    return hit.entity != prevEntity;
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/glm.hpp>
+#include <glm/gtx/hash.hpp>
+
+#include "maths/aabb.hpp"
+#include "typedefs.hpp"
+#include "util/parallel_for.hpp"
+#include "voxels/blocks_agent.hpp"
+
+class Ray;
+
+/// @brief Casts many rays against blocks and entities in one call.
+/// Rays are sorted by the start chunk, so sequential rays mostly reuse
+/// the cached chunk pointer. Entities are looked up in a grid built once
+/// per batch instead of checking every entity for every ray.
+class RaycastBatch {
+public:
+    struct Query {
+        glm::vec3 start;
+        /// @brief normalized ray direction
+        glm::vec3 dir;
+        float maxDistance;
+    };
+
+    struct Hit {
+        /// @brief BLOCK_VOID if no block hit
+        blockid_t block = BLOCK_VOID;
+        /// @brief 0 if no entity hit
+        entityid_t entity = 0;
+        /// @brief distance to the nearest hit or query max distance
+        float distance = 0.0f;
+        glm::ivec3 normal {};
+        /// @brief hit block position
+        glm::ivec3 iend {};
+    };
+
+    struct Target {
+        entityid_t uid;
+        AABB aabb;
+    };
+
+    /// @brief Entities grid cell size
+    static inline constexpr int CELL_SIZE = 16;
+    /// @brief Min number of rays processed by a thread
+    static inline constexpr size_t MIN_THREAD_RAYS = 256;
+
+    /// @param targets entities hitboxes
+    explicit RaycastBatch(std::vector<Target> targets = {});
+
+    /// @brief Find nearest entity hit closer than hit.distance
+    /// @return true if hit is updated
+    bool raycastEntities(
+        const Query& query, entityid_t ignore, Hit& hit
+    ) const;
+
+    /// @brief Cast all rays
+    /// @param chunks chunks storage
+    /// @param queries rays
+    /// @param filter ignored blocks, not selectable blocks are ignored
+    /// if empty
+    /// @param ignore ignored entity
+    /// @return hits in order of queries
+    template <class Storage>
+    std::vector<Hit> perform(
+        const Storage& chunks,
+        const std::vector<Query>& queries,
+        const std::set<blockid_t>& filter,
+        entityid_t ignore = 0
+    ) const {
+        std::vector<Hit> hits(queries.size());
+        std::vector<std::pair<uint64_t, size_t>> order(queries.size());
+        for (size_t i = 0; i < queries.size(); i++) {
+            const auto& start = queries[i].start;
+            int cx = floordiv<CHUNK_W>(static_cast<int>(std::floor(start.x)));
+            int cz = floordiv<CHUNK_D>(static_cast<int>(std::floor(start.z)));
+            uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(cz))
+                            << 32) |
+                           static_cast<uint32_t>(cx);
+            order[i] = {key, i};
+        }
+        std::sort(order.begin(), order.end());
+
+        util::parallel_for(
+            order.size(),
+            MIN_THREAD_RAYS,
+            [&](size_t begin, size_t end) {
+                blocks_agent::ChunkCache cache;
+                glm::vec3 endPoint;
+                for (size_t i = begin; i < end; i++) {
+                    size_t index = order[i].second;
+                    const auto& query = queries[index];
+                    auto& hit = hits[index];
+                    hit.distance = query.maxDistance;
+                    if (auto voxel = blocks_agent::raycast(
+                            chunks,
+                            cache,
+                            query.start,
+                            query.dir,
+                            query.maxDistance,
+                            endPoint,
+                            hit.normal,
+                            hit.iend,
+                            filter
+                        )) {
+                        hit.block = voxel->id;
+                        hit.distance = glm::distance(query.start, endPoint);
+                    }
+                    raycastEntities(query, ignore, hit);
+                }
+            }
+        );
+        return hits;
+    }
+
+    size_t getTargetsCount() const {
+        return targets.size();
+    }
+private:
+    std::vector<Target> targets;
+    /// @brief Indices of targets intersecting XZ grid cells
+    std::unordered_map<glm::ivec2, std::vector<size_t>> cells;
+    /// @brief Min and max cells containing targets
+    glm::ivec2 minCell {};
+    glm::ivec2 maxCell {};
+
+    void testCell(
+        Ray& ray,
+        const Query& query,
+        const glm::ivec2& cell,
+        entityid_t ignore,
+        Hit& hit
+    ) const;
+};
@@ -67,12 +67,17 @@ struct GraphicsSettings {
     FlagSetting denseRender {true};
     /// @brief Enable chunks frustum culling
     FlagSetting frustumCulling {true};
+    /// @brief Skip chunks hidden behind opaque blocks (caves culling)
+    FlagSetting occlusionCulling {true};
     /// @brief Skybox texture face resolution
     IntegerSetting skyboxResolution {64 + 32, 64, 128};
     /// @brief Chunk renderer vertices buffer capacity
     IntegerSetting chunkMaxVertices {200'000, 0, 4'000'000};
     /// @brief Chunk renderer vertices buffer capacity in dense render mode
     IntegerSetting chunkMaxVerticesDense {800'000, 0, 8'000'000};
+    /// @brief Distance in chunks from which chunks are meshed with lower
+    /// level of detail (halved again at double distance), 0 to disable
+    IntegerSetting chunkLodDistance {16, 0, 80};
     /// @brief Limit of chunk renderers count
     IntegerSetting chunkMaxRenderers {6, -4, 32};
 };
@@ -82,6 +87,21 @@ struct DebugSettings {
     FlagSetting generatorTestMode {false};
     /// @brief Write lights cache
     FlagSetting doWriteLights {true};
+    /// @brief Min level of messages written to the log file:
+    /// debug, info, warning, error
+    StringSetting logFileLevel {"debug"};
+    /// @brief Min level of messages written to stdout
+    StringSetting logConsoleLevel {"debug"};
+};
+
+struct StorageSettings {
+    /// @brief Region layers compression in format `method[:level]`.
+    /// Available methods: none, extrle8, extrle16, gzip, lz4, zstd
+    StringSetting voxelsCompression {"extrle16"};
+    StringSetting lightsCompression {"extrle8"};
+    StringSetting inventoriesCompression {"none"};
+    StringSetting entitiesCompression {"none"};
+    StringSetting blocksDataCompression {"none"};
 };
 
 struct UiSettings {
@@ -90,6 +110,23 @@ struct UiSettings {
 };
 
 struct NetworkSettings {
+    /// @brief Max number of sockets I/O threads (epoll backend)
+    IntegerSetting ioThreads {1, 1, 16};
+    /// @brief Max bytes queued for sending per connection.
+    /// Sending to a connection with full queue is partial
+    IntegerSetting writeQueueSize {4 * 1024 * 1024, 16 * 1024, 256 * 1024 * 1024};
+    /// @brief Per-connection receive ring buffer size.
+    /// Reading from socket pauses while the buffer is full
+    IntegerSetting readBufferSize {1024 * 1024, 16 * 1024, 256 * 1024 * 1024};
+};
+
+struct MetricsSettings {
+    /// @brief Metrics export file path (empty to disable export)
+    StringSetting exportFile {""};
+    /// @brief Export interval in seconds
+    IntegerSetting exportInterval {10, 1, 3600};
+    /// @brief Export format: 'prometheus' or 'jsonl'
+    StringSetting exportFormat {"prometheus"};
 };
 
 struct EngineSettings {
@@ -99,6 +136,8 @@ struct EngineSettings {
     CameraSettings camera;
     GraphicsSettings graphics;
     DebugSettings debug;
+    StorageSettings storage;
     UiSettings ui;
     NetworkSettings network;
+    MetricsSettings metrics;
 };
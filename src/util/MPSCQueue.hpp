@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+namespace util {
+    /// @brief Unbounded lock-free multi-producer single-consumer queue
+    /// (intrusive Vyukov queue). Push is wait-free: one atomic exchange.
+    /// @note Pop may temporarily return false while a producer is between
+    /// exchange and link, following elements become visible after that
+    /// @tparam T element type (default constructible)
+    template <typename T>
+    class MPSCQueue {
+        struct Node {
+            std::atomic<Node*> next {nullptr};
+            T value;
+
+            Node() = default;
+            Node(T value) : value(std::move(value)) {
+            }
+        };
+        /// @brief Last pushed node, written by producers
+        alignas(64) std::atomic<Node*> head;
+        /// @brief Already consumed node, written by consumer only
+        alignas(64) Node* tail;
+    public:
+        MPSCQueue() : head(new Node()), tail(head.load()) {
+        }
+
+        MPSCQueue(const MPSCQueue&) = delete;
+
+        ~MPSCQueue() {
+            while (tail) {
+                Node* next = tail->next.load(std::memory_order_relaxed);
+                delete tail;
+                tail = next;
+            }
+        }
+
+        /// @brief Producer: push element (thread-safe)
+        void push(T value) {
+            Node* node = new Node(std::move(value));
+            Node* prev = head.exchange(node, std::memory_order_acq_rel);
+            prev->next.store(node, std::memory_order_release);
+        }
+
+        /// @brief Consumer: pop element
+        /// @return false if queue is empty
+        bool pop(T& dst) {
+            Node* next = tail->next.load(std::memory_order_acquire);
+            if (next == nullptr) {
+                return false;
+            }
+            dst = std::move(next->value);
+            delete tail;
+            tail = next;
+            return true;
+        }
+    };
+}
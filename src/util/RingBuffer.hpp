@@ -0,0 +1,145 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <cstring>
+#include <algorithm>
+
+namespace util {
+    /// @brief Fixed-capacity lock-free single-producer single-consumer
+    /// ring buffer of trivially copyable elements.
+    /// Positions are not wrapped, so size is always tail - head.
+    /// @tparam T element type
+    template <typename T>
+    class RingBuffer {
+        std::unique_ptr<T[]> buffer;
+        size_t mask;
+        /// @brief Read position, written by consumer only
+        alignas(64) std::atomic<size_t> head {0};
+        /// @brief Write position, written by producer only
+        alignas(64) std::atomic<size_t> tail {0};
+
+        static size_t round_capacity(size_t capacity) {
+            size_t result = 1;
+            while (result < capacity) {
+                result <<= 1;
+            }
+            return result;
+        }
+
+        /// @brief Copy elements from buffer starting at absolute position
+        void copyOut(size_t position, T* dst, size_t count) const {
+            size_t index = position & mask;
+            size_t first = std::min(count, capacity() - index);
+            std::memcpy(dst, buffer.get() + index, first * sizeof(T));
+            std::memcpy(dst + first, buffer.get(), (count - first) * sizeof(T));
+        }
+    public:
+        /// @param capacity min capacity, rounded up to power of two
+        RingBuffer(size_t capacity)
+            : buffer(std::make_unique<T[]>(round_capacity(capacity))),
+              mask(round_capacity(capacity) - 1) {
+        }
+
+        RingBuffer(const RingBuffer&) = delete;
+
+        size_t capacity() const {
+            return mask + 1;
+        }
+
+        /// @brief Number of stored elements. Exact for the consumer,
+        /// lower estimate for the producer
+        size_t size() const {
+            return tail.load(std::memory_order_acquire) -
+                   head.load(std::memory_order_acquire);
+        }
+
+        /// @brief Number of elements that can be written. Exact for the
+        /// producer, lower estimate for the consumer
+        size_t space() const {
+            return capacity() - size();
+        }
+
+        bool empty() const {
+            return size() == 0;
+        }
+
+        /// @brief Producer: write elements
+        /// @return number of written elements (less than count if full)
+        size_t write(const T* src, size_t count) {
+            size_t position = tail.load(std::memory_order_relaxed);
+            count = std::min(
+                count,
+                capacity() - (position - head.load(std::memory_order_acquire))
+            );
+            size_t index = position & mask;
+            size_t first = std::min(count, capacity() - index);
+            std::memcpy(buffer.get() + index, src, first * sizeof(T));
+            std::memcpy(buffer.get(), src + first, (count - first) * sizeof(T));
+            tail.store(position + count, std::memory_order_release);
+            return count;
+        }
+
+        /// @brief Producer: get contiguous free region for direct writing
+        /// (e.g. recv into it). Call commit after writing
+        /// @param count writable elements in the region
+        /// @return region start
+        T* writeRegion(size_t& count) {
+            size_t position = tail.load(std::memory_order_relaxed);
+            size_t free =
+                capacity() - (position - head.load(std::memory_order_acquire));
+            size_t index = position & mask;
+            count = std::min(free, capacity() - index);
+            return buffer.get() + index;
+        }
+
+        /// @brief Producer: publish elements written to writeRegion
+        void commit(size_t count) {
+            tail.store(
+                tail.load(std::memory_order_relaxed) + count,
+                std::memory_order_release
+            );
+        }
+
+        /// @brief Consumer: copy elements without removing them
+        /// @param offset number of elements to skip
+        /// @return number of copied elements
+        size_t peek(T* dst, size_t count, size_t offset=0) const {
+            size_t position = head.load(std::memory_order_relaxed);
+            size_t stored = tail.load(std::memory_order_acquire) - position;
+            if (offset >= stored) {
+                return 0;
+            }
+            count = std::min(count, stored - offset);
+            copyOut(position + offset, dst, count);
+            return count;
+        }
+
+        /// @brief Consumer: remove elements without copying
+        /// @return number of removed elements
+        size_t skip(size_t count) {
+            size_t position = head.load(std::memory_order_relaxed);
+            count = std::min(
+                count, tail.load(std::memory_order_acquire) - position
+            );
+            head.store(position + count, std::memory_order_release);
+            return count;
+        }
+
+        /// @brief Consumer: copy and remove elements
+        /// @return number of read elements
+        size_t read(T* dst, size_t count) {
+            count = peek(dst, count);
+            head.store(
+                head.load(std::memory_order_relaxed) + count,
+                std::memory_order_release
+            );
+            return count;
+        }
+
+        /// @brief Consumer: remove all stored elements
+        void clear() {
+            skip(size());
+        }
+    };
+}
@@ -125,6 +125,12 @@ namespace util {
             return read_int_le<Tsize>(ptr, -1);
         }
 
+        /// @brief Remove all entries keeping the allocated buffer
+        void clear() {
+            buffer.clear();
+            entriesCount = 0;
+        }
+
         /// @return number of entries
         Tindex count() const {
             return entriesCount;
@@ -154,10 +160,34 @@ namespace util {
             return out;
         }
 
+        /// @brief Load entries serialized with serialize()
+        /// @throws std::invalid_argument if data is truncated or entries
+        /// do not match its size
         void deserialize(const ubyte* src, size_t size) {
-            entriesCount = read_int_le<Tindex>(src);
-            buffer.resize(size - sizeof(Tindex));
-            std::memcpy(buffer.data(), src + sizeof(Tindex), buffer.size());
+            if (size < sizeof(Tindex)) {
+                throw std::invalid_argument("heap data is too short");
+            }
+            Tindex count = read_int_le<Tindex>(src);
+            const ubyte* data = src + sizeof(Tindex);
+            size_t length = size - sizeof(Tindex);
+            size_t offset = 0;
+            for (size_t i = 0; i < count; i++) {
+                if (length - offset < sizeof(Tindex) + sizeof(Tsize)) {
+                    throw std::invalid_argument("heap data is truncated");
+                }
+                offset += sizeof(Tindex);
+                Tsize entrySize = read_int_le<Tsize>(data + offset);
+                offset += sizeof(Tsize);
+                if (length - offset < entrySize) {
+                    throw std::invalid_argument("heap data is truncated");
+                }
+                offset += entrySize;
+            }
+            if (offset != length) {
+                throw std::invalid_argument("heap data size mismatch");
+            }
+            entriesCount = count;
+            buffer.assign(data, data + length);
         }
 
         struct const_iterator {
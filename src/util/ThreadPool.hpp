@@ -10,6 +10,7 @@
 #include <utility>
 
 #include "debug/Logger.hpp"
+#include "debug/Profiler.hpp"
 #include "delegates.hpp"
 #include "interfaces/Task.hpp"
 
@@ -34,6 +35,7 @@ namespace util {
 
     template <class T, class R>
     class ThreadPool : public Task {
+        std::string name;
         debug::Logger logger;
         std::queue<T> jobs;
         std::queue<ThreadPoolResult<T, R>> results;
@@ -53,6 +55,9 @@ namespace util {
         bool stopOnFail = true;
 
         void threadLoop(int index, std::shared_ptr<Worker<T, R>> worker) {
+            debug::Profiler::setThreadName(
+                name + " #" + std::to_string(index)
+            );
             std::condition_variable variable;
             std::mutex mutex;
             bool locked = false;
@@ -119,7 +124,7 @@ namespace util {
             consumer<R&> resultConsumer,
             int maxWorkers=UNLIMITED
         )
-            : logger(std::move(name)), resultConsumer(resultConsumer) {
+            : name(name), logger(name), resultConsumer(resultConsumer) {
             uint numThreads = std::thread::hardware_concurrency();
             switch (maxWorkers) {
                 case UNLIMITED:
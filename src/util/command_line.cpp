@@ -8,6 +8,15 @@
 
 namespace fs = std::filesystem;
 
+static int next_int(util::ArgsReader& reader) {
+    auto token = reader.next();
+    try {
+        return std::stoi(token);
+    } catch (const std::logic_error&) {
+        throw std::runtime_error("integer expected, got " + token);
+    }
+}
+
 static bool perform_keyword(
     util::ArgsReader& reader, const std::string& keyword, CoreParameters& params
 ) {
@@ -28,6 +37,12 @@ static bool perform_keyword(
         std::cout << " --headless - run in headless mode\n";
         std::cout << " --test <path> - test script file\n";
         std::cout << " --script <path> - main script file\n";
+        std::cout << " --pregen <world> - pre-generate world chunks and exit"
+                     " (headless)\n";
+        std::cout << " --pregen-radius <chunks> - pre-generation area radius"
+                     " around 0, 0 (default: 32)\n";
+        std::cout << " --pregen-area <x1> <z1> <x2> <z2> - pre-generation area"
+                     " in chunks\n";
         std::cout << std::endl;
         return false;
     } else if (keyword == "--version") {
@@ -39,6 +54,18 @@ static bool perform_keyword(
         auto token = reader.next();
         params.testMode = true;
         params.scriptFile = token;
+    } else if (keyword == "--pregen") {
+        params.headless = true;
+        params.pregenWorld = reader.next();
+    } else if (keyword == "--pregen-radius") {
+        int radius = next_int(reader);
+        params.pregenMin = glm::ivec2(-radius);
+        params.pregenMax = glm::ivec2(radius);
+    } else if (keyword == "--pregen-area") {
+        params.pregenMin.x = next_int(reader);
+        params.pregenMin.y = next_int(reader);
+        params.pregenMax.x = next_int(reader);
+        params.pregenMax.y = next_int(reader);
     } else if (keyword == "--script") {
         auto token = reader.next();
         params.testMode = false;
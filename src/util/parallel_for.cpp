@@ -0,0 +1,66 @@
+#include "parallel_for.hpp"
+
+using namespace util;
+
+ParallelPool::ParallelPool(size_t threadsCount) {
+    threads.reserve(threadsCount);
+    for (size_t i = 0; i < threadsCount; i++) {
+        threads.emplace_back(&ParallelPool::threadLoop, this);
+    }
+}
+
+ParallelPool::~ParallelPool() {
+    {
+        std::lock_guard lock(mutex);
+        stopped = true;
+    }
+    jobsCv.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void ParallelPool::runPart(Job& job, std::unique_lock<std::mutex>& lock) {
+    size_t part = job.next++;
+    if (job.next == job.parts) {
+        jobs.erase(std::find(jobs.begin(), jobs.end(), &job));
+    }
+    lock.unlock();
+    job.func(part);
+    lock.lock();
+    if (++job.finished == job.parts) {
+        doneCv.notify_all();
+    }
+}
+
+void ParallelPool::threadLoop() {
+    std::unique_lock lock(mutex);
+    while (true) {
+        jobsCv.wait(lock, [this]() { return stopped || !jobs.empty(); });
+        if (stopped) {
+            return;
+        }
+        runPart(*jobs.front(), lock);
+    }
+}
+
+void ParallelPool::run(size_t parts, const std::function<void(size_t)>& func) {
+    if (parts == 0) {
+        return;
+    }
+    Job job {func, parts};
+    std::unique_lock lock(mutex);
+    jobs.push_back(&job);
+    jobsCv.notify_all();
+    while (job.next < job.parts) {
+        runPart(job, lock);
+    }
+    doneCv.wait(lock, [&job]() { return job.finished == job.parts; });
+}
+
+ParallelPool& ParallelPool::global() {
+    static ParallelPool pool(
+        std::max(1u, std::thread::hardware_concurrency()) - 1
+    );
+    return pool;
+}
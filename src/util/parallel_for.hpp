@@ -0,0 +1,75 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace util {
+    /// @brief Persistent worker threads used by parallel_for.
+    /// Calling thread processes parts of its job too, so nested and
+    /// concurrent calls never wait for a free worker
+    class ParallelPool {
+        struct Job {
+            const std::function<void(size_t)>& func;
+            size_t parts;
+            size_t next = 0;
+            size_t finished = 0;
+        };
+        std::vector<std::thread> threads;
+        std::mutex mutex;
+        std::condition_variable jobsCv;
+        std::condition_variable doneCv;
+        std::deque<Job*> jobs;
+        bool stopped = false;
+
+        void threadLoop();
+        /// @brief Process next part of the job
+        /// @param lock locked pool mutex, unlocked while the part is processed
+        void runPart(Job& job, std::unique_lock<std::mutex>& lock);
+    public:
+        /// @param threadsCount number of worker threads
+        explicit ParallelPool(size_t threadsCount);
+        ~ParallelPool();
+
+        ParallelPool(const ParallelPool&) = delete;
+
+        /// @brief Call func(part) for each part in [0, parts) and wait
+        /// until all parts are processed
+        void run(size_t parts, const std::function<void(size_t)>& func);
+
+        /// @brief Max number of parts processed at the same time
+        size_t getConcurrency() const {
+            return threads.size() + 1;
+        }
+
+        /// @brief Get pool shared by all parallel_for calls
+        static ParallelPool& global();
+    };
+
+    /// @brief Split [0, count) range into parts and process them in parallel
+    /// using the global pool. The calling thread processes parts too.
+    /// @param count range size
+    /// @param minPart min number of elements in a part. Range is processed
+    /// in the calling thread if count is less than minPart * 2
+    /// @param func callback func(begin, end). Must not throw
+    template <typename Func>
+    void parallel_for(size_t count, size_t minPart, const Func& func) {
+        auto& pool = ParallelPool::global();
+        size_t parts = std::min<size_t>(
+            pool.getConcurrency(), count / std::max<size_t>(minPart, 1)
+        );
+        if (parts <= 1) {
+            func(size_t(0), count);
+            return;
+        }
+        size_t step = (count + parts - 1) / parts;
+        pool.run((count + step - 1) / step, [&](size_t part) {
+            size_t begin = part * step;
+            func(begin, std::min(begin + step, count));
+        });
+    }
+}
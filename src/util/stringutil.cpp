@@ -611,3 +611,16 @@ std::pair<std::string, std::string> util::split_at(
         std::string(view.substr(0, idx)), std::string(view.substr(idx + 1))
     );
 }
+
+util::TextEdit util::find_edit(std::wstring_view from, std::wstring_view to) {
+    size_t minLength = std::min(from.length(), to.length());
+    size_t prefix = std::mismatch(
+        from.begin(), from.begin() + minLength, to.begin()
+    ).first - from.begin();
+    size_t suffix = std::mismatch(
+        from.rbegin(), from.rbegin() + (minLength - prefix), to.rbegin()
+    ).first - from.rbegin();
+    return TextEdit {
+        prefix, from.length() - prefix - suffix, to.length() - prefix - suffix
+    };
+}
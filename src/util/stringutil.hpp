@@ -116,6 +116,22 @@ namespace util {
 
     std::pair<std::string, std::string> split_at(std::string_view view, char c);
 
+    /// @brief Single replacement turning one text version into another
+    struct TextEdit {
+        size_t start;
+        size_t removed;
+        size_t inserted;
+
+        bool empty() const {
+            return removed == 0 && inserted == 0;
+        }
+    };
+
+    /// @brief Find replacement keeping the longest common prefix and suffix
+    /// @param from previous text version
+    /// @param to new text version
+    TextEdit find_edit(std::wstring_view from, std::wstring_view to);
+
     template <typename CharT>
     std::vector<std::basic_string<CharT>> split_by_n(
         const std::basic_string<CharT>& str, size_t n
@@ -1,5 +1,6 @@
 #include "Chunk.hpp"
 
+#include <atomic>
 #include <utility>
 
 #include "content/ContentReport.hpp"
@@ -8,11 +9,29 @@
 #include "util/data_io.hpp"
 #include "voxel.hpp"
 
-Chunk::Chunk(int xpos, int zpos) : x(xpos), z(zpos) {
+Chunk::Chunk(int xpos, int zpos)
+    : x(xpos), z(zpos), version(generateVersion()) {
     bottom = 0;
     top = CHUNK_H;
 }
 
+void Chunk::reset(int xpos, int zpos) {
+    x = xpos;
+    z = zpos;
+    bottom = 0;
+    top = CHUNK_H;
+    flags = {};
+    inventories.clear();
+    blocksMetadata.clear();
+    lightmap.highestPoint = 0;
+    updateVersion();
+}
+
+uint64_t Chunk::generateVersion() {
+    static std::atomic<uint64_t> nextVersion = 1;
+    return nextVersion.fetch_add(1, std::memory_order_relaxed);
+}
+
 void Chunk::updateHeights() {
     for (uint i = 0; i < CHUNK_VOL; i++) {
         if (voxels[i].id != 0) {
@@ -96,11 +115,16 @@ bool Chunk::decode(const ubyte* data) {
     return true;
 }
 
-void Chunk::convert(ubyte* data, const ContentReport* report) {
+bool Chunk::convert(ubyte* data, const ContentReport* report) {
     auto buffer = reinterpret_cast<uint16_t*>(data);
+    bool modified = false;
     for (uint i = 0; i < CHUNK_VOL; i++) {
         blockid_t id = dataio::le2h(buffer[i]);
         blockid_t replacement = report->blocks.getId(id);
-        buffer[i] = dataio::h2le(replacement);
+        if (replacement != id) {
+            buffer[i] = dataio::h2le(replacement);
+            modified = true;
+        }
     }
+    return modified;
 }
@@ -43,9 +43,23 @@ public:
     ChunkInventoriesMap inventories;
     /// @brief Blocks metadata heap
     BlocksMetadata blocksMetadata;
+    /// @brief Voxels and blocks metadata version. Updated on modification,
+    /// unique across all chunks
+    uint64_t version;
 
     Chunk(int x, int z);
 
+    /// @brief Reset chunk state to reuse it for another position.
+    /// Voxels and lightmap content is kept as is
+    void reset(int x, int z);
+
+    /// @brief Generate new unique chunk data version (thread-safe)
+    static uint64_t generateVersion();
+
+    inline void updateVersion() {
+        version = generateVersion();
+    }
+
     /// @brief Refresh `bottom` and `top` values
     void updateHeights();
 
@@ -66,6 +80,7 @@ public:
     inline void setModifiedAndUnsaved() {
         flags.modified = true;
         flags.unsaved = true;
+        updateVersion();
     }
 
     /// @brief Encode chunk to bytes array of size CHUNK_DATA_LEN
@@ -75,7 +90,9 @@ public:
     /// @return true if all is fine
     bool decode(const ubyte* data);
 
-    static void convert(ubyte* data, const ContentReport* report);
+    /// @brief Replace block ids in encoded chunk data
+    /// @return true if any id is changed
+    static bool convert(ubyte* data, const ContentReport* report);
 
     AABB getAABB() const {
         return AABB(
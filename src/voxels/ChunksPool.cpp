@@ -0,0 +1,51 @@
+#include "ChunksPool.hpp"
+
+#include "Chunk.hpp"
+
+ChunksPool::ChunksPool(size_t capacity) : capacity(capacity) {
+}
+
+ChunksPool::~ChunksPool() = default;
+
+std::shared_ptr<Chunk> ChunksPool::acquire(int x, int z, bool& recycled) {
+    std::unique_ptr<Chunk> chunk;
+    {
+        std::lock_guard lock(mutex);
+        if (!freeChunks.empty()) {
+            chunk = std::move(freeChunks.back());
+            freeChunks.pop_back();
+        }
+    }
+    recycled = chunk != nullptr;
+    if (recycled) {
+        chunk->reset(x, z);
+    } else {
+        chunk = std::make_unique<Chunk>(x, z);
+    }
+    // chunks may outlive the pool
+    std::weak_ptr<ChunksPool> pool = weak_from_this();
+    return std::shared_ptr<Chunk>(chunk.release(), [pool](Chunk* ptr) {
+        if (auto owner = pool.lock()) {
+            owner->release(ptr);
+        } else {
+            delete ptr;
+        }
+    });
+}
+
+void ChunksPool::release(Chunk* chunk) {
+    // block inventories must not be kept alive by free chunks
+    chunk->inventories.clear();
+
+    std::lock_guard lock(mutex);
+    if (freeChunks.size() < capacity) {
+        freeChunks.emplace_back(chunk);
+    } else {
+        delete chunk;
+    }
+}
+
+size_t ChunksPool::countFree() {
+    std::lock_guard lock(mutex);
+    return freeChunks.size();
+}
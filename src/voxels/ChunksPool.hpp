@@ -0,0 +1,40 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class Chunk;
+
+/// @brief Thread-safe pool of unloaded chunks kept for reuse.
+/// Recycled chunks keep voxels, lightmap and metadata heap storage, so
+/// loading a chunk again requires no allocation and zeroing.
+/// Number of free chunks is limited by the pool capacity, excess chunks
+/// are deleted.
+/// @attention Must be created with std::make_shared
+class ChunksPool : public std::enable_shared_from_this<ChunksPool> {
+    std::vector<std::unique_ptr<Chunk>> freeChunks;
+    std::mutex mutex;
+    size_t capacity;
+
+    void release(Chunk* chunk);
+public:
+    /// @param capacity max number of free chunks
+    explicit ChunksPool(size_t capacity);
+    ~ChunksPool();
+
+    /// @brief Get a free chunk or allocate a new one
+    /// @param x chunk x
+    /// @param z chunk z
+    /// @param recycled [out] true if chunk is recycled: voxels and lightmap
+    /// contain previous chunk data and must be overwritten or cleared
+    /// @return pointer that brings chunk back to the pool when destroyed
+    std::shared_ptr<Chunk> acquire(int x, int z, bool& recycled);
+
+    /// @return number of free chunks
+    size_t countFree();
+
+    size_t getCapacity() const {
+        return capacity;
+    }
+};
@@ -0,0 +1,181 @@
+#include "EncodedChunksCache.hpp"
+
+#include <algorithm>
+
+#include "coders/rle.hpp"
+#include "compressed_chunks.hpp"
+#include "world/files/WorldRegions.hpp"
+
+EncodedChunksCache::EncodedChunksCache(size_t capacity)
+    : capacity(capacity), rleBuffer(CHUNK_DATA_LEN * 2) {
+}
+
+EncodedChunksCache::~EncodedChunksCache() = default;
+
+void EncodedChunksCache::update(
+    Entry& entry,
+    uint64_t version,
+    const ubyte* voxelData,
+    const BlocksMetadata& metadata
+) {
+    size_t rleSize =
+        extrle::encode16(voxelData, CHUNK_DATA_LEN, rleBuffer.data());
+    entry.payload = std::make_shared<const std::vector<ubyte>>(
+        compressed_chunks::encode_rle(rleBuffer.data(), rleSize, metadata)
+    );
+    entry.version = version;
+    entry.metadata = metadata;
+    entry.deltas.clear();
+    entry.history.push_back(PrevVersion {
+        version,
+        std::vector<ubyte>(rleBuffer.data(), rleBuffer.data() + rleSize)});
+    while (entry.history.size() > HISTORY_SIZE) {
+        entry.history.pop_front();
+    }
+    updateSize(entry);
+}
+
+void EncodedChunksCache::updateSize(Entry& entry) {
+    size_t size = entry.metadata.size();
+    if (entry.payload) {
+        size += entry.payload->size();
+    }
+    for (const auto& prev : entry.history) {
+        size += prev.rleData.size();
+    }
+    for (const auto& [_, delta] : entry.deltas) {
+        if (delta != entry.payload) {
+            size += delta->size();
+        }
+    }
+    totalSize = totalSize - entry.size + size;
+    entry.size = size;
+}
+
+EncodedChunksCache::Payload EncodedChunksCache::get(
+    Entry& entry, uint64_t knownVersion
+) {
+    entry.lastAccess = ++accessCounter;
+    if (knownVersion == 0) {
+        return entry.payload;
+    }
+    const auto& foundDelta = entry.deltas.find(knownVersion);
+    if (foundDelta != entry.deltas.end()) {
+        return foundDelta->second;
+    }
+    const auto& prev = std::find_if(
+        entry.history.begin(),
+        entry.history.end(),
+        [knownVersion](const auto& prev) {
+            return prev.version == knownVersion;
+        }
+    );
+    if (prev == entry.history.end()) {
+        return entry.payload;
+    }
+    const auto& current = entry.history.back();
+    util::Buffer<ubyte> prevData(CHUNK_DATA_LEN);
+    util::Buffer<ubyte> currentData(CHUNK_DATA_LEN);
+    extrle::decode16(
+        prev->rleData.data(), prev->rleData.size(), prevData.data()
+    );
+    extrle::decode16(
+        current.rleData.data(), current.rleData.size(), currentData.data()
+    );
+    auto delta = compressed_chunks::encode_delta(
+        prevData.data(), currentData.data(), entry.metadata
+    );
+    Payload payload = entry.payload;
+    if (delta.size() < payload->size()) {
+        payload = std::make_shared<const std::vector<ubyte>>(std::move(delta));
+    }
+    entry.deltas[knownVersion] = payload;
+    updateSize(entry);
+    return payload;
+}
+
+void EncodedChunksCache::evict() {
+    if (totalSize <= capacity) {
+        return;
+    }
+    // remove least recently used entries until 3/4 of capacity is used
+    std::vector<std::pair<uint64_t, glm::ivec2>> accesses;
+    accesses.reserve(entries.size());
+    for (const auto& [pos, entry] : entries) {
+        accesses.emplace_back(entry.lastAccess, pos);
+    }
+    std::sort(
+        accesses.begin(),
+        accesses.end(),
+        [](const auto& a, const auto& b) { return a.first < b.first; }
+    );
+    size_t target = capacity * 3 / 4;
+    for (const auto& [_, pos] : accesses) {
+        if (totalSize <= target) {
+            break;
+        }
+        invalidate(pos.x, pos.y);
+    }
+}
+
+EncodedChunksCache::Payload EncodedChunksCache::get(
+    const Chunk& chunk, uint64_t knownVersion
+) {
+    auto& entry = entries[glm::ivec2(chunk.x, chunk.z)];
+    if (entry.payload == nullptr || entry.version != chunk.version) {
+        auto voxelData = chunk.encode();
+        update(entry, chunk.version, voxelData.get(), chunk.blocksMetadata);
+    }
+    auto payload = get(entry, knownVersion);
+    evict();
+    return payload;
+}
+
+EncodedChunksCache::Payload EncodedChunksCache::get(
+    int x,
+    int z,
+    WorldRegions& regions,
+    uint64_t& version,
+    uint64_t knownVersion
+) {
+    const auto& found = entries.find(glm::ivec2(x, z));
+    if (found != entries.end() && found->second.regionVersion &&
+        found->second.version == found->second.regionVersion) {
+        version = found->second.version;
+        return get(found->second, knownVersion);
+    }
+    auto voxelData = regions.getVoxels(x, z);
+    if (voxelData == nullptr) {
+        return nullptr;
+    }
+    auto& entry = entries[glm::ivec2(x, z)];
+    if (entry.regionVersion == 0) {
+        entry.regionVersion = Chunk::generateVersion();
+    }
+    update(
+        entry,
+        entry.regionVersion,
+        voxelData.get(),
+        regions.getBlocksData(x, z)
+    );
+    version = entry.version;
+    auto payload = get(entry, knownVersion);
+    evict();
+    return payload;
+}
+
+void EncodedChunksCache::onUnload(const Chunk& chunk) {
+    const auto& found = entries.find(glm::ivec2(chunk.x, chunk.z));
+    if (found != entries.end()) {
+        found->second.regionVersion = chunk.version;
+    }
+}
+
+void EncodedChunksCache::invalidate(int x, int z) {
+    const auto& found = entries.find(glm::ivec2(x, z));
+    if (found == entries.end()) {
+        return;
+    }
+    totalSize -= found->second.size;
+    entries.erase(found);
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/glm.hpp>
+#include <glm/gtx/hash.hpp>
+
+#include "typedefs.hpp"
+#include "util/Buffer.hpp"
+#include "Chunk.hpp"
+
+class WorldRegions;
+
+/// @brief Cache of compressed_chunks payloads (world.get_chunk_data)
+/// invalidated by chunk version. Keeps a few previous versions of each
+/// chunk to encode deltas for receivers knowing one of them.
+/// @attention Not thread-safe
+class EncodedChunksCache {
+public:
+    using Payload = std::shared_ptr<const std::vector<ubyte>>;
+private:
+    struct PrevVersion {
+        uint64_t version;
+        /// @brief EXTRLE16 compressed voxel data
+        std::vector<ubyte> rleData;
+    };
+    struct Entry {
+        /// @brief Version of the cached payload
+        uint64_t version = 0;
+        /// @brief Version stored in regions when the chunk is unloaded,
+        /// 0 if unknown
+        uint64_t regionVersion = 0;
+        Payload payload;
+        BlocksMetadata metadata;
+        /// @brief Recent versions including the current one
+        std::deque<PrevVersion> history;
+        /// @brief Encoded deltas from known versions to the current one
+        std::unordered_map<uint64_t, Payload> deltas;
+        uint64_t lastAccess = 0;
+        /// @brief Total size of the entry data in bytes
+        size_t size = 0;
+    };
+    /// @brief Max total size of cached data in bytes
+    size_t capacity;
+    size_t totalSize = 0;
+    uint64_t accessCounter = 0;
+    std::unordered_map<glm::ivec2, Entry> entries;
+    util::Buffer<ubyte> rleBuffer;
+
+    void update(
+        Entry& entry,
+        uint64_t version,
+        const ubyte* voxelData,
+        const BlocksMetadata& metadata
+    );
+    Payload get(Entry& entry, uint64_t knownVersion);
+    /// @brief Recalculate entry size after modification
+    void updateSize(Entry& entry);
+    void evict();
+public:
+    /// @brief Number of previous versions kept for deltas
+    static inline constexpr size_t HISTORY_SIZE = 4;
+
+    /// @param capacity max total size of cached data in bytes
+    explicit EncodedChunksCache(size_t capacity = 64 * 1024 * 1024);
+    ~EncodedChunksCache();
+
+    /// @brief Get loaded chunk payload
+    /// @param knownVersion chunk version known by the receiver, the full
+    /// payload is returned if it is 0 or not in the history
+    Payload get(const Chunk& chunk, uint64_t knownVersion = 0);
+
+    /// @brief Get payload of an unloaded chunk stored in regions
+    /// @param version output chunk version
+    /// @return nullptr if the chunk is not found
+    Payload get(
+        int x,
+        int z,
+        WorldRegions& regions,
+        uint64_t& version,
+        uint64_t knownVersion = 0
+    );
+
+    /// @brief Remember version stored to regions on the chunk unload
+    void onUnload(const Chunk& chunk);
+
+    /// @brief Forget chunk after its regions data is replaced
+    void invalidate(int x, int z);
+
+    size_t size() const {
+        return entries.size();
+    }
+
+    /// @return total size of cached data in bytes
+    size_t getTotalSize() const {
+        return totalSize;
+    }
+};
@@ -1,10 +1,12 @@
 #include "GlobalChunks.hpp"
 
 #include <algorithm>
+#include <cstring>
 
 #include "content/Content.hpp"
 #include "coders/json.hpp"
 #include "debug/Logger.hpp"
+#include "debug/Metrics.hpp"
 #include "world/files/WorldFiles.hpp"
 #include "items/Inventories.hpp"
 #include "lighting/Lightmap.hpp"
@@ -17,14 +19,19 @@
 #include "world/World.hpp"
 #include "Block.hpp"
 #include "Chunk.hpp"
+#include "ChunksPool.hpp"
 
 static debug::Logger logger("chunks-storage");
 
 GlobalChunks::GlobalChunks(Level& level)
-    : level(level), indices(*level.content.getIndices()) {
+    : level(level),
+      indices(*level.content.getIndices()),
+      pool(std::make_shared<ChunksPool>(CHUNKS_POOL_CAPACITY)) {
     chunksMap.max_load_factor(CHUNKS_MAP_MAX_LOAD_FACTOR);
 }
 
+GlobalChunks::~GlobalChunks() = default;
+
 void GlobalChunks::setOnUnload(consumer<Chunk&> onUnload) {
     this->onUnload = std::move(onUnload);
 }
@@ -94,13 +101,23 @@ std::shared_ptr<Chunk> GlobalChunks::create(int x, int z) {
         return found->second;
     }
 
-    auto chunk = std::make_shared<Chunk>(x, z);
+    bool recycled;
+    auto chunk = pool->acquire(x, z, recycled);
     chunksMap[keyfrom(x, z)] = chunk;
+    if (recycled) {
+        static auto& reused = debug::MetricsRegistry::global().counter(
+            "chunks_recycled_total", "Number of chunks reused from the pool"
+        );
+        reused.add();
+    }
 
     World& world = *level.getWorld();
     auto& regions = world.wfile.get()->getRegions();
 
     if (auto data = regions.getVoxels(chunk->x, chunk->z)) {
+        static auto& loaded = debug::MetricsRegistry::global().counter(
+            "chunks_loaded_total", "Number of chunks loaded from regions"
+        );
         const auto& indices = *level.content.getIndices();
 
         chunk->decode(data.get());
@@ -117,15 +134,20 @@ std::shared_ptr<Chunk> GlobalChunks::create(int x, int z) {
         }
 
         chunk->flags.loaded = true;
+        loaded.add();
         for (auto& entry : chunk->inventories) {
             level.inventories->store(entry.second);
         }
+    } else if (recycled) {
+        std::memset(chunk->voxels, 0, sizeof(chunk->voxels));
     }
     if (auto lights = regions.getLights(chunk->x, chunk->z)) {
         chunk->lightmap.set(lights.get());
         chunk->flags.loadedLights = true;
+    } else if (recycled) {
+        chunk->lightmap.clear();
     }
-    chunk->blocksMetadata = regions.getBlocksData(chunk->x, chunk->z);
+    regions.getBlocksData(chunk->x, chunk->z, chunk->blocksMetadata);
 
     level.events->trigger(LevelEventType::CHUNK_PRESENT, chunk.get());
     return chunk;
@@ -11,6 +11,7 @@
 #include "delegates.hpp"
 
 class Chunk;
+class ChunksPool;
 class Level;
 struct AABB;
 class ContentIndices;
@@ -28,6 +29,7 @@ class GlobalChunks {
 
     Level& level;
     const ContentIndices& indices;
+    std::shared_ptr<ChunksPool> pool;
     std::unordered_map<uint64_t, std::shared_ptr<Chunk>> chunksMap;
     std::unordered_map<glm::ivec2, std::shared_ptr<Chunk>> pinnedChunks;
     std::unordered_map<ptrdiff_t, int> refCounters;
@@ -35,7 +37,7 @@ class GlobalChunks {
     consumer<Chunk&> onUnload;
 public:
     GlobalChunks(Level& level);
-    ~GlobalChunks() = default;
+    ~GlobalChunks();
 
     void setOnUnload(consumer<Chunk&> onUnload);
 
@@ -3,6 +3,7 @@
 #include "maths/rays.hpp"
 
 #include <limits>
+#include <tuple>
 
 using namespace blocks_agent;
 
@@ -98,146 +99,321 @@ void blocks_agent::set(
     set_block(chunks, x, y, z, id, state);
 }
 
+/// @brief Blocks without inventories, metadata and segments may be written
+/// directly to the chunk voxels
+static inline bool is_plain_block(const Block& def) {
+    return def.inventorySize == 0 && !def.rt.extended &&
+           def.dataStruct == nullptr;
+}
+
+/// @brief Chunk-grouped voxels writer used by bulk operations.
+/// Chunk flags, heights and neighbour chunks are updated once per chunk.
 template <class Storage>
-static inline voxel* raycast_blocks(
-    const Storage& chunks,
-    const glm::vec3& start,
-    const glm::vec3& dir,
-    float maxDist,
-    glm::vec3& end,
-    glm::ivec3& norm,
-    glm::ivec3& iend,
-    std::set<blockid_t> filter
-) {
-    const auto& blocks = chunks.getContentIndices().blocks;
-    float px = start.x;
-    float py = start.y;
-    float pz = start.z;
-
-    float dx = dir.x;
-    float dy = dir.y;
-    float dz = dir.z;
-
-    float t = 0.0f;
-    int ix = std::floor(px);
-    int iy = std::floor(py);
-    int iz = std::floor(pz);
-
-    int stepx = (dx > 0.0f) ? 1 : -1;
-    int stepy = (dy > 0.0f) ? 1 : -1;
-    int stepz = (dz > 0.0f) ? 1 : -1;
-
-    constexpr float infinity = std::numeric_limits<float>::infinity();
-    constexpr float epsilon = 1e-6f;  // 0.000001
-    float txDelta = (std::fabs(dx) < epsilon) ? infinity : std::fabs(1.0f / dx);
-    float tyDelta = (std::fabs(dy) < epsilon) ? infinity : std::fabs(1.0f / dy);
-    float tzDelta = (std::fabs(dz) < epsilon) ? infinity : std::fabs(1.0f / dz);
-
-    float xdist = (stepx > 0) ? (ix + 1 - px) : (px - ix);
-    float ydist = (stepy > 0) ? (iy + 1 - py) : (py - iy);
-    float zdist = (stepz > 0) ? (iz + 1 - pz) : (pz - iz);
-
-    float txMax = (txDelta < infinity) ? txDelta * xdist : infinity;
-    float tyMax = (tyDelta < infinity) ? tyDelta * ydist : infinity;
-    float tzMax = (tzDelta < infinity) ? tzDelta * zdist : infinity;
-
-    int steppedIndex = -1;
-
-    while (t <= maxDist) {
-        voxel* voxel = get(chunks, ix, iy, iz);
-        if (voxel == nullptr) {
-            return nullptr;
+class BulkWriter {
+    Storage& chunks;
+    const Block* const* defs;
+    std::vector<glm::ivec3>* changed;
+    Chunk* chunk = nullptr;
+    int cx = 0;
+    int cz = 0;
+    size_t chunkCount = 0;
+    bool touchedEdges[4] {};
+public:
+    size_t count = 0;
+
+    BulkWriter(Storage& chunks, std::vector<glm::ivec3>* changed)
+        : chunks(chunks),
+          defs(chunks.getContentIndices().blocks.getDefs()),
+          changed(changed) {
+    }
+
+    ~BulkWriter() {
+        finish();
+    }
+
+    bool begin(int cx, int cz) {
+        finish();
+        this->cx = cx;
+        this->cz = cz;
+        chunk = get_chunk(chunks, cx, cz);
+        return chunk != nullptr;
+    }
+
+    inline void write(int lx, int y, int lz, blockid_t id, blockstate state) {
+        voxel& vox = chunk->voxels[vox_index(lx, y, lz)];
+        if (vox.id == id &&
+            blockstate2int(vox.state) == blockstate2int(state)) {
+            return;
         }
+        int x = cx * CHUNK_W + lx;
+        int z = cz * CHUNK_D + lz;
+        if (is_plain_block(*defs[vox.id]) && is_plain_block(*defs[id])) {
+            vox.id = id;
+            vox.state = state;
+        } else {
+            // inventories, metadata and segments finalization
+            set_block(chunks, x, y, z, id, state);
+        }
+        touchedEdges[0] |= lx == 0;
+        touchedEdges[1] |= lz == 0;
+        touchedEdges[2] |= lx == CHUNK_W - 1;
+        touchedEdges[3] |= lz == CHUNK_D - 1;
+        chunkCount++;
+        if (changed) {
+            changed->emplace_back(x, y, z);
+        }
+    }
 
-        const auto& def = blocks.require(voxel->id);
-        if ((filter.empty() && def.selectable) ||
-            (!filter.empty() && filter.find(def.rt.id) == filter.end())) {
-            end.x = px + t * dx;
-            end.y = py + t * dy;
-            end.z = pz + t * dz;
-            iend.x = ix;
-            iend.y = iy;
-            iend.z = iz;
-
-            if (!def.rt.solid) {
-                const std::vector<AABB>& hitboxes =
-                    def.rotatable ? def.rt.hitboxes[voxel->state.rotation]
-                                  : def.hitboxes;
-
-                scalar_t distance = maxDist;
-                Ray ray(start, dir);
-
-                bool hit = false;
-
-                glm::vec3 offset {};
-                if (voxel->state.segment) {
-                    offset = seek_origin(chunks, iend, def, voxel->state) - iend;
-                }
+    void finish() {
+        if (chunk == nullptr || chunkCount == 0) {
+            return;
+        }
+        chunk->setModifiedAndUnsaved();
+        chunk->updateHeights();
 
-                for (auto box : hitboxes) {
-                    box.a += offset;
-                    box.b += offset;
-                    scalar_t boxDistance;
-                    glm::ivec3 boxNorm;
-                    if (ray.intersectAABB(
-                            iend, box, maxDist, boxNorm, boxDistance
-                        ) > RayRelation::None &&
-                        boxDistance < distance) {
-                        hit = true;
-                        distance = boxDistance;
-                        norm = boxNorm;
-                        end = start + (dir * glm::vec3(distance));
+        const int offsets[4][2] {{-1, 0}, {0, -1}, {1, 0}, {0, 1}};
+        for (int i = 0; i < 4; i++) {
+            if (!touchedEdges[i]) {
+                continue;
+            }
+            touchedEdges[i] = false;
+            auto neighbour =
+                get_chunk(chunks, cx + offsets[i][0], cz + offsets[i][1]);
+            if (neighbour) {
+                neighbour->flags.modified = true;
+            }
+        }
+        count += chunkCount;
+        chunkCount = 0;
+        chunk = nullptr;
+    }
+};
+
+template <class Storage>
+static size_t fill_box(
+    Storage& chunks,
+    const glm::ivec3& a,
+    const glm::ivec3& b,
+    blockid_t id,
+    blockstate state,
+    int filter,
+    std::vector<glm::ivec3>* changed
+) {
+    chunks.getContentIndices().blocks.require(id);
+
+    auto min = glm::min(a, b);
+    auto max = glm::max(a, b);
+    min.y = std::max(min.y, 0);
+    max.y = std::min(max.y, CHUNK_H - 1);
+    if (min.y > max.y) {
+        return 0;
+    }
+    BulkWriter writer(chunks, changed);
+    for (int cz = floordiv<CHUNK_D>(min.z); cz <= floordiv<CHUNK_D>(max.z);
+         cz++) {
+        for (int cx = floordiv<CHUNK_W>(min.x);
+             cx <= floordiv<CHUNK_W>(max.x);
+             cx++) {
+            if (!writer.begin(cx, cz)) {
+                continue;
+            }
+            const voxel* voxels = get_chunk(chunks, cx, cz)->voxels;
+            int lx1 = std::max(min.x - cx * CHUNK_W, 0);
+            int lx2 = std::min(max.x - cx * CHUNK_W, CHUNK_W - 1);
+            int lz1 = std::max(min.z - cz * CHUNK_D, 0);
+            int lz2 = std::min(max.z - cz * CHUNK_D, CHUNK_D - 1);
+            for (int y = min.y; y <= max.y; y++) {
+                for (int lz = lz1; lz <= lz2; lz++) {
+                    for (int lx = lx1; lx <= lx2; lx++) {
+                        if (filter != -1 &&
+                            voxels[vox_index(lx, y, lz)].id != filter) {
+                            continue;
+                        }
+                        writer.write(lx, y, lz, id, state);
                     }
                 }
-
-                if (hit) return voxel;
-            } else {
-                iend.x = ix;
-                iend.y = iy;
-                iend.z = iz;
-
-                norm.x = norm.y = norm.z = 0;
-                if (steppedIndex == 0) norm.x = -stepx;
-                if (steppedIndex == 1) norm.y = -stepy;
-                if (steppedIndex == 2) norm.z = -stepz;
-                return voxel;
             }
         }
-        if (txMax < tyMax) {
-            if (txMax < tzMax) {
-                ix += stepx;
-                t = txMax;
-                txMax += txDelta;
-                steppedIndex = 0;
-            } else {
-                iz += stepz;
-                t = tzMax;
-                tzMax += tzDelta;
-                steppedIndex = 2;
+    }
+    writer.finish();
+    return writer.count;
+}
+
+template <class Storage>
+static size_t paste_volume(
+    Storage& chunks,
+    const voxel* voxels,
+    const glm::ivec3& size,
+    const glm::ivec3& offset,
+    std::vector<glm::ivec3>* changed
+) {
+    const auto& blocks = chunks.getContentIndices().blocks;
+    int y1 = std::max(offset.y, 0);
+    int y2 = std::min(offset.y + size.y, CHUNK_H) - 1;
+    if (y1 > y2 || size.x <= 0 || size.z <= 0) {
+        return 0;
+    }
+    auto max = offset + size - 1;
+
+    BulkWriter writer(chunks, changed);
+    for (int cz = floordiv<CHUNK_D>(offset.z); cz <= floordiv<CHUNK_D>(max.z);
+         cz++) {
+        for (int cx = floordiv<CHUNK_W>(offset.x);
+             cx <= floordiv<CHUNK_W>(max.x);
+             cx++) {
+            if (!writer.begin(cx, cz)) {
+                continue;
             }
-        } else {
-            if (tyMax < tzMax) {
-                iy += stepy;
-                t = tyMax;
-                tyMax += tyDelta;
-                steppedIndex = 1;
-            } else {
-                iz += stepz;
-                t = tzMax;
-                tzMax += tzDelta;
-                steppedIndex = 2;
+            int gx1 = std::max(offset.x, cx * CHUNK_W);
+            int gx2 = std::min(max.x, cx * CHUNK_W + CHUNK_W - 1);
+            int gz1 = std::max(offset.z, cz * CHUNK_D);
+            int gz2 = std::min(max.z, cz * CHUNK_D + CHUNK_D - 1);
+            for (int y = y1; y <= y2; y++) {
+                for (int gz = gz1; gz <= gz2; gz++) {
+                    const voxel* row = voxels + vox_index(
+                        gx1 - offset.x, y - offset.y, gz - offset.z,
+                        size.x, size.z
+                    );
+                    for (int gx = gx1; gx <= gx2; gx++, row++) {
+                        if (row->id == 0) {
+                            continue;
+                        }
+                        blocks.require(row->id);
+                        writer.write(
+                            gx - cx * CHUNK_W,
+                            y,
+                            gz - cz * CHUNK_D,
+                            row->id,
+                            row->state
+                        );
+                    }
+                }
+            }
+        }
+    }
+    writer.finish();
+    return writer.count;
+}
+
+template <class Storage>
+static size_t set_edits(
+    Storage& chunks,
+    std::vector<voxel_edit>& edits,
+    std::vector<glm::ivec3>* changed
+) {
+    const auto& blocks = chunks.getContentIndices().blocks;
+    auto chunk_key = [](const voxel_edit& edit) {
+        return std::make_pair(
+            floordiv<CHUNK_D>(edit.pos.z), floordiv<CHUNK_W>(edit.pos.x)
+        );
+    };
+    // stable to keep entries for the same position in the original order
+    std::stable_sort(
+        edits.begin(),
+        edits.end(),
+        [&chunk_key](const auto& a, const auto& b) {
+            auto keyA = chunk_key(a);
+            auto keyB = chunk_key(b);
+            if (keyA != keyB) {
+                return keyA < keyB;
             }
+            return std::tie(a.pos.y, a.pos.z, a.pos.x) <
+                   std::tie(b.pos.y, b.pos.z, b.pos.x);
+        }
+    );
+    BulkWriter writer(chunks, changed);
+    bool available = false;
+    bool started = false;
+    std::pair<int, int> current {};
+    for (size_t i = 0; i < edits.size(); i++) {
+        const auto& edit = edits[i];
+        if (edit.pos.y < 0 || edit.pos.y >= CHUNK_H) {
+            continue;
         }
+        // only the last entry for a position is applied
+        if (i + 1 < edits.size() && edits[i + 1].pos == edit.pos) {
+            continue;
+        }
+        auto key = chunk_key(edit);
+        if (!started || key != current) {
+            started = true;
+            current = key;
+            available = writer.begin(key.second, key.first);
+        }
+        if (!available) {
+            continue;
+        }
+        blocks.require(edit.id);
+        writer.write(
+            edit.pos.x - key.second * CHUNK_W,
+            edit.pos.y,
+            edit.pos.z - key.first * CHUNK_D,
+            edit.id,
+            edit.state
+        );
     }
-    iend.x = ix;
-    iend.y = iy;
-    iend.z = iz;
-
-    end.x = px + t * dx;
-    end.y = py + t * dy;
-    end.z = pz + t * dz;
-    norm.x = norm.y = norm.z = 0;
-    return nullptr;
+    writer.finish();
+    return writer.count;
+}
+
+size_t blocks_agent::fill(
+    Chunks& chunks,
+    const glm::ivec3& a,
+    const glm::ivec3& b,
+    blockid_t id,
+    blockstate state,
+    int filter,
+    std::vector<glm::ivec3>* changed
+) {
+    return fill_box(chunks, a, b, id, state, filter, changed);
+}
+
+size_t blocks_agent::fill(
+    GlobalChunks& chunks,
+    const glm::ivec3& a,
+    const glm::ivec3& b,
+    blockid_t id,
+    blockstate state,
+    int filter,
+    std::vector<glm::ivec3>* changed
+) {
+    return fill_box(chunks, a, b, id, state, filter, changed);
+}
+
+size_t blocks_agent::paste(
+    Chunks& chunks,
+    const voxel* voxels,
+    const glm::ivec3& size,
+    const glm::ivec3& offset,
+    std::vector<glm::ivec3>* changed
+) {
+    return paste_volume(chunks, voxels, size, offset, changed);
+}
+
+size_t blocks_agent::paste(
+    GlobalChunks& chunks,
+    const voxel* voxels,
+    const glm::ivec3& size,
+    const glm::ivec3& offset,
+    std::vector<glm::ivec3>* changed
+) {
+    return paste_volume(chunks, voxels, size, offset, changed);
+}
+
+size_t blocks_agent::set_many(
+    Chunks& chunks,
+    std::vector<voxel_edit>& edits,
+    std::vector<glm::ivec3>* changed
+) {
+    return set_edits(chunks, edits, changed);
+}
+
+size_t blocks_agent::set_many(
+    GlobalChunks& chunks,
+    std::vector<voxel_edit>& edits,
+    std::vector<glm::ivec3>* changed
+) {
+    return set_edits(chunks, edits, changed);
 }
 
 voxel* blocks_agent::raycast(
@@ -250,7 +426,8 @@ voxel* blocks_agent::raycast(
     glm::ivec3& iend,
     std::set<blockid_t> filter
 ) {
-    return raycast_blocks(chunks, start, dir, maxDist, end, norm, iend, filter);
+    ChunkCache cache;
+    return raycast(chunks, cache, start, dir, maxDist, end, norm, iend, filter);
 }
 
 voxel* blocks_agent::raycast(
@@ -263,7 +440,8 @@ voxel* blocks_agent::raycast(
     glm::ivec3& iend,
     std::set<blockid_t> filter
 ) {
-    return raycast_blocks(chunks, start, dir, maxDist, end, norm, iend, filter);
+    ChunkCache cache;
+    return raycast(chunks, cache, start, dir, maxDist, end, norm, iend, filter);
 }
 
 // reduce nesting on next modification
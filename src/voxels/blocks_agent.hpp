@@ -12,12 +12,15 @@
 #include "typedefs.hpp"
 #include "content/Content.hpp"
 #include "maths/voxmaths.hpp"
+#include "maths/rays.hpp"
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <set>
-#include <algorithm>
 #include <stdint.h>
 #include <stdexcept>
+#include <vector>
 #include <glm/glm.hpp>
 
 struct AABB;
@@ -59,6 +62,46 @@ inline voxel* get(const Storage& chunks, int32_t x, int32_t y, int32_t z) {
     return &chunk->voxels[(y * CHUNK_D + lz) * CHUNK_W + lx];
 }
 
+/// @brief Last found chunk to skip storage lookups on sequential access
+struct ChunkCache {
+    Chunk* chunk = nullptr;
+    int cx = 0;
+    int cz = 0;
+};
+
+/// @brief Get voxel at specified position using the last found chunk
+/// if it contains the position.
+/// Returns nullptr if voxel does not exists.
+/// @tparam Storage chunks storage class
+/// @param chunks chunks storage
+/// @param cache chunk cache
+/// @param x position X
+/// @param y position Y
+/// @param z position Z
+/// @return voxel pointer or nullptr
+template<class Storage>
+inline voxel* get(
+    const Storage& chunks, ChunkCache& cache, int32_t x, int32_t y, int32_t z
+) {
+    if (y < 0 || y >= CHUNK_H) {
+        return nullptr;
+    }
+    int cx = floordiv<CHUNK_W>(x);
+    int cz = floordiv<CHUNK_D>(z);
+    if (cache.chunk == nullptr || cache.cx != cx || cache.cz != cz) {
+        Chunk* chunk = get_chunk(chunks, cx, cz);
+        if (chunk == nullptr) {
+            return nullptr;
+        }
+        cache.chunk = chunk;
+        cache.cx = cx;
+        cache.cz = cz;
+    }
+    int lx = x - cx * CHUNK_W;
+    int lz = z - cz * CHUNK_D;
+    return &cache.chunk->voxels[(y * CHUNK_D + lz) * CHUNK_W + lx];
+}
+
 /// @brief Get voxel at specified position.
 /// @throws std::runtime_error if voxel does not exists
 /// @tparam Storage chunks storage class
@@ -144,6 +187,113 @@ void set(
     blockstate state
 );
 
+/// @brief Bulk edit entry
+struct voxel_edit {
+    glm::ivec3 pos;
+    blockid_t id;
+    blockstate state;
+};
+
+/// @brief Fill box with the block. Writes are grouped by chunk, so every
+/// chunk is resolved, flagged and gets heights updated once.
+/// Lighting and neighbour blocks are not updated
+/// (see BlocksController::onBlocksSet).
+/// @param chunks chunks storage
+/// @param a box corner
+/// @param b opposite box corner (inclusive)
+/// @param id new block id
+/// @param state new block state
+/// @param filter replace only blocks with this id (-1 - replace any block)
+/// @param changed [out] nullable positions of modified voxels
+/// @return number of modified voxels
+size_t fill(
+    Chunks& chunks,
+    const glm::ivec3& a,
+    const glm::ivec3& b,
+    blockid_t id,
+    blockstate state,
+    int filter = -1,
+    std::vector<glm::ivec3>* changed = nullptr
+);
+
+/// @brief Fill box with the block. Writes are grouped by chunk, so every
+/// chunk is resolved, flagged and gets heights updated once.
+/// Lighting and neighbour blocks are not updated
+/// (see BlocksController::onBlocksSet).
+/// @param chunks chunks storage
+/// @param a box corner
+/// @param b opposite box corner (inclusive)
+/// @param id new block id
+/// @param state new block state
+/// @param filter replace only blocks with this id (-1 - replace any block)
+/// @param changed [out] nullable positions of modified voxels
+/// @return number of modified voxels
+size_t fill(
+    GlobalChunks& chunks,
+    const glm::ivec3& a,
+    const glm::ivec3& b,
+    blockid_t id,
+    blockstate state,
+    int filter = -1,
+    std::vector<glm::ivec3>* changed = nullptr
+);
+
+/// @brief Copy voxels volume to the world skipping air (id 0).
+/// Writes are grouped by chunk.
+/// @param chunks chunks storage
+/// @param voxels source voxels with runtime block indices (XZY order)
+/// @param size source volume size
+/// @param offset target position
+/// @param changed [out] nullable positions of modified voxels
+/// @return number of modified voxels
+size_t paste(
+    Chunks& chunks,
+    const voxel* voxels,
+    const glm::ivec3& size,
+    const glm::ivec3& offset,
+    std::vector<glm::ivec3>* changed = nullptr
+);
+
+/// @brief Copy voxels volume to the world skipping air (id 0).
+/// Writes are grouped by chunk.
+/// @param chunks chunks storage
+/// @param voxels source voxels with runtime block indices (XZY order)
+/// @param size source volume size
+/// @param offset target position
+/// @param changed [out] nullable positions of modified voxels
+/// @return number of modified voxels
+size_t paste(
+    GlobalChunks& chunks,
+    const voxel* voxels,
+    const glm::ivec3& size,
+    const glm::ivec3& offset,
+    std::vector<glm::ivec3>* changed = nullptr
+);
+
+/// @brief Apply edits buffer. Entries are reordered to group writes by
+/// chunk; for the same position the last entry in the buffer wins.
+/// @param chunks chunks storage
+/// @param edits edits buffer (will be sorted)
+/// @param changed [out] nullable positions of modified voxels
+/// @return number of modified voxels
+size_t set_many(
+    Chunks& chunks,
+    std::vector<voxel_edit>& edits,
+    std::vector<glm::ivec3>* changed = nullptr
+);
+
+/// @brief Apply edits buffer. Entries are reordered to group writes by
+/// chunk; for the same position the last entry in the buffer wins.
+/// @param chunks chunks storage
+/// @param edits edits buffer (will be sorted)
+/// @param changed [out] nullable positions of modified voxels
+/// @return number of modified voxels
+size_t set_many(
+    GlobalChunks& chunks,
+    std::vector<voxel_edit>& edits,
+    std::vector<glm::ivec3>* changed = nullptr
+);
+
 /// @brief Erase extended block segments
 /// @tparam Storage chunks storage class
 /// @param chunks chunks storage
@@ -395,6 +545,161 @@ inline void set_rotation(
     }
 }
 
+/// @brief Cast ray to a selectable block with filter based on id.
+/// @tparam Storage chunks storage class
+/// @param chunks chunks storage
+/// @param cache chunk cache, may be reused by sequential calls
+/// @param start ray start position
+/// @param dir normalized ray direction vector
+/// @param maxDist maximum ray length
+/// @param end [out] ray end position
+/// @param norm [out] surface normal vector
+/// @param iend [out] ray end integer position (voxel position + normal)
+/// @param filter filtered ids
+/// @return voxel pointer or nullptr
+template <class Storage>
+inline voxel* raycast(
+    const Storage& chunks,
+    ChunkCache& cache,
+    const glm::vec3& start,
+    const glm::vec3& dir,
+    float maxDist,
+    glm::vec3& end,
+    glm::ivec3& norm,
+    glm::ivec3& iend,
+    const std::set<blockid_t>& filter
+) {
+    const auto& blocks = chunks.getContentIndices().blocks;
+    float px = start.x;
+    float py = start.y;
+    float pz = start.z;
+
+    float dx = dir.x;
+    float dy = dir.y;
+    float dz = dir.z;
+
+    float t = 0.0f;
+    int ix = std::floor(px);
+    int iy = std::floor(py);
+    int iz = std::floor(pz);
+
+    int stepx = (dx > 0.0f) ? 1 : -1;
+    int stepy = (dy > 0.0f) ? 1 : -1;
+    int stepz = (dz > 0.0f) ? 1 : -1;
+
+    constexpr float infinity = std::numeric_limits<float>::infinity();
+    constexpr float epsilon = 1e-6f;  // 0.000001
+    float txDelta = (std::fabs(dx) < epsilon) ? infinity : std::fabs(1.0f / dx);
+    float tyDelta = (std::fabs(dy) < epsilon) ? infinity : std::fabs(1.0f / dy);
+    float tzDelta = (std::fabs(dz) < epsilon) ? infinity : std::fabs(1.0f / dz);
+
+    float xdist = (stepx > 0) ? (ix + 1 - px) : (px - ix);
+    float ydist = (stepy > 0) ? (iy + 1 - py) : (py - iy);
+    float zdist = (stepz > 0) ? (iz + 1 - pz) : (pz - iz);
+
+    float txMax = (txDelta < infinity) ? txDelta * xdist : infinity;
+    float tyMax = (tyDelta < infinity) ? tyDelta * ydist : infinity;
+    float tzMax = (tzDelta < infinity) ? tzDelta * zdist : infinity;
+
+    int steppedIndex = -1;
+
+    while (t <= maxDist) {
+        voxel* voxel = get(chunks, cache, ix, iy, iz);
+        if (voxel == nullptr) {
+            return nullptr;
+        }
+
+        const auto& def = blocks.require(voxel->id);
+        if ((filter.empty() && def.selectable) ||
+            (!filter.empty() && filter.find(def.rt.id) == filter.end())) {
+            end.x = px + t * dx;
+            end.y = py + t * dy;
+            end.z = pz + t * dz;
+            iend.x = ix;
+            iend.y = iy;
+            iend.z = iz;
+
+            if (!def.rt.solid) {
+                const std::vector<AABB>& hitboxes =
+                    def.rotatable ? def.rt.hitboxes[voxel->state.rotation]
+                                  : def.hitboxes;
+
+                scalar_t distance = maxDist;
+                Ray ray(start, dir);
+
+                bool hit = false;
+
+                glm::vec3 offset {};
+                if (voxel->state.segment) {
+                    offset = seek_origin(chunks, iend, def, voxel->state) - iend;
+                }
+
+                for (auto box : hitboxes) {
+                    box.a += offset;
+                    box.b += offset;
+                    scalar_t boxDistance;
+                    glm::ivec3 boxNorm;
+                    if (ray.intersectAABB(
+                            iend, box, maxDist, boxNorm, boxDistance
+                        ) > RayRelation::None &&
+                        boxDistance < distance) {
+                        hit = true;
+                        distance = boxDistance;
+                        norm = boxNorm;
+                        end = start + (dir * glm::vec3(distance));
+                    }
+                }
+
+                if (hit) return voxel;
+            } else {
+                iend.x = ix;
+                iend.y = iy;
+                iend.z = iz;
+
+                norm.x = norm.y = norm.z = 0;
+                if (steppedIndex == 0) norm.x = -stepx;
+                if (steppedIndex == 1) norm.y = -stepy;
+                if (steppedIndex == 2) norm.z = -stepz;
+                return voxel;
+            }
+        }
+        if (txMax < tyMax) {
+            if (txMax < tzMax) {
+                ix += stepx;
+                t = txMax;
+                txMax += txDelta;
+                steppedIndex = 0;
+            } else {
+                iz += stepz;
+                t = tzMax;
+                tzMax += tzDelta;
+                steppedIndex = 2;
+            }
+        } else {
+            if (tyMax < tzMax) {
+                iy += stepy;
+                t = tyMax;
+                tyMax += tyDelta;
+                steppedIndex = 1;
+            } else {
+                iz += stepz;
+                t = tzMax;
+                tzMax += tzDelta;
+                steppedIndex = 2;
+            }
+        }
+    }
+    iend.x = ix;
+    iend.y = iy;
+    iend.z = iz;
+
+    end.x = px + t * dx;
+    end.y = py + t * dy;
+    end.z = pz + t * dz;
+    norm.x = norm.y = norm.z = 0;
+    return nullptr;
+}
+
 /// @brief Cast ray to a selectable block with filter based on id.
 /// @param chunks chunks matrix
 /// @param start ray start position
@@ -1,5 +1,7 @@
 #include "compressed_chunks.hpp"
 
+#include <cstring>
+
 #include "coders/rle.hpp"
 #include "coders/gzip.hpp"
 
@@ -8,6 +10,36 @@
 
 inline constexpr int HAS_VOXELS = 0x1;
 inline constexpr int HAS_METADATA = 0x2;
+/// @brief Voxel data runs to be applied to the current data
+inline constexpr int HAS_VOXELS_DELTA = 0x4;
+
+/// @brief Max unchanged bytes count merged into a delta run
+inline constexpr size_t DELTA_RUN_GAP = 8;
+
+static std::vector<ubyte> build_payload(
+    int flags,
+    const std::vector<ubyte>& voxelBytes,
+    const BlocksMetadata& metadata
+) {
+    auto metadataBytes = metadata.serialize();
+
+    ByteBuilder builder(2 + 8 + voxelBytes.size() + metadataBytes.size());
+    builder.put(flags | HAS_METADATA);
+    builder.put(0); // reserved
+    builder.putInt32(voxelBytes.size());
+    builder.put(voxelBytes.data(), voxelBytes.size());
+    builder.putInt32(metadataBytes.size());
+    builder.put(metadataBytes.data(), metadataBytes.size());
+    return builder.build();
+}
+
+std::vector<ubyte> compressed_chunks::encode_rle(
+    const ubyte* rleData, size_t rleSize, const BlocksMetadata& metadata
+) {
+    return build_payload(
+        HAS_VOXELS, gzip::compress(rleData, rleSize), metadata
+    );
+}
 
 std::vector<ubyte> compressed_chunks::encode(
     const ubyte* data,
@@ -16,20 +48,36 @@ std::vector<ubyte> compressed_chunks::encode(
 ) {
     size_t rleCompressedSize =
         extrle::encode16(data, CHUNK_DATA_LEN, rleBuffer.data());
+    return encode_rle(rleBuffer.data(), rleCompressedSize, metadata);
+}
 
-    const auto gzipCompressedData = gzip::compress(
-        rleBuffer.data(), rleCompressedSize
+std::vector<ubyte> compressed_chunks::encode_delta(
+    const ubyte* prevData, const ubyte* data, const BlocksMetadata& metadata
+) {
+    // runs: int32 offset, int32 length, bytes
+    ByteBuilder runs;
+    size_t i = 0;
+    while (i < CHUNK_DATA_LEN) {
+        if (prevData[i] == data[i]) {
+            i++;
+            continue;
+        }
+        size_t begin = i;
+        size_t end = i + 1;
+        for (i = end; i < CHUNK_DATA_LEN && i - end <= DELTA_RUN_GAP; i++) {
+            if (prevData[i] != data[i]) {
+                end = i + 1;
+            }
+        }
+        runs.putInt32(begin);
+        runs.putInt32(end - begin);
+        runs.put(data + begin, end - begin);
+        i = end;
+    }
+    auto bytes = runs.build();
+    return build_payload(
+        HAS_VOXELS_DELTA, gzip::compress(bytes.data(), bytes.size()), metadata
     );
-    auto metadataBytes = metadata.serialize();
-
-    ByteBuilder builder(2 + 8 + gzipCompressedData.size() + metadataBytes.size());
-    builder.put(HAS_VOXELS | HAS_METADATA); // flags
-    builder.put(0); // reserved
-    builder.putInt32(gzipCompressedData.size());
-    builder.put(gzipCompressedData.data(), gzipCompressedData.size());
-    builder.putInt32(metadataBytes.size());
-    builder.put(metadataBytes.data(), metadataBytes.size());
-    return builder.build();
 }
 
 std::vector<ubyte> compressed_chunks::encode(const Chunk& chunk) {
@@ -40,15 +88,61 @@ std::vector<ubyte> compressed_chunks::encode(const Chunk& chunk) {
     return encode(data.get(), chunk.blocksMetadata, rleBuffer);
 }
 
+/// @brief Read size of the following data block
+/// @throws std::runtime_error if size exceeds the remaining bytes
+static size_t read_block_size(ByteReader& reader) {
+    uint32_t size = static_cast<uint32_t>(reader.getInt32());
+    if (size > reader.remaining()) {
+        throw std::runtime_error("invalid chunk data block size");
+    }
+    return size;
+}
+
 static void read_voxel_data(ByteReader& reader, util::Buffer<ubyte>& dst) {
-    size_t gzipCompressedSize = reader.getInt32();
-        
+    size_t gzipCompressedSize = read_block_size(reader);
+
     auto rleData = gzip::decompress(reader.pointer(), gzipCompressedSize);
     reader.skip(gzipCompressedSize);
 
     extrle::decode16(rleData.data(), rleData.size(), dst.data());
 }
 
+/// @brief Apply voxel data runs to the dst
+static void read_voxel_delta(ByteReader& reader, ubyte* dst) {
+    size_t gzipCompressedSize = read_block_size(reader);
+
+    auto runsData = gzip::decompress(reader.pointer(), gzipCompressedSize);
+    reader.skip(gzipCompressedSize);
+
+    ByteReader runs(runsData.data(), runsData.size());
+    while (runs.hasNext()) {
+        uint32_t offset = static_cast<uint32_t>(runs.getInt32());
+        uint32_t length = static_cast<uint32_t>(runs.getInt32());
+        if (offset > CHUNK_DATA_LEN || length > CHUNK_DATA_LEN - offset ||
+            length > runs.remaining()) {
+            throw std::runtime_error("invalid chunk delta run");
+        }
+        std::memcpy(dst + offset, runs.pointer(), length);
+        runs.skip(length);
+    }
+}
+
+static void check_voxel_data(
+    const Chunk& chunk, const ubyte* data, const ContentIndices& indices
+) {
+    auto src = reinterpret_cast<const uint16_t*>(data);
+    for (size_t i = 0; i < CHUNK_VOL; i++) {
+        blockid_t id = dataio::le2h(src[i]);
+        if (indices.blocks.get(id) == nullptr) {
+            throw std::runtime_error(
+                "block data corruption (chunk: " + std::to_string(chunk.x) +
+                ", " + std::to_string(chunk.z) + ") at " +
+                std::to_string(i) + " id: " + std::to_string(id)
+            );
+        }
+    }
+}
+
 void compressed_chunks::decode(
     Chunk& chunk, const ubyte* src, size_t size, const ContentIndices& indices
 ) {
@@ -61,23 +155,18 @@ void compressed_chunks::decode(
         /// world.get_chunk_data is only available in the main Lua state
         static util::Buffer<ubyte> voxelData (CHUNK_DATA_LEN);
         read_voxel_data(reader, voxelData);
-        // TODO: move somewhere in Chunk
-        auto src = reinterpret_cast<const uint16_t*>(voxelData.data());
-        for (size_t i = 0; i < CHUNK_VOL; i++) {
-            blockid_t id = dataio::le2h(src[i]);;
-            if (indices.blocks.get(id) == nullptr) {
-                throw std::runtime_error(
-                    "block data corruption (chunk: " + std::to_string(chunk.x) +
-                    ", " + std::to_string(chunk.z) + ") at " +
-                    std::to_string(i) + " id: " + std::to_string(id)
-                );
-            }
-        }
+        check_voxel_data(chunk, voxelData.data(), indices);
         chunk.decode(voxelData.data());
         chunk.updateHeights();
+    } else if (flags & HAS_VOXELS_DELTA) {
+        auto voxelData = chunk.encode();
+        read_voxel_delta(reader, voxelData.get());
+        check_voxel_data(chunk, voxelData.get(), indices);
+        chunk.decode(voxelData.get());
+        chunk.updateHeights();
     }
     if (flags & HAS_METADATA) {
-        size_t metadataSize = reader.getInt32();
+        size_t metadataSize = read_block_size(reader);
         chunk.blocksMetadata.deserialize(reader.pointer(), metadataSize);
         reader.skip(metadataSize);
     }
@@ -97,9 +186,21 @@ void compressed_chunks::save(
         regions.put(
             x, z, REGION_LAYER_VOXELS, voxelData.release(), CHUNK_DATA_LEN
         );
+    } else if (flags & HAS_VOXELS_DELTA) {
+        auto voxelData = regions.getVoxels(x, z);
+        if (voxelData == nullptr) {
+            throw std::runtime_error(
+                "chunk delta base is not found (chunk: " + std::to_string(x) +
+                ", " + std::to_string(z) + ")"
+            );
+        }
+        read_voxel_delta(reader, voxelData.get());
+        regions.put(
+            x, z, REGION_LAYER_VOXELS, std::move(voxelData), CHUNK_DATA_LEN
+        );
     }
     if (flags & HAS_METADATA) {
-        size_t metadataSize = reader.getInt32();
+        size_t metadataSize = read_block_size(reader);
         regions.put(
             x,
             z,
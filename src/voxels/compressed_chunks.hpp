@@ -10,12 +10,25 @@ class ContentIndices;
 class WorldRegions;
 
 namespace compressed_chunks {
+    /// @brief Encode chunk payload from EXTRLE16 compressed voxel data
+    std::vector<ubyte> encode_rle(
+        const ubyte* rleData, size_t rleSize, const BlocksMetadata& metadata
+    );
     std::vector<ubyte> encode(
         const ubyte* voxelData,
         const BlocksMetadata& metadata,
         util::Buffer<ubyte>& rleBuffer
     );
     std::vector<ubyte> encode(const Chunk& chunk);
+    /// @brief Encode chunk payload containing voxel data runs changed since
+    /// the previous data, decoded on top of the previous data
+    /// @param prevData previous voxel data (CHUNK_DATA_LEN bytes)
+    /// @param data current voxel data (CHUNK_DATA_LEN bytes)
+    std::vector<ubyte> encode_delta(
+        const ubyte* prevData,
+        const ubyte* data,
+        const BlocksMetadata& metadata
+    );
     void decode(
         Chunk& chunk,
         const ubyte* src,
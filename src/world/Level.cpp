@@ -11,6 +11,7 @@
 #include "physics/PhysicsSolver.hpp"
 #include "settings.hpp"
 #include "voxels/Chunk.hpp"
+#include "voxels/EncodedChunksCache.hpp"
 #include "voxels/GlobalChunks.hpp"
 #include "window/Camera.hpp"
 #include "LevelEvents.hpp"
@@ -27,7 +28,8 @@ Level::Level(
       physics(std::make_unique<PhysicsSolver>(glm::vec3(0, -22.6f, 0))),
       events(std::make_unique<LevelEvents>()),
       entities(std::make_unique<Entities>(*this)),
-      players(std::make_unique<Players>(*this)) {
+      players(std::make_unique<Players>(*this)),
+      encodedChunks(std::make_unique<EncodedChunksCache>()) {
     const auto& worldInfo = world->getInfo();
     auto& cameraIndices = content.getIndices(ResourceType::CAMERA);
     for (size_t i = 0; i < cameraIndices.size(); i++) {
@@ -59,6 +61,7 @@ Level::Level(
     });
     chunks->setOnUnload([this](Chunk& chunk) {
         events->trigger(LevelEventType::CHUNK_UNLOAD, &chunk);
+        encodedChunks->onUnload(chunk);
         AABB aabb = chunk.getAABB();
         entities->despawn(entities->getAllInside(aabb));
     });
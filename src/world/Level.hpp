@@ -14,6 +14,7 @@ class Inventories;
 class LevelEvents;
 class PhysicsSolver;
 class GlobalChunks;
+class EncodedChunksCache;
 class Camera;
 class Players;
 struct EngineSettings;
@@ -30,6 +31,8 @@ public:
     std::unique_ptr<LevelEvents> events;
     std::unique_ptr<Entities> entities;
     std::unique_ptr<Players> players;
+    /// @brief Chunk payloads cache for world.get_chunk_data
+    std::unique_ptr<EncodedChunksCache> encodedChunks;
     std::vector<std::shared_ptr<Camera>> cameras;  // move somewhere?
 
     Level(
@@ -91,7 +91,7 @@ std::unique_ptr<Level> World::create(
     info.seed = seed;
     auto world = std::make_unique<World>(
         info,
-        std::make_unique<WorldFiles>(directory, settings.debug),
+        std::make_unique<WorldFiles>(directory, settings),
         content,
         packs
     );
@@ -2,8 +2,16 @@
 
 #include <cstring>
 
+#include "coders/zstd.hpp"
+#include "debug/Profiler.hpp"
 #include "util/data_io.hpp"
 
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 #define REGION_FORMAT_MAGIC ".VOXREG"
 
 static io::path get_region_filename(int x, int z) {
@@ -11,7 +19,9 @@ static io::path get_region_filename(int x, int z) {
 }
 
 /// @brief Read missing chunks data (null pointers) from region file
-static void fetch_chunks(WorldRegion* region, int x, int z, regfile* file) {
+static void fetch_chunks(
+    const RegionsLayer& layer, WorldRegion* region, int x, int z, regfile* file
+) {
     auto* chunks = region->getChunks();
     auto sizes = region->getSizes();
 
@@ -19,14 +29,37 @@ static void fetch_chunks(WorldRegion* region, int x, int z, regfile* file) {
         int chunk_x = (i % REGION_SIZE) + x * REGION_SIZE;
         int chunk_z = (i / REGION_SIZE) + z * REGION_SIZE;
         if (chunks[i] == nullptr) {
-            chunks[i] = RegionsLayer::readChunkData(
+            chunks[i] = layer.readChunkData(
                     chunk_x, chunk_z, sizes[i][0], sizes[i][1], file);
         }
     }
 }
 
-regfile::regfile(io::path filename) : file(std::move(filename)) {
-    if (file.length() < REGION_HEADER_SIZE)
+static std::filesystem::path resolve_native(const io::path& file) {
+    try {
+        return io::resolve(file);
+    } catch (const std::runtime_error&) {
+        // device has no filesystem representation (e.g. zip archive)
+        return {};
+    }
+}
+
+static io::rafile open_region_file(const io::path& file) {
+    if (!resolve_native(file).empty()) {
+        return io::rafile(file);
+    }
+    return io::rafile(io::read(file), io::file_size(file));
+}
+
+static inline uint32_t read_uint32_le(const ubyte* src) {
+    uint32_t value;
+    std::memcpy(&value, src, sizeof(value));
+    return dataio::le2h(value);
+}
+
+regfile::regfile(io::path filename) : file(open_region_file(filename)) {
+    size_t fileSize = file.length();
+    if (fileSize < REGION_HEADER_SIZE + REGION_CHUNKS_COUNT * 4)
         throw std::runtime_error("incomplete region file header");
     char header[REGION_HEADER_SIZE];
     file.read(header, REGION_HEADER_SIZE);
@@ -42,20 +75,75 @@ regfile::regfile(io::path filename) : file(std::move(filename)) {
             "region format " + std::to_string(version) + " is not supported"
         );
     }
+    if (static_cast<ubyte>(header[9]) >
+        static_cast<ubyte>(compression::Method::ZSTD)) {
+        throw illegal_region_format(
+            "unknown compression method " + std::to_string(header[9])
+        );
+    }
+    compression = static_cast<compression::Method>(header[9]);
+
+    file.seekg(fileSize - REGION_CHUNKS_COUNT * 4);
+    file.read(reinterpret_cast<char*>(offsets), sizeof(offsets));
+    for (auto& offset : offsets) {
+        offset = dataio::le2h(offset);
+    }
+
+#ifdef __linux__
+    auto nativePath = resolve_native(filename);
+    if (nativePath.empty()) {
+        return;
+    }
+    int fd = ::open(nativePath.c_str(), O_RDONLY);
+    if (fd == -1) {
+        return;
+    }
+    void* ptr = ::mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (ptr != MAP_FAILED) {
+        mapped = static_cast<const ubyte*>(ptr);
+        mappedSize = fileSize;
+    }
+#endif
 }
 
-std::unique_ptr<ubyte[]> regfile::read(int index, uint32_t& size, uint32_t& srcSize) {
-    size_t file_size = file.length();
-    size_t table_offset = file_size - REGION_CHUNKS_COUNT * 4;
+regfile::~regfile() {
+#ifdef __linux__
+    if (mapped) {
+        ::munmap(const_cast<ubyte*>(mapped), mappedSize);
+    }
+#endif
+}
 
-    uint32_t buff32;
-    file.seekg(table_offset + index * 4);
-    file.read(reinterpret_cast<char*>(&buff32), 4);
-    uint32_t offset = dataio::le2h(buff32);
+const ubyte* regfile::view(int index, uint32_t& size, uint32_t& srcSize) const {
+    size_t offset = offsets[index];
+    if (mapped == nullptr || offset == 0) {
+        return nullptr;
+    }
+    if (offset + 8 > mappedSize) {
+        throw std::runtime_error("region chunk offset is out of file bounds");
+    }
+    size = read_uint32_le(mapped + offset);
+    srcSize = read_uint32_le(mapped + offset + 4);
+    if (offset + 8 + size > mappedSize) {
+        throw std::runtime_error("region chunk data is out of file bounds");
+    }
+    return mapped + offset + 8;
+}
+
+std::unique_ptr<ubyte[]> regfile::read(int index, uint32_t& size, uint32_t& srcSize) {
+    uint32_t offset = offsets[index];
     if (offset == 0) {
         return nullptr;
     }
+    if (mapped) {
+        const ubyte* src = view(index, size, srcSize);
+        auto data = std::make_unique<ubyte[]>(size);
+        std::memcpy(data.get(), src, size);
+        return data;
+    }
 
+    uint32_t buff32;
     file.seekg(offset);
     file.read(reinterpret_cast<char*>(&buff32), 4);
     size = dataio::le2h(buff32);
@@ -138,19 +226,27 @@ WorldRegion* RegionsLayer::getRegion(int x, int z) {
     return found->second.get();
 }
 
+size_t RegionsLayer::countRegions() {
+    std::lock_guard lock(mapMutex);
+    return regions.size();
+}
+
+size_t RegionsLayer::countOpenRegFiles() {
+    std::lock_guard lock(regFilesMutex);
+    return openRegFiles.size();
+}
+
 io::path RegionsLayer::getRegionFilePath(int x, int z) const {
     return folder / get_region_filename(x, z);
 }
 
 WorldRegion* RegionsLayer::getOrCreateRegion(int x, int z) {
-    if (auto region = getRegion(x, z)) {
-        return region;
-    }
     std::lock_guard lock(mapMutex);
-    auto region_ptr = std::make_unique<WorldRegion>();
-    auto region = region_ptr.get();
-    regions[{x, z}] = std::move(region_ptr);
-    return region;
+    auto& region = regions[{x, z}];
+    if (region == nullptr) {
+        region = std::make_unique<WorldRegion>();
+    }
+    return region.get();
 }
 
 ubyte* RegionsLayer::getData(int x, int z, uint32_t& size, uint32_t& srcSize) {
@@ -178,12 +274,135 @@ ubyte* RegionsLayer::getData(int x, int z, uint32_t& size, uint32_t& srcSize) {
     return nullptr;
 }
 
-void RegionsLayer::writeRegion(int x, int z, WorldRegion* entry) {
+std::unique_ptr<ubyte[]> RegionsLayer::getDecompressed(
+    int x, int z, uint32_t& srcSize
+) {
+    PROFILE_ZONE("region read");
+    int regionX, regionZ, localX, localZ;
+    calc_reg_coords(x, z, regionX, regionZ, localX, localZ);
+
+    uint32_t size;
+    WorldRegion* region = getRegion(regionX, regionZ);
+    if (region == nullptr || region->getChunkData(localX, localZ) == nullptr) {
+        auto regfile = getRegFile({regionX, regionZ});
+        if (regfile == nullptr) {
+            return nullptr;
+        }
+        int chunkIndex = localZ * REGION_SIZE + localX;
+        if (regfile.get()->mapped) {
+            return readDecompressed(*regfile.get(), chunkIndex, srcSize);
+        }
+    }
+    const ubyte* data = getData(x, z, size, srcSize);
+    if (data == nullptr) {
+        return nullptr;
+    }
+    if (compression.method == compression::Method::NONE) {
+        auto copy = std::make_unique<ubyte[]>(size);
+        std::memcpy(copy.get(), data, size);
+        return copy;
+    }
+    return compression::decompress(data, size, srcSize, compression);
+}
+
+std::unique_ptr<ubyte[]> RegionsLayer::readDecompressed(
+    regfile& rfile, int index, uint32_t& srcSize
+) const {
+    uint32_t size;
+    std::unique_ptr<ubyte[]> data;
+    const ubyte* src = rfile.view(index, size, srcSize);
+    if (src == nullptr) {
+        data = rfile.read(index, size, srcSize);
+        if (data == nullptr) {
+            return nullptr;
+        }
+        src = data.get();
+    }
+    if (rfile.compression == compression::Method::NONE) {
+        srcSize = size;
+        if (data == nullptr) {
+            data = std::make_unique<ubyte[]>(size);
+            std::memcpy(data.get(), src, size);
+        }
+        return data;
+    }
+    compression::Settings settings(rfile.compression);
+    if (rfile.compression == compression::Method::ZSTD) {
+        const auto& found =
+            dictionaries.find(zstd::get_dictionary_id(src, size));
+        if (found != dictionaries.end()) {
+            settings.dictionary = found->second;
+        }
+    }
+    return compression::decompress(src, size, srcSize, settings);
+}
+
+/// @brief Compress decompressed chunk data using the layer settings
+static std::unique_ptr<ubyte[]> compress_chunk_data(
+    const RegionsLayer& layer,
+    std::unique_ptr<ubyte[]> data,
+    uint32_t& size,
+    uint32_t srcSize
+) {
+    if (layer.compression.method == compression::Method::NONE) {
+        size = srcSize;
+        return data;
+    }
+    size_t length;
+    data = compression::compress(
+        data.get(), srcSize, length, layer.compression
+    );
+    size = length;
+    return data;
+}
+
+void RegionsLayer::recompressRegion(int x, int z) {
+    if (getRegion(x, z)) {
+        throw std::runtime_error("not implemented for in-memory regions");
+    }
+    WorldRegion region;
+    {
+        auto regfile = getRegFile({x, z});
+        if (regfile == nullptr) {
+            throw std::runtime_error("could not open region file");
+        }
+        for (size_t i = 0; i < REGION_CHUNKS_COUNT; i++) {
+            uint32_t size;
+            uint32_t srcSize;
+            auto data = readDecompressed(*regfile.get(), i, srcSize);
+            if (data == nullptr) {
+                continue;
+            }
+            data = compress_chunk_data(*this, std::move(data), size, srcSize);
+            region.put(
+                i % REGION_SIZE, i / REGION_SIZE, std::move(data), size, srcSize
+            );
+        }
+    }
+    writeRegion(x, z, &region);
+}
+
+io::path RegionsLayer::getDictionaryFile() const {
+    return folder / "zstd.dict";
+}
+
+io::path RegionsLayer::getDictionaryFile(uint id) const {
+    return folder / ("zstd-" + std::to_string(id) + ".dict");
+}
+
+void RegionsLayer::writeRegion(
+    int x, int z, WorldRegion* entry, const runnable& beforeReplace
+) {
+    PROFILE_ZONE("region write");
     io::path filename = folder / get_region_filename(x, z);
+    // written to a temporary file first, so an interrupted write
+    // never leaves a broken region file
+    io::path tmpFilename = filename.string() + ".tmp";
 
     glm::ivec2 regcoord(x, z);
-    if (auto regfile = getRegFile(regcoord, false)) {
-        fetch_chunks(entry, x, z, regfile.get());
+    // region file may be closed already, missing chunks are still required
+    if (auto regfile = getRegFile(regcoord)) {
+        fetch_chunks(*this, entry, x, z, regfile.get());
 
         std::lock_guard lock(regFilesMutex);
         regfile.reset();
@@ -192,8 +411,10 @@ void RegionsLayer::writeRegion(int x, int z, WorldRegion* entry) {
 
     char header[REGION_HEADER_SIZE] = REGION_FORMAT_MAGIC;
     header[8] = REGION_FORMAT_VERSION;
-    header[9] = static_cast<ubyte>(compression); // FIXME
-    std::ofstream file(io::resolve(filename), std::ios::out | std::ios::binary);
+    header[9] = static_cast<ubyte>(compression.method);
+    std::ofstream file(
+        io::resolve(tmpFilename), std::ios::out | std::ios::binary
+    );
     file.write(header, REGION_HEADER_SIZE);
 
     size_t offset = REGION_HEADER_SIZE;
@@ -229,13 +450,31 @@ void RegionsLayer::writeRegion(int x, int z, WorldRegion* entry) {
         intbuf = dataio::h2le(offsets[i]);
         file.write(reinterpret_cast<const char*>(&intbuf), 4);
     }
+    file.close();
+    if (file && beforeReplace) {
+        beforeReplace();
+    }
+    if (!file || !io::rename(tmpFilename, filename)) {
+        io::remove(tmpFilename);
+        throw std::runtime_error(
+            "could not write region file " + filename.string()
+        );
+    }
 }
 
 std::unique_ptr<ubyte[]> RegionsLayer::readChunkData(
     int x, int z, uint32_t& size, uint32_t& srcSize, regfile* rfile
-) {
+) const {
     int regionX, regionZ, localX, localZ;
     calc_reg_coords(x, z, regionX, regionZ, localX, localZ);
     int chunkIndex = localZ * REGION_SIZE + localX;
-    return rfile->read(chunkIndex, size, srcSize);
+    if (rfile->compression == compression.method) {
+        return rfile->read(chunkIndex, size, srcSize);
+    }
+    // region file is written with another compression method
+    auto data = readDecompressed(*rfile, chunkIndex, srcSize);
+    if (data == nullptr) {
+        return nullptr;
+    }
+    return compress_chunk_data(*this, std::move(data), size, srcSize);
 }
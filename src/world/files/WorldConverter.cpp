@@ -1,10 +1,12 @@
 #include "WorldConverter.hpp"
 
+#include <fstream>
 #include <iostream>
 #include <memory>
 #include <stdexcept>
 #include <utility>
 
+#include "coders/json.hpp"
 #include "content/ContentReport.hpp"
 #include "compatibility.hpp"
 #include "debug/Logger.hpp"
@@ -33,6 +35,65 @@ public:
     }
 };
 
+/// @brief Unique task key stored in the journal
+static std::string get_task_key(const ConvertTask& task) {
+    return std::to_string(static_cast<int>(task.type)) + " " +
+           std::to_string(static_cast<int>(task.layer)) + " " +
+           std::to_string(task.x) + " " + std::to_string(task.z);
+}
+
+void WorldConverter::addTask(ConvertTask task) {
+    auto key = get_task_key(task);
+    if (finishedTasks.find(key) != finishedTasks.end()) {
+        return;
+    }
+    if (pendingTasks.find(key) != pendingTasks.end()) {
+        io::path tmpFile = task.file.string() + ".tmp";
+        if (!io::is_regular_file(tmpFile)) {
+            // interrupted after the source file is replaced
+            commitTask(task);
+            return;
+        }
+        // interrupted before the source file is replaced
+        io::remove(tmpFile);
+    }
+    tasks.push(std::move(task));
+}
+
+void WorldConverter::loadJournal() {
+    // journal is valid only for the same conversion result
+    std::string header = std::to_string(static_cast<int>(mode)) + " " +
+                         json::stringify(patch, false);
+    if (io::is_regular_file(journalFile)) {
+        auto lines = io::read_list(journalFile);
+        if (!lines.empty() && lines[0] == header) {
+            for (size_t i = 1; i < lines.size(); i++) {
+                const auto& line = lines[i];
+                if (line.rfind(JOURNAL_PENDING, 0) == 0) {
+                    pendingTasks.insert(line.substr(JOURNAL_PENDING.length()));
+                } else {
+                    finishedTasks.insert(line);
+                }
+            }
+            logger.info() << "resuming conversion with "
+                          << finishedTasks.size() << " tasks finished";
+            return;
+        }
+        logger.warning() << "conversion journal does not match, ignored";
+    }
+    io::write_string(journalFile, header + "\n");
+}
+
+void WorldConverter::appendJournal(const std::string& line) {
+    std::lock_guard lock(journalMutex);
+    std::ofstream file(io::resolve(journalFile), std::ios::app);
+    file << line << std::endl;
+}
+
+void WorldConverter::commitTask(const ConvertTask& task) {
+    appendJournal(get_task_key(task));
+}
+
 void WorldConverter::addRegionsTasks(
     RegionLayerIndex layerid,
     ConvertTaskType taskType
@@ -43,13 +104,16 @@ void WorldConverter::addRegionsTasks(
         return;
     }
     for (const auto& file :io::directory_iterator(regionsFolder)) {
+        if (file.extension() != ".bin") {
+            continue;
+        }
         int x, z;
         std::string name = file.stem();
         if (!WorldRegions::parseRegionFilename(name, x, z)) {
             logger.error() << "could not parse region name " << name;
             continue;
         }
-        tasks.push(ConvertTask {taskType, file, x, z, layerid});
+        addTask(ConvertTask {taskType, file, x, z, layerid});
     }
 }
 
@@ -95,7 +159,7 @@ void WorldConverter::createConvertTasks() {
         }
     }
 
-    tasks.push(ConvertTask {
+    addTask(ConvertTask {
         ConvertTaskType::PLAYER, wfile->getPlayerFile(), 0, 0, {}});
 }
 
@@ -125,8 +189,23 @@ WorldConverter::WorldConverter(
     : wfile(worldFiles),
       report(std::move(reportPtr)),
       content(content),
-      mode(mode)
+      mode(mode),
+      patch(dv::object()),
+      journalFile(worldFiles->getFolder() / JOURNAL_FILE)
 {
+    switch (mode) {
+        case ConvertMode::UPGRADE:
+            patch["region-version"] = REGION_FORMAT_VERSION;
+            break;
+        case ConvertMode::REINDEX:
+            WorldFiles::createContentIndicesCache(content->getIndices(), patch);
+            break;
+        case ConvertMode::BLOCK_FIELDS:
+            WorldFiles::createBlockFieldsIndices(content->getIndices(), patch);
+            break;
+    }
+    loadJournal();
+
     switch (mode) {
         case ConvertMode::UPGRADE:
             createUpgradeTasks();
@@ -180,38 +259,77 @@ std::shared_ptr<Task> WorldConverter::startTask(
 }
 
 void WorldConverter::upgradeRegion(
-    const io::path& file, int x, int z, RegionLayerIndex layer
+    const io::path& file,
+    int x,
+    int z,
+    RegionLayerIndex layer,
+    const runnable& beforeReplace
 ) const {
     auto path = wfile->getRegions().getRegionFilePath(layer, x, z);
     auto bytes = io::read_bytes_buffer(path);
+    if (bytes.size() >= REGION_HEADER_SIZE &&
+        bytes[8] >= REGION_FORMAT_VERSION) {
+        logger.info() << "region " << path.string() << " is already upgraded";
+        return;
+    }
     auto buffer = compatibility::convert_region_2to3(bytes, layer);
-    io::write_bytes(path, buffer.data(), buffer.size());
+
+    io::path tmpFile = path.string() + ".tmp";
+    bool written = io::write_bytes(tmpFile, buffer.data(), buffer.size());
+    if (written) {
+        beforeReplace();
+    }
+    if (!written || !io::rename(tmpFile, path)) {
+        io::remove(tmpFile);
+        throw std::runtime_error(
+            "could not write region file " + path.string()
+        );
+    }
 }
 
-void WorldConverter::convertVoxels(const io::path& file, int x, int z) const {
+void WorldConverter::convertVoxels(
+    const io::path& file, int x, int z, const runnable& beforeReplace
+) const {
     logger.info() << "converting voxels region " << x << "_" << z;
     wfile->getRegions().processRegion(x, z, REGION_LAYER_VOXELS,
     [=](std::unique_ptr<ubyte[]> data, uint32_t*) {
-        Chunk::convert(data.get(), report.get());
+        if (!Chunk::convert(data.get(), report.get())) {
+            return std::unique_ptr<ubyte[]>();
+        }
         return data;
-    });
+    }, beforeReplace);
 }
 
-void WorldConverter::convertInventories(const io::path& file, int x, int z) const {
+void WorldConverter::convertInventories(
+    const io::path& file, int x, int z, const runnable& beforeReplace
+) const {
     logger.info() << "converting inventories region " << x << "_" << z;
     wfile->getRegions().processInventories(x, z, [=](Inventory* inventory) {
-        inventory->convert(report.get());
-    });
+        return inventory->convert(report.get());
+    }, beforeReplace);
 }
 
-void WorldConverter::convertPlayer(const io::path& file) const {
+void WorldConverter::convertPlayer(
+    const io::path& file, const runnable& beforeReplace
+) const {
     logger.info() << "converting player " << file.string();
     auto map = io::read_json(file);
     Player::convert(map, report.get());
-    io::write_json(file, map);
+
+    io::path tmpFile = file.string() + ".tmp";
+    bool written = io::write_json(tmpFile, map);
+    if (written) {
+        beforeReplace();
+    }
+    if (!written || !io::rename(tmpFile, file)) {
+        io::remove(tmpFile);
+        throw std::runtime_error("could not write player " + file.string());
+    }
 }
 
-void WorldConverter::convertBlocksData(int x, int z, const ContentReport& report) const {
+void WorldConverter::convertBlocksData(
+    int x, int z, const ContentReport& report, const runnable& beforeReplace
+) const {
     logger.info() << "converting blocks data";
     wfile->getRegions().processBlocksData(x, z, 
     [=](BlocksMetadata* heap, std::unique_ptr<ubyte[]> voxelsData) {
@@ -236,29 +354,34 @@ void WorldConverter::convertBlocksData(int x, int z, const ContentReport& report
             newStruct.convert(prevStruct, entry.data(), dst, true);
         }
         *heap = std::move(newHeap);
-    });
+    }, beforeReplace);
 }
 
-void WorldConverter::convert(const ConvertTask& task) const {
+void WorldConverter::convert(const ConvertTask& task) {
     if (!io::is_regular_file(task.file)) return;
 
+    // converted file is written to "<file>.tmp" completely at this point
+    auto beforeReplace = [this, &task]() {
+        appendJournal(JOURNAL_PENDING + get_task_key(task));
+    };
     switch (task.type) {
         case ConvertTaskType::UPGRADE_REGION:
-            upgradeRegion(task.file, task.x, task.z, task.layer);
+            upgradeRegion(task.file, task.x, task.z, task.layer, beforeReplace);
             break;
         case ConvertTaskType::VOXELS:
-            convertVoxels(task.file, task.x, task.z);
+            convertVoxels(task.file, task.x, task.z, beforeReplace);
             break;
         case ConvertTaskType::INVENTORIES:
-            convertInventories(task.file, task.x, task.z);
+            convertInventories(task.file, task.x, task.z, beforeReplace);
             break;
         case ConvertTaskType::PLAYER:
-            convertPlayer(task.file);
+            convertPlayer(task.file, beforeReplace);
             break;
         case ConvertTaskType::CONVERT_BLOCKS_DATA:
-            convertBlocksData(task.x, task.z, *report);
+            convertBlocksData(task.x, task.z, *report, beforeReplace);
             break;
     }
+    commitTask(task);
 }
 
 void WorldConverter::convertNext() {
@@ -277,7 +400,10 @@ void WorldConverter::setOnComplete(runnable callback) {
 }
 
 void WorldConverter::update() {
-    convertNext();
+    // all tasks may be finished before an interruption
+    if (!tasks.empty()) {
+        convertNext();
+    }
     if (onComplete && tasks.empty()) {
         onComplete();
     }
@@ -294,20 +420,9 @@ bool WorldConverter::isActive() const {
 void WorldConverter::write() {
     logger.info() << "applying changes";
 
-    auto patch = dv::object();
-    switch (mode) {
-        case ConvertMode::UPGRADE:
-            patch["region-version"] = REGION_FORMAT_VERSION;
-            break;
-        case ConvertMode::REINDEX:
-            WorldFiles::createContentIndicesCache(content->getIndices(), patch);
-            break;
-        case ConvertMode::BLOCK_FIELDS:
-            WorldFiles::createBlockFieldsIndices(content->getIndices(), patch);
-            break;
-    }
     wfile->patchIndicesFile(patch);
     wfile->write(nullptr, nullptr);
+    io::remove(journalFile);
 }
 
 void WorldConverter::waitForEnd() {
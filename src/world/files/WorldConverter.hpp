@@ -1,10 +1,14 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <queue>
+#include <string>
+#include <unordered_set>
 
 #include "delegates.hpp"
 #include "interfaces/Task.hpp"
+#include "data/dv.hpp"
 #include "io/io.hpp"
 #include "world/files/world_regions_fwd.hpp"
 #include "typedefs.hpp"
@@ -41,6 +45,12 @@ enum class ConvertMode {
     BLOCK_FIELDS,
 };
 
+/// @brief Converts world files region by region. Each region is written
+/// to the file as soon as processed. Finished tasks are appended to the
+/// journal file, so an interrupted conversion is resumed instead of
+/// converting already converted regions again. A task is marked pending
+/// in the journal before the converted file replaces the source one, so
+/// a task interrupted right after the replacement is not repeated
 class WorldConverter : public Task {
     std::shared_ptr<WorldFiles> wfile;
     std::shared_ptr<ContentReport> const report;
@@ -49,13 +59,43 @@ class WorldConverter : public Task {
     runnable onComplete;
     uint tasksDone = 0;
     ConvertMode mode;
+    /// @brief World indices patch applied on finish
+    dv::value patch;
+    io::path journalFile;
+    /// @brief Keys of tasks finished before the converter is created
+    std::unordered_set<std::string> finishedTasks;
+    /// @brief Keys of tasks interrupted before or after the converted file
+    /// replaced the source one
+    std::unordered_set<std::string> pendingTasks;
+    std::mutex journalMutex;
+
+    void loadJournal();
+    void appendJournal(const std::string& line);
+    void commitTask(const ConvertTask& task);
+    void addTask(ConvertTask task);
 
     void upgradeRegion(
-        const io::path& file, int x, int z, RegionLayerIndex layer) const;
-    void convertPlayer(const io::path& file) const;
-    void convertVoxels(const io::path& file, int x, int z) const;
-    void convertInventories(const io::path& file, int x, int z) const;
-    void convertBlocksData(int x, int z, const ContentReport& report) const;
+        const io::path& file,
+        int x,
+        int z,
+        RegionLayerIndex layer,
+        const runnable& beforeReplace
+    ) const;
+    void convertPlayer(
+        const io::path& file, const runnable& beforeReplace
+    ) const;
+    void convertVoxels(
+        const io::path& file, int x, int z, const runnable& beforeReplace
+    ) const;
+    void convertInventories(
+        const io::path& file, int x, int z, const runnable& beforeReplace
+    ) const;
+    void convertBlocksData(
+        int x,
+        int z,
+        const ContentReport& report,
+        const runnable& beforeReplace
+    ) const;
 
     void addRegionsTasks(
         RegionLayerIndex layerid,
@@ -74,11 +114,17 @@ public:
     );
     ~WorldConverter();
 
-    void convert(const ConvertTask& task) const;
+    void convert(const ConvertTask& task);
     void convertNext();
     void setOnComplete(runnable callback);
     void write();
 
+    /// @brief Checkpoint journal file name inside of the world folder
+    static inline const std::string JOURNAL_FILE = "convert.journal";
+    /// @brief Journal line prefix of a task which converted file is going
+    /// to replace the source one
+    static inline const std::string JOURNAL_PENDING = "pending ";
+
     void update() override;
     void terminate() override;
     bool isActive() const override;
@@ -41,12 +41,38 @@ WorldFiles::WorldFiles(const io::path& directory)
     : directory(directory), regions(directory) {
 }
 
-WorldFiles::WorldFiles(const io::path& directory, const DebugSettings& settings)
+static void set_compression(
+    WorldRegions& regions, RegionLayerIndex layer, const StringSetting& setting
+) {
+    try {
+        regions.setCompression(
+            layer, compression::parse_settings(setting.get())
+        );
+    } catch (const std::exception& err) {
+        logger.error() << "invalid compression '" << setting.get()
+                       << "': " << err.what();
+    }
+}
+
+WorldFiles::WorldFiles(const io::path& directory, const EngineSettings& settings)
     : WorldFiles(directory) {
-    generatorTestMode = settings.generatorTestMode.get();
-    doWriteLights = settings.doWriteLights.get();
+    generatorTestMode = settings.debug.generatorTestMode.get();
+    doWriteLights = settings.debug.doWriteLights.get();
     regions.generatorTestMode = generatorTestMode;
     regions.doWriteLights = doWriteLights;
+
+    const auto& storage = settings.storage;
+    set_compression(regions, REGION_LAYER_VOXELS, storage.voxelsCompression);
+    set_compression(regions, REGION_LAYER_LIGHTS, storage.lightsCompression);
+    set_compression(
+        regions, REGION_LAYER_INVENTORIES, storage.inventoriesCompression
+    );
+    set_compression(
+        regions, REGION_LAYER_ENTITIES, storage.entitiesCompression
+    );
+    set_compression(
+        regions, REGION_LAYER_BLOCKS_DATA, storage.blocksDataCompression
+    );
 }
 
 WorldFiles::~WorldFiles() = default;
@@ -21,7 +21,7 @@ class Content;
 class ContentIndices;
 class World;
 struct WorldInfo;
-struct DebugSettings;
+struct EngineSettings;
 
 class WorldFiles {
     io::path directory;
@@ -37,7 +37,7 @@ class WorldFiles {
     void writeIndices(const ContentIndices* indices);
 public:
     WorldFiles(const io::path& directory);
-    WorldFiles(const io::path& directory, const DebugSettings& settings);
+    WorldFiles(const io::path& directory, const EngineSettings& settings);
     ~WorldFiles();
 
     io::path getPlayerFile() const;
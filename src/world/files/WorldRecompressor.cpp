@@ -0,0 +1,77 @@
+#include "WorldRecompressor.hpp"
+
+#include <utility>
+
+#include "debug/Logger.hpp"
+#include "WorldFiles.hpp"
+
+static debug::Logger logger("world-recompressor");
+
+WorldRecompressor::WorldRecompressor(
+    std::shared_ptr<WorldFiles> worldFiles, bool trainDictionary
+)
+    : wfile(std::move(worldFiles)) {
+    auto& regions = wfile->getRegions();
+    for (uint i = 0; i < REGION_LAYERS_COUNT; i++) {
+        auto layer = static_cast<RegionLayerIndex>(i);
+        for (const auto& coord :
+             regions.prepareRecompress(layer, trainDictionary)) {
+            tasks.push(RecompressTask {layer, coord.x, coord.y});
+        }
+    }
+}
+
+WorldRecompressor::~WorldRecompressor() = default;
+
+void WorldRecompressor::setOnComplete(runnable callback) {
+    this->onComplete = std::move(callback);
+}
+
+void WorldRecompressor::finish() {
+    auto& regions = wfile->getRegions();
+    for (uint i = 0; i < REGION_LAYERS_COUNT; i++) {
+        regions.finishRecompress(static_cast<RegionLayerIndex>(i));
+    }
+    logger.info() << "recompressed " << tasksDone << " regions";
+    if (onComplete) {
+        onComplete();
+    }
+}
+
+void WorldRecompressor::update() {
+    if (!tasks.empty()) {
+        RecompressTask task = tasks.front();
+        tasks.pop();
+        tasksDone++;
+
+        wfile->getRegions().recompressRegion(task.layer, task.x, task.z);
+    }
+    if (tasks.empty() && !finished) {
+        finished = true;
+        finish();
+    }
+}
+
+void WorldRecompressor::terminate() {
+    // rewritten regions stay readable using dictionaries stored under ID
+    tasks = {};
+    finished = true;
+}
+
+bool WorldRecompressor::isActive() const {
+    return !finished;
+}
+
+void WorldRecompressor::waitForEnd() {
+    while (isActive()) {
+        update();
+    }
+}
+
+uint WorldRecompressor::getWorkTotal() const {
+    return tasks.size() + tasksDone;
+}
+
+uint WorldRecompressor::getWorkDone() const {
+    return tasksDone;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <memory>
+#include <queue>
+
+#include "delegates.hpp"
+#include "interfaces/Task.hpp"
+#include "world/files/world_regions_fwd.hpp"
+#include "typedefs.hpp"
+
+class WorldFiles;
+
+struct RecompressTask {
+    RegionLayerIndex layer;
+    /// @brief region coords
+    int x, z;
+};
+
+/// @brief Rewrites world region files using the layers compression settings
+/// one region per update. New zstd dictionary replaces the previous one
+/// only when all regions of the layer are rewritten
+class WorldRecompressor : public Task {
+    std::shared_ptr<WorldFiles> wfile;
+    std::queue<RecompressTask> tasks;
+    runnable onComplete;
+    uint tasksDone = 0;
+    bool finished = false;
+
+    void finish();
+public:
+    /// @param worldFiles world files
+    /// @param trainDictionary train new zstd dictionaries for layers
+    /// using zstd compression
+    WorldRecompressor(
+        std::shared_ptr<WorldFiles> worldFiles, bool trainDictionary
+    );
+    ~WorldRecompressor();
+
+    void setOnComplete(runnable callback);
+
+    void update() override;
+    void terminate() override;
+    bool isActive() const override;
+    void waitForEnd() override;
+    uint getWorkTotal() const override;
+    uint getWorkDone() const override;
+};
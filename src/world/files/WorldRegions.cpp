@@ -9,6 +9,9 @@
 #include "coders/byte_utils.hpp"
 #include "coders/rle.hpp"
 #include "coders/binary_json.hpp"
+#include "coders/gzip.hpp"
+#include "coders/zstd.hpp"
+#include "debug/Profiler.hpp"
 #include "items/Inventory.hpp"
 #include "maths/voxmaths.hpp"
 #include "util/data_io.hpp"
@@ -17,6 +20,11 @@
 
 static debug::Logger logger("world-regions");
 
+/// @brief Max trained zstd dictionary size
+inline constexpr size_t DICTIONARY_CAPACITY = 112 * 1024;
+/// @brief Chunks data volume used to train zstd dictionary
+inline constexpr size_t DICTIONARY_SAMPLES_VOLUME = DICTIONARY_CAPACITY * 100;
+
 WorldRegion::WorldRegion()
     : chunksData(
           std::make_unique<std::unique_ptr<ubyte[]>[]>(REGION_CHUNKS_COUNT)
@@ -61,20 +69,18 @@ WorldRegions::WorldRegions(const io::path& directory) : directory(directory) {
     for (size_t i = 0; i < REGION_LAYERS_COUNT; i++) {
         layers[i].layer = static_cast<RegionLayerIndex>(i);
     }
-    auto& voxels = layers[REGION_LAYER_VOXELS];
-    voxels.folder = directory / "regions";
-    voxels.compression = compression::Method::EXTRLE16;
-
-    auto& lights = layers[REGION_LAYER_LIGHTS];
-    lights.folder = directory / "lights";
-    lights.compression = compression::Method::EXTRLE8;
-
+    layers[REGION_LAYER_VOXELS].folder = directory / "regions";
+    layers[REGION_LAYER_LIGHTS].folder = directory / "lights";
     layers[REGION_LAYER_INVENTORIES].folder =
         directory / "inventories";
     layers[REGION_LAYER_ENTITIES].folder = directory / "entities";
+    layers[REGION_LAYER_BLOCKS_DATA].folder = directory / "blocksdata";
 
-    auto& blocksData = layers[REGION_LAYER_BLOCKS_DATA];
-    blocksData.folder = directory / "blocksdata";
+    setCompression(REGION_LAYER_VOXELS, compression::Method::EXTRLE16);
+    setCompression(REGION_LAYER_LIGHTS, compression::Method::EXTRLE8);
+    setCompression(REGION_LAYER_INVENTORIES, compression::Method::NONE);
+    setCompression(REGION_LAYER_ENTITIES, compression::Method::NONE);
+    setCompression(REGION_LAYER_BLOCKS_DATA, compression::Method::NONE);
 }
 
 WorldRegions::~WorldRegions() = default;
@@ -90,6 +96,30 @@ void RegionsLayer::writeAll() {
     }
 }
 
+void RegionsLayer::flush() {
+    writeAll();
+    std::lock_guard lock(mapMutex);
+    regions.clear();
+}
+
+void RegionsLayer::flushRegion(
+    int x, int z, const runnable& beforeReplace
+) {
+    std::unique_ptr<WorldRegion> region;
+    {
+        std::lock_guard lock(mapMutex);
+        auto found = regions.find({x, z});
+        if (found == regions.end()) {
+            return;
+        }
+        region = std::move(found->second);
+        regions.erase(found);
+    }
+    if (region->isUnsaved()) {
+        writeRegion(x, z, region.get(), beforeReplace);
+    }
+}
+
 void WorldRegions::put(
     int x,
     int z,
@@ -110,7 +140,7 @@ void WorldRegions::put(
         return;
     }
 
-    if (layer.compression != compression::Method::NONE) {
+    if (layer.compression.method != compression::Method::NONE) {
         data = compression::compress(
             data.get(), size, size, layer.compression);
     }
@@ -143,16 +173,24 @@ static ChunkInventoriesMap load_inventories(const ubyte* src, uint32_t size) {
     for (int i = 0; i < count; i++) {
         uint index = reader.getInt32();
         uint size = reader.getInt32();
-        auto map = json::from_binary(reader.pointer(), size);
-        reader.skip(size);
         auto inv = std::make_shared<Inventory>(0, 0);
-        inv->deserialize(map);
+        if (size >= 2 && reader.pointer()[0] == gzip::MAGIC[0] &&
+            reader.pointer()[1] == gzip::MAGIC[1]) {
+            auto data = gzip::decompress(reader.pointer(), size);
+            json::BinaryReader invReader(data.data(), data.size());
+            inv->deserialize(invReader);
+        } else {
+            json::BinaryReader invReader(reader.pointer(), size);
+            inv->deserialize(invReader);
+        }
+        reader.skip(size);
         inventories[index] = std::move(inv);
     }
     return inventories;
 }
 
 void WorldRegions::put(Chunk* chunk, std::vector<ubyte> entitiesData) {
+    PROFILE_ZONE("chunk save");
     if (generatorTestMode) {
         return;
     }
@@ -216,66 +254,70 @@ void WorldRegions::put(Chunk* chunk, std::vector<ubyte> entitiesData) {
 }
 
 std::unique_ptr<ubyte[]> WorldRegions::getVoxels(int x, int z) {
-    uint32_t size;
     uint32_t srcSize;
-    auto& layer = layers[REGION_LAYER_VOXELS];
-    auto* data = layer.getData(x, z, size, srcSize);
+    auto data = layers[REGION_LAYER_VOXELS].getDecompressed(x, z, srcSize);
     if (data == nullptr) {
         return nullptr;
     }
     assert(srcSize == CHUNK_DATA_LEN);
-    return compression::decompress(data, size, srcSize, layer.compression);
+    return data;
 }
 
 std::unique_ptr<light_t[]> WorldRegions::getLights(int x, int z) {
-    uint32_t size;
     uint32_t srcSize;
-    auto& layer = layers[REGION_LAYER_LIGHTS];
-    auto* bytes = layer.getData(x, z, size, srcSize);
-    if (bytes == nullptr) {
+    auto data = layers[REGION_LAYER_LIGHTS].getDecompressed(x, z, srcSize);
+    if (data == nullptr) {
         return nullptr;
     }
-    auto data = compression::decompress(
-        bytes, size, srcSize, layer.compression
-    );
     assert(srcSize == LIGHTMAP_DATA_LEN);
     return Lightmap::decode(data.get());
 }
 
 ChunkInventoriesMap WorldRegions::fetchInventories(int x, int z) {
-    uint32_t bytesSize;
     uint32_t srcSize;
-    auto bytes = layers[REGION_LAYER_INVENTORIES].getData(x, z, bytesSize, srcSize);
+    auto bytes = layers[REGION_LAYER_INVENTORIES].getDecompressed(x, z, srcSize);
     if (bytes == nullptr) {
         return {};
     }
-    return load_inventories(bytes, bytesSize);
+    return load_inventories(bytes.get(), srcSize);
 }
 
 BlocksMetadata WorldRegions::getBlocksData(int x, int z) {
-    uint32_t bytesSize;
+    BlocksMetadata heap;
+    getBlocksData(x, z, heap);
+    return heap;
+}
+
+void WorldRegions::getBlocksData(int x, int z, BlocksMetadata& heap) {
     uint32_t srcSize;
-    auto bytes = layers[REGION_LAYER_BLOCKS_DATA].getData(x, z, bytesSize, srcSize);
+    auto bytes = layers[REGION_LAYER_BLOCKS_DATA].getDecompressed(x, z, srcSize);
     if (bytes == nullptr) {
-        return {};
+        heap.clear();
+        return;
     }
-    BlocksMetadata heap;
-    heap.deserialize(bytes, bytesSize);
-    return heap;
+    heap.deserialize(bytes.get(), srcSize);
 }
 
-void WorldRegions::processInventories(int x, int z, const InventoryProc& func) {
+void WorldRegions::processInventories(
+    int x, int z, const InventoryProc& func, const runnable& beforeReplace
+) {
     processRegion(x, z, REGION_LAYER_INVENTORIES,
     [=](std::unique_ptr<ubyte[]> data, uint32_t* size) {
         auto inventories = load_inventories(data.get(), *size);
+        bool modified = false;
         for (const auto& [_, inventory] : inventories) {
-            func(inventory.get());
+            modified |= func(inventory.get());
+        }
+        if (!modified) {
+            return std::unique_ptr<ubyte[]>();
         }
         return write_inventories(inventories, *size);
-    });
+    }, beforeReplace);
 }
 
-void WorldRegions::processBlocksData(int x, int z, const BlockDataProc& func) {
+void WorldRegions::processBlocksData(
+    int x, int z, const BlockDataProc& func, const runnable& beforeReplace
+) {
     auto& voxLayer = layers[REGION_LAYER_VOXELS];
     auto& datLayer = layers[REGION_LAYER_BLOCKS_DATA];
     if (voxLayer.getRegion(x, z) || datLayer.getRegion(x, z)) {
@@ -299,15 +341,21 @@ void WorldRegions::processBlocksData(int x, int z, const BlockDataProc& func) {
 
             uint32_t datLength;
             uint32_t datSrcSize;
-            auto datData = RegionsLayer::readChunkData(
+            auto datData = datLayer.readChunkData(
                 gx, gz, datLength, datSrcSize, datRegfile.get()
             );
             if (datData == nullptr) {
                 continue;
             }
+            if (datLayer.compression.method != compression::Method::NONE) {
+                datData = compression::decompress(
+                    datData.get(), datLength, datSrcSize, datLayer.compression
+                );
+                datLength = datSrcSize;
+            }
             uint32_t voxLength;
             uint32_t voxSrcSize;
-            auto voxData = RegionsLayer::readChunkData(
+            auto voxData = voxLayer.readChunkData(
                 gx, gz, voxLength, voxSrcSize, voxRegfile.get()
             );
             if (voxData == nullptr) {
@@ -333,19 +381,21 @@ void WorldRegions::processBlocksData(int x, int z, const BlockDataProc& func) {
             put(gx, gz, REGION_LAYER_BLOCKS_DATA, bytes.release(), bytes.size());
         }
     }
+    datRegfile.reset();
+    voxRegfile.reset();
+    datLayer.flushRegion(x, z, beforeReplace);
 }
 
 dv::value WorldRegions::fetchEntities(int x, int z) {
     if (generatorTestMode) {
         return nullptr;
     }
-    uint32_t bytesSize;
     uint32_t srcSize;
-    const ubyte* data = layers[REGION_LAYER_ENTITIES].getData(x, z, bytesSize, srcSize);
+    auto data = layers[REGION_LAYER_ENTITIES].getDecompressed(x, z, srcSize);
     if (data == nullptr) {
         return nullptr;
     }
-    auto map = json::from_binary(data, bytesSize);
+    auto map = json::from_binary(data.get(), srcSize);
     if (map.empty()) {
         return nullptr;
     }
@@ -353,7 +403,11 @@ dv::value WorldRegions::fetchEntities(int x, int z) {
 }
 
 void WorldRegions::processRegion(
-    int x, int z, RegionLayerIndex layerid, const RegionProc& func
+    int x,
+    int z,
+    RegionLayerIndex layerid,
+    const RegionProc& func,
+    const runnable& beforeReplace
 ) {
     auto& layer = layers[layerid];
     if (layer.getRegion(x, z)) {
@@ -370,11 +424,11 @@ void WorldRegions::processRegion(
             uint32_t length;
             uint32_t srcSize;
             auto data =
-                RegionsLayer::readChunkData(gx, gz, length, srcSize, regfile.get());
+                layer.readChunkData(gx, gz, length, srcSize, regfile.get());
             if (data == nullptr) {
                 continue;
             }
-            if (layer.compression != compression::Method::NONE) {
+            if (layer.compression.method != compression::Method::NONE) {
                 data = compression::decompress(
                     data.get(), length, srcSize, layer.compression
                 );
@@ -386,6 +440,8 @@ void WorldRegions::processRegion(
             }
         }
     }
+    regfile.reset();
+    layer.flushRegion(x, z, beforeReplace);
 }
 
 const io::path& WorldRegions::getRegionsFolder(RegionLayerIndex layerid) const {
@@ -396,6 +452,140 @@ io::path WorldRegions::getRegionFilePath(RegionLayerIndex layerid, int x, int z)
     return layers[layerid].getRegionFilePath(x, z);
 }
 
+void WorldRegions::setCompression(
+    RegionLayerIndex layerid, compression::Settings settings
+) {
+    auto& layer = layers[layerid];
+    layer.dictionaries.clear();
+    int level = settings.level ? settings.level : zstd::DEFAULT_LEVEL;
+    std::shared_ptr<zstd::Dictionary> current;
+    auto dictionaryFile = layer.getDictionaryFile();
+    if (io::is_regular_file(dictionaryFile)) {
+        current = std::make_shared<zstd::Dictionary>(
+            io::read_bytes(dictionaryFile), level
+        );
+        layer.dictionaries[current->getId()] = current;
+    }
+    // dictionaries left by an interrupted recompression
+    if (io::is_directory(layer.folder)) {
+        for (const auto& file : io::directory_iterator(layer.folder)) {
+            if (file.extension() != ".dict" || file == dictionaryFile) {
+                continue;
+            }
+            auto dictionary = std::make_shared<zstd::Dictionary>(
+                io::read_bytes(file), level
+            );
+            layer.dictionaries[dictionary->getId()] = std::move(dictionary);
+        }
+    }
+    if (settings.method == compression::Method::ZSTD) {
+        settings.dictionary = std::move(current);
+    }
+    layer.compression = std::move(settings);
+}
+
+/// @brief Write file replacing the previous one only if written completely
+static void write_file_safe(const io::path& file, const std::vector<ubyte>& bytes) {
+    io::path tmpFile = file.string() + ".tmp";
+    if (!io::write_bytes(tmpFile, bytes.data(), bytes.size()) ||
+        !io::rename(tmpFile, file)) {
+        io::remove(tmpFile);
+        throw std::runtime_error("could not write file " + file.string());
+    }
+}
+
+static std::vector<glm::ivec2> list_regions(const io::path& folder) {
+    std::vector<glm::ivec2> regions;
+    if (!io::is_directory(folder)) {
+        return regions;
+    }
+    for (const auto& file : io::directory_iterator(folder)) {
+        if (file.extension() != ".bin") {
+            continue;
+        }
+        int x, z;
+        std::string name = file.stem();
+        if (!WorldRegions::parseRegionFilename(name, x, z)) {
+            logger.error() << "could not parse region name " << name;
+            continue;
+        }
+        regions.emplace_back(x, z);
+    }
+    return regions;
+}
+
+static std::vector<ubyte> train_dictionary(
+    RegionsLayer& layer, const std::vector<glm::ivec2>& regions
+) {
+    std::vector<ubyte> samples;
+    std::vector<size_t> sizes;
+    for (const auto& coord : regions) {
+        if (samples.size() >= DICTIONARY_SAMPLES_VOLUME) {
+            break;
+        }
+        auto regfile = layer.getRegFile(coord);
+        if (regfile == nullptr) {
+            continue;
+        }
+        for (size_t i = 0; i < REGION_CHUNKS_COUNT; i++) {
+            uint32_t srcSize;
+            auto data = layer.readDecompressed(*regfile.get(), i, srcSize);
+            if (data == nullptr) {
+                continue;
+            }
+            samples.insert(samples.end(), data.get(), data.get() + srcSize);
+            sizes.push_back(srcSize);
+        }
+    }
+    return zstd::train_dictionary(samples, sizes, DICTIONARY_CAPACITY);
+}
+
+std::vector<glm::ivec2> WorldRegions::prepareRecompress(
+    RegionLayerIndex layerid, bool trainDictionary
+) {
+    auto& layer = layers[layerid];
+    auto regions = list_regions(layer.folder);
+    if (regions.empty()) {
+        return regions;
+    }
+    if (trainDictionary &&
+        layer.compression.method == compression::Method::ZSTD) {
+        logger.info() << "training zstd dictionary for "
+                      << layer.folder.string();
+        int level = layer.compression.level ? layer.compression.level
+                                            : zstd::DEFAULT_LEVEL;
+        auto dictionary = std::make_shared<zstd::Dictionary>(
+            train_dictionary(layer, regions), level
+        );
+        // must be available to read rewritten regions if interrupted
+        write_file_safe(
+            layer.getDictionaryFile(dictionary->getId()),
+            dictionary->getBytes()
+        );
+        layer.dictionaries[dictionary->getId()] = dictionary;
+        layer.compression.dictionary = std::move(dictionary);
+    }
+    logger.info() << "recompressing " << regions.size() << " regions in "
+                  << layer.folder.string() << " to "
+                  << compression::to_string(layer.compression);
+    return regions;
+}
+
+void WorldRegions::recompressRegion(RegionLayerIndex layerid, int x, int z) {
+    layers[layerid].recompressRegion(x, z);
+}
+
+void WorldRegions::finishRecompress(RegionLayerIndex layerid) {
+    auto& layer = layers[layerid];
+    if (const auto& dictionary = layer.compression.dictionary) {
+        write_file_safe(layer.getDictionaryFile(), dictionary->getBytes());
+    }
+    // all region files are rewritten using the current settings
+    for (const auto& [id, _] : layer.dictionaries) {
+        io::remove(layer.getDictionaryFile(id));
+    }
+}
+
 void WorldRegions::writeAll() {
     for (auto& layer : layers) {
         io::create_directories(layer.folder);
@@ -403,6 +593,29 @@ void WorldRegions::writeAll() {
     }
 }
 
+void WorldRegions::flush() {
+    for (auto& layer : layers) {
+        io::create_directories(layer.folder);
+        layer.flush();
+    }
+}
+
+size_t WorldRegions::countRegions() {
+    size_t count = 0;
+    for (auto& layer : layers) {
+        count += layer.countRegions();
+    }
+    return count;
+}
+
+size_t WorldRegions::countOpenRegFiles() {
+    size_t count = 0;
+    for (auto& layer : layers) {
+        count += layer.countOpenRegFiles();
+    }
+    return count;
+}
+
 void WorldRegions::deleteRegion(RegionLayerIndex layerid, int x, int z) {
     auto& layer = layers[layerid];
     if (layer.getRegFile({x, z}, false)) {
@@ -1,12 +1,15 @@
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <functional>
 #include <glm/glm.hpp>
 #include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <vector>
 
+#include "delegates.hpp"
 #include "typedefs.hpp"
 #include "util/BufferPool.hpp"
 #include "voxels/Chunk.hpp"
@@ -34,7 +37,7 @@ public:
 class WorldRegion {
     std::unique_ptr<std::unique_ptr<ubyte[]>[]> chunksData;
     std::unique_ptr<glm::u32vec2[]> sizes;
-    bool unsaved = false;
+    std::atomic<bool> unsaved {false};
 public:
     WorldRegion();
     ~WorldRegion();
@@ -53,17 +56,33 @@ public:
 struct regfile {
     io::rafile file;
     int version;
+    /// @brief Compression method of the region file chunks
+    compression::Method compression;
     bool inUse = false;
+    /// @brief Chunk data offsets table (read once on open)
+    uint32_t offsets[REGION_CHUNKS_COUNT] {};
+    /// @brief Memory-mapped file content or nullptr if not mapped
+    const ubyte* mapped = nullptr;
+    size_t mappedSize = 0;
 
     regfile(io::path filename);
     regfile(const regfile&) = delete;
+    ~regfile();
 
     std::unique_ptr<ubyte[]> read(int index, uint32_t& size, uint32_t& srcSize);
+
+    /// @brief Get compressed chunk data directly from the mapped file
+    /// @param index chunk index inside of the region
+    /// @param size [out] compressed chunk data length
+    /// @param srcSize [out] source chunk data length
+    /// @return nullptr if file is not mapped or chunk is not present
+    const ubyte* view(int index, uint32_t& size, uint32_t& srcSize) const;
 };
 
 using RegionsMap = std::unordered_map<glm::ivec2, std::unique_ptr<WorldRegion>>;
 using RegionProc = std::function<std::unique_ptr<ubyte[]>(std::unique_ptr<ubyte[]>,uint32_t*)>;
-using InventoryProc = std::function<void(Inventory*)>;
+/// @brief Returns true if the inventory is modified
+using InventoryProc = std::function<bool(Inventory*)>;
 using BlockDataProc = std::function<void(BlocksMetadata*, std::unique_ptr<ubyte[]>)>;
 
 /// @brief Region file pointer keeping inUse flag on until destroyed
@@ -120,7 +139,13 @@ struct RegionsLayer {
     /// @brief Regions layer folder
     io::path folder;
 
-    compression::Method compression = compression::Method::NONE;
+    /// @brief Chunks data compression settings
+    compression::Settings compression;
+
+    /// @brief zstd dictionaries used to decompress region files by ID.
+    /// Files rewritten by an interrupted recompression may use
+    /// a dictionary other than the current one
+    std::unordered_map<uint, std::shared_ptr<zstd::Dictionary>> dictionaries;
 
     /// @brief In-memory regions data
     RegionsMap regions;
@@ -153,14 +178,41 @@ struct RegionsLayer {
     /// @return nullptr if no saved chunk data found
     [[nodiscard]] ubyte* getData(int x, int z, uint32_t& size, uint32_t& srcSize);
 
+    /// @brief Get decompressed chunk data. Chunk data not loaded yet is
+    /// decompressed straight from the mapped region file without caching.
+    /// @param x chunk x coord
+    /// @param z chunk z coord
+    /// @param srcSize [out] source chunk data length
+    /// @return nullptr if no saved chunk data found
+    [[nodiscard]] std::unique_ptr<ubyte[]> getDecompressed(
+        int x, int z, uint32_t& srcSize
+    );
+
     /// @brief Write or rewrite region file
     /// @param x region X
     /// @param z region Z
-    void writeRegion(int x, int y, WorldRegion* entry);
+    /// @param beforeReplace called when the new file is written completely
+    /// and is going to replace the previous one
+    void writeRegion(
+        int x,
+        int y,
+        WorldRegion* entry,
+        const runnable& beforeReplace = nullptr
+    );
 
     /// @brief Write all unsaved regions to files
     void writeAll();
 
+    /// @brief Write all unsaved regions to files and remove in-memory
+    /// regions
+    void flush();
+
+    /// @brief Write region if unsaved and remove it from memory
+    /// @param x region X
+    /// @param z region Z
+    /// @param beforeReplace see writeRegion
+    void flushRegion(int x, int z, const runnable& beforeReplace = nullptr);
+
     /// @brief Read chunk data from region file
     /// @param x chunk x coord
     /// @param z chunk z coord
@@ -168,9 +220,36 @@ struct RegionsLayer {
     /// @param srcSize [out] source chunk data length
     /// @param rfile region file
     /// @return nullptr if chunk is not present in region file
-    [[nodiscard]] static std::unique_ptr<ubyte[]> readChunkData(
+    [[nodiscard]] std::unique_ptr<ubyte[]> readChunkData(
         int x, int z, uint32_t& size, uint32_t& srcSize, regfile* rfile
-    );
+    ) const;
+
+    /// @brief Read and decompress chunk data from region file
+    /// @param rfile region file
+    /// @param index chunk index inside of the region
+    /// @param srcSize [out] source chunk data length
+    /// @return nullptr if chunk is not present in region file
+    [[nodiscard]] std::unique_ptr<ubyte[]> readDecompressed(
+        regfile& rfile, int index, uint32_t& srcSize
+    ) const;
+
+    /// @brief Rewrite region file using the layer compression settings
+    /// @param x region X
+    /// @param z region Z
+    void recompressRegion(int x, int z);
+
+    /// @brief Get current trained zstd dictionary file path
+    io::path getDictionaryFile() const;
+
+    /// @brief Get path of zstd dictionary file stored under its ID
+    /// until recompression is finished
+    io::path getDictionaryFile(uint id) const;
+
+    /// @return number of in-memory regions
+    size_t countRegions();
+
+    /// @return number of open region files
+    size_t countOpenRegFiles();
 };
 
 class WorldRegions {
@@ -216,6 +295,9 @@ public:
     ChunkInventoriesMap fetchInventories(int x, int z);
 
     BlocksMetadata getBlocksData(int x, int z);
+
+    /// @brief Read blocks data to the heap reusing its buffer
+    void getBlocksData(int x, int z, BlocksMetadata& heap);
     
     /// @brief Load saved entities data for chunk
     /// @param x chunk.x
@@ -223,17 +305,38 @@ public:
     /// @return map with entities list as "data"
     dv::value fetchEntities(int x, int z);
 
-    /// @brief Load, process and save processed region chunks data
+    /// @brief Load, process and save processed region chunks data.
+    /// Chunks are streamed from the region file one by one, the region is
+    /// written and freed on finish. Region file is not rewritten if
+    /// the callback returns nullptr for all chunks
     /// @param x region X
     /// @param z region Z
     /// @param layerid regions layer index
-    /// @param func processing callback
+    /// @param func processing callback returning nullptr if chunk data
+    /// is not modified
+    /// @param beforeReplace called when the processed region is written
+    /// to a temporary file and is going to replace the region file
     void processRegion(
-        int x, int z, RegionLayerIndex layerid, const RegionProc& func);
+        int x,
+        int z,
+        RegionLayerIndex layerid,
+        const RegionProc& func,
+        const runnable& beforeReplace = nullptr
+    );
 
-    void processInventories(int x, int z, const InventoryProc& func);
+    void processInventories(
+        int x,
+        int z,
+        const InventoryProc& func,
+        const runnable& beforeReplace = nullptr
+    );
 
-    void processBlocksData(int x, int z, const BlockDataProc& func);
+    void processBlocksData(
+        int x,
+        int z,
+        const BlockDataProc& func,
+        const runnable& beforeReplace = nullptr
+    );
 
     /// @brief Get regions directory by layer index
     /// @param layerid layer index
@@ -242,11 +345,48 @@ public:
 
     io::path getRegionFilePath(RegionLayerIndex layerid, int x, int z) const;
 
+    /// @brief Set layer compression settings. Trained zstd dictionary is
+    /// loaded from the layer folder if exists
+    /// @param layerid layer index
+    /// @param settings compression settings
+    void setCompression(
+        RegionLayerIndex layerid, compression::Settings settings
+    );
+
+    /// @brief Prepare rewriting all region files of the layer using
+    /// the layer compression settings. New dictionary is written to the
+    /// file under its ID before any region file is rewritten, the previous
+    /// one is kept until the recompression is finished
+    /// @param layerid layer index
+    /// @param trainDictionary train new zstd dictionary on the layer chunks
+    /// (ZSTD compression only)
+    /// @return coords of the layer regions to rewrite
+    std::vector<glm::ivec2> prepareRecompress(
+        RegionLayerIndex layerid, bool trainDictionary
+    );
+
+    /// @brief Rewrite region file using the layer compression settings
+    void recompressRegion(RegionLayerIndex layerid, int x, int z);
+
+    /// @brief Make new dictionary current and remove dictionaries not
+    /// used anymore. Called when all region files are rewritten
+    void finishRecompress(RegionLayerIndex layerid);
+
     /// @brief Write all region layers
     void writeAll();
 
+    /// @brief Write all region layers and free in-memory regions.
+    /// Used by bulk writers (world pre-generation)
+    void flush();
+
     void deleteRegion(RegionLayerIndex layerid, int x, int z);
 
+    /// @return number of in-memory regions of all layers
+    size_t countRegions();
+
+    /// @return number of open region files of all layers
+    size_t countOpenRegFiles();
+
     /// @brief Extract X and Z from 'X_Z.bin' region file name.
     /// @param name source region file name
     /// @param x parsed X destination
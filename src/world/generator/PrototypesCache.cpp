@@ -0,0 +1,54 @@
+#include "PrototypesCache.hpp"
+
+#include <algorithm>
+
+PrototypesCache::PrototypesCache(size_t capacity) : capacity(capacity) {
+}
+
+PrototypesCache::~PrototypesCache() = default;
+
+void PrototypesCache::evict() {
+    // remove least recently used entries in one pass
+    size_t removeCount = entries.size() - capacity * 3 / 4;
+    std::vector<uint64_t> accesses;
+    accesses.reserve(entries.size());
+    for (const auto& [_, entry] : entries) {
+        accesses.push_back(entry.lastAccess);
+    }
+    std::nth_element(
+        accesses.begin(), accesses.begin() + removeCount - 1, accesses.end()
+    );
+    uint64_t threshold = accesses[removeCount - 1];
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (it->second.lastAccess <= threshold) {
+            it = entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+PrototypesCache::Entry* PrototypesCache::find(int x, int z) {
+    const auto& found = entries.find(glm::ivec2(x, z));
+    if (found == entries.end()) {
+        return nullptr;
+    }
+    found->second.lastAccess = ++accessCounter;
+    return &found->second;
+}
+
+PrototypesCache::Entry& PrototypesCache::require(int x, int z) {
+    if (auto entry = find(x, z)) {
+        return *entry;
+    }
+    if (!entries.empty() && entries.size() >= capacity) {
+        evict();
+    }
+    auto& entry = entries[glm::ivec2(x, z)];
+    entry.lastAccess = ++accessCounter;
+    return entry;
+}
+
+void PrototypesCache::clear() {
+    entries.clear();
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/glm.hpp>
+#include <glm/gtx/hash.hpp>
+
+#include "typedefs.hpp"
+#include "StructurePlacement.hpp"
+
+class Heightmap;
+struct Biome;
+
+/// @brief Bounded cache of chunk prototypes generation results.
+/// Generator scripts are deterministic for the seed, so a prototype removed
+/// from the generator area is rebuilt from the cache without calling
+/// scripts when the area returns to it.
+/// Valid for a single generator and seed only.
+/// @attention Not thread-safe
+class PrototypesCache {
+public:
+    struct Entry {
+        /// @brief Wide structures placed by the chunk
+        std::unique_ptr<std::vector<Placement>> wideStructs;
+        /// @brief Chunk biomes matrix
+        std::unique_ptr<const Biome*[]> biomes;
+        /// @brief Biome parameters maps used to generate heightmap
+        std::vector<std::shared_ptr<Heightmap>> heightmapInputs;
+        /// @brief Chunk heightmap
+        std::shared_ptr<Heightmap> heightmap;
+        /// @brief Structures placed by the generator script
+        std::unique_ptr<std::vector<Placement>> structs;
+        uint64_t lastAccess = 0;
+    };
+private:
+    size_t capacity;
+    uint64_t accessCounter = 0;
+    std::unordered_map<glm::ivec2, Entry> entries;
+
+    void evict();
+public:
+    /// @param capacity max number of cached prototypes
+    explicit PrototypesCache(size_t capacity = 4096);
+    ~PrototypesCache();
+
+    /// @return cached entry or nullptr
+    Entry* find(int x, int z);
+
+    /// @brief Get existing or create an empty entry.
+    /// Least recently used entries are removed if capacity is exceeded
+    Entry& require(int x, int z);
+
+    void clear();
+
+    size_t size() const {
+        return entries.size();
+    }
+
+    size_t getCapacity() const {
+        return capacity;
+    }
+};
@@ -170,29 +170,16 @@ void VoxelFragment::prepare(const Content& content) {
     }
 }
 
-void VoxelFragment::place(
-    GlobalChunks& chunks, const glm::ivec3& offset, ubyte rotation
+size_t VoxelFragment::place(
+    GlobalChunks& chunks,
+    const glm::ivec3& offset,
+    ubyte rotation,
+    std::vector<glm::ivec3>* changed
 ) {
-    auto& structVoxels = getRuntimeVoxels();
-    for (int y = 0; y < size.y; y++) {
-        int sy = y + offset.y;
-        if (sy < 0 || sy >= CHUNK_H) {
-            continue;
-        }
-        for (int z = 0; z < size.z; z++) {
-            int sz = z + offset.z;
-            for (int x = 0; x < size.x; x++) {
-                int sx = x + offset.x;
-                const auto& structVoxel = 
-                    structVoxels[vox_index(x, y, z, size.x, size.z)];
-                if (structVoxel.id) {
-                    blocks_agent::set(
-                        chunks, sx, sy, sz, structVoxel.id, structVoxel.state
-                    );
-                }
-            }
-        }
-    }
+    const auto& structVoxels = getRuntimeVoxels();
+    return blocks_agent::paste(
+        chunks, structVoxels.data(), size, offset, changed
+    );
 }
 
 std::unique_ptr<VoxelFragment> VoxelFragment::rotated(const Content& content) const {
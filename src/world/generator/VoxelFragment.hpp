@@ -46,7 +46,14 @@ public:
     /// @brief Place fragment to the world
     /// @param offset target location
     /// @param rotation rotation index
-    void place(GlobalChunks& chunks, const glm::ivec3& offset, ubyte rotation);
+    /// @param changed [out] nullable positions of modified voxels
+    /// @return number of modified voxels
+    size_t place(
+        GlobalChunks& chunks,
+        const glm::ivec3& offset,
+        ubyte rotation,
+        std::vector<glm::ivec3>* changed = nullptr
+    );
 
     /// @brief Create structure copy rotated 90 deg. clockwise
     std::unique_ptr<VoxelFragment> rotated(const Content& content) const;
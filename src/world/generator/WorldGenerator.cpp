@@ -3,6 +3,7 @@
 #include <cstring>
 #include <algorithm>
 
+#include "debug/Profiler.hpp"
 #include "maths/util.hpp"
 #include "content/Content.hpp"
 #include "voxels/Block.hpp"
@@ -23,13 +24,36 @@ static inline constexpr uint MAX_PARAMETERS = 4;
 /// @brief Initial + wide_structs + biomes + heightmaps + complete
 static inline constexpr uint BASIC_PROTOTYPE_LAYERS = 5;
 
+static std::vector<std::shared_ptr<Heightmap>> copy_heightmaps(
+    const std::vector<std::shared_ptr<Heightmap>>& maps
+) {
+    std::vector<std::shared_ptr<Heightmap>> copies;
+    copies.reserve(maps.size());
+    for (const auto& map : maps) {
+        copies.push_back(std::make_shared<Heightmap>(*map));
+    }
+    return copies;
+}
+
+static std::unique_ptr<const Biome*[]> copy_biomes(
+    const Biome* const* biomes
+) {
+    auto copy = std::make_unique<const Biome*[]>(CHUNK_W * CHUNK_D);
+    std::copy(biomes, biomes + CHUNK_W * CHUNK_D, copy.get());
+    return copy;
+}
+
 WorldGenerator::WorldGenerator(
-    const GeneratorDef& def, const Content& content, uint64_t seed
+    const GeneratorDef& def,
+    const Content& content,
+    uint64_t seed,
+    size_t prototypesCacheCapacity
 )
     : def(def), 
       content(content), 
       seed(seed),
-      surroundMap(0, BASIC_PROTOTYPE_LAYERS + def.wideStructsChunksRadius * 2)
+      surroundMap(0, BASIC_PROTOTYPE_LAYERS + def.wideStructsChunksRadius * 2),
+      prototypesCache(prototypesCacheCapacity)
 {
     def.script->initialize(seed);
 
@@ -230,10 +254,17 @@ void WorldGenerator::generateStructuresWide(
     if (prototype.level >= ChunkPrototypeLevel::WIDE_STRUCTS) {
         return;
     }
-    auto placements = def.script->placeStructuresWide(
-        {chunkX * CHUNK_W, chunkZ * CHUNK_D}, {CHUNK_W, CHUNK_D}, CHUNK_H
-    );
-    placeStructures(placements, prototype, chunkX, chunkZ);
+    auto& cached = prototypesCache.require(chunkX, chunkZ);
+    if (cached.wideStructs == nullptr) {
+        cached.wideStructs = std::make_unique<std::vector<Placement>>(
+            def.script->placeStructuresWide(
+                {chunkX * CHUNK_W, chunkZ * CHUNK_D},
+                {CHUNK_W, CHUNK_D},
+                CHUNK_H
+            )
+        );
+    }
+    placeStructures(*cached.wideStructs, prototype, chunkX, chunkZ);
 
     prototype.level = ChunkPrototypeLevel::WIDE_STRUCTS;
 }
@@ -247,11 +278,16 @@ void WorldGenerator::generateStructures(
     const auto& biomes = prototype.biomes;
     const auto& heightmap = prototype.heightmap;
 
-    auto placements = def.script->placeStructures(
-        {chunkX * CHUNK_W, chunkZ * CHUNK_D}, {CHUNK_W, CHUNK_D},
-        heightmap, CHUNK_H
-    );
-    placeStructures(placements, prototype, chunkX, chunkZ);
+    auto& cached = prototypesCache.require(chunkX, chunkZ);
+    if (cached.structs == nullptr) {
+        cached.structs = std::make_unique<std::vector<Placement>>(
+            def.script->placeStructures(
+                {chunkX * CHUNK_W, chunkZ * CHUNK_D}, {CHUNK_W, CHUNK_D},
+                heightmap, CHUNK_H
+            )
+        );
+    }
+    placeStructures(*cached.structs, prototype, chunkX, chunkZ);
 
     util::PseudoRandom structsRand;
     structsRand.setSeed(chunkX, chunkZ);
@@ -297,6 +333,22 @@ void WorldGenerator::generateBiomes(
     if (prototype.level >= ChunkPrototypeLevel::BIOMES) {
         return;
     }
+    auto& cached = prototypesCache.require(chunkX, chunkZ);
+    if (cached.biomes) {
+        prototype.biomes = copy_biomes(cached.biomes.get());
+        if (cached.heightmap) {
+            // inputs are dropped once the heightmap is cached and the entry
+            // may be evicted before the heightmap stage, so take both now
+            prototype.heightmap =
+                std::make_shared<Heightmap>(*cached.heightmap);
+            prototype.level = ChunkPrototypeLevel::HEIGHTMAP;
+            return;
+        }
+        // scripts may modify maps passed to them
+        prototype.heightmapInputs = copy_heightmaps(cached.heightmapInputs);
+        prototype.level = ChunkPrototypeLevel::BIOMES;
+        return;
+    }
     uint bpd = def.biomesBPD;
     auto biomeParams = def.script->generateParameterMaps(
         {floordiv(chunkX * CHUNK_W, bpd), floordiv(chunkZ * CHUNK_D, bpd)},
@@ -328,6 +380,8 @@ void WorldGenerator::generateBiomes(
                 choose_biome(biomes, biomeParams, x, z);
         }
     }
+    cached.heightmapInputs = copy_heightmaps(prototype.heightmapInputs);
+    cached.biomes = copy_biomes(chunkBiomes.get());
     prototype.biomes = std::move(chunkBiomes);
     prototype.level = ChunkPrototypeLevel::BIOMES;
 }
@@ -338,6 +392,12 @@ void WorldGenerator::generateHeightmap(
     if (prototype.level >= ChunkPrototypeLevel::HEIGHTMAP) {
         return;
     }
+    auto& cached = prototypesCache.require(chunkX, chunkZ);
+    if (cached.heightmap) {
+        prototype.heightmap = std::make_shared<Heightmap>(*cached.heightmap);
+        prototype.level = ChunkPrototypeLevel::HEIGHTMAP;
+        return;
+    }
     uint bpd = def.heightsBPD;
     prototype.heightmap = def.script->generateHeightmap(
         {floordiv(chunkX * CHUNK_W, bpd), floordiv(chunkZ * CHUNK_D, bpd)},
@@ -350,6 +410,9 @@ void WorldGenerator::generateHeightmap(
         CHUNK_W + bpd, CHUNK_D + bpd, def.heightsInterpolation
     );
     prototype.heightmap->crop(0, 0, CHUNK_W, CHUNK_D);
+    cached.heightmap = std::make_shared<Heightmap>(*prototype.heightmap);
+    // inputs are not used anymore when the heightmap is cached
+    cached.heightmapInputs.clear();
     prototype.level = ChunkPrototypeLevel::HEIGHTMAP;
 }
 
@@ -427,6 +490,7 @@ void WorldGenerator::generateLand(
 }
 
 void WorldGenerator::generate(voxel* voxels, int chunkX, int chunkZ) {
+    PROFILE_ZONE("chunk generate");
     surroundMap.completeAt(chunkX, chunkZ);
 
     const auto& prototype = requirePrototype(chunkX, chunkZ);
@@ -11,6 +11,7 @@
 #include "voxels/voxel.hpp"
 #include "SurroundMap.hpp"
 #include "StructurePlacement.hpp"
+#include "PrototypesCache.hpp"
 
 class Content;
 struct GeneratorDef;
@@ -57,6 +58,9 @@ class WorldGenerator {
     std::unordered_map<glm::ivec2, std::unique_ptr<ChunkPrototype>> prototypes;
     /// @brief Chunk prototypes loading surround map
     SurroundMap surroundMap;
+    /// @brief Generator scripts results of prototypes removed from
+    /// the surround map area. Shared by all players using the generator
+    PrototypesCache prototypesCache;
 
     /// @brief Generate chunk prototype (see ChunkPrototype)
     /// @param x chunk position X divided by CHUNK_W
@@ -118,10 +122,13 @@ class WorldGenerator {
         int x, int z
     );
 public:
+    /// @param prototypesCacheCapacity max number of cached prototypes
+    /// generation results
     WorldGenerator(
         const GeneratorDef& def,
         const Content& content,
-        uint64_t seed
+        uint64_t seed,
+        size_t prototypesCacheCapacity = 4096
     );
     ~WorldGenerator();
 
@@ -135,5 +142,9 @@ public:
 
     WorldGenDebugInfo createDebugInfo() const;
 
+    const PrototypesCache& getPrototypesCache() const {
+        return prototypesCache;
+    }
+
     uint64_t getSeed() const;
 };
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "assets/atlas_cache.hpp"
+#include "graphics/core/Atlas.hpp"
+#include "graphics/core/ImageData.hpp"
+
+static std::unique_ptr<ImageData> make_image(uint w, uint h, ubyte value) {
+    auto image = std::make_unique<ImageData>(ImageFormat::rgba8888, w, h);
+    std::memset(image->getData(), value, image->getDataSize());
+    return image;
+}
+
+TEST(atlas_cache, EncodeDecode) {
+    AtlasBuilder builder;
+    builder.add("a", make_image(16, 16, 10));
+    builder.add("b", make_image(8, 32, 20));
+    builder.add("c", make_image(4, 4, 30));
+    auto atlas = builder.build(2, false);
+
+    uint64_t key = 0x1234567890ABCDEFULL;
+    auto bytes = atlas_cache::encode(*atlas, key);
+    auto decoded = atlas_cache::decode(bytes.data(), bytes.size(), key, false);
+    ASSERT_NE(decoded, nullptr);
+
+    const auto& srcImage = *atlas->getImage();
+    const auto& dstImage = *decoded->getImage();
+    ASSERT_EQ(srcImage.getWidth(), dstImage.getWidth());
+    ASSERT_EQ(srcImage.getHeight(), dstImage.getHeight());
+    ASSERT_EQ(srcImage.getFormat(), dstImage.getFormat());
+    EXPECT_EQ(
+        std::memcmp(
+            srcImage.getData(), dstImage.getData(), srcImage.getDataSize()
+        ),
+        0
+    );
+    for (const auto& name : {"a", "b", "c"}) {
+        const auto& src = atlas->get(name);
+        const auto& dst = decoded->get(name);
+        EXPECT_FLOAT_EQ(src.u1, dst.u1);
+        EXPECT_FLOAT_EQ(src.v1, dst.v1);
+        EXPECT_FLOAT_EQ(src.u2, dst.u2);
+        EXPECT_FLOAT_EQ(src.v2, dst.v2);
+    }
+}
+
+TEST(atlas_cache, KeyMismatch) {
+    AtlasBuilder builder;
+    builder.add("a", make_image(16, 16, 10));
+    auto atlas = builder.build(2, false);
+
+    auto bytes = atlas_cache::encode(*atlas, 1);
+    EXPECT_EQ(atlas_cache::decode(bytes.data(), bytes.size(), 2, false), nullptr);
+    bytes.resize(bytes.size() - 1);
+    EXPECT_EQ(atlas_cache::decode(bytes.data(), bytes.size(), 1, false), nullptr);
+}
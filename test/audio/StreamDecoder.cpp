@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "audio/StreamDecoder.hpp"
+
+using namespace audio;
+
+/// @brief 8 bit mono source of (position % 251) bytes
+class PatternStream : public PCMStream {
+    size_t totalSamples;
+    size_t position = 0;
+    bool closed = false;
+public:
+    PatternStream(size_t totalSamples) : totalSamples(totalSamples) {
+    }
+
+    size_t read(char* buffer, size_t bufferSize) override {
+        size_t count = std::min(bufferSize, totalSamples - position);
+        for (size_t i = 0; i < count; i++) {
+            buffer[i] = static_cast<char>((position + i) % 251);
+        }
+        position += count;
+        return count;
+    }
+
+    void close() override {
+        closed = true;
+    }
+
+    bool isOpen() const override {
+        return !closed;
+    }
+
+    size_t getTotalSamples() const override {
+        return totalSamples;
+    }
+
+    duration_t getTotalDuration() const override {
+        return totalSamples / 44100.0;
+    }
+
+    uint getChannels() const override {
+        return 1;
+    }
+
+    uint getSampleRate() const override {
+        return 44100;
+    }
+
+    uint getBitsPerSample() const override {
+        return 8;
+    }
+
+    bool isSeekable() const override {
+        return true;
+    }
+
+    void seek(size_t position) override {
+        this->position = std::min(position, totalSamples);
+    }
+};
+
+/// @brief Read decoded data until count bytes are received or stream ends
+static std::vector<char> read_decoded(
+    BufferedPCMStream& stream, size_t count
+) {
+    std::vector<char> data(count);
+    size_t size = 0;
+    while (size < count) {
+        if (stream.available() == 0 && stream.isEnded()) {
+            break;
+        }
+        size += stream.read(data.data() + size, count - size);
+        std::this_thread::yield();
+    }
+    data.resize(size);
+    return data;
+}
+
+TEST(StreamDecoder, DecodeAhead) {
+    const size_t total = 1'000'000;
+    StreamDecoder decoder;
+    auto stream = std::make_shared<BufferedPCMStream>(
+        std::make_shared<PatternStream>(total), 65536
+    );
+    decoder.add(stream);
+
+    auto data = read_decoded(*stream, total + 1);
+    ASSERT_EQ(data.size(), total);
+    for (size_t i = 0; i < total; i++) {
+        ASSERT_EQ(data[i], static_cast<char>(i % 251));
+    }
+}
+
+TEST(StreamDecoder, LoopAndSeek) {
+    const size_t total = 3000;
+    StreamDecoder decoder;
+    auto stream = std::make_shared<BufferedPCMStream>(
+        std::make_shared<PatternStream>(total), 4096
+    );
+    decoder.add(stream);
+    // loop is enabled after the decoder may have reached the end
+    while (!stream->isEnded()) {
+        std::this_thread::yield();
+    }
+    stream->setLoop(true);
+
+    auto data = read_decoded(*stream, total * 3);
+    ASSERT_EQ(data.size(), total * 3);
+    for (size_t i = 0; i < data.size(); i++) {
+        ASSERT_EQ(data[i], static_cast<char>(i % total % 251));
+    }
+
+    stream->seek(2000);
+    decoder.notify();
+    data = read_decoded(*stream, 100);
+    ASSERT_EQ(data.size(), 100);
+    for (size_t i = 0; i < data.size(); i++) {
+        ASSERT_EQ(data[i], static_cast<char>((2000 + i) % 251));
+    }
+}
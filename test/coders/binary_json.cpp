@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <iostream>
+
 #include "util/Buffer.hpp"
 #include "coders/binary_json.hpp"
 
@@ -36,3 +39,137 @@ TEST(BJSON, EncodeDecode) {
         }
     }
 }
+
+static dv::value create_inventory_data(int slots) {
+    auto map = dv::object();
+    map["id"] = 42;
+    auto& slotsarr = map.list("slots");
+    for (int i = 0; i < slots; i++) {
+        auto& slotmap = slotsarr.object();
+        slotmap["id"] = i * 3;
+        slotmap["count"] = i % 64;
+        if (i % 5 == 0) {
+            auto& fields = slotmap.object("fields");
+            fields["name"] = "item" + std::to_string(i);
+            fields["durability"] = i * 0.5;
+        }
+    }
+    return map;
+}
+
+TEST(BJSON, NestedDocuments) {
+    auto object = create_inventory_data(20);
+    object["nested"] = dv::object();
+    object["nested"]["inner"] = dv::object();
+    object["nested"]["inner"]["flag"] = true;
+
+    auto bytes = json::to_binary(object, false);
+    auto decoded = json::from_binary(bytes.data(), bytes.size());
+    EXPECT_EQ(decoded["id"].asInteger(), 42);
+    EXPECT_EQ(decoded["slots"].size(), 20);
+    EXPECT_EQ(decoded["slots"][10]["fields"]["name"].asString(), "item10");
+    EXPECT_TRUE(decoded["nested"]["inner"]["flag"].asBoolean());
+    EXPECT_EQ(json::to_binary(decoded, false).size(), bytes.size());
+}
+
+TEST(BJSON, PullReader) {
+    auto object = create_inventory_data(20);
+    object["nested"] = dv::object();
+    auto& list = object["nested"].list("list");
+    list.add(1);
+    list.add(2.5);
+    list.add("three");
+    auto& pos = object.list("pos");
+    pos.add(1.5);
+    pos.add(-2);
+    pos.add(300000);
+    auto bytes = json::to_binary(object, false);
+
+    json::BinaryReader reader(bytes.data(), bytes.size());
+    std::string_view key;
+    size_t slots = 0;
+    float posValues[3] {};
+    reader.beginObject();
+    while (reader.nextKey(key)) {
+        if (key == "id") {
+            EXPECT_EQ(reader.readInteger(), 42);
+        } else if (key == "slots") {
+            reader.beginList();
+            while (reader.nextElement()) {
+                reader.skip();
+                slots++;
+            }
+        } else if (key == "pos") {
+            EXPECT_EQ(reader.readNumbers(posValues, 3), 3);
+        } else {
+            reader.skip();
+        }
+    }
+    EXPECT_EQ(slots, 20);
+    EXPECT_FLOAT_EQ(posValues[0], 1.5f);
+    EXPECT_FLOAT_EQ(posValues[1], -2.0f);
+    EXPECT_FLOAT_EQ(posValues[2], 300000.0f);
+}
+
+TEST(BJSON, DISABLED_Benchmark) {
+    const int iterations = 2000;
+    auto object = create_inventory_data(50);
+    for (int i = 0; i < 4; i++) {
+        auto parent = create_inventory_data(200);
+        parent["child"] = object;
+        object = parent;
+    }
+
+    std::vector<ubyte> bytes;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        bytes = json::to_binary(object, false);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << "to_binary: " << std::chrono::duration_cast<
+        std::chrono::microseconds>(end - start).count() / iterations
+              << " us/op, " << bytes.size() << " bytes" << std::endl;
+
+    start = std::chrono::high_resolution_clock::now();
+    integer_t checksum1 = 0;
+    for (int i = 0; i < iterations; i++) {
+        auto value = json::from_binary(bytes.data(), bytes.size());
+        for (const auto& slot : value["slots"]) {
+            checksum1 += slot["id"].asInteger();
+        }
+    }
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "from_binary: " << std::chrono::duration_cast<
+        std::chrono::microseconds>(end - start).count() / iterations
+              << " us/op" << std::endl;
+
+    start = std::chrono::high_resolution_clock::now();
+    integer_t checksum2 = 0;
+    for (int i = 0; i < iterations; i++) {
+        json::BinaryReader reader(bytes.data(), bytes.size());
+        std::string_view key;
+        reader.beginObject();
+        while (reader.nextKey(key)) {
+            if (key != "slots") {
+                reader.skip();
+                continue;
+            }
+            reader.beginList();
+            while (reader.nextElement()) {
+                reader.beginObject();
+                while (reader.nextKey(key)) {
+                    if (key == "id") {
+                        checksum2 += reader.readInteger();
+                    } else {
+                        reader.skip();
+                    }
+                }
+            }
+        }
+    }
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "BinaryReader: " << std::chrono::duration_cast<
+        std::chrono::microseconds>(end - start).count() / iterations
+              << " us/op" << std::endl;
+    EXPECT_EQ(checksum1, checksum2);
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+
+#include "typedefs.hpp"
+#include "coders/compression.hpp"
+#include "coders/zstd.hpp"
+
+using namespace compression;
+
+static std::vector<ubyte> generate_data(size_t size, int dencity) {
+    std::vector<ubyte> data(size);
+    ubyte next = rand();
+    for (size_t i = 0; i < size; i++) {
+        data[i] = next;
+        if (rand() % dencity == 0) {
+            next = rand();
+        }
+    }
+    return data;
+}
+
+static void test_compress_decompress(const Settings& settings) {
+    auto source = generate_data(200'000, 20);
+    size_t length;
+    auto compressed = compress(source.data(), source.size(), length, settings);
+    EXPECT_LT(length, source.size());
+
+    auto decompressed =
+        decompress(compressed.get(), length, source.size(), settings);
+    EXPECT_EQ(std::memcmp(decompressed.get(), source.data(), source.size()), 0);
+}
+
+TEST(compression, LZ4) {
+    test_compress_decompress(Settings(Method::LZ4));
+}
+
+TEST(compression, ZSTD) {
+    test_compress_decompress(Settings(Method::ZSTD));
+    test_compress_decompress(Settings(Method::ZSTD, 19));
+}
+
+TEST(compression, ZSTDDictionary) {
+    std::vector<ubyte> samples;
+    std::vector<size_t> sizes;
+    for (int i = 0; i < 1000; i++) {
+        std::string sample = "{\"id\":" + std::to_string(i) +
+                             ",\"name\":\"base:item\",\"count\":" +
+                             std::to_string(i % 64) + "}";
+        samples.insert(samples.end(), sample.begin(), sample.end());
+        sizes.push_back(sample.size());
+    }
+    Settings settings(Method::ZSTD);
+    settings.dictionary = std::make_shared<zstd::Dictionary>(
+        zstd::train_dictionary(samples, sizes, 4096), zstd::DEFAULT_LEVEL
+    );
+
+    std::string payload = "{\"id\":5000,\"name\":\"base:item\",\"count\":12}";
+    const auto* src = reinterpret_cast<const ubyte*>(payload.data());
+    size_t length;
+    auto compressed = compress(src, payload.size(), length, settings);
+
+    auto decompressed =
+        decompress(compressed.get(), length, payload.size(), settings);
+    EXPECT_EQ(std::memcmp(decompressed.get(), src, payload.size()), 0);
+
+    EXPECT_THROW(
+        decompress(compressed.get(), length, payload.size(), Method::ZSTD),
+        std::runtime_error
+    );
+}
+
+TEST(compression, ParseSettings) {
+    auto settings = parse_settings("zstd:9");
+    EXPECT_EQ(settings.method, Method::ZSTD);
+    EXPECT_EQ(settings.level, 9);
+    EXPECT_EQ(to_string(settings), "zstd:9");
+
+    EXPECT_EQ(parse_settings("extrle16").method, Method::EXTRLE16);
+    EXPECT_THROW(parse_settings("unknown"), std::runtime_error);
+}
@@ -27,3 +27,68 @@ TEST(dv, dv) {
         }
     }
 }
+
+TEST(dv, ObjectStorage) {
+    auto object = dv::object();
+    auto& first = object["key0"];
+    first = 0;
+    for (int i = 1; i < 100; i++) {
+        object["key" + std::to_string(i)] = i;
+    }
+    // references stay valid after insertions
+    first = -1;
+    EXPECT_EQ(object["key0"].asInteger(), -1);
+    EXPECT_EQ(object.size(), 100);
+
+    for (int i = 0; i < 100; i += 2) {
+        object.erase("key" + std::to_string(i));
+    }
+    EXPECT_EQ(object.size(), 50);
+    EXPECT_FALSE(object.has("key10"));
+    EXPECT_TRUE(object.has("key11"));
+
+    // entries are iterated in insertion order
+    int expected = 1;
+    for (const auto& [key, value] : object.asObject()) {
+        EXPECT_EQ(key, "key" + std::to_string(expected));
+        EXPECT_EQ(value.asInteger(), expected);
+        expected += 2;
+    }
+    EXPECT_EQ(expected, 101);
+
+    dv::objects::Object copy = object.asObject();
+    EXPECT_EQ(copy.size(), 50);
+    EXPECT_EQ(copy["key99"].asInteger(), 99);
+}
+
+TEST(dv, ObjectChurn) {
+    auto object = dv::object();
+    auto& fixed = object["fixed"];
+    for (int i = 0; i < 64; i++) {
+        object["key" + std::to_string(i)] = i;
+    }
+    const auto& obj = object.asObject();
+    size_t slots = obj.slotsCount();
+    for (int i = 64; i < 100'000; i++) {
+        object.erase("key" + std::to_string(i - 64));
+        object["key" + std::to_string(i)] = i;
+    }
+    // erased entries slots are reused by new entries
+    EXPECT_EQ(obj.size(), 65);
+    EXPECT_EQ(obj.slotsCount(), slots);
+    EXPECT_FALSE(object.has("key0"));
+    for (int i = 100'000 - 64; i < 100'000; i++) {
+        EXPECT_EQ(object["key" + std::to_string(i)].asInteger(), i);
+    }
+    fixed = -1;
+    EXPECT_EQ(object["fixed"].asInteger(), -1);
+
+    size_t count = 0;
+    for (const auto& [key, value] : obj) {
+        if (key != "fixed") {
+            EXPECT_EQ(key, "key" + std::to_string(value.asInteger()));
+        }
+        count++;
+    }
+    EXPECT_EQ(count, obj.size());
+}
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include "coders/json.hpp"
+#include "debug/Metrics.hpp"
+
+using namespace debug;
+
+TEST(Metrics, Registry) {
+    MetricsRegistry registry;
+    registry.counter("test_total", "Test counter").add(3);
+    registry.counter("test_total", "").add();
+    registry.gauge("test_gauge", "").set(-1.5);
+    EXPECT_THROW(registry.gauge("test_total", ""), std::runtime_error);
+    EXPECT_THROW(registry.counter("0invalid", ""), std::runtime_error);
+
+    MetricSample sample;
+    EXPECT_TRUE(registry.collect("test_total", sample));
+    EXPECT_EQ(sample.value, 4.0);
+    EXPECT_TRUE(registry.collect("test_gauge", sample));
+    EXPECT_EQ(sample.value, -1.5);
+    EXPECT_FALSE(registry.collect("missing", sample));
+}
+
+TEST(Metrics, Callback) {
+    MetricsRegistry registry;
+    double value = 1.0;
+    {
+        auto handler = registry.addCallback("test_callback", "", [&value]() {
+            return value;
+        });
+        value = 2.0;
+        auto samples = registry.collect();
+        ASSERT_EQ(samples.size(), 1);
+        EXPECT_EQ(samples[0].value, 2.0);
+
+        // replaced callback is not removed by previous handler
+        auto replacement = registry.addCallback("test_callback", "", []() {
+            return 5.0;
+        });
+        handler = ObserverHandler();
+        EXPECT_TRUE(registry.has("test_callback"));
+    }
+    EXPECT_FALSE(registry.has("test_callback"));
+}
+
+TEST(Metrics, HistogramPrometheus) {
+    MetricsRegistry registry;
+    auto& histogram = registry.histogram("test_seconds", "Test\nhelp", {0.1, 1});
+    histogram.observe(0.05);
+    histogram.observe(0.1);
+    histogram.observe(0.5);
+    histogram.observe(2);
+    EXPECT_EQ(histogram.getCount(), 4);
+
+    auto text = metrics::to_prometheus(registry.collect());
+    EXPECT_EQ(
+        text,
+        "# HELP test_seconds Test\\nhelp\n"
+        "# TYPE test_seconds histogram\n"
+        "test_seconds_bucket{le=\"0.1\"} 2\n"
+        "test_seconds_bucket{le=\"1\"} 3\n"
+        "test_seconds_bucket{le=\"+Inf\"} 4\n"
+        "test_seconds_sum 2.65\n"
+        "test_seconds_count 4\n"
+    );
+    EXPECT_THROW(Histogram({1, 0.5}), std::runtime_error);
+}
+
+TEST(Metrics, JsonLine) {
+    MetricsRegistry registry;
+    registry.counter("a_total", "").add(2);
+    registry.histogram("b_seconds", "", {1}).observe(0.5);
+
+    auto line = metrics::to_json_line(registry.collect(), 100.0);
+    EXPECT_EQ(line.find('\n'), std::string::npos);
+    auto root = json::parse(line);
+    EXPECT_EQ(root["timestamp"].asNumber(), 100.0);
+    EXPECT_EQ(root["metrics"]["a_total"].asNumber(), 2.0);
+    EXPECT_EQ(root["metrics"]["b_seconds"]["count"].asInteger(), 1);
+    EXPECT_EQ(root["metrics"]["b_seconds"]["buckets"][1][0].asString(), "+Inf");
+}
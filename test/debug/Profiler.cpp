@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "coders/json.hpp"
+#include "debug/Profiler.hpp"
+
+using namespace debug;
+
+static void profiled_function() {
+    PROFILE_ZONE("profiled_function");
+}
+
+TEST(Profiler, InactiveByDefault) {
+    profiled_function();
+    EXPECT_FALSE(Profiler::isActive());
+    EXPECT_TRUE(Profiler::stop().threads.empty());
+}
+
+TEST(Profiler, Capture) {
+    Profiler::start();
+    Profiler::setThreadName("test \"main\"");
+    {
+        PROFILE_ZONE("outer");
+        profiled_function();
+    }
+    std::thread thread([]() {
+        Profiler::setThreadName("worker");
+        profiled_function();
+    });
+    thread.join();
+    auto capture = Profiler::stop();
+    profiled_function();
+
+    ASSERT_EQ(capture.threads.size(), 2);
+    size_t events = 0;
+    for (const auto& trace : capture.threads) {
+        events += trace.events.size();
+        for (const auto& event : trace.events) {
+            EXPECT_GE(event.start, capture.start);
+            EXPECT_GE(event.duration, 0);
+        }
+    }
+    EXPECT_EQ(events, 3);
+
+    auto root = json::parse(Profiler::toChromeTrace(capture));
+    const auto& traceEvents = root["traceEvents"];
+    // 2 thread names and 3 zones
+    EXPECT_EQ(traceEvents.size(), 5);
+    EXPECT_EQ(traceEvents[0]["args"]["name"].asString(), "test \"main\"");
+}
+
+TEST(Profiler, RingBufferOverflow) {
+    Profiler::start();
+    size_t count = Profiler::THREAD_BUFFER_CAPACITY + 10;
+    for (size_t i = 0; i < count; i++) {
+        profiled_function();
+    }
+    auto capture = Profiler::stop();
+    ASSERT_EQ(capture.threads.size(), 1);
+    const auto& trace = capture.threads[0];
+    EXPECT_EQ(trace.events.size(), Profiler::THREAD_BUFFER_CAPACITY);
+    EXPECT_EQ(trace.dropped, 10);
+    for (size_t i = 1; i < trace.events.size(); i++) {
+        EXPECT_LE(trace.events[i - 1].start, trace.events[i].start);
+    }
+}
@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+
+#include "coders/syntax_parser.hpp"
+#include "devtools/SyntaxProcessor.hpp"
+#include "graphics/core/Font.hpp"
+
+using namespace devtools;
+
+static std::unique_ptr<Syntax> create_lua_syntax() {
+    auto syntax = std::make_unique<Syntax>();
+    syntax->language = "Lua";
+    syntax->extensions = {"lua"};
+    syntax->lineComment = L"--";
+    syntax->multilineCommentStart = L"[==[";
+    syntax->multilineCommentEnd = L"]==]";
+    syntax->multilineStringStart = L"[[";
+    syntax->multilineStringEnd = L"]]";
+    syntax->keywords = {
+        L"do", L"else", L"end", L"function", L"if", L"local", L"return",
+        L"then"};
+    return syntax;
+}
+
+static const std::wstring SAMPLE_SOURCE =
+    L"local function f(a, b) -- comment\n"
+    L"    local s = \"string \\\"quoted\\\"\" .. 'other'\n"
+    L"    [==[ multiline\n"
+    L"    comment ]==] return [[multiline\n"
+    L"string]], 42, 0.5\n"
+    L"end\n";
+
+/// @brief Compare incremental styles with full highlighting
+static void expect_same_styles(
+    const SyntaxProcessor& processor,
+    const SyntaxHighlighter& highlighter,
+    const std::wstring& text
+) {
+    auto expected = processor.highlight("lua", text);
+    if (expected == nullptr) {
+        // full tokenizer rejected the source (e.g. illegal escape)
+        return;
+    }
+    const auto& map = highlighter.getStyles()->map;
+    ASSERT_EQ(map.size(), text.length() + 1);
+    for (size_t i = 0; i < text.length(); i++) {
+        ASSERT_EQ(
+            map[i], expected->map[std::min(expected->map.size() - 1, i)]
+        ) << "at " << i << " in:\n" << std::string(text.begin(), text.end());
+    }
+}
+
+TEST(SyntaxHighlighter, InitialText) {
+    SyntaxProcessor processor;
+    processor.addSyntax(create_lua_syntax());
+    auto highlighter = processor.createHighlighter("lua");
+    ASSERT_NE(highlighter, nullptr);
+    EXPECT_EQ(processor.createHighlighter("txt"), nullptr);
+
+    EXPECT_TRUE(highlighter->update(SAMPLE_SOURCE));
+    EXPECT_EQ(highlighter->getTokenizedLines(), 7);
+    expect_same_styles(processor, *highlighter, SAMPLE_SOURCE);
+    EXPECT_FALSE(highlighter->update(SAMPLE_SOURCE));
+}
+
+TEST(SyntaxHighlighter, StateConvergence) {
+    SyntaxProcessor processor;
+    processor.addSyntax(create_lua_syntax());
+    auto highlighter = processor.createHighlighter("lua");
+
+    std::wstring text;
+    for (int i = 0; i < 100; i++) {
+        text += L"local x = " + std::to_wstring(i) + L" -- value\n";
+    }
+    highlighter->update(text);
+
+    // single line edit
+    text.insert(text.find(L"50"), L"1");
+    highlighter->update(text);
+    EXPECT_EQ(highlighter->getTokenizedLines(), 1);
+    expect_same_styles(processor, *highlighter, text);
+
+    // opened comment changes all next lines
+    text.insert(text.find(L"local x = 10 "), L"[==[");
+    highlighter->update(text);
+    EXPECT_EQ(highlighter->getTokenizedLines(), 91);
+    expect_same_styles(processor, *highlighter, text);
+
+    // closed comment converges after the closing line
+    text.insert(text.find(L"local x = 20 "), L"]==]");
+    highlighter->update(text);
+    EXPECT_EQ(highlighter->getTokenizedLines(), 81);
+    expect_same_styles(processor, *highlighter, text);
+}
+
+TEST(SyntaxHighlighter, RandomEdits) {
+    SyntaxProcessor processor;
+    processor.addSyntax(create_lua_syntax());
+    auto highlighter = processor.createHighlighter("lua");
+
+    const std::wstring pieces[] {
+        L"\n", L" ", L"\"", L"'", L"[[", L"]]", L"[==[", L"]==]", L"--",
+        L"local", L"end", L"x", L"12", L"(", L")", L"=", L"\\n",
+    };
+    std::mt19937 random(42);
+    std::wstring text = SAMPLE_SOURCE;
+    highlighter->update(text);
+    for (int i = 0; i < 2000; i++) {
+        size_t pos = random() % (text.length() + 1);
+        if (random() % 3 == 0 && pos < text.length()) {
+            text.erase(pos, 1 + random() % std::min<size_t>(8, text.length() - pos));
+        } else {
+            text.insert(pos, pieces[random() % std::size(pieces)]);
+        }
+        highlighter->update(text);
+        expect_same_styles(processor, *highlighter, text);
+        if (HasFatalFailure()) {
+            return;
+        }
+    }
+}
+
+TEST(SyntaxHighlighter, DISABLED_Benchmark) {
+    // ~30K lines
+    const size_t length = 800'000;
+    const int keystrokes = 200;
+    SyntaxProcessor processor;
+    processor.addSyntax(create_lua_syntax());
+    auto highlighter = processor.createHighlighter("lua");
+
+    std::wstring text;
+    while (text.length() < length) {
+        text += SAMPLE_SOURCE;
+    }
+    highlighter->update(text);
+
+    size_t pos = text.length() / 2;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < keystrokes; i++) {
+        text.insert(pos++, 1, L'x');
+        auto styles = processor.highlight("lua", text);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << "full: " << std::chrono::duration_cast<
+        std::chrono::microseconds>(end - start).count() / keystrokes
+              << " us/keystroke" << std::endl;
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < keystrokes; i++) {
+        text.insert(pos++, 1, L'x');
+        highlighter->update(text);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "incremental: " << std::chrono::duration_cast<
+        std::chrono::microseconds>(end - start).count() / keystrokes
+              << " us/keystroke" << std::endl;
+}
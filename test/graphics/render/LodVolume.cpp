@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "graphics/render/LodVolume.hpp"
+#include "voxels/VoxelsVolume.hpp"
+
+static const std::vector<ubyte> TYPES {
+    LodVolume::TYPE_NONE, LodVolume::TYPE_OPAQUE, LodVolume::TYPE_TRANSLUCENT};
+
+static constexpr int PADDING = 2;
+
+/// @brief Create chunk at 0, 0 with padding filled with the supplier blocks
+template <typename Supplier>
+static std::unique_ptr<VoxelsVolume> create_volume(const Supplier& supplier) {
+    auto volume = std::make_unique<VoxelsVolume>(
+        -PADDING,
+        0,
+        -PADDING,
+        CHUNK_W + PADDING * 2,
+        CHUNK_H,
+        CHUNK_D + PADDING * 2
+    );
+    for (int y = 0; y < volume->getH(); y++) {
+        for (int z = 0; z < volume->getD(); z++) {
+            for (int x = 0; x < volume->getW(); x++) {
+                volume->getVoxels()[vox_index(
+                    x, y, z, volume->getW(), volume->getD()
+                )].id = supplier(x - PADDING, y, z - PADDING);
+            }
+        }
+    }
+    return volume;
+}
+
+TEST(LodVolume, FlatTerrain) {
+    auto volume = create_volume([](int, int y, int) {
+        return y < 64 ? 1 : 0;
+    });
+    for (int lod : {1, 2, 4}) {
+        LodVolume lodVolume(lod);
+        lodVolume.build(*volume, 0, 0, TYPES);
+        int side = CHUNK_W / lod;
+        EXPECT_EQ(lodVolume.countFaces(LodVolume::TYPE_OPAQUE), side * side);
+        const auto& cell = lodVolume.get(0, 64 / lod - 1, 0);
+        EXPECT_EQ(cell.id, 1);
+        EXPECT_EQ(cell.openFaces, 1 << 2);
+    }
+}
+
+TEST(LodVolume, ChunkBorder) {
+    // no blocks behind +X border
+    auto volume = create_volume([](int x, int y, int) {
+        return y < 64 && x < CHUNK_W ? 1 : 0;
+    });
+    LodVolume lodVolume(2);
+    lodVolume.build(*volume, 0, 0, TYPES);
+    EXPECT_EQ(lodVolume.countFaces(LodVolume::TYPE_OPAQUE), 64 + 32 * 8);
+
+    // not loaded neighbours
+    VoxelsVolume chunkOnly(0, 0, 0, CHUNK_W, CHUNK_H, CHUNK_D);
+    for (int i = 0; i < CHUNK_VOL; i++) {
+        chunkOnly.getVoxels()[i].id = i < 64 * CHUNK_W * CHUNK_D;
+    }
+    lodVolume.build(chunkOnly, 0, 0, TYPES);
+    EXPECT_EQ(lodVolume.countFaces(LodVolume::TYPE_OPAQUE), 64);
+}
+
+TEST(LodVolume, Translucent) {
+    auto volume = create_volume([](int, int y, int) {
+        return y < 64 ? 1 : (y < 70 ? 2 : 0);
+    });
+    LodVolume lodVolume(2);
+    lodVolume.build(*volume, 0, 0, TYPES);
+    // opaque surface is seen through translucent blocks
+    EXPECT_EQ(lodVolume.countFaces(LodVolume::TYPE_OPAQUE), 64);
+    EXPECT_EQ(lodVolume.countFaces(LodVolume::TYPE_TRANSLUCENT), 64);
+}
+
+TEST(LodVolume, FacesReduction) {
+    auto volume = create_volume([](int x, int y, int z) {
+        int height = 64 + (x * 7 + z * 13) % 11 + (x * z) % 5;
+        return y < height ? 1 : 0;
+    });
+    size_t prevCount = 0;
+    for (int lod : {1, 2, 4}) {
+        LodVolume lodVolume(lod);
+        lodVolume.build(*volume, 0, 0, TYPES);
+        size_t count = lodVolume.countFaces(LodVolume::TYPE_OPAQUE);
+        if (prevCount) {
+            EXPECT_LT(count * 2, prevCount);
+        }
+        prevCount = count;
+    }
+}
@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+
+#include "graphics/render/ParticlesSimulation.hpp"
+#include "lighting/Lightmap.hpp"
+#include "test_content.hpp"
+#include "voxels/Chunks.hpp"
+
+static constexpr int FLOOR_HEIGHT = 10;
+
+class ParticlesSimulationTest : public ::testing::Test {
+protected:
+    std::unique_ptr<Content> content;
+    std::unique_ptr<Chunks> chunks;
+
+    void SetUp() override {
+        content = test_content::create();
+        chunks = std::make_unique<Chunks>(
+            5, 5, 0, 0, nullptr, *content->getIndices()
+        );
+        chunks->setCenter(0, 0);
+        for (int cz = -2; cz <= 2; cz++) {
+            for (int cx = -2; cx <= 2; cx++) {
+                auto chunk = std::make_shared<Chunk>(cx, cz);
+                test_content::fill_chunk(*chunk, FLOOR_HEIGHT);
+                for (uint i = 0; i < CHUNK_VOL; i++) {
+                    chunk->lightmap.map[i] = Lightmap::combine(6, 0, 3, 15);
+                }
+                ASSERT_TRUE(chunks->putChunk(chunk));
+            }
+        }
+    }
+
+    /// @brief Preset with deterministic particles movement
+    static ParticlesPreset create_preset() {
+        ParticlesPreset preset {};
+        preset.collision = false;
+        preset.lighting = false;
+        preset.spawnInterval = 0.01f;
+        preset.lifetime = 1.0f;
+        preset.lifetimeSpread = 0.0f;
+        preset.velocity = {0.0f, 1.0f, 0.0f};
+        preset.acceleration = {};
+        preset.explosion = {};
+        return preset;
+    }
+
+    static u64id_t add_emitter(
+        ParticlesSimulation& simulation,
+        const glm::vec3& position,
+        ParticlesPreset preset,
+        int count
+    ) {
+        return simulation.add(std::make_unique<Emitter>(
+            nullptr,
+            position,
+            std::move(preset),
+            nullptr,
+            UVRegion(),
+            count
+        ));
+    }
+};
+
+TEST_F(ParticlesSimulationTest, Lifecycle) {
+    const glm::vec3 origin {0.5f, 50.0f, 0.5f};
+    ParticlesSimulation simulation(*chunks);
+    auto id = add_emitter(simulation, origin, create_preset(), 100);
+    ASSERT_NE(simulation.getEmitter(id), nullptr);
+
+    const float delta = 0.05f;
+    size_t maxCount = 0;
+    for (int frame = 0; frame < 60; frame++) {
+        simulation.update(delta, origin, false);
+        auto emitter = simulation.getEmitter(id);
+        if (emitter == nullptr) {
+            break;
+        }
+        const auto& particles = emitter->particles;
+        maxCount = std::max(maxCount, particles.size());
+        // swap-remove must keep particle arrays consistent
+        for (size_t i = 0; i < particles.size(); i++) {
+            float age = 1.0f - particles.lifetime[i];
+            EXPECT_NEAR(particles.posY[i] - origin.y, age, 1e-4f);
+            EXPECT_FLOAT_EQ(particles.posX[i], origin.x);
+            EXPECT_FLOAT_EQ(particles.velY[i], 1.0f);
+        }
+    }
+    EXPECT_GT(maxCount, 0);
+    EXPECT_EQ(simulation.getEmitter(id), nullptr);
+    EXPECT_EQ(simulation.countParticles(), 0);
+}
+
+TEST_F(ParticlesSimulationTest, Collision) {
+    const glm::vec3 origin {0.5f, 20.0f, 0.5f};
+    auto preset = create_preset();
+    preset.collision = true;
+    preset.lifetime = 10.0f;
+    preset.velocity = {0.0f, -8.0f, 0.0f};
+    preset.acceleration = {0.0f, -16.0f, 0.0f};
+    preset.explosion = glm::vec3(2.0f);
+
+    ParticlesSimulation simulation(*chunks);
+    auto id = add_emitter(simulation, origin, preset, 50);
+    for (int frame = 0; frame < 120; frame++) {
+        simulation.update(1.0f / 60.0f, origin, false);
+    }
+    auto emitter = simulation.getEmitter(id);
+    ASSERT_NE(emitter, nullptr);
+    const auto& particles = emitter->particles;
+    EXPECT_EQ(particles.size(), 50);
+    for (size_t i = 0; i < particles.size(); i++) {
+        EXPECT_GE(particles.posY[i], FLOOR_HEIGHT);
+    }
+}
+
+TEST_F(ParticlesSimulationTest, FramesAndLight) {
+    const glm::vec3 origin {0.5f, 50.0f, 0.5f};
+    auto preset = create_preset();
+    preset.lighting = true;
+    preset.frames = {"a", "b", "c", "d"};
+
+    std::vector<UVRegion> frames;
+    for (int i = 0; i < 4; i++) {
+        frames.emplace_back(i * 0.25f, 0.0f, (i + 1) * 0.25f, 1.0f);
+    }
+    ParticlesSimulation simulation(*chunks);
+    auto emitterPtr = std::make_unique<Emitter>(
+        nullptr, origin, preset, nullptr, UVRegion(), 1
+    );
+    emitterPtr->setFrames(frames);
+    auto id = simulation.add(std::move(emitterPtr));
+
+    // frame boundaries are not hit exactly
+    const float delta = 0.07f;
+    for (int frame = 0; frame < 13; frame++) {
+        simulation.update(delta, origin, false);
+        const auto& particles = simulation.getEmitter(id)->particles;
+        ASSERT_EQ(particles.size(), 1);
+
+        float time = preset.lifetime - particles.lifetime[0];
+        int expected = glm::min(3, static_cast<int>(time / 0.25f));
+        EXPECT_FLOAT_EQ(particles.region[0].u1, frames[expected].u1);
+
+        // channels are scaled by the same random factor
+        const auto& light = particles.light[0];
+        EXPECT_GT(light.a, 0.8f);
+        EXPECT_LE(light.a, 1.0f);
+        EXPECT_NEAR(light.r / light.a, 6 / 15.0f, 1e-5f);
+        EXPECT_FLOAT_EQ(light.g, 0.0f);
+        EXPECT_NEAR(light.b / light.a, 3 / 15.0f, 1e-5f);
+    }
+}
+
+TEST_F(ParticlesSimulationTest, DISABLED_Benchmark) {
+    const int emittersCount = 200;
+    const int particlesPerEmitter = 1000;
+    const glm::vec3 camera {0.0f, 40.0f, 0.0f};
+
+    auto preset = create_preset();
+    preset.collision = true;
+    preset.lighting = true;
+    preset.lifetime = 1000.0f;
+    preset.spawnInterval = 1e-5f;
+    preset.velocity = {0.5f, -4.0f, 0.0f};
+    preset.acceleration = {};
+    preset.explosion = glm::vec3(1.0f);
+    preset.spawnShape = ParticleSpawnShape::BOX;
+    preset.spawnSpread = {8.0f, 4.0f, 8.0f};
+    preset.maxDistance = 1000.0f;
+
+    ParticlesSimulation simulation(*chunks);
+    for (int i = 0; i < emittersCount; i++) {
+        glm::vec3 position {
+            (i % 14) * 4.0f - 28.0f, 60.0f, (i / 14) * 4.0f - 28.0f
+        };
+        add_emitter(simulation, position, preset, particlesPerEmitter);
+    }
+    // spawn all particles
+    simulation.update(0.1f, camera, false);
+    size_t particles = simulation.countParticles();
+    ASSERT_EQ(particles, emittersCount * particlesPerEmitter);
+
+    const int frames = 30;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < frames; i++) {
+        simulation.update(1.0f / 60.0f, camera, false);
+    }
+    auto finish = std::chrono::high_resolution_clock::now();
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(
+        finish - start
+    ).count();
+    std::cout << particles << " particles: " << us / frames << " us/frame, "
+              << particles * frames * 1'000'000 / us << " particles/s"
+              << std::endl;
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+
+#include "graphics/render/VisibilityGraph.hpp"
+#include "voxels/voxel.hpp"
+
+static const std::vector<ubyte> OPAQUE {0, 1};
+
+static std::vector<voxel> create_chunk(blockid_t id) {
+    std::vector<voxel> voxels(CHUNK_VOL);
+    for (auto& vox : voxels) {
+        vox.id = id;
+    }
+    return voxels;
+}
+
+TEST(VisibilityGraph, Build) {
+    ChunkVisibility visibility;
+
+    auto voxels = create_chunk(0);
+    visibility.build(voxels.data(), OPAQUE);
+    for (int a = 0; a < 6; a++) {
+        for (int b = 0; b < 6; b++) {
+            EXPECT_TRUE(visibility.isConnected(0, a, b));
+        }
+    }
+
+    voxels = create_chunk(1);
+    visibility.build(voxels.data(), OPAQUE);
+    for (int a = 0; a < 6; a++) {
+        for (int b = 0; b < 6; b++) {
+            EXPECT_FALSE(visibility.isConnected(0, a, b));
+        }
+    }
+
+    // vertical tunnel connects only top and bottom faces
+    for (int y = 0; y < CHUNK_H; y++) {
+        voxels[vox_index(8, y, 8)].id = 0;
+    }
+    visibility.build(voxels.data(), OPAQUE);
+    for (int section = 0; section < ChunkVisibility::SECTIONS; section++) {
+        EXPECT_TRUE(visibility.isConnected(section, 2, 3));
+        EXPECT_TRUE(visibility.isConnected(section, 3, 2));
+        EXPECT_FALSE(visibility.isConnected(section, 0, 1));
+        EXPECT_FALSE(visibility.isConnected(section, 2, 4));
+        EXPECT_FALSE(visibility.isConnected(section, 5, 3));
+    }
+}
+
+TEST(VisibilityGraph, FindVisible) {
+    const int size = 5;
+    VisibilityGraph graph;
+    std::vector<ubyte> visible;
+    glm::vec3 cameraPos(2.5f * CHUNK_W, 100.0f, 2.5f * CHUNK_D);
+
+    std::vector<const ChunkVisibility*> chunks(size * size, nullptr);
+    graph.findVisible(chunks, size, size, {0, 0}, cameraPos, nullptr, visible);
+    ASSERT_EQ(visible.size(), size * size);
+    for (int i = 0; i < size * size; i++) {
+        EXPECT_TRUE(visible[i]);
+    }
+
+    ChunkVisibility solid;
+    solid.sections.fill(0);
+    chunks.assign(size * size, &solid);
+    graph.findVisible(chunks, size, size, {0, 0}, cameraPos, nullptr, visible);
+    for (int i = 0; i < size * size; i++) {
+        // camera chunk and its neighbours
+        int dx = std::abs(i % size - 2);
+        int dz = std::abs(i / size - 2);
+        EXPECT_EQ(visible[i], dx + dz <= 1) << i;
+    }
+
+    // camera is outside of the area
+    graph.findVisible(
+        chunks, size, size, {10, 0}, cameraPos, nullptr, visible
+    );
+    for (int i = 0; i < size * size; i++) {
+        EXPECT_TRUE(visible[i]);
+    }
+}
+
+TEST(VisibilityGraph, DISABLED_Benchmark) {
+    const int size = 65;
+    const int iterations = 100;
+
+    auto voxels = create_chunk(1);
+    for (int y = 0; y < CHUNK_H; y++) {
+        for (int x = 0; x < CHUNK_W; x++) {
+            voxels[vox_index(x, y, 8)].id = (x + y) % 3 == 0;
+        }
+    }
+    ChunkVisibility visibility;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        visibility.build(voxels.data(), OPAQUE);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << "build: " << std::chrono::duration_cast<
+        std::chrono::microseconds>(end - start).count() / iterations
+              << " us/chunk" << std::endl;
+
+    VisibilityGraph graph;
+    std::vector<ubyte> visible;
+    std::vector<const ChunkVisibility*> chunks(size * size, &visibility);
+    glm::vec3 cameraPos(size / 2 * CHUNK_W, 100.0f, size / 2 * CHUNK_D);
+    start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        graph.findVisible(
+            chunks, size, size, {0, 0}, cameraPos, nullptr, visible
+        );
+    }
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "findVisible: " << std::chrono::duration_cast<
+        std::chrono::microseconds>(end - start).count() / iterations
+              << " us" << std::endl;
+}
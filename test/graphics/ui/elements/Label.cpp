@@ -0,0 +1,40 @@
+#include "graphics/ui/elements/Label.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+using namespace gui;
+
+TEST(LabelCache, IncrementalUpdate) {
+    std::mt19937 random(1);
+    const std::wstring alphabet = L"ab \n\n";
+    std::wstring text = L"first line\nsecond\n\nlast";
+
+    LabelCache cache;
+    cache.prepare(nullptr, 100);
+    cache.update(text, true, false);
+    for (int i = 0; i < 1000; i++) {
+        size_t start = random() % (text.length() + 1);
+        size_t removed =
+            random() % (std::min<size_t>(text.length() - start, 4) + 1);
+        std::wstring inserted;
+        for (size_t j = random() % 4; j > 0; j--) {
+            inserted += alphabet[random() % alphabet.length()];
+        }
+        text.replace(start, removed, inserted);
+        cache.update(text, start, removed, inserted.length());
+
+        LabelCache expected;
+        expected.prepare(nullptr, 100);
+        expected.update(text, true, false);
+        ASSERT_EQ(cache.lines.size(), expected.lines.size());
+        for (size_t line = 0; line < cache.lines.size(); line++) {
+            ASSERT_EQ(cache.lines[line].offset, expected.lines[line].offset);
+        }
+        EXPECT_EQ(
+            cache.getLineByTextIndex(start),
+            expected.getLineByTextIndex(start)
+        );
+    }
+}
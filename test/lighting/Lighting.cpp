@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "content/Content.hpp"
+#include "content/ContentBuilder.hpp"
+#include "items/ItemDef.hpp"
+#include "lighting/Lighting.hpp"
+#include "lighting/Lightmap.hpp"
+#include "objects/rigging.hpp"
+#include "voxels/Block.hpp"
+#include "voxels/Chunk.hpp"
+#include "voxels/Chunks.hpp"
+#include "voxels/blocks_agent.hpp"
+
+static std::unique_ptr<Content> create_content() {
+    ContentBuilder builder;
+    builder.items.create("core:empty");
+
+    auto& air = builder.blocks.create("core:air");
+    air.pickingItem = "core:empty";
+    air.lightPassing = true;
+    air.skyLightPassing = true;
+
+    auto& stone = builder.blocks.create("base:stone");
+    stone.pickingItem = "core:empty";
+
+    auto& lamp = builder.blocks.create("base:lamp");
+    lamp.pickingItem = "core:empty";
+    lamp.emission[0] = 15;
+    lamp.emission[1] = 12;
+    lamp.emission[2] = 6;
+
+    auto& glass = builder.blocks.create("base:glass");
+    glass.pickingItem = "core:empty";
+    glass.lightPassing = true;
+    return builder.build();
+}
+
+struct TestWorld {
+    Chunks chunks;
+    Lighting lighting;
+
+    TestWorld(const Content& content)
+        : chunks(3, 3, 0, 0, nullptr, *content.getIndices()),
+          lighting(content, chunks) {
+        chunks.setCenter(0, 0);
+        const auto& indices = *content.getIndices();
+        for (int cz = -1; cz <= 1; cz++) {
+            for (int cx = -1; cx <= 1; cx++) {
+                auto chunk = std::make_shared<Chunk>(cx, cz);
+                for (int y = 0; y < 40; y++) {
+                    for (int z = 0; z < CHUNK_D; z++) {
+                        for (int x = 0; x < CHUNK_W; x++) {
+                            auto& vox = chunk->voxels[vox_index(x, y, z)];
+                            vox.id = (x + z + cx) % 7 == 0 && y == 39 ? 2 : 1;
+                        }
+                    }
+                }
+                chunk->updateHeights();
+                Lighting::prebuildSkyLight(*chunk, indices);
+                EXPECT_TRUE(chunks.putChunk(chunk));
+            }
+        }
+        for (int cz = -1; cz <= 1; cz++) {
+            for (int cx = -1; cx <= 1; cx++) {
+                lighting.buildSkyLight(cx, cz);
+                lighting.onChunkLoaded(cx, cz, true);
+            }
+        }
+    }
+};
+
+static std::vector<blocks_agent::voxel_edit> create_edits() {
+    std::vector<blocks_agent::voxel_edit> edits;
+    // glass roof crossing chunk borders
+    for (int z = -6; z < 6; z++) {
+        for (int x = -6; x < 6; x++) {
+            edits.push_back({{x, 50, z}, 3, {}});
+        }
+    }
+    // carved cave under the roof with lamps
+    for (int y = 30; y < 40; y++) {
+        for (int z = -4; z < 4; z++) {
+            for (int x = -4; x < 4; x++) {
+                edits.push_back({{x, y, z}, 0, {}});
+            }
+        }
+    }
+    edits.push_back({{-3, 31, -3}, 2, {}});
+    edits.push_back({{3, 31, 2}, 2, {}});
+    // shaft to the sky
+    for (int y = 40; y < 50; y++) {
+        edits.push_back({{10, y, 10}, 1, {}});
+    }
+    for (int y = 20; y < 40; y++) {
+        edits.push_back({{-10, y, 7}, 0, {}});
+    }
+    // existing lamps removed
+    for (int x = -CHUNK_W; x < CHUNK_W * 2; x += 7) {
+        edits.push_back({{x, 39, -1}, 1, {}});
+    }
+    return edits;
+}
+
+static void expect_same_lights(const Chunks& a, const Chunks& b) {
+    for (int cz = -1; cz <= 1; cz++) {
+        for (int cx = -1; cx <= 1; cx++) {
+            auto chunkA = a.getChunk(cx, cz);
+            auto chunkB = b.getChunk(cx, cz);
+            ASSERT_NE(chunkA, nullptr);
+            ASSERT_NE(chunkB, nullptr);
+            EXPECT_EQ(
+                std::memcmp(
+                    chunkA->lightmap.map,
+                    chunkB->lightmap.map,
+                    sizeof(chunkA->lightmap.map)
+                ),
+                0
+            ) << "chunk " << cx << " " << cz;
+        }
+    }
+}
+
+TEST(Lighting, BatchedEqualsPerBlock) {
+    auto content = create_content();
+    TestWorld single(*content);
+    TestWorld batched(*content);
+    expect_same_lights(single.chunks, batched.chunks);
+
+    auto edits = create_edits();
+    for (const auto& edit : edits) {
+        const auto& pos = edit.pos;
+        single.chunks.set(pos.x, pos.y, pos.z, edit.id, edit.state);
+        single.lighting.onBlockSet(pos.x, pos.y, pos.z, edit.id);
+    }
+    std::vector<glm::ivec3> changed;
+    blocks_agent::set_many(batched.chunks, edits, &changed);
+    batched.lighting.onBlocksSet(changed);
+
+    expect_same_lights(single.chunks, batched.chunks);
+}
+
+TEST(Lighting, SetManyDuplicates) {
+    auto content = create_content();
+    TestWorld world(*content);
+
+    std::vector<blocks_agent::voxel_edit> edits {
+        {{1, 45, 1}, 2, {}},
+        {{2, 45, 1}, 3, {}},
+        {{1, 45, 1}, 3, {}},
+        {{1, 45, 1}, 0, {}},
+        {{2, 45, 1}, 2, {}},
+    };
+    std::vector<glm::ivec3> changed;
+    size_t count = blocks_agent::set_many(world.chunks, edits, &changed);
+    // {1, 45, 1} ends up as air, which it already was
+    EXPECT_EQ(count, 1);
+    ASSERT_EQ(changed.size(), 1);
+    EXPECT_EQ(changed[0], glm::ivec3(2, 45, 1));
+    EXPECT_EQ(world.chunks.get(1, 45, 1)->id, 0);
+    EXPECT_EQ(world.chunks.get(2, 45, 1)->id, 2);
+}
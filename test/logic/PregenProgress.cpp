@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "io/io.hpp"
+#include "io/devices/StdfsDevice.hpp"
+#include "logic/PregenProgress.hpp"
+#include "world/files/WorldRegions.hpp"
+
+namespace fs = std::filesystem;
+
+class PregenProgressTest : public ::testing::Test {
+protected:
+    fs::path root = fs::temp_directory_path() / "ve_pregen_test";
+    io::path file = "pregentest:pregen.json";
+
+    void SetUp() override {
+        fs::create_directories(root);
+        io::set_device("pregentest", std::make_shared<io::StdfsDevice>(root));
+    }
+
+    void TearDown() override {
+        io::remove_device("pregentest");
+        fs::remove_all(root);
+    }
+};
+
+TEST_F(PregenProgressTest, AreaRegions) {
+    const int size = REGION_SIZE;
+    // swapped corners, area crosses zero
+    PregenProgress progress({size + 3, 5}, {-2, -size - 1}, file);
+    const auto& regions = progress.getRegions();
+    ASSERT_EQ(regions.size(), 3 * 3);
+    EXPECT_EQ(regions.front(), glm::ivec2(-1, -2));
+    EXPECT_EQ(regions.back(), glm::ivec2(1, 0));
+
+    size_t chunks = 0;
+    for (const auto& region : regions) {
+        glm::ivec2 min;
+        glm::ivec2 max;
+        progress.getRegionArea(region, min, max);
+        ASSERT_LT(min.x, max.x);
+        ASSERT_LT(min.y, max.y);
+        EXPECT_GE(min.x, region.x * size);
+        EXPECT_LE(max.y, (region.y + 1) * size);
+        chunks += (max.x - min.x) * (max.y - min.y);
+    }
+    EXPECT_EQ(chunks, (size + 5) * (size + 6));
+
+    glm::ivec2 min;
+    glm::ivec2 max;
+    progress.getRegionArea({-1, -2}, min, max);
+    EXPECT_EQ(min, glm::ivec2(-2, -size - 1));
+    EXPECT_EQ(max, glm::ivec2(0, -size));
+}
+
+TEST_F(PregenProgressTest, Resume) {
+    const glm::ivec2 areaMin {0, 0};
+    const glm::ivec2 areaMax {REGION_SIZE * 2, REGION_SIZE * 2};
+    std::vector<glm::ivec2> processed;
+    {
+        PregenProgress progress(areaMin, areaMax, file);
+        progress.load();
+        for (int i = 0; i < 2; i++) {
+            auto region = progress.next();
+            ASSERT_TRUE(region.has_value());
+            processed.push_back(*region);
+            progress.finish(*region);
+        }
+        // taken but interrupted before finish
+        EXPECT_TRUE(progress.next().has_value());
+    }
+    EXPECT_TRUE(io::is_regular_file(file));
+    EXPECT_FALSE(io::exists(file.string() + ".tmp"));
+
+    PregenProgress progress(areaMin, areaMax, file);
+    progress.load();
+    EXPECT_EQ(progress.getFinishedCount(), 2);
+    while (auto region = progress.next()) {
+        EXPECT_EQ(
+            std::find(processed.begin(), processed.end(), *region),
+            processed.end()
+        );
+        processed.push_back(*region);
+        progress.finish(*region);
+    }
+    EXPECT_EQ(processed.size(), 4);
+    EXPECT_EQ(progress.getFinishedCount(), 4);
+
+    // checkpoint of another area is ignored
+    PregenProgress other(areaMin, areaMax + 1, file);
+    other.load();
+    EXPECT_EQ(other.getFinishedCount(), 0);
+}
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "maths/FastNoiseLite.h"
+#include "maths/Heightmap.hpp"
+#include "util/parallel_for.hpp"
+
+/// @brief Per-pixel noise evaluation, the reference for batched rows
+static void add_noise_serial(
+    fnl_state* noise, Heightmap& map, const NoiseParams& params
+) {
+    float* heights = map.getValues();
+    uint w = map.getWidth();
+    for (uint y = 0; y < map.getHeight(); y++) {
+        for (uint x = 0; x < w; x++) {
+            uint i = y * w + x;
+            for (uint c = 0; c < params.octaves; c++) {
+                float m = params.scale * (1 << c);
+                float u = (x + params.offset.x) * m;
+                float v = (y + params.offset.y) * m;
+                if (params.shiftMapX) {
+                    u += params.shiftMapX[i];
+                }
+                if (params.shiftMapY) {
+                    v += params.shiftMapY[i];
+                }
+                heights[i] += fnlGetNoise2D(noise, u, v) /
+                              static_cast<float>(1 << c) * params.multiplier;
+            }
+        }
+    }
+}
+
+TEST(Heightmap, NoiseBitIdentical) {
+    const uint width = 256;
+    const uint height = 512;
+    fnl_state noise = fnlCreateState();
+    noise.seed = 42;
+
+    Heightmap shift(width, height);
+    for (uint i = 0; i < width * height; i++) {
+        shift.getValues()[i] = (i % 97) * 0.37f;
+    }
+    NoiseParams params {};
+    params.offset = {-123.5f, 77.25f};
+    params.scale = 0.013f;
+    params.octaves = 5;
+    params.multiplier = 0.8f;
+    params.shiftMapX = shift.getValues();
+    params.shiftMapY = shift.getValues();
+
+    Heightmap serial(width, height);
+    add_noise_serial(&noise, serial, params);
+
+    Heightmap parallel(width, height);
+    util::parallel_for(height, 16, [&](size_t y1, size_t y2) {
+        parallel.addNoise(&noise, params, y1, y2);
+    });
+    EXPECT_EQ(
+        std::memcmp(
+            serial.getValues(),
+            parallel.getValues(),
+            width * height * sizeof(float)
+        ),
+        0
+    );
+}
+
+TEST(Heightmap, ResizeZero) {
+    Heightmap map(16, 16);
+    map.resize(0, 8, InterpolationType::LINEAR);
+    EXPECT_EQ(map.getWidth(), 0);
+    EXPECT_EQ(map.getHeight(), 8);
+
+    map.resize(4, 4, InterpolationType::LINEAR);
+    EXPECT_EQ(map.getWidth(), 4);
+    EXPECT_EQ(map.getHeight(), 4);
+    EXPECT_EQ(map.get(3, 3), 0.0f);
+}
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+
+#include <glm/ext/matrix_transform.hpp>
+
+#include "objects/rigging.hpp"
+
+using namespace rigging;
+
+static const char* SKELETON_SRC = R"({
+    "root": {
+        "name": "root",
+        "model": "",
+        "nodes": [
+            {
+                "name": "body",
+                "model": "",
+                "offset": [0, 1, 0],
+                "nodes": [
+                    {"name": "head", "model": "", "offset": [0, 0.5, 0]}
+                ]
+            },
+            {"name": "tail", "model": "", "offset": [0, 0, -1]}
+        ]
+    }
+})";
+
+static glm::vec3 origin_of(const glm::mat4& matrix) {
+    return glm::vec3(matrix * glm::vec4(0, 0, 0, 1));
+}
+
+TEST(rigging, UpdatePose) {
+    auto config = SkeletonConfig::parse(SKELETON_SRC, "test.json", "test");
+    ASSERT_EQ(config->getBones().size(), 4);
+    auto skeleton = config->instance();
+
+    auto matrix = glm::translate(glm::mat4(1.0f), glm::vec3(10, 0, 0));
+    EXPECT_TRUE(config->update(skeleton, matrix, glm::vec3(10, 0, 0)));
+
+    const auto& calculated = skeleton.calculated.matrices;
+    EXPECT_EQ(origin_of(calculated[0]), glm::vec3(10, 0, 0));
+    EXPECT_EQ(origin_of(calculated[1]), glm::vec3(10, 1, 0));
+    EXPECT_EQ(origin_of(calculated[2]), glm::vec3(10, 1.5f, 0));
+    EXPECT_EQ(origin_of(calculated[3]), glm::vec3(10, 0, -1));
+
+    // nothing changed
+    EXPECT_FALSE(config->update(skeleton, matrix, glm::vec3(10, 0, 0)));
+
+    skeleton.pose.matrices[1] =
+        glm::translate(glm::mat4(1.0f), glm::vec3(0, 2, 0));
+    skeleton.dirty = true;
+    EXPECT_TRUE(config->update(skeleton, matrix, glm::vec3(10, 0, 0)));
+    EXPECT_EQ(origin_of(calculated[2]), glm::vec3(10, 3.5f, 0));
+    EXPECT_EQ(origin_of(calculated[3]), glm::vec3(10, 0, -1));
+}
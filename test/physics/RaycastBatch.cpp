@@ -0,0 +1,250 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+
+#include "maths/rays.hpp"
+#include "physics/RaycastBatch.hpp"
+#include "test_content.hpp"
+
+/// @brief Minimal chunks storage for blocks_agent templates
+class TestChunks {
+    const ContentIndices& indices;
+    std::unordered_map<glm::ivec2, std::unique_ptr<Chunk>> chunks;
+public:
+    TestChunks(const ContentIndices& indices, int radius) : indices(indices) {
+        for (int cz = -radius; cz < radius; cz++) {
+            for (int cx = -radius; cx < radius; cx++) {
+                auto chunk = std::make_unique<Chunk>(cx, cz);
+                // flat ground with sparse pillars
+                test_content::fill_chunk(*chunk, 60, 10, 23);
+                chunks[glm::ivec2(cx, cz)] = std::move(chunk);
+            }
+        }
+    }
+
+    Chunk* getChunk(int cx, int cz) const {
+        const auto& found = chunks.find(glm::ivec2(cx, cz));
+        if (found == chunks.end()) {
+            return nullptr;
+        }
+        return found->second.get();
+    }
+
+    const ContentIndices& getContentIndices() const {
+        return indices;
+    }
+};
+
+class RaycastBatchTest : public ::testing::Test {
+protected:
+    std::unique_ptr<Content> content = test_content::create();
+};
+
+static std::vector<RaycastBatch::Query> generate_queries(
+    size_t count, float range
+) {
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> coord(-range, range);
+    std::uniform_real_distribution<float> height(60.0f, 80.0f);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::vector<RaycastBatch::Query> queries(count);
+    for (auto& query : queries) {
+        query.start = {coord(random), height(random), coord(random)};
+        glm::vec3 dir {unit(random), unit(random) * 0.5f, unit(random)};
+        query.dir = glm::normalize(dir + glm::vec3(1e-3f));
+        query.maxDistance = 64.0f;
+    }
+    return queries;
+}
+
+static std::vector<RaycastBatch::Target> generate_targets(
+    size_t count, float range
+) {
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> coord(-range, range);
+    std::vector<RaycastBatch::Target> targets(count);
+    for (size_t i = 0; i < count; i++) {
+        glm::vec3 pos {coord(random), 60.0f, coord(random)};
+        targets[i] = {i + 1, AABB(pos, pos + glm::vec3(0.6f, 1.8f, 0.6f))};
+    }
+    return targets;
+}
+
+TEST_F(RaycastBatchTest, MatchesSingleRaycast) {
+    TestChunks chunks(*content->getIndices(), 4);
+    auto queries = generate_queries(4000, 60.0f);
+    RaycastBatch batch;
+    auto hits = batch.perform(chunks, queries, {});
+    ASSERT_EQ(hits.size(), queries.size());
+
+    size_t blockHits = 0;
+    for (size_t i = 0; i < queries.size(); i++) {
+        const auto& query = queries[i];
+        glm::vec3 end;
+        glm::ivec3 normal;
+        glm::ivec3 iend;
+        blocks_agent::ChunkCache cache;
+        auto voxel = blocks_agent::raycast(
+            chunks,
+            cache,
+            query.start,
+            query.dir,
+            query.maxDistance,
+            end,
+            normal,
+            iend,
+            {}
+        );
+        if (voxel == nullptr) {
+            EXPECT_EQ(hits[i].block, BLOCK_VOID);
+            continue;
+        }
+        blockHits++;
+        EXPECT_EQ(hits[i].block, voxel->id);
+        EXPECT_EQ(hits[i].iend, iend);
+        EXPECT_EQ(hits[i].normal, normal);
+        EXPECT_FLOAT_EQ(hits[i].distance, glm::distance(query.start, end));
+    }
+    EXPECT_GT(blockHits, 0);
+}
+
+TEST_F(RaycastBatchTest, Entities) {
+    auto targets = generate_targets(500, 60.0f);
+    RaycastBatch batch(targets);
+    auto queries = generate_queries(2000, 60.0f);
+    size_t entityHits = 0;
+    for (const auto& query : queries) {
+        // brute force
+        Ray ray(query.start, query.dir);
+        RaycastBatch::Hit expected {};
+        expected.distance = query.maxDistance;
+        for (const auto& target : targets) {
+            glm::ivec3 normal;
+            scalar_t distance;
+            if (ray.intersectAABB(
+                    glm::vec3(), target.aabb, expected.distance, normal, distance
+                ) > RayRelation::None &&
+                distance < expected.distance) {
+                expected.entity = target.uid;
+                expected.distance = distance;
+            }
+        }
+        RaycastBatch::Hit hit {};
+        hit.distance = query.maxDistance;
+        EXPECT_EQ(batch.raycastEntities(query, 0, hit), expected.entity != 0);
+        EXPECT_EQ(hit.entity, expected.entity);
+        EXPECT_FLOAT_EQ(hit.distance, expected.distance);
+        entityHits += hit.entity != 0;
+
+        if (hit.entity) {
+            RaycastBatch::Hit ignored {};
+            ignored.distance = query.maxDistance;
+            batch.raycastEntities(query, hit.entity, ignored);
+            EXPECT_NE(ignored.entity, hit.entity);
+        }
+    }
+    EXPECT_GT(entityHits, 0);
+}
+
+TEST_F(RaycastBatchTest, InfiniteDistance) {
+    float infinity = std::numeric_limits<float>::infinity();
+    RaycastBatch batch({
+        {1, AABB(glm::vec3(0.0f), glm::vec3(1.0f))},
+        {2, AABB(glm::vec3(40.0f, 0.0f, 40.0f), glm::vec3(41.0f))},
+    });
+    // vertical ray
+    RaycastBatch::Query query {{0.5f, 10.0f, 0.5f}, {0, -1, 0}, infinity};
+    RaycastBatch::Hit hit {};
+    hit.distance = query.maxDistance;
+    EXPECT_TRUE(batch.raycastEntities(query, 0, hit));
+    EXPECT_EQ(hit.entity, 1);
+    EXPECT_FLOAT_EQ(hit.distance, 9.0f);
+
+    // vertical ray outside of the targets cells
+    query.start = {100.0f, 10.0f, 100.0f};
+    hit = {};
+    hit.distance = infinity;
+    EXPECT_FALSE(batch.raycastEntities(query, 0, hit));
+
+    // horizontal rays missing all targets
+    for (const auto& dir : {
+             glm::vec3(1, 0, 0),
+             glm::vec3(0, 0, -1),
+             glm::normalize(glm::vec3(1, 0, 1e-7f))}) {
+        query = {{0.5f, 10.0f, 0.5f}, dir, infinity};
+        hit = {};
+        hit.distance = infinity;
+        EXPECT_FALSE(batch.raycastEntities(query, 0, hit));
+    }
+    // diagonal ray hitting the far target
+    query = {{0.5f, 40.5f, 0.5f}, glm::normalize(glm::vec3(1, 0, 1)), infinity};
+    hit = {};
+    hit.distance = infinity;
+    EXPECT_TRUE(batch.raycastEntities(query, 1, hit));
+    EXPECT_EQ(hit.entity, 2);
+}
+
+TEST_F(RaycastBatchTest, DISABLED_Benchmark) {
+    TestChunks chunks(*content->getIndices(), 8);
+    auto queries = generate_queries(50'000, 120.0f);
+    auto targets = generate_targets(2000, 120.0f);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    size_t checksum1 = 0;
+    glm::vec3 end;
+    glm::ivec3 normal;
+    glm::ivec3 iend;
+    for (const auto& query : queries) {
+        blocks_agent::ChunkCache cache;
+        float maxDistance = query.maxDistance;
+        if (blocks_agent::raycast(
+                chunks,
+                cache,
+                query.start,
+                query.dir,
+                maxDistance,
+                end,
+                normal,
+                iend,
+                {}
+            )) {
+            maxDistance = glm::distance(query.start, end);
+            checksum1++;
+        }
+        // full entities scan as Entities::rayCast does
+        Ray ray(query.start, query.dir);
+        for (const auto& target : targets) {
+            scalar_t distance;
+            if (ray.intersectAABB(
+                    glm::vec3(), target.aabb, maxDistance, normal, distance
+                ) > RayRelation::None) {
+                maxDistance = distance;
+            }
+        }
+    }
+    auto finish = std::chrono::high_resolution_clock::now();
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(
+        finish - start
+    ).count();
+    std::cout << "single: " << queries.size() * 1'000'000 / us
+              << " rays/s" << std::endl;
+
+    start = std::chrono::high_resolution_clock::now();
+    RaycastBatch batch(targets);
+    auto hits = batch.perform(chunks, queries, {});
+    finish = std::chrono::high_resolution_clock::now();
+    us = std::chrono::duration_cast<std::chrono::microseconds>(
+        finish - start
+    ).count();
+    size_t checksum2 = 0;
+    for (const auto& hit : hits) {
+        checksum2 += hit.block != BLOCK_VOID;
+    }
+    std::cout << "batch: " << queries.size() * 1'000'000 / us
+              << " rays/s" << std::endl;
+    EXPECT_EQ(checksum1, checksum2);
+}
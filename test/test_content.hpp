@@ -0,0 +1,52 @@
+#pragma once
+
+#include <memory>
+
+#include "content/Content.hpp"
+#include "content/ContentBuilder.hpp"
+#include "core_defs.hpp"
+#include "items/ItemDef.hpp"
+#include "objects/rigging.hpp"
+#include "voxels/Block.hpp"
+#include "voxels/Chunk.hpp"
+
+/// @brief Shared content and chunks setup for tests
+namespace test_content {
+    inline constexpr blockid_t AIR = 0;
+    inline constexpr blockid_t STONE = 1;
+
+    /// @brief Build content with core:air and base:stone blocks only
+    inline std::unique_ptr<Content> create() {
+        ContentBuilder builder;
+        builder.items.create(CORE_EMPTY);
+
+        auto& air = builder.blocks.create(CORE_AIR);
+        air.replaceable = true;
+        air.lightPassing = true;
+        air.skyLightPassing = true;
+        air.obstacle = false;
+        air.selectable = false;
+        air.model.type = BlockModelType::NONE;
+        air.pickingItem = CORE_EMPTY;
+
+        auto& stone = builder.blocks.create("base:stone");
+        stone.pickingItem = CORE_EMPTY;
+        return builder.build();
+    }
+
+    /// @brief Fill chunk with stone ground and stone blocks scattered
+    /// over it
+    /// @param groundHeight height of the solid stone layer
+    /// @param bumpsHeight height of the scattered blocks layer
+    /// @param sparsity one of sparsity voxels of the layer is stone
+    inline void fill_chunk(
+        Chunk& chunk, int groundHeight, int bumpsHeight = 0, uint sparsity = 1
+    ) {
+        for (uint i = 0; i < CHUNK_VOL; i++) {
+            int y = i / (CHUNK_W * CHUNK_D);
+            bool bump = y < groundHeight + bumpsHeight &&
+                        (i * 2654435761u >> 9) % sparsity == 0;
+            chunk.voxels[i].id = y < groundHeight || bump ? STONE : AIR;
+        }
+    }
+}
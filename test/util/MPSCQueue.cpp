@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "util/MPSCQueue.hpp"
+
+using namespace util;
+
+TEST(MPSCQueue, Order) {
+    MPSCQueue<std::string> queue;
+    std::string value;
+    EXPECT_FALSE(queue.pop(value));
+    queue.push("a");
+    queue.push("b");
+    EXPECT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, "a");
+    queue.push("c");
+    EXPECT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, "b");
+    EXPECT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, "c");
+    EXPECT_FALSE(queue.pop(value));
+    // destructor frees remaining elements
+    queue.push("d");
+}
+
+TEST(MPSCQueue, MultipleProducers) {
+    const int producersCount = 4;
+    const uint32_t perProducer = 200'000;
+    MPSCQueue<uint64_t> queue;
+
+    std::vector<std::thread> producers;
+    for (int id = 0; id < producersCount; id++) {
+        producers.emplace_back([&queue, id]() {
+            for (uint32_t i = 0; i < perProducer; i++) {
+                queue.push(static_cast<uint64_t>(id) << 32 | i);
+            }
+        });
+    }
+    // elements of each producer must arrive in order
+    std::vector<uint32_t> next(producersCount);
+    uint64_t received = 0;
+    uint64_t value;
+    while (received < producersCount * perProducer) {
+        if (!queue.pop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        int id = value >> 32;
+        ASSERT_EQ(static_cast<uint32_t>(value), next[id]);
+        next[id]++;
+        received++;
+    }
+    for (auto& thread : producers) {
+        thread.join();
+    }
+    EXPECT_FALSE(queue.pop(value));
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "util/RingBuffer.hpp"
+
+using namespace util;
+
+TEST(RingBuffer, Capacity) {
+    RingBuffer<char> buffer(100);
+    EXPECT_EQ(buffer.capacity(), 128);
+    EXPECT_EQ(buffer.space(), 128);
+    EXPECT_TRUE(buffer.empty());
+}
+
+TEST(RingBuffer, WrapAround) {
+    RingBuffer<int> buffer(8);
+    int values[8] {0, 1, 2, 3, 4, 5, 6, 7};
+    int out[8] {};
+
+    EXPECT_EQ(buffer.write(values, 6), 6);
+    EXPECT_EQ(buffer.read(out, 4), 4);
+    // only 6 elements of free space left
+    EXPECT_EQ(buffer.write(values, 8), 6);
+    EXPECT_EQ(buffer.size(), 8);
+    EXPECT_EQ(buffer.space(), 0);
+
+    EXPECT_EQ(buffer.peek(out, 3, 1), 3);
+    EXPECT_EQ(out[0], 5);
+    EXPECT_EQ(out[1], 0);
+    EXPECT_EQ(out[2], 1);
+    EXPECT_EQ(buffer.size(), 8);
+
+    EXPECT_EQ(buffer.skip(2), 2);
+    EXPECT_EQ(buffer.read(out, 8), 6);
+    for (int i = 0; i < 6; i++) {
+        EXPECT_EQ(out[i], i);
+    }
+    EXPECT_TRUE(buffer.empty());
+}
+
+TEST(RingBuffer, WriteRegion) {
+    RingBuffer<char> buffer(8);
+    char out[8];
+    buffer.write("abcdef", 6);
+    buffer.skip(6);
+
+    size_t count;
+    char* region = buffer.writeRegion(count);
+    // contiguous part only
+    EXPECT_EQ(count, 2);
+    region[0] = 'x';
+    region[1] = 'y';
+    buffer.commit(2);
+    region = buffer.writeRegion(count);
+    EXPECT_EQ(count, 6);
+    region[0] = 'z';
+    buffer.commit(1);
+
+    EXPECT_EQ(buffer.read(out, 8), 3);
+    EXPECT_EQ(std::string(out, 3), "xyz");
+}
+
+TEST(RingBuffer, SingleProducerSingleConsumer) {
+    const size_t total = 1'000'000;
+    RingBuffer<uint32_t> buffer(1000);
+
+    std::thread producer([&buffer]() {
+        uint32_t chunk[37];
+        size_t next = 0;
+        while (next < total) {
+            size_t count = std::min<size_t>(37, total - next);
+            for (size_t i = 0; i < count; i++) {
+                chunk[i] = next + i;
+            }
+            size_t written = 0;
+            while (written < count) {
+                written += buffer.write(chunk + written, count - written);
+            }
+            next += count;
+        }
+    });
+    std::vector<uint32_t> received;
+    received.reserve(total);
+    uint32_t chunk[53];
+    while (received.size() < total) {
+        size_t count = buffer.read(chunk, 53);
+        received.insert(received.end(), chunk, chunk + count);
+    }
+    producer.join();
+
+    for (size_t i = 0; i < total; i++) {
+        ASSERT_EQ(received[i], i);
+    }
+}
@@ -82,3 +82,28 @@ TEST(SmallHeap, Iterator) {
     }
     EXPECT_EQ(sum, 44);
 }
+
+TEST(SmallHeap, DecodeTruncated) {
+    SmallHeap<uint16_t, uint8_t> map;
+    map.allocate(1, 10);
+    map.allocate(2, 20);
+    map.allocate(4, 14);
+    auto bytes = map.serialize();
+
+    for (size_t size = 0; size < bytes.size(); size++) {
+        SmallHeap<uint16_t, uint8_t> out;
+        EXPECT_THROW(out.deserialize(bytes.data(), size), std::invalid_argument)
+            << "size " << size;
+        EXPECT_EQ(out.count(), 0);
+    }
+    // trailing garbage
+    std::vector<ubyte> extended(bytes.data(), bytes.data() + bytes.size());
+    extended.push_back(0);
+    SmallHeap<uint16_t, uint8_t> out;
+    EXPECT_THROW(
+        out.deserialize(extended.data(), extended.size()),
+        std::invalid_argument
+    );
+    out.deserialize(bytes.data(), bytes.size());
+    EXPECT_EQ(map, out);
+}
@@ -0,0 +1,32 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+#include "util/parallel_for.hpp"
+
+TEST(parallel_for, CoversRange) {
+    for (size_t count : {0, 1, 7, 1000, 100'003}) {
+        std::vector<std::atomic<int>> visits(count);
+        util::parallel_for(count, 16, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                visits[i]++;
+            }
+        });
+        for (size_t i = 0; i < count; i++) {
+            EXPECT_EQ(visits[i], 1);
+        }
+    }
+}
+
+TEST(parallel_for, Nested) {
+    std::atomic<size_t> sum = 0;
+    util::parallel_for(64, 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            util::parallel_for(1000, 1, [&](size_t begin, size_t end) {
+                sum += end - begin;
+            });
+        }
+    });
+    EXPECT_EQ(sum, 64'000);
+}
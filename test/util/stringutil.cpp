@@ -47,3 +47,17 @@ TEST(stringutil, base64_urlsafe) {
         }
     }
 }
+
+TEST(stringutil, find_edit) {
+    auto edit = util::find_edit(L"hello world", L"hello, big world");
+    EXPECT_EQ(edit.start, 5);
+    EXPECT_EQ(edit.removed, 0);
+    EXPECT_EQ(edit.inserted, 5);
+
+    edit = util::find_edit(L"aaaa", L"aa");
+    EXPECT_EQ(edit.start, 2);
+    EXPECT_EQ(edit.removed, 2);
+    EXPECT_EQ(edit.inserted, 0);
+
+    EXPECT_TRUE(util::find_edit(L"same", L"same").empty());
+}
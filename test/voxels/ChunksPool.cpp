@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "voxels/Chunk.hpp"
+#include "voxels/ChunksPool.hpp"
+
+TEST(ChunksPool, Recycle) {
+    auto pool = std::make_shared<ChunksPool>(1);
+    bool recycled;
+    auto chunk = pool->acquire(1, 2, recycled);
+    EXPECT_FALSE(recycled);
+    chunk->voxels[10].id = 5;
+    chunk->flags.loaded = true;
+    chunk->blocksMetadata.allocate(10, 4);
+    Chunk* ptr = chunk.get();
+    uint64_t version = chunk->version;
+    chunk = nullptr;
+    EXPECT_EQ(pool->countFree(), 1);
+
+    chunk = pool->acquire(3, 4, recycled);
+    EXPECT_TRUE(recycled);
+    EXPECT_EQ(chunk.get(), ptr);
+    EXPECT_EQ(chunk->x, 3);
+    EXPECT_EQ(chunk->z, 4);
+    EXPECT_FALSE(chunk->flags.loaded);
+    EXPECT_EQ(chunk->blocksMetadata.count(), 0);
+    EXPECT_NE(chunk->version, version);
+    // voxels are not cleared
+    EXPECT_EQ(chunk->voxels[10].id, 5);
+    EXPECT_EQ(pool->countFree(), 0);
+}
+
+TEST(ChunksPool, Capacity) {
+    auto pool = std::make_shared<ChunksPool>(2);
+    bool recycled;
+    {
+        std::vector<std::shared_ptr<Chunk>> chunks;
+        for (int i = 0; i < 4; i++) {
+            chunks.push_back(pool->acquire(i, 0, recycled));
+        }
+    }
+    EXPECT_EQ(pool->countFree(), pool->getCapacity());
+
+    // chunks may outlive the pool
+    auto chunk = pool->acquire(0, 0, recycled);
+    pool = nullptr;
+    chunk = nullptr;
+}
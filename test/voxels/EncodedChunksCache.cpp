@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include "test_content.hpp"
+#include "voxels/EncodedChunksCache.hpp"
+#include "voxels/compressed_chunks.hpp"
+
+TEST(EncodedChunksCache, Delta) {
+    auto content = test_content::create();
+    const auto& indices = *content->getIndices();
+
+    EncodedChunksCache cache;
+    Chunk chunk(0, 0);
+    test_content::fill_chunk(chunk, 60, 8, 2);
+    auto payload1 = cache.get(chunk);
+    uint64_t version1 = chunk.version;
+    EXPECT_EQ(payload1, cache.get(chunk));
+
+    for (int y = 64; y < 70; y++) {
+        chunk.voxels[vox_index(3, y, 5)].id = 1;
+    }
+    chunk.voxels[vox_index(8, 63, 8)].id = 0;
+    chunk.setModifiedAndUnsaved();
+    EXPECT_NE(chunk.version, version1);
+
+    auto payload2 = cache.get(chunk);
+    EXPECT_NE(payload1, payload2);
+    auto delta = cache.get(chunk, version1);
+    EXPECT_LT(delta->size(), payload2->size());
+    EXPECT_EQ(delta, cache.get(chunk, version1));
+    // unknown version
+    EXPECT_EQ(payload2, cache.get(chunk, chunk.version + 100));
+
+    Chunk received(0, 0);
+    compressed_chunks::decode(
+        received, payload1->data(), payload1->size(), indices
+    );
+    compressed_chunks::decode(received, delta->data(), delta->size(), indices);
+    for (int i = 0; i < CHUNK_VOL; i++) {
+        ASSERT_EQ(received.voxels[i].id, chunk.voxels[i].id);
+    }
+}
+
+TEST(EncodedChunksCache, Eviction) {
+    std::vector<std::unique_ptr<Chunk>> chunks;
+    for (int i = 0; i < 10; i++) {
+        chunks.push_back(std::make_unique<Chunk>(i, 0));
+        test_content::fill_chunk(*chunks.back(), 60, 8, 2);
+    }
+    size_t entrySize;
+    {
+        EncodedChunksCache cache;
+        cache.get(*chunks[0]);
+        entrySize = cache.getTotalSize();
+        EXPECT_GT(entrySize, 0);
+    }
+    // capacity is limited by bytes
+    EncodedChunksCache cache(entrySize * 4);
+    for (const auto& chunk : chunks) {
+        cache.get(*chunk);
+        EXPECT_LE(cache.getTotalSize(), entrySize * 4);
+    }
+    EXPECT_LE(cache.size(), 4);
+    cache.invalidate(chunks.back()->x, chunks.back()->z);
+    EXPECT_LE(cache.getTotalSize(), entrySize * 3);
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include "coders/byte_utils.hpp"
+#include "coders/gzip.hpp"
+#include "test_content.hpp"
+#include "voxels/compressed_chunks.hpp"
+
+/// @brief Build delta payload containing a single run
+static std::vector<ubyte> build_delta(int32_t offset, int32_t length) {
+    ByteBuilder runs;
+    runs.putInt32(offset);
+    runs.putInt32(length);
+    for (int32_t i = 0; i < 32; i++) {
+        runs.put(0xFF);
+    }
+    auto runsBytes = runs.build();
+    auto gzipped = gzip::compress(runsBytes.data(), runsBytes.size());
+
+    ByteBuilder builder;
+    builder.put(0x4); // voxels delta
+    builder.put(0);
+    builder.putInt32(gzipped.size());
+    builder.put(gzipped.data(), gzipped.size());
+    return builder.build();
+}
+
+TEST(compressed_chunks, InvalidDelta) {
+    auto content = test_content::create();
+    const auto& indices = *content->getIndices();
+    Chunk chunk(0, 0);
+
+    // negative offset
+    auto payload = build_delta(-16, 32);
+    EXPECT_THROW(
+        compressed_chunks::decode(
+            chunk, payload.data(), payload.size(), indices
+        ),
+        std::runtime_error
+    );
+    // run out of the chunk data
+    payload = build_delta(CHUNK_DATA_LEN - 16, 32);
+    EXPECT_THROW(
+        compressed_chunks::decode(
+            chunk, payload.data(), payload.size(), indices
+        ),
+        std::runtime_error
+    );
+    // length is larger than the run data
+    payload = build_delta(0, 64);
+    EXPECT_THROW(
+        compressed_chunks::decode(
+            chunk, payload.data(), payload.size(), indices
+        ),
+        std::runtime_error
+    );
+    // gzip data size is larger than the payload
+    payload = build_delta(0, 32);
+    payload[2] = 0xFF;
+    payload[3] = 0xFF;
+    EXPECT_THROW(
+        compressed_chunks::decode(
+            chunk, payload.data(), payload.size(), indices
+        ),
+        std::runtime_error
+    );
+    for (int i = 0; i < CHUNK_VOL; i++) {
+        ASSERT_EQ(chunk.voxels[i].id, 0);
+    }
+}
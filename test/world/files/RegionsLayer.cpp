@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "coders/zstd.hpp"
+#include "io/io.hpp"
+#include "io/devices/StdfsDevice.hpp"
+#include "world/files/WorldRegions.hpp"
+
+namespace fs = std::filesystem;
+
+static constexpr uint32_t SOURCE_SIZE = 256;
+
+static void fill_source(ubyte* source) {
+    for (uint32_t i = 0; i < SOURCE_SIZE; i++) {
+        source[i] = i / 16;
+    }
+}
+
+/// @brief Write test region 0_0 with every third diagonal chunk present
+static void write_region(RegionsLayer& layer, const ubyte* source) {
+    WorldRegion region;
+    for (uint i = 0; i < REGION_SIZE; i += 3) {
+        size_t size;
+        auto data = compression::compress(
+            source, SOURCE_SIZE, size, layer.compression
+        );
+        region.put(i, i, std::move(data), size, SOURCE_SIZE);
+    }
+    layer.writeRegion(0, 0, &region);
+}
+
+class RegionsLayerTest : public ::testing::Test {
+protected:
+    fs::path root = fs::temp_directory_path() / "ve_regions_test";
+    RegionsLayer layer {};
+    ubyte source[SOURCE_SIZE];
+
+    void SetUp() override {
+        fs::create_directories(root);
+        io::set_device("regtest", std::make_shared<io::StdfsDevice>(root));
+        layer.folder = "regtest:";
+        layer.compression = compression::Method::EXTRLE8;
+        fill_source(source);
+        write_region(layer, source);
+    }
+
+    void TearDown() override {
+        layer.openRegFiles.clear();
+        io::remove_device("regtest");
+        fs::remove_all(root);
+    }
+};
+
+TEST_F(RegionsLayerTest, ReadChunks) {
+    regfile file(layer.getRegionFilePath(0, 0));
+#ifdef __linux__
+    EXPECT_NE(file.mapped, nullptr);
+#endif
+    EXPECT_EQ(file.compression, compression::Method::EXTRLE8);
+    for (uint i = 0; i < REGION_SIZE; i++) {
+        uint32_t size, srcSize;
+        auto data = file.read(i * REGION_SIZE + i, size, srcSize);
+        if (i % 3) {
+            EXPECT_EQ(data, nullptr);
+            continue;
+        }
+        ASSERT_NE(data, nullptr);
+        EXPECT_EQ(srcSize, SOURCE_SIZE);
+        if (const ubyte* view = file.view(i * REGION_SIZE + i, size, srcSize)) {
+            EXPECT_EQ(std::memcmp(view, data.get(), size), 0);
+        }
+        auto decompressed = layer.getDecompressed(i, i, srcSize);
+        ASSERT_NE(decompressed, nullptr);
+        EXPECT_EQ(srcSize, SOURCE_SIZE);
+        EXPECT_EQ(std::memcmp(decompressed.get(), source, SOURCE_SIZE), 0);
+    }
+    uint32_t srcSize;
+    EXPECT_EQ(layer.getDecompressed(1, 0, srcSize), nullptr);
+}
+
+TEST_F(RegionsLayerTest, Recompress) {
+    layer.compression = compression::Method::ZSTD;
+    {
+        // region file written with another method is converted on read
+        regfile file(layer.getRegionFilePath(0, 0));
+        uint32_t size, srcSize;
+        auto data = layer.readChunkData(3, 3, size, srcSize, &file);
+        ASSERT_NE(data, nullptr);
+        auto decompressed = compression::decompress(
+            data.get(), size, srcSize, layer.compression
+        );
+        EXPECT_EQ(std::memcmp(decompressed.get(), source, SOURCE_SIZE), 0);
+    }
+    layer.recompressRegion(0, 0);
+
+    regfile file(layer.getRegionFilePath(0, 0));
+    EXPECT_EQ(file.compression, compression::Method::ZSTD);
+    for (uint i = 0; i < REGION_SIZE; i += 3) {
+        uint32_t srcSize;
+        auto decompressed = layer.getDecompressed(i, i, srcSize);
+        ASSERT_NE(decompressed, nullptr);
+        EXPECT_EQ(std::memcmp(decompressed.get(), source, SOURCE_SIZE), 0);
+    }
+}
+
+static std::shared_ptr<zstd::Dictionary> train_dictionary(
+    const std::string& name
+) {
+    std::vector<ubyte> samples;
+    std::vector<size_t> sizes;
+    for (int i = 0; i < 1000; i++) {
+        std::string sample = "{\"id\":" + std::to_string(i) + ",\"name\":\"" +
+                             name + "\",\"count\":" +
+                             std::to_string(i % 64) + "}";
+        samples.insert(samples.end(), sample.begin(), sample.end());
+        sizes.push_back(sample.size());
+    }
+    return std::make_shared<zstd::Dictionary>(
+        zstd::train_dictionary(samples, sizes, 4096), zstd::DEFAULT_LEVEL
+    );
+}
+
+TEST_F(RegionsLayerTest, RecompressDictionary) {
+    auto prevDictionary = train_dictionary("base:item");
+    auto dictionary = train_dictionary("base:block");
+    ASSERT_NE(prevDictionary->getId(), dictionary->getId());
+
+    layer.compression = compression::Method::ZSTD;
+    layer.compression.dictionary = prevDictionary;
+    layer.dictionaries[prevDictionary->getId()] = prevDictionary;
+    write_region(layer, source);
+
+    // regions are decompressed using dictionary with the frame ID
+    layer.compression.dictionary = dictionary;
+    layer.dictionaries[dictionary->getId()] = dictionary;
+    layer.recompressRegion(0, 0);
+
+    layer.dictionaries.erase(prevDictionary->getId());
+    for (uint i = 0; i < REGION_SIZE; i += 3) {
+        uint32_t srcSize;
+        auto decompressed = layer.getDecompressed(i, i, srcSize);
+        ASSERT_NE(decompressed, nullptr);
+        EXPECT_EQ(std::memcmp(decompressed.get(), source, SOURCE_SIZE), 0);
+    }
+    layer.dictionaries.clear();
+    uint32_t srcSize;
+    EXPECT_THROW(layer.getDecompressed(0, 0, srcSize), std::runtime_error);
+}
+
+TEST_F(RegionsLayerTest, FlushRegion) {
+    size_t size;
+    auto data = compression::compress(
+        source, SOURCE_SIZE, size, layer.compression
+    );
+    auto region = layer.getOrCreateRegion(0, 0);
+    region->put(1, 1, std::move(data), size, SOURCE_SIZE);
+    region->setUnsaved(true);
+    layer.flushRegion(0, 0);
+
+    EXPECT_EQ(layer.countRegions(), 0);
+    EXPECT_FALSE(fs::exists(root / "0_0.bin.tmp"));
+
+    // chunks missing in memory are kept from the closed region file
+    regfile file(layer.getRegionFilePath(0, 0));
+    for (uint i = 0; i < REGION_SIZE; i++) {
+        uint32_t srcSize;
+        auto data = layer.readDecompressed(file, i * REGION_SIZE + i, srcSize);
+        if (i % 3 && i != 1) {
+            EXPECT_EQ(data, nullptr);
+            continue;
+        }
+        ASSERT_NE(data, nullptr);
+        EXPECT_EQ(std::memcmp(data.get(), source, SOURCE_SIZE), 0);
+    }
+}
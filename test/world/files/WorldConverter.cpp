@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include "content/ContentReport.hpp"
+#include "io/devices/StdfsDevice.hpp"
+#include "io/io.hpp"
+#include "test_content.hpp"
+#include "world/files/WorldConverter.hpp"
+#include "world/files/WorldFiles.hpp"
+
+namespace fs = std::filesystem;
+
+static constexpr int GROUND_HEIGHT = 60;
+
+/// @brief World saved with air and stone indices swapped
+class WorldConverterTest : public ::testing::Test {
+protected:
+    fs::path root = fs::temp_directory_path() / "ve_converter_test";
+    std::unique_ptr<Content> content;
+    std::shared_ptr<WorldFiles> worldFiles;
+    std::shared_ptr<ContentReport> report;
+    io::path regionFile;
+    io::path journalFile;
+
+    void SetUp() override {
+        fs::create_directories(root);
+        io::set_device("convtest", std::make_shared<io::StdfsDevice>(root));
+        content = test_content::create();
+        worldFiles = std::make_shared<WorldFiles>("convtest:");
+
+        auto& regions = worldFiles->getRegions();
+        io::create_directories(regions.getRegionsFolder(REGION_LAYER_VOXELS));
+        Chunk chunk(0, 0);
+        test_content::fill_chunk(chunk, GROUND_HEIGHT);
+        regions.put(0, 0, REGION_LAYER_VOXELS, chunk.encode(), CHUNK_DATA_LEN);
+        regions.flush();
+        regionFile = regions.getRegionFilePath(REGION_LAYER_VOXELS, 0, 0);
+        journalFile = worldFiles->getFolder() / WorldConverter::JOURNAL_FILE;
+
+        report = std::make_shared<ContentReport>(
+            content->getIndices(), 2, 0, REGION_FORMAT_VERSION
+        );
+        report->blocks.set(0, "base:stone", test_content::STONE);
+        report->blocks.set(1, "core:air", test_content::AIR);
+        report->buildIssues();
+    }
+
+    void TearDown() override {
+        worldFiles.reset();
+        io::remove_device("convtest");
+        fs::remove_all(root);
+    }
+
+    void convert() {
+        WorldConverter converter(
+            worldFiles, content.get(), report, ConvertMode::REINDEX
+        );
+        converter.waitForEnd();
+    }
+
+    /// @brief Remove the last journal line, as if the converter was
+    /// interrupted before the task commit
+    void dropLastCommit() {
+        auto lines = io::read_list(journalFile);
+        ASSERT_GE(lines.size(), 3);
+        const auto& pending = lines[lines.size() - 2];
+        ASSERT_EQ(pending.rfind(WorldConverter::JOURNAL_PENDING, 0), 0);
+        lines.pop_back();
+        std::string text;
+        for (const auto& line : lines) {
+            text += line + "\n";
+        }
+        io::write_string(journalFile, text);
+    }
+
+    /// @brief Check region is converted exactly once
+    void expectConverted() {
+        auto voxels = worldFiles->getRegions().getVoxels(0, 0);
+        ASSERT_NE(voxels, nullptr);
+        Chunk chunk(0, 0);
+        chunk.decode(voxels.get());
+        for (uint i = 0; i < CHUNK_VOL; i++) {
+            int y = i / (CHUNK_W * CHUNK_D);
+            blockid_t expected =
+                y < GROUND_HEIGHT ? test_content::AIR : test_content::STONE;
+            ASSERT_EQ(chunk.voxels[i].id, expected) << "voxel " << i;
+        }
+    }
+};
+
+TEST_F(WorldConverterTest, Convert) {
+    convert();
+    expectConverted();
+    // finished tasks are not repeated
+    convert();
+    expectConverted();
+}
+
+TEST_F(WorldConverterTest, InterruptedAfterReplace) {
+    convert();
+    dropLastCommit();
+    convert();
+    expectConverted();
+}
+
+TEST_F(WorldConverterTest, InterruptedBeforeReplace) {
+    auto source = io::read_bytes_buffer(regionFile);
+    convert();
+    dropLastCommit();
+    // converted region is left in the temporary file
+    auto converted = io::read_bytes_buffer(regionFile);
+    io::path tmpFile = regionFile.string() + ".tmp";
+    io::write_bytes(tmpFile, converted.data(), converted.size());
+    io::write_bytes(regionFile, source.data(), source.size());
+
+    convert();
+    expectConverted();
+    EXPECT_FALSE(io::is_regular_file(tmpFile));
+}
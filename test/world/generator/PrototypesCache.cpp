@@ -0,0 +1,35 @@
+#include <gtest/gtest.h>
+
+#include "world/generator/PrototypesCache.hpp"
+
+TEST(PrototypesCache, RequireFind) {
+    PrototypesCache cache(16);
+    EXPECT_EQ(cache.find(1, 2), nullptr);
+
+    auto& entry = cache.require(1, 2);
+    EXPECT_EQ(entry.structs, nullptr);
+    entry.structs = std::make_unique<std::vector<Placement>>();
+    entry.structs->emplace_back(1, StructurePlacement(0, {1, 2, 3}, 0));
+
+    auto found = cache.find(1, 2);
+    ASSERT_NE(found, nullptr);
+    ASSERT_NE(found->structs, nullptr);
+    EXPECT_EQ(found->structs->size(), 1);
+    EXPECT_EQ(&cache.require(1, 2), found);
+    EXPECT_EQ(cache.size(), 1);
+}
+
+TEST(PrototypesCache, Evict) {
+    PrototypesCache cache(16);
+    for (int i = 0; i < 16; i++) {
+        cache.require(i, 0);
+    }
+    // keep the first entry recently used
+    cache.find(0, 0);
+    cache.require(100, 0);
+
+    EXPECT_LE(cache.size(), cache.getCapacity());
+    EXPECT_NE(cache.find(0, 0), nullptr);
+    EXPECT_NE(cache.find(100, 0), nullptr);
+    EXPECT_EQ(cache.find(1, 0), nullptr);
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstring>
+#include <memory>
+
+#include "maths/Heightmap.hpp"
+#include "test_content.hpp"
+#include "world/generator/GeneratorDef.hpp"
+#include "world/generator/WorldGenerator.hpp"
+
+/// @brief Deterministic script using heightmap inputs the way generator
+/// scripts do
+class TestScript : public GeneratorScript {
+public:
+    int emptyInputsCalls = 0;
+
+    void initialize(uint64_t) override {
+    }
+
+    std::shared_ptr<Heightmap> generateHeightmap(
+        const glm::ivec2& offset,
+        const glm::ivec2& size,
+        uint bpd,
+        const std::vector<std::shared_ptr<Heightmap>>& inputs
+    ) override {
+        auto map = std::make_shared<Heightmap>(size.x, size.y);
+        if (inputs.empty()) {
+            emptyInputsCalls++;
+            return map;
+        }
+        const float* src = inputs[0]->getValues();
+        float* dst = map->getValues();
+        for (int i = 0; i < size.x * size.y; i++) {
+            dst[i] = 0.2f + src[i] * 0.5f;
+        }
+        return map;
+    }
+
+    std::vector<std::shared_ptr<Heightmap>> generateParameterMaps(
+        const glm::ivec2& offset, const glm::ivec2& size, uint bpd
+    ) override {
+        auto map = std::make_shared<Heightmap>(size.x, size.y);
+        float* values = map->getValues();
+        for (int y = 0; y < size.y; y++) {
+            for (int x = 0; x < size.x; x++) {
+                float wx = (offset.x + x) * 0.13f;
+                float wz = (offset.y + y) * 0.07f;
+                values[y * size.x + x] =
+                    std::sin(wx) * std::cos(wz) * 0.5f + 0.5f;
+            }
+        }
+        return {map};
+    }
+
+    std::vector<Placement> placeStructuresWide(
+        const glm::ivec2&, const glm::ivec2&, uint
+    ) override {
+        return {};
+    }
+
+    std::vector<Placement> placeStructures(
+        const glm::ivec2&,
+        const glm::ivec2&,
+        const std::shared_ptr<Heightmap>&,
+        uint
+    ) override {
+        return {};
+    }
+};
+
+static std::unique_ptr<GeneratorDef> create_generator(const Content& content) {
+    auto def = std::make_unique<GeneratorDef>("test:generator");
+    def->script = std::make_unique<TestScript>();
+    def->biomeParameters = 1;
+    def->heightmapInputs = {0};
+    def->wideStructsChunksRadius = 1;
+
+    Biome biome {};
+    biome.name = "test:plain";
+    biome.parameters = {{0.5f, 1.0f}};
+    biome.groundLayers.layers = {{"base:stone", -1, true, {}}};
+    biome.groundLayers.lastLayersHeight = 0;
+    def->biomes.push_back(std::move(biome));
+    def->prepare(&content);
+    return def;
+}
+
+/// @brief Compare chunk with one generated without cached results
+static void expect_same_chunk(
+    WorldGenerator& generator,
+    const GeneratorDef& def,
+    const Content& content,
+    int x,
+    int z
+) {
+    auto actual = std::make_unique<voxel[]>(CHUNK_VOL);
+    generator.generate(actual.get(), x, z);
+
+    WorldGenerator reference(def, content, 0);
+    reference.update(x, z, 1);
+    auto expected = std::make_unique<voxel[]>(CHUNK_VOL);
+    reference.generate(expected.get(), x, z);
+    EXPECT_EQ(
+        std::memcmp(actual.get(), expected.get(), sizeof(voxel) * CHUNK_VOL), 0
+    ) << "chunk " << x << " " << z;
+}
+
+TEST(WorldGenerator, CacheEvictionBetweenStages) {
+    auto content = test_content::create();
+    auto def = create_generator(*content);
+    auto referenceDef = create_generator(*content);
+    auto script = static_cast<TestScript*>(def->script.get());
+
+    WorldGenerator generator(*def, *content, 0, 128);
+    auto voxels = std::make_unique<voxel[]>(CHUNK_VOL);
+    // chunks around 0, 0 get biomes and heightmaps cached
+    generator.update(0, 0, 1);
+    generator.generate(voxels.get(), 0, 0);
+    // prototypes are removed out of the area, cache entries are kept
+    generator.update(9, 0, 1);
+    // biomes of the 0, 0 column are taken from the cache
+    generator.update(3, 0, 1);
+    generator.generate(voxels.get(), 3, 0);
+    // new chunks evict the column entries before its heightmaps stage
+    for (int x : {6, 8}) {
+        generator.update(x, 0, 1);
+        generator.generate(voxels.get(), x, 0);
+    }
+    generator.update(2, 0, 1);
+    for (int z = -2; z <= 2; z++) {
+        expect_same_chunk(generator, *referenceDef, *content, 0, z);
+    }
+    EXPECT_EQ(script->emptyInputsCalls, 0);
+    EXPECT_LE(generator.getPrototypesCache().size(), 128);
+}